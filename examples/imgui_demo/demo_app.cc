@@ -40,6 +40,11 @@ void demo_app::load_default_fonts() {
 }
 
 void demo_app::render() {
+    // Pick up caches rebuilt in the background after a size change
+    if (m_font_manager.update()) {
+        m_renderer_dirty = true;
+    }
+
     // Menu bar
     if (ImGui::BeginMainMenuBar()) {
         if (ImGui::BeginMenu("File")) {
@@ -96,12 +96,10 @@ bool font_manager::load_font_data(font_data& fd, int font_index) {
             if (!fd.bitmap) {
                 return false;
             }
-            fd.source = std::make_unique<onyx_font::font_source>(
-                onyx_font::font_source::from_bitmap(*fd.bitmap));
             fd.info.type = onyx_font::font_source_type::bitmap;
             fd.info.scalable = false;
             // Bitmap fonts have fixed size
-            fd.info.current_size = fd.source->native_size();
+            fd.info.current_size = make_source(fd).native_size();
             break;
         }
 
@@ -111,8 +109,6 @@ bool font_manager::load_font_data(font_data& fd, int font_index) {
             if (!fd.vector) {
                 return false;
             }
-            fd.source = std::make_unique<onyx_font::font_source>(
-                onyx_font::font_source::from_vector(*fd.vector));
             fd.info.type = onyx_font::font_source_type::vector;
             fd.info.scalable = true;
             break;
@@ -125,8 +121,6 @@ bool font_manager::load_font_data(font_data& fd, int font_index) {
                 return false;
             }
 
-            fd.source = std::make_unique<onyx_font::font_source>(
-                onyx_font::font_source::from_ttf(*fd.ttf));
             fd.info.type = onyx_font::font_source_type::outline;
             fd.info.scalable = true;
             break;
@@ -142,27 +136,35 @@ bool font_manager::load_font_data(font_data& fd, int font_index) {
     }
 
     // Build the renderer
-    rebuild_renderer(fd);
+    build_renderer(fd);
 
     return fd.renderer != nullptr;
 }
 
-void font_manager::rebuild_renderer(font_data& fd) {
-    if (!fd.source) {
-        return;
+onyx_font::font_source font_manager::make_source(const font_data& fd) {
+    if (fd.bitmap) {
+        return onyx_font::font_source::from_bitmap(*fd.bitmap);
     }
+    if (fd.vector) {
+        return onyx_font::font_source::from_vector(*fd.vector);
+    }
+    return onyx_font::font_source::from_ttf(*fd.ttf);
+}
 
-    // Create glyph cache with current size
+void font_manager::build_renderer(font_data& fd) {
     onyx_font::glyph_cache_config config;
     config.atlas_size = 512;
     config.pre_cache_ascii = true;
 
-    fd.cache = std::make_unique<onyx_font::glyph_cache<onyx_font::memory_atlas>>(
-        std::move(*fd.source), fd.info.current_size, config);
+    // font_data lives behind a unique_ptr, so the factory may keep a
+    // pointer; the cache (declared after the fonts) waits for its
+    // background build before the fonts are destroyed
+    const font_data* data = &fd;
+    fd.cache = std::make_unique<onyx_font::resizable_glyph_cache<onyx_font::memory_atlas>>(
+        [data] { return make_source(*data); }, fd.info.current_size, config);
 
-    // Create text renderer
     fd.renderer = std::make_unique<onyx_font::text_renderer<onyx_font::memory_atlas>>(
-        *fd.cache);
+        fd.cache->active());
 }
 
 void font_manager::remove_font(std::size_t index) {
@@ -189,7 +191,7 @@ font_manager::get_renderer(std::size_t index) {
 onyx_font::glyph_cache<onyx_font::memory_atlas>*
 font_manager::get_cache(std::size_t index) {
     if (index < m_fonts.size()) {
-        return m_fonts[index]->cache.get();
+        return &m_fonts[index]->cache->active();
     }
     return nullptr;
 }
@@ -213,11 +215,24 @@ bool font_manager::set_font_size(std::size_t index, float size) {
         return false; // No significant change
     }
 
+    // The old cache keeps serving until update() swaps the new one in
     fd.info.current_size = size;
-    rebuild_renderer(fd);
+    fd.cache->resize(size);
     return true;
 }
 
+bool font_manager::update() {
+    bool swapped = false;
+    for (auto& fd : m_fonts) {
+        if (fd->cache && fd->cache->poll()) {
+            fd->renderer = std::make_unique<onyx_font::text_renderer<onyx_font::memory_atlas>>(
+                fd->cache->active());
+            swapped = true;
+        }
+    }
+    return swapped;
+}
+
 std::vector<std::pair<std::string, std::string>> font_manager::get_test_fonts() {
     std::vector<std::pair<std::string, std::string>> fonts;
 
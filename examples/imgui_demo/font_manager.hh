@@ -12,6 +12,7 @@
 #include <onyx_font/font_factory.hh>
 #include <onyx_font/text/font_source.hh>
 #include <onyx_font/text/glyph_cache.hh>
+#include <onyx_font/text/resizable_cache.hh>
 #include <onyx_font/text/atlas_surface.hh>
 #include <onyx_font/text/text_renderer.hh>
 
@@ -80,12 +81,17 @@ public:
     [[nodiscard]] onyx_font::glyph_cache<onyx_font::memory_atlas>*
         get_cache(std::size_t index);
 
-    /// Update font size (recreates cache/renderer)
+    /// Update font size (the cache for the new size is built in the
+    /// background; the old one keeps serving until update() swaps)
     /// @param index Font index
     /// @param size New size in pixels
-    /// @return true if size was changed
+    /// @return true if a size change was requested
     bool set_font_size(std::size_t index, float size);
 
+    /// Swap in caches finished in the background (call once per frame)
+    /// @return true if any cache (and its renderer) was replaced
+    bool update();
+
     /// Get list of available test fonts
     [[nodiscard]] static std::vector<std::pair<std::string, std::string>>
         get_test_fonts();
@@ -102,8 +108,7 @@ private:
         std::optional<onyx_font::ttf_font> ttf;
 
         // Rendering pipeline
-        std::unique_ptr<onyx_font::font_source> source;
-        std::unique_ptr<onyx_font::glyph_cache<onyx_font::memory_atlas>> cache;
+        std::unique_ptr<onyx_font::resizable_glyph_cache<onyx_font::memory_atlas>> cache;
         std::unique_ptr<onyx_font::text_renderer<onyx_font::memory_atlas>> renderer;
 
         // Metadata
@@ -115,8 +120,11 @@ private:
     /// Helper to detect font type and load
     bool load_font_data(font_data& fd, int font_index);
 
-    /// Rebuild cache and renderer after size change
-    void rebuild_renderer(font_data& fd);
+    /// Create a font source for the loaded font (callable from any thread)
+    static onyx_font::font_source make_source(const font_data& fd);
+
+    /// Create the cache and renderer for the current size
+    void build_renderer(font_data& fd);
 };
 
 } // namespace imgui_demo
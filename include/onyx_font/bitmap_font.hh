@@ -56,7 +56,7 @@
  * int pen_x = start_x;
  * int pen_y = start_y;  // Top of text line
  *
- * for (char ch : text) {
+ * for (char32_t ch : utf8_view(text)) {
  *     if (!font.has_glyph(ch)) {
  *         ch = font.get_default_char();
  *     }
@@ -109,10 +109,14 @@
 #include <span>
 #include <vector>
 #include <onyx_font/utils/bitmap_glyphs_storage.hh>
+#include <onyx_font/utils/codepoint_index.hh>
+#include <onyx_font/utils/codepage.hh>
 
 namespace onyx_font {
     namespace internal {
         struct win_bitmap_fon_loader;
+        struct psf_font_loader;
+        struct bundle_font_codec;
     }
 
     struct font_converter;
@@ -239,6 +243,15 @@ namespace onyx_font {
      * - Windows .FON files (NE/PE executables with font resources)
      * - Raw BIOS font dumps (VGA 8x8, 8x14, 8x16)
      * - Converted from vector or TrueType fonts via font_converter
+     * - Linux console PSF fonts
+     *
+     * @section char_codes Character Codes
+     *
+     * FON, FNT and raw fonts cover a contiguous range of 8-bit codes in
+     * their native encoding. PSF fonts with a Unicode table and wide
+     * font_converter output map Unicode codepoints to glyphs through a
+     * sparse codepoint_index, so they can hold tens of thousands of glyphs.
+     * Lookup is O(1) either way.
      *
      * @section usage_example Usage Example
      *
@@ -271,6 +284,8 @@ namespace onyx_font {
      */
     class ONYX_FONT_EXPORT bitmap_font {
         friend struct internal::win_bitmap_fon_loader;
+        friend struct internal::psf_font_loader;
+        friend struct internal::bundle_font_codec;
         friend struct font_converter;
         friend struct font_factory;
 
@@ -291,15 +306,19 @@ namespace onyx_font {
 
         /**
          * @brief Get the first character code in the font.
+         *
+         * For fonts with a sparse index this is the lowest mapped
+         * codepoint; characters between the first and last may be missing.
+         *
          * @return First valid character code (typically 0 or 32)
          */
-        [[nodiscard]] uint8_t get_first_char() const;
+        [[nodiscard]] char32_t get_first_char() const;
 
         /**
          * @brief Get the last character code in the font.
-         * @return Last valid character code (typically 255)
+         * @return Last valid character code (typically 255 for 8-bit fonts)
          */
-        [[nodiscard]] uint8_t get_last_char() const;
+        [[nodiscard]] char32_t get_last_char() const;
 
         /**
          * @brief Get the default character for missing glyphs.
@@ -309,13 +328,24 @@ namespace onyx_font {
          *
          * @return Default character code (typically '?' or a box glyph)
          */
-        [[nodiscard]] uint8_t get_default_char() const;
+        [[nodiscard]] char32_t get_default_char() const;
 
         /**
          * @brief Get the word break character.
          * @return Break character code (typically space, 0x20)
          */
-        [[nodiscard]] uint8_t get_break_char() const;
+        [[nodiscard]] char32_t get_break_char() const;
+
+        /**
+         * @brief Get the codepage of the font's 8-bit character codes.
+         *
+         * Known for Windows fonts with a recognized charset and for raw
+         * BIOS fonts (CP437 by default). font_source uses it to map
+         * Unicode text to glyphs.
+         *
+         * @return Codepage, or nullopt if unknown or the font is Unicode
+         */
+        [[nodiscard]] std::optional<codepage> get_codepage() const;
 
         /**
          * @brief Get font-level metrics.
@@ -327,17 +357,23 @@ namespace onyx_font {
          */
         [[nodiscard]] const font_metrics& get_metrics() const;
 
+        /**
+         * @brief Check whether the font has a glyph for a character.
+         * @param ch Character code
+         * @return True if get_glyph() and get_spacing() accept @p ch
+         */
+        [[nodiscard]] bool has_glyph(char32_t ch) const;
+
         /**
          * @brief Get spacing information for a character.
          *
          * Returns the ABC spacing values for positioning the character.
-         * If the character is outside the font's range, returns spacing
-         * for the default character.
          *
          * @param ch Character code
          * @return Reference to glyph spacing data
+         * @throws std::out_of_range if the font has no glyph for @p ch
          */
-        [[nodiscard]] const glyph_spacing& get_spacing(uint8_t ch) const;
+        [[nodiscard]] const glyph_spacing& get_spacing(char32_t ch) const;
 
         /**
          * @brief Get the bitmap view for a character's glyph.
@@ -345,25 +381,64 @@ namespace onyx_font {
          * Returns a view into the glyph's bitmap data. The view provides
          * access to individual pixels and row data.
          *
-         * If the character is outside the font's range, returns the
-         * glyph for the default character.
-         *
          * @param ch Character code
          * @return Bitmap view for accessing glyph pixels
+         * @throws std::out_of_range if the font has no glyph for @p ch
          *
          * @see bitmap_view For pixel access methods
          */
-        [[nodiscard]] bitmap_view get_glyph(uint8_t ch) const;
+        [[nodiscard]] bitmap_view get_glyph(char32_t ch) const;
+
+        /**
+         * @brief Get the number of glyphs stored in the font.
+         * @return Number of glyphs
+         */
+        [[nodiscard]] std::size_t get_glyph_count() const;
+
+        /**
+         * @brief Check whether characters are looked up in a sparse index.
+         *
+         * Fonts with a Unicode table (PSF) and wide font_converter output
+         * map Unicode codepoints to glyphs through a codepoint_index.
+         * Other fonts cover the contiguous range first..last in their
+         * native 8-bit encoding.
+         *
+         * @return True if the font uses a codepoint index
+         */
+        [[nodiscard]] bool has_unicode_table() const;
+
+        /**
+         * @brief Find the glyph index for a character.
+         *
+         * Lookup is O(1) for both contiguous and sparse fonts.
+         *
+         * @param ch Character code
+         * @return Glyph index, or nullopt if the font has no such glyph
+         */
+        [[nodiscard]] std::optional<std::size_t> find_glyph(char32_t ch) const;
+
+        /**
+         * @brief Get the bitmap view for a glyph by storage index.
+         * @param index Glyph index (0 to get_glyph_count()-1)
+         * @return Bitmap view for accessing glyph pixels
+         * @throws std::out_of_range if the index is invalid
+         */
+        [[nodiscard]] bitmap_view get_glyph_by_index(std::size_t index) const;
 
     private:
         std::string m_name;              ///< Font display name
-        uint8_t m_first_char{};          ///< First character in font
-        uint8_t m_last_char{};           ///< Last character in font
-        uint8_t m_default_char{};        ///< Fallback character
-        uint8_t m_break_char{};          ///< Word break character
+        char32_t m_first_char{};         ///< First character in font
+        char32_t m_last_char{};          ///< Last character in font
+        char32_t m_default_char{};       ///< Fallback character
+        char32_t m_break_char{};         ///< Word break character
 
         font_metrics m_metrics;          ///< Font-level metrics
-        std::vector<glyph_spacing> m_spacing;  ///< Per-glyph spacing
+        std::vector<glyph_spacing> m_spacing;  ///< Per-glyph spacing, by glyph index
         bitmap_storage m_storage;        ///< Glyph bitmap storage
+        codepoint_index m_index;         ///< Sparse character map (empty: contiguous first..last)
+        std::optional<codepage> m_codepage;  ///< Encoding of 8-bit character codes
+
+        /// Set the character range from m_index
+        void use_index();
     };
 }
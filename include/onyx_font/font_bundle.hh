@@ -0,0 +1,347 @@
+/**
+ * @file font_bundle.hh
+ * @brief Single-file archive of fonts and pre-rendered atlases.
+ *
+ * Shipping dozens of font files and separately generated atlases costs
+ * one open and one parse per file at startup. A font bundle packs them
+ * into one file that is memory-mapped once and read in place:
+ *
+ * @code
+ *   +----------------------+  offset 0
+ *   | header               |  magic "OXFB", version, counts, offsets
+ *   | face table           |  one record per font, sorted by name
+ *   | atlas table          |  one record per atlas, sorted by name
+ *   | string pool          |  UTF-8 names
+ *   +----------------------+
+ *   | payloads             |  each aligned to 64 bytes:
+ *   |   TTF/OTF/TTC bytes  |    served in place to ttf_font
+ *   |   bitmap fonts       |    metrics, spacing, packed glyphs in place
+ *   |   vector fonts       |    metrics and strokes
+ *   |   atlas glyphs       |    baked_glyph[], sorted by codepoint
+ *   |   atlas pixels       |    8-bit alpha, width * height
+ *   +----------------------+
+ * @endcode
+ *
+ * Opening a bundle validates the header and tables only; a lookup is a
+ * binary search over the face table. TrueType data, bitmap glyph pixels
+ * and atlas pixels are never copied. Vector fonts are small and are
+ * decoded into a vector_font.
+ *
+ * The layout uses the native byte order of little-endian machines;
+ * opening a bundle on a big-endian machine throws.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/font_factory.hh>
+#include <onyx_font/text/types.hh>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Glyph of a pre-rendered atlas.
+     *
+     * Mirrors cached_glyph for a single atlas page, so a glyph_cache can
+     * be baked into a bundle and drawn from it without rasterizing.
+     */
+    struct ONYX_FONT_EXPORT baked_glyph {
+        char32_t codepoint = 0;  ///< Unicode codepoint
+        glyph_rect rect;         ///< Position and size within the atlas
+        float bearing_x = 0;     ///< Left side bearing (pen to glyph left edge)
+        float bearing_y = 0;     ///< Top side bearing (baseline to glyph top)
+        float advance_x = 0;     ///< Horizontal advance to next glyph
+    };
+
+    /**
+     * @brief Pre-rendered atlas stored in a bundle.
+     *
+     * All views point into the bundle's memory and stay valid while the
+     * font_bundle (or a copy of it) exists.
+     */
+    struct ONYX_FONT_EXPORT baked_atlas {
+        std::string_view name;              ///< Atlas name
+        std::optional<std::size_t> font;    ///< Face the atlas was rendered from
+        float size = 0;                     ///< Pixel size the atlas was rendered at
+        int width = 0;                      ///< Width in pixels
+        int height = 0;                     ///< Height in pixels
+        std::span<const uint8_t> pixels;    ///< 8-bit alpha, row stride = width
+        std::span<const baked_glyph> glyphs;  ///< Sorted by codepoint
+
+        /**
+         * @brief Look up a glyph.
+         * @param codepoint Unicode codepoint
+         * @return Glyph, or nullptr if the atlas does not contain it
+         */
+        [[nodiscard]] const baked_glyph* find(char32_t codepoint) const noexcept;
+    };
+
+    /**
+     * @brief Builds a font bundle.
+     *
+     * @code{.cpp}
+     * font_bundle_writer writer;
+     *
+     * auto arial = writer.add_ttf(read("ARIAL.TTF"));
+     * writer.add_bitmap(font_factory::load_bitmap(std::filesystem::path("HELVA.FON"), 1));
+     *
+     * // Bake the first page of a warmed-up cache
+     * std::vector<baked_glyph> glyphs;
+     * for (char32_t cp = U' '; cp <= U'~'; ++cp) {
+     *     const auto& g = cache.get(cp);
+     *     glyphs.push_back({cp, g.rect, g.bearing_x, g.bearing_y, g.advance_x});
+     * }
+     * const auto& page = cache.atlas(0);
+     * writer.add_atlas("ui", arial, 16.0f, page.width(), page.height(),
+     *                  {page.data(), static_cast<std::size_t>(page.stride() * page.height())},
+     *                  page.stride(), std::move(glyphs));
+     *
+     * writer.save("assets/fonts.oxfb");
+     * @endcode
+     */
+    class ONYX_FONT_EXPORT font_bundle_writer {
+    public:
+        /// Writer-local handle returned by the add functions
+        using font_handle = std::size_t;
+
+        /**
+         * @brief Add a TrueType/OpenType face.
+         *
+         * The name, weight and slant are read from the font. Faces of one
+         * collection (TTC) share a single copy of the data in the bundle.
+         *
+         * @param data TTF, OTF or TTC file contents (copied)
+         * @param index Face index within a collection
+         * @return Handle for add_atlas()
+         * @throws std::runtime_error if the data is not a TrueType font
+         * @throws std::out_of_range if @p index is invalid
+         */
+        font_handle add_ttf(std::span<const uint8_t> data, std::size_t index = 0);
+
+        /**
+         * @brief Add a bitmap font.
+         *
+         * @param font Font to encode
+         * @param entry Name, weight and slant to record (default: the
+         *              font's name, 400, upright)
+         * @return Handle for add_atlas()
+         */
+        font_handle add_bitmap(const bitmap_font& font, const std::optional<font_entry>& entry = std::nullopt);
+
+        /**
+         * @brief Add a vector font.
+         *
+         * @param font Font to encode
+         * @param entry Name, weight and slant to record (default: the
+         *              font's name, 400, upright)
+         * @return Handle for add_atlas()
+         */
+        font_handle add_vector(const vector_font& font, const std::optional<font_entry>& entry = std::nullopt);
+
+        /**
+         * @brief Add a pre-rendered atlas.
+         *
+         * @param name Atlas name
+         * @param font Face the atlas was rendered from, if any
+         * @param size Pixel size the atlas was rendered at
+         * @param width Atlas width in pixels
+         * @param height Atlas height in pixels
+         * @param pixels 8-bit alpha pixels (copied)
+         * @param stride Bytes per row of @p pixels
+         * @param glyphs Glyphs placed in the atlas
+         * @throws std::invalid_argument if the geometry is invalid, a glyph
+         *         lies outside the atlas or a codepoint repeats
+         * @throws std::out_of_range if @p font is not a handle of this writer
+         */
+        void add_atlas(std::string name, std::optional<font_handle> font, float size,
+                       int width, int height, std::span<const uint8_t> pixels, int stride,
+                       std::vector<baked_glyph> glyphs);
+
+        /**
+         * @brief Encode the bundle.
+         * @return File contents
+         */
+        [[nodiscard]] std::vector<uint8_t> serialize() const;
+
+        /**
+         * @brief Write the bundle to a file.
+         * @param path Destination file
+         * @throws std::runtime_error If the file cannot be written
+         */
+        void save(const std::filesystem::path& path) const;
+
+    private:
+        struct pending_font {
+            font_entry entry;
+            uint32_t face_index = 0;
+            std::shared_ptr<const std::vector<uint8_t>> payload;
+        };
+
+        struct pending_atlas {
+            std::string name;
+            std::optional<font_handle> font;
+            float size = 0;
+            int width = 0;
+            int height = 0;
+            std::vector<uint8_t> pixels;
+            std::vector<baked_glyph> glyphs;
+        };
+
+        std::vector<pending_font> m_fonts;
+        std::vector<pending_atlas> m_atlases;
+    };
+
+    /**
+     * @brief Read-only view of a font bundle.
+     *
+     * @code{.cpp}
+     * auto bundle = font_bundle::open("assets/fonts.oxfb");   // one mmap
+     *
+     * if (auto face = bundle.find("Helv", 8)) {
+     *     bitmap_font helv = bundle.load_bitmap(*face);       // glyphs stay in the mapping
+     * }
+     * if (auto ui = bundle.find_atlas("ui")) {
+     *     baked_atlas atlas = bundle.atlas(*ui);
+     *     upload_texture(atlas.pixels.data(), atlas.width, atlas.height);
+     * }
+     * @endcode
+     *
+     * Copies share the mapping. Bitmap fonts loaded from the bundle keep
+     * the mapping alive on their own; ttf_font objects and atlas views
+     * refer to it and must not outlive the bundle.
+     */
+    class ONYX_FONT_EXPORT font_bundle {
+    public:
+        /// Face handle (position in the face table)
+        using face_id = std::size_t;
+
+        /**
+         * @brief Memory-map a bundle file.
+         * @param path Bundle file
+         * @return Bundle reading the mapping
+         * @throws std::runtime_error if the file cannot be read or is not a valid bundle
+         */
+        static font_bundle open(const std::filesystem::path& path);
+
+        /**
+         * @brief Read a bundle held in memory.
+         * @param data Bundle bytes (owned by the bundle)
+         * @throws std::runtime_error if the data is not a valid bundle
+         */
+        explicit font_bundle(std::vector<uint8_t> data);
+
+        /// Number of faces
+        [[nodiscard]] std::size_t size() const noexcept { return m_font_count; }
+
+        /// Number of atlases
+        [[nodiscard]] std::size_t atlas_count() const noexcept { return m_atlas_count; }
+
+        /**
+         * @brief Get the name of a face without copying it.
+         * @param id Face handle
+         * @return Name (valid while the bundle exists)
+         * @throws std::out_of_range if @p id is invalid
+         */
+        [[nodiscard]] std::string_view name(face_id id) const;
+
+        /**
+         * @brief Get the metadata of a face.
+         * @param id Face handle
+         * @return Name, type, size, weight and slant
+         * @throws std::out_of_range if @p id is invalid
+         */
+        [[nodiscard]] font_entry entry(face_id id) const;
+
+        /**
+         * @brief Find a face by name.
+         *
+         * Names are compared case-insensitively. When several faces share
+         * the name, the one whose pixel height is nearest to
+         * @p pixel_height is returned (scalable faces match any height).
+         *
+         * @param name Face name
+         * @param pixel_height Requested size in pixels (0: any)
+         * @return Face, or nullopt if no face has the name
+         */
+        [[nodiscard]] std::optional<face_id> find(std::string_view name, uint16_t pixel_height = 0) const;
+
+        /**
+         * @brief Get the stored bytes of a face.
+         *
+         * For outline faces this is the TrueType file (shared by the faces
+         * of a collection).
+         *
+         * @param id Face handle
+         * @return Bytes inside the bundle
+         * @throws std::out_of_range if @p id is invalid
+         */
+        [[nodiscard]] std::span<const uint8_t> data(face_id id) const;
+
+        /**
+         * @brief Load a bitmap face; glyph pixels stay in the bundle.
+         * @param id Face handle
+         * @return Font sharing ownership of the bundle memory
+         * @throws std::invalid_argument if the face is not a bitmap font
+         * @throws std::runtime_error if the stored font is corrupt
+         */
+        [[nodiscard]] bitmap_font load_bitmap(face_id id) const;
+
+        /**
+         * @brief Load a vector face.
+         * @param id Face handle
+         * @return Decoded font
+         * @throws std::invalid_argument if the face is not a vector font
+         * @throws std::runtime_error if the stored font is corrupt
+         */
+        [[nodiscard]] vector_font load_vector(face_id id) const;
+
+        /**
+         * @brief Load an outline face reading the bundle in place.
+         * @param id Face handle
+         * @return Font referring to the bundle memory
+         * @throws std::invalid_argument if the face is not an outline font
+         */
+        [[nodiscard]] ttf_font load_ttf(face_id id) const;
+
+        /**
+         * @brief Get a pre-rendered atlas.
+         * @param index Atlas index (0 to atlas_count() - 1)
+         * @return Views into the bundle
+         * @throws std::out_of_range if @p index is invalid
+         */
+        [[nodiscard]] baked_atlas atlas(std::size_t index) const;
+
+        /**
+         * @brief Find an atlas by name (case-insensitive).
+         * @param name Atlas name
+         * @return Atlas index, or nullopt
+         */
+        [[nodiscard]] std::optional<std::size_t> find_atlas(std::string_view name) const;
+
+    private:
+        std::shared_ptr<const void> m_owner;
+        std::span<const uint8_t> m_bytes;
+        std::size_t m_font_count = 0;
+        std::size_t m_atlas_count = 0;
+        std::size_t m_fonts_offset = 0;
+        std::size_t m_atlases_offset = 0;
+        std::size_t m_strings_offset = 0;
+
+        explicit font_bundle(std::shared_ptr<const std::vector<uint8_t>> data);
+        font_bundle(std::shared_ptr<const void> owner, std::span<const uint8_t> bytes);
+
+        [[nodiscard]] std::string_view record_name(uint32_t offset, uint32_t length) const;
+        void check_face(face_id id, font_type type) const;
+    };
+} // namespace onyx_font
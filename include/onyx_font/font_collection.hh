@@ -0,0 +1,215 @@
+/**
+ * @file font_collection.hh
+ * @brief Indexed set of font faces with best-match lookup.
+ *
+ * Applications that load many font files need to answer queries such as
+ * "Arial, 700, italic, 13px" quickly. font_collection ingests containers
+ * through font_factory::analyze(), indexes every face it finds and loads
+ * a face only when it is first used.
+ *
+ * @section collection_index Indexing
+ *
+ * Faces are hashed by case-folded name. Each name maps to the faces of
+ * that family sorted by (type, italic, weight, pixel_height), so a query
+ * is one hash lookup plus a few binary searches:
+ *
+ * @code
+ *   "arial" -> [ BITMAP  upright 400 10px ]
+ *              [ BITMAP  upright 400 13px ]
+ *              [ OUTLINE upright 400      ]
+ *              [ OUTLINE upright 700      ]
+ *              [ OUTLINE italic  700      ]
+ * @endcode
+ *
+ * @section collection_match Matching
+ *
+ * Among the faces with the requested name, find() prefers, in order:
+ * 1. The requested slant (italic or upright)
+ * 2. The nearest weight; ties go to the lighter face for weights up to
+ *    500 and to the heavier one above
+ * 3. For bitmap faces, the nearest strike to the requested pixel height,
+ *    the smaller one on ties; scalable faces fit any size
+ * 4. Bitmap over outline over vector faces
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/font_factory.hh>
+#include <onyx_font/text/font_source.hh>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Face request for font_collection::find().
+     */
+    struct ONYX_FONT_EXPORT font_query {
+        std::string name;                              ///< Face name (case-insensitive)
+        uint16_t weight = 400;                         ///< Requested weight (400=normal, 700=bold)
+        bool italic = false;                           ///< Requested slant
+        uint16_t pixel_height = 0;                     ///< Requested size in pixels (0: any)
+        std::optional<font_type> type = std::nullopt; ///< Restrict to one font type
+    };
+
+    /**
+     * @brief Collection of font faces indexed by name and style.
+     *
+     * @code{.cpp}
+     * font_collection fonts;
+     * fonts.add("fonts/ARIAL.TTF");
+     * fonts.add("fonts/HELVA.FON");
+     *
+     * if (auto face = fonts.find({.name = "Helv", .pixel_height = 9})) {
+     *     font_source source = fonts.source(*face);  // loads the 8px strike
+     * }
+     * @endcode
+     *
+     * Loaded faces keep their address until the collection is destroyed,
+     * so font_source objects created from them stay valid as more
+     * containers are added. The collection is not thread-safe.
+     */
+    class ONYX_FONT_EXPORT font_collection {
+    public:
+        /// Face handle (position in add order)
+        using face_id = std::size_t;
+
+        /**
+         * @brief Construct an empty collection.
+         */
+        font_collection();
+
+        /// @cond
+        font_collection(const font_collection&) = delete;
+        font_collection& operator=(const font_collection&) = delete;
+        /// @endcond
+
+        /**
+         * @brief Move constructor.
+         */
+        font_collection(font_collection&&) noexcept;
+
+        /**
+         * @brief Move assignment operator.
+         */
+        font_collection& operator=(font_collection&&) noexcept;
+
+        /**
+         * @brief Destructor.
+         */
+        ~font_collection();
+
+        /**
+         * @brief Index the faces of a font file.
+         *
+         * The file is analyzed now and read again when one of its faces is
+         * first loaded.
+         *
+         * @param path Path to a font container (TTF, TTC, FON, FNT, CHR, PSF)
+         * @return Number of faces added
+         * @throws std::runtime_error if the file cannot be read
+         */
+        std::size_t add(const std::filesystem::path& path);
+
+        /**
+         * @brief Index the faces of a font container in memory.
+         *
+         * @param data Container bytes (owned by the collection)
+         * @return Number of faces added
+         */
+        std::size_t add(std::vector<uint8_t> data);
+
+        /// Number of indexed faces
+        [[nodiscard]] std::size_t size() const noexcept { return m_faces.size(); }
+
+        /**
+         * @brief Get the metadata of a face.
+         * @param id Face handle
+         * @return Entry reported by font_factory::analyze()
+         * @throws std::out_of_range if @p id is invalid
+         */
+        [[nodiscard]] const font_entry& entry(face_id id) const;
+
+        /**
+         * @brief Find the face that best matches a query.
+         *
+         * Runs in O(log n) for n faces with the requested name.
+         *
+         * @param query Name, weight, slant, size and optional type
+         * @return Best face, or nullopt if no face has the name (and type)
+         */
+        [[nodiscard]] std::optional<face_id> find(const font_query& query) const;
+
+        /**
+         * @brief Check whether a face has been loaded.
+         * @param id Face handle
+         * @return True once get_bitmap(), get_vector(), get_ttf() or source() loaded it
+         */
+        [[nodiscard]] bool is_loaded(face_id id) const;
+
+        /**
+         * @brief Get a bitmap face, loading it on first use.
+         * @param id Face handle
+         * @return Loaded font
+         * @throws std::invalid_argument if the face is not a bitmap font
+         */
+        const bitmap_font& get_bitmap(face_id id);
+
+        /**
+         * @brief Get a vector face, loading it on first use.
+         * @param id Face handle
+         * @return Loaded font
+         * @throws std::invalid_argument if the face is not a vector font
+         */
+        const vector_font& get_vector(face_id id);
+
+        /**
+         * @brief Get an outline face, loading it on first use.
+         * @param id Face handle
+         * @return Loaded font
+         * @throws std::invalid_argument if the face is not an outline font
+         */
+        const ttf_font& get_ttf(face_id id);
+
+        /**
+         * @brief Create a font_source for a face, loading it on first use.
+         * @param id Face handle
+         * @return Source referring to the collection's copy of the face
+         */
+        font_source source(face_id id);
+
+    private:
+        struct container_record {
+            std::filesystem::path path;                    ///< Empty for in-memory containers
+            std::shared_ptr<const std::vector<uint8_t>> data;  ///< Read on first load for files
+        };
+
+        struct face_record {
+            font_entry entry;
+            std::size_t container = 0;
+            std::size_t index = 0;        ///< Index among faces of the same type in the container
+            std::unique_ptr<bitmap_font> bitmap;
+            std::unique_ptr<vector_font> vector;
+            std::unique_ptr<ttf_font> ttf;
+        };
+
+        std::vector<container_record> m_containers;
+        std::vector<face_record> m_faces;
+        /// Case-folded name -> faces sorted by (type, italic, weight, pixel_height)
+        std::unordered_map<std::string, std::vector<face_id>> m_families;
+
+        std::size_t index_container(const container_info& info);
+        const face_record& checked(face_id id) const;
+        std::span<const uint8_t> container_data(std::size_t index);
+    };
+} // namespace onyx_font
@@ -88,7 +88,10 @@
 #include <onyx_font/bitmap_font.hh>
 #include <onyx_font/vector_font.hh>
 #include <onyx_font/ttf_font.hh>
+#include <onyx_font/text/supersample.hh>
 #include <cstdint>
+#include <span>
+#include <vector>
 
 namespace onyx_font {
     /**
@@ -141,7 +144,7 @@ namespace onyx_font {
          * @note If greater than the source font's first_char,
          *       this value takes precedence.
          */
-        uint8_t first_char = 0;
+        char32_t first_char = 0;
 
         /**
          * @brief Last character code to include in output.
@@ -150,10 +153,15 @@ namespace onyx_font {
          * Set to 126 (~) for printable ASCII only.
          * Set to 255 to include all characters from the source font.
          *
+         * TTF ranges wider than 256 codepoints (a script or CJK block)
+         * keep only the codepoints the font has, and the result maps them
+         * through a sparse index (bitmap_font::has_unicode_table()).
+         * Vector fonts stop at 255.
+         *
          * @note If less than the source font's last_char,
          *       this value takes precedence.
          */
-        uint8_t last_char = 255;
+        char32_t last_char = 255;
 
         /**
          * @brief Enable antialiasing during rasterization.
@@ -168,6 +176,22 @@ namespace onyx_font {
          * producing hard pixel edges directly.
          */
         bool antialias = true;
+
+        /**
+         * @brief Reference size for multi-size TTF batches.
+         *
+         * When greater than 0, the batch overload of
+         * font_converter::from_ttf() rasterizes each glyph once at this
+         * pixel height and downsamples it to every smaller requested size.
+         * Sizes at or above it are rasterized directly. 0 (default)
+         * rasterizes every size directly.
+         */
+        float supersample_size = 0.0f;
+
+        /**
+         * @brief Filter used when downsampling from supersample_size.
+         */
+        downsample_filter supersample_filter = downsample_filter::area;
     };
 
     /**
@@ -283,5 +307,60 @@ namespace onyx_font {
             float pixel_height,
             const conversion_options& options = {}
         );
+
+        /**
+         * @brief Convert a TTF font using glyphs downsampled from a strike.
+         *
+         * Like from_ttf(), but glyph coverage and metrics come from
+         * @p strike scaled to @p pixel_height instead of a rasterization
+         * at that size. Reuse one strike for many sizes to rasterize each
+         * outline only once.
+         *
+         * @param font Source TTF font (the font @p strike was built from)
+         * @param pixel_height Target height in pixels
+         * @param strike Reference strike (must support @p pixel_height)
+         * @param options Conversion options (threshold, character range)
+         * @return Newly created bitmap font
+         *
+         * @code{.cpp}
+         * reference_strike strike(font_source::from_ttf(ttf), 96.0f);
+         * std::vector<bitmap_font> sizes;
+         * for (int px = 8; px <= 48; ++px) {
+         *     sizes.push_back(font_converter::from_ttf(ttf, float(px), strike));
+         * }
+         * @endcode
+         */
+        static bitmap_font from_ttf(
+            const ttf_font& font,
+            float pixel_height,
+            reference_strike& strike,
+            const conversion_options& options = {}
+        );
+
+        /**
+         * @brief Convert a TTF font at several sizes.
+         *
+         * With options.supersample_size > 0 a single reference_strike is
+         * shared by all sizes below it; otherwise equivalent to calling
+         * from_ttf() for each size.
+         *
+         * @param font Source TTF font
+         * @param pixel_heights Target heights in pixels
+         * @param options Conversion options
+         * @return One bitmap font per requested height, in order
+         */
+        static std::vector<bitmap_font> from_ttf(
+            const ttf_font& font,
+            std::span<const float> pixel_heights,
+            const conversion_options& options = {}
+        );
+
+    private:
+        static bitmap_font convert_ttf(
+            const ttf_font& font,
+            float pixel_height,
+            reference_strike* strike,
+            const conversion_options& options
+        );
     };
 } // namespace onyx_font
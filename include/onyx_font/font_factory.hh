@@ -26,6 +26,7 @@
  * | FON_LX | .fon | OS/2 LX executable |
  * | FNT | .fnt | Raw Windows font resource |
  * | BGI | .chr | Borland Graphics Interface stroke font |
+ * | PSF | .psf, .psfu | PC Screen Font (Linux console, PSF1/PSF2) |
  *
  * @section factory_usage Usage Examples
  *
@@ -74,6 +75,7 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <optional>
 
 #include <onyx_font/export.h>
 #include <onyx_font/bitmap_font.hh>
@@ -153,12 +155,20 @@ namespace onyx_font {
          */
         std::string name = "BIOS";
 
+        /**
+         * @brief Codepage of the character codes.
+         *
+         * BIOS fonts use the PC character set (CP437). Set to nullopt
+         * if the dump is in an unknown encoding.
+         */
+        std::optional<codepage> encoding = codepage::cp437;
+
         /**
          * @brief Create options for standard 8x8 VGA font.
          * @return Options configured for 8x8 VGA font (2048 bytes)
          */
         static raw_font_options vga_8x8() {
-            return {8, 8, 0, 256, true, "VGA 8x8"};
+            return {8, 8, 0, 256, true, "VGA 8x8", codepage::cp437};
         }
 
         /**
@@ -166,7 +176,7 @@ namespace onyx_font {
          * @return Options configured for 8x14 EGA font (3584 bytes)
          */
         static raw_font_options ega_8x14() {
-            return {8, 14, 0, 256, true, "EGA 8x14"};
+            return {8, 14, 0, 256, true, "EGA 8x14", codepage::cp437};
         }
 
         /**
@@ -174,7 +184,7 @@ namespace onyx_font {
          * @return Options configured for 8x16 VGA font (4096 bytes)
          */
         static raw_font_options vga_8x16() {
-            return {8, 16, 0, 256, true, "VGA 8x16"};
+            return {8, 16, 0, 256, true, "VGA 8x16", codepage::cp437};
         }
     };
 
@@ -196,7 +206,9 @@ namespace onyx_font {
         FON_PE,    ///< Windows 32/64-bit PE executable (.fon) - one or more fonts
         FON_LX,    ///< OS/2 LX executable with font resources
 
-        BGI        ///< Borland Graphics Interface (.chr) - vector stroke font
+        BGI,       ///< Borland Graphics Interface (.chr) - vector stroke font
+
+        PSF        ///< PC Screen Font (.psf) - Linux console bitmap font
     };
 
     /**
@@ -329,13 +341,32 @@ namespace onyx_font {
          * Loads a single bitmap font from a container file.
          * Use analyze() first to determine available fonts and their indices.
          *
-         * @param data Raw file data (NE/PE/LX FON or FNT)
+         * PSF glyphs are copied in one block and keep their packed
+         * layout; the Unicode table, if any, is available through
+         * bitmap_font::find_glyph().
+         *
+         * @param data Raw file data (NE/PE/LX FON, FNT or PSF)
          * @param index Font index within container (0-based)
          * @return Loaded bitmap font
          * @throws std::runtime_error if index invalid or font is not bitmap type
          */
         static bitmap_font load_bitmap(std::span<const uint8_t> data, size_t index = 0);
 
+        /**
+         * @brief Load a bitmap font by index from disk.
+         *
+         * PSF fonts are memory-mapped and their glyphs are served from the
+         * mapping without copying or transcoding; the mapping lives as long
+         * as the returned font. Other formats are read and loaded as by the
+         * span overload.
+         *
+         * @param path Path to font file
+         * @param index Font index within container (0-based)
+         * @return Loaded bitmap font
+         * @throws std::runtime_error if the file cannot be read or holds no such bitmap font
+         */
+        static bitmap_font load_bitmap(const std::filesystem::path& path, size_t index = 0);
+
         /**
          * @brief Load a vector font by index.
          *
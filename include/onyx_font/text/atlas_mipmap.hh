@@ -0,0 +1,135 @@
+/**
+ * @file atlas_mipmap.hh
+ * @brief Incremental CPU mip chain generation for atlas pages.
+ *
+ * Minified text sampled with trilinear filtering reads from lower mip
+ * levels of the atlas. atlas_mip_chain builds those levels with a 2x2 box
+ * filter and, when fed from a memory_atlas, regenerates only the blocks
+ * under tiles that changed since the previous update.
+ *
+ * @section mipmap_bleeding Avoiding Bleeding
+ *
+ * Box filtering merges 2^k x 2^k pixel blocks at level k. Glyphs only stay
+ * separated if they never share such a block, which is what
+ * glyph_cache_config::mip_levels guarantees:
+ *
+ * @code{.cpp}
+ * glyph_cache_config config;
+ * config.mip_levels = 3;  // Clean down to 1/8 scale
+ *
+ * glyph_cache<memory_atlas> cache(std::move(source), 32.0f, config);
+ * atlas_mip_chain mips(config.atlas_size, config.atlas_size, config.mip_levels);
+ *
+ * // After caching new glyphs
+ * glyph_rect changed = mips.update(cache.atlas(0));
+ * for (int level = 1; level <= mips.level_count(); ++level) {
+ *     upload_level(level, mips.level_data(level), mips.level_width(level),
+ *                  mips.level_height(level));
+ * }
+ * @endcode
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/text/types.hh>
+#include <onyx_font/text/atlas_surface.hh>
+#include <cstdint>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Box-filtered mip levels for an 8-bit atlas page.
+     *
+     * Level 0 is the source page itself and is not stored. Levels
+     * 1..level_count() halve the dimensions (rounding down, minimum 1)
+     * and are owned by the chain.
+     */
+    class ONYX_FONT_EXPORT atlas_mip_chain {
+    public:
+        /**
+         * @brief Create a zero-filled mip chain.
+         *
+         * @param width Width of the base level in pixels
+         * @param height Height of the base level in pixels
+         * @param levels Number of levels below the base; clamped so the
+         *        smallest level is at least 1x1
+         */
+        atlas_mip_chain(int width, int height, int levels);
+
+        /**
+         * @brief Get number of generated levels (excluding the base).
+         * @return Level count
+         */
+        [[nodiscard]] int level_count() const noexcept {
+            return static_cast<int>(m_levels.size());
+        }
+
+        /**
+         * @brief Get width of a level.
+         *
+         * @param level Level index (0 = base)
+         * @return Width in pixels
+         */
+        [[nodiscard]] int level_width(int level) const noexcept;
+
+        /**
+         * @brief Get height of a level.
+         *
+         * @param level Level index (0 = base)
+         * @return Height in pixels
+         */
+        [[nodiscard]] int level_height(int level) const noexcept;
+
+        /**
+         * @brief Access pixel data of a generated level.
+         *
+         * Rows are tightly packed (stride equals level_width()).
+         *
+         * @param level Level index, 1 to level_count()
+         * @return Pointer to level data
+         * @throws std::out_of_range if level is not a generated level
+         */
+        [[nodiscard]] const uint8_t* level_data(int level) const;
+
+        /**
+         * @brief Regenerate all levels from a base image.
+         *
+         * @param pixels Base level (8-bit, row-major)
+         * @param stride Base row stride in bytes
+         */
+        void rebuild(const uint8_t* pixels, int stride);
+
+        /**
+         * @brief Regenerate the levels covering a base-level region.
+         *
+         * @param pixels Base level (8-bit, row-major)
+         * @param stride Base row stride in bytes
+         * @param region Changed region of the base level
+         */
+        void update_region(const uint8_t* pixels, int stride, glyph_rect region);
+
+        /**
+         * @brief Regenerate levels for tiles changed in an atlas.
+         *
+         * Uses the atlas change tracking, so only tiles written after
+         * the previous call are filtered again. If the atlas is not the
+         * one seen by the previous call (alpha_atlas_base::identity()),
+         * every level is rebuilt.
+         *
+         * @param atlas Base level, e.g. memory_atlas (same dimensions as the chain)
+         * @return Bounding box of processed base-level tiles, empty if none
+         */
+        glyph_rect update(const alpha_atlas_base& atlas);
+
+    private:
+        int m_width;
+        int m_height;
+        std::vector<std::vector<uint8_t>> m_levels;
+        uint64_t m_atlas = 0;     ///< Identity of the atlas seen by the last update(), 0 if none
+        uint64_t m_revision = 0;  ///< Atlas revision seen by the last update()
+    };
+} // namespace onyx_font
@@ -15,10 +15,15 @@
  * @section atlas_concept The Concept
  *
  * An atlas_surface must support:
- * - Construction with (width, height)
  * - width() and height() queries
  * - write_alpha(x, y, w, h, pixels, stride) for writing glyph data
  *
+ * Surfaces constructible from (width, height) also satisfy
+ * sized_atlas_surface and can be created by glyph_cache on its own; other
+ * surfaces are created through a factory passed to the cache. Surfaces
+ * exposing writable memory (direct_atlas_surface) receive glyphs
+ * rasterized in place, without an intermediate buffer.
+ *
  * @section atlas_usage Usage
  *
  * @code{.cpp}
@@ -33,6 +38,37 @@
  * uint8_t pixel = atlas.pixel(15, 15);
  * @endcode
  *
+ * @section atlas_dirty Change Tracking
+ *
+ * memory_atlas keeps a revision counter and records, per 16x16 tile, the
+ * revision of its last modification. Consumers that post-process the atlas
+ * (GPU upload, BC4 compression, mip generation) remember the revision they
+ * last saw and only revisit tiles changed since then:
+ *
+ * @code{.cpp}
+ * uint64_t seen = 0;
+ * // ... glyphs get written ...
+ * atlas.for_each_dirty_tile(seen, [&](glyph_rect tile) {
+ *     upload_region(tile);
+ * });
+ * seen = atlas.revision();
+ * @endcode
+ *
+ * Revisions only compare within one atlas: a replaced page (for example
+ * after glyph_cache::clear()) starts again at revision 0. Consumers also
+ * remember identity() and rebuild everything when it changes.
+ *
+ * @section atlas_memory Caller-Provided Memory
+ *
+ * basic_memory_atlas takes an allocator for its pixel storage, and
+ * external_memory_atlas writes into memory the caller already owns, such
+ * as a persistently mapped staging buffer:
+ *
+ * @code{.cpp}
+ * uint8_t* mapped = map_staging_buffer(1024 * 512);
+ * external_memory_atlas atlas(mapped, 512, 512, 1024);  // stride 1024
+ * @endcode
+ *
  * @section atlas_custom Custom Implementation
  *
  * For GPU rendering, implement an atlas that uploads to texture:
@@ -60,8 +96,13 @@
 #pragma once
 
 #include <onyx_font/export.h>
+#include <onyx_font/text/types.hh>
+#include <algorithm>
 #include <concepts>
 #include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 #include <cstring>
 
@@ -70,14 +111,13 @@ namespace onyx_font {
      * @brief Concept for atlas surface types.
      *
      * Atlas surfaces store rasterized glyphs for efficient rendering.
-     * They must support construction with dimensions and writing of
-     * alpha data to rectangular regions.
+     * They must report their dimensions and support writing of alpha
+     * data to rectangular regions.
      *
      * @tparam T Type to check against the concept
      *
      * @section atlas_concept_requirements Requirements
      *
-     * - `T(int, int)` - Constructible with width and height
      * - `surface.width()` - Returns width as convertible to int
      * - `surface.height()` - Returns height as convertible to int
      * - `surface.write_alpha(x, y, w, h, pixels, stride)` - Writes alpha data
@@ -86,48 +126,72 @@ namespace onyx_font {
     concept atlas_surface = requires(T& surface, int x, int y, int w, int h,
                                      const uint8_t* pixels, int stride)
     {
-        { T(int{}, int{}) };
         { surface.width() } -> std::convertible_to<int>;
         { surface.height() } -> std::convertible_to<int>;
         { surface.write_alpha(x, y, w, h, pixels, stride) } -> std::same_as<void>;
     };
 
     /**
-     * @brief Simple in-memory atlas surface.
+     * @brief Atlas surface that can be constructed from its dimensions.
      *
-     * Stores glyphs in a CPU-side buffer. Suitable for testing,
-     * software rendering, or as a staging area before GPU upload.
+     * glyph_cache creates such surfaces itself; other surfaces need a
+     * surface factory.
      *
-     * @section memory_atlas_usage Usage
+     * @tparam T Type to check against the concept
+     */
+    template<typename T>
+    concept sized_atlas_surface = atlas_surface<T> && std::constructible_from<T, int, int>;
+
+    /**
+     * @brief Atlas surface exposing writable pixel memory.
      *
-     * @code{.cpp}
-     * // Create 512x512 atlas
-     * memory_atlas atlas(512, 512);
+     * glyph_cache rasterizes glyphs straight into such surfaces instead of
+     * going through a temporary buffer and write_alpha().
      *
-     * // Write a glyph
-     * atlas.write_alpha(0, 0, glyph.width, glyph.height,
-     *                   glyph.data, glyph.stride);
+     * @tparam T Type to check against the concept
      *
-     * // Access data for GPU upload
-     * glTexImage2D(GL_TEXTURE_2D, 0, GL_R8,
-     *              atlas.width(), atlas.height(), 0,
-     *              GL_RED, GL_UNSIGNED_BYTE, atlas.data());
-     * @endcode
+     * @section direct_atlas_requirements Requirements
+     *
+     * - `surface.data()` - Returns `uint8_t*` to the top-left pixel
+     * - `surface.stride()` - Returns the row stride in bytes
+     * - `surface.invalidate(x, y, w, h)` - Records an in-place modification
+     */
+    template<typename T>
+    concept direct_atlas_surface = atlas_surface<T> &&
+        requires(T& surface, int x, int y, int w, int h)
+    {
+        { surface.data() } -> std::same_as<uint8_t*>;
+        { surface.stride() } -> std::convertible_to<int>;
+        { surface.invalidate(x, y, w, h) } -> std::same_as<void>;
+    };
+
+    /**
+     * @brief Atlas surface whose pixels can be read back.
+     *
+     * glyph_cache copies glyphs out of such surfaces into a glyph_store
+     * before dropping its pages.
+     *
+     * @tparam T Type to check against the concept
+     */
+    template<typename T>
+    concept readable_atlas_surface = atlas_surface<T> &&
+        requires(const T& surface, int x, int y)
+    {
+        { surface.pixel(x, y) } -> std::convertible_to<uint8_t>;
+    };
+
+    /**
+     * @brief 8-bit alpha surface over a pixel pointer, with change tracking.
+     *
+     * Common base of basic_memory_atlas and external_memory_atlas. It does
+     * not own the pixels; derived classes supply them through attach().
+     * Consumers that only read pixels and dirty tiles (bc4_image,
+     * atlas_mip_chain) accept any atlas through this base.
      */
-    class memory_atlas {
+    class alpha_atlas_base {
     public:
-        /**
-         * @brief Construct atlas with given dimensions.
-         *
-         * @param width Atlas width in pixels
-         * @param height Atlas height in pixels
-         * @pre width >= 0 && height >= 0
-         */
-        memory_atlas(int width, int height)
-            : m_width(width)
-              , m_height(height)
-              , m_data(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), 0) {
-        }
+        /// Edge length of the square tiles used for change tracking
+        static constexpr int dirty_tile_size = 16;
 
         /**
          * @brief Get atlas width.
@@ -141,6 +205,12 @@ namespace onyx_font {
          */
         [[nodiscard]] int height() const noexcept { return m_height; }
 
+        /**
+         * @brief Get row stride.
+         * @return Distance between rows in bytes (>= width())
+         */
+        [[nodiscard]] int stride() const noexcept { return m_stride; }
+
         /**
          * @brief Write alpha data to a region of the atlas.
          *
@@ -158,6 +228,8 @@ namespace onyx_font {
                          const uint8_t* pixels, int stride) {
             if (!pixels || w <= 0 || h <= 0) return;
 
+            mark_dirty(x, y, w, h);
+
             for (int row = 0; row < h; ++row) {
                 int dst_y = y + row;
                 if (dst_y < 0 || dst_y >= m_height) continue;
@@ -177,10 +249,10 @@ namespace onyx_font {
 
                 if (copy_start < copy_end) {
                     std::size_t dst_offset = static_cast<std::size_t>(dst_y) *
-                                             static_cast<std::size_t>(m_width) +
+                                             static_cast<std::size_t>(m_stride) +
                                              static_cast<std::size_t>(x + copy_start);
                     std::memcpy(
-                        m_data.data() + dst_offset,
+                        m_data + dst_offset,
                         pixels + src_offset + copy_start,
                         static_cast<std::size_t>(copy_end - copy_start)
                     );
@@ -190,15 +262,19 @@ namespace onyx_font {
 
         /**
          * @brief Access pixel data (read-only).
-         * @return Pointer to atlas data (row-major, 8-bit alpha)
+         * @return Pointer to atlas data (row-major, 8-bit alpha, stride() bytes per row)
          */
-        [[nodiscard]] const uint8_t* data() const noexcept { return m_data.data(); }
+        [[nodiscard]] const uint8_t* data() const noexcept { return m_data; }
 
         /**
          * @brief Access pixel data (read-write).
+         *
+         * Call invalidate() for regions modified through this pointer so
+         * that change tracking sees them.
+         *
          * @return Pointer to atlas data
          */
-        [[nodiscard]] uint8_t* data() noexcept { return m_data.data(); }
+        [[nodiscard]] uint8_t* data() noexcept { return m_data; }
 
         /**
          * @brief Get pixel at position.
@@ -209,7 +285,7 @@ namespace onyx_font {
          */
         [[nodiscard]] uint8_t pixel(int x, int y) const noexcept {
             if (x >= 0 && x < m_width && y >= 0 && y < m_height) {
-                return m_data[static_cast<std::size_t>(y) * static_cast<std::size_t>(m_width) +
+                return m_data[static_cast<std::size_t>(y) * static_cast<std::size_t>(m_stride) +
                               static_cast<std::size_t>(x)];
             }
             return 0;
@@ -217,17 +293,327 @@ namespace onyx_font {
 
         /**
          * @brief Clear the atlas to zero.
+         *
+         * Bytes between width() and stride() are left untouched.
          */
         void clear() noexcept {
-            std::fill(m_data.begin(), m_data.end(), static_cast<uint8_t>(0));
+            if (!m_data) return;
+            for (int y = 0; y < m_height; ++y) {
+                std::memset(m_data + static_cast<std::size_t>(y) * static_cast<std::size_t>(m_stride),
+                            0, static_cast<std::size_t>(m_width));
+            }
+            mark_dirty(0, 0, m_width, m_height);
+        }
+
+        /**
+         * @brief Record a modification made through data().
+         *
+         * @param x Left edge of the modified region
+         * @param y Top edge of the modified region
+         * @param w Region width
+         * @param h Region height
+         */
+        void invalidate(int x, int y, int w, int h) noexcept {
+            mark_dirty(x, y, w, h);
+        }
+
+        /**
+         * @brief Get the modification revision.
+         *
+         * Incremented by every write_alpha(), clear() and invalidate().
+         * A freshly constructed atlas has revision 0.
+         *
+         * @return Current revision
+         */
+        [[nodiscard]] uint64_t revision() const noexcept { return m_revision; }
+
+        /**
+         * @brief Identify this atlas for change tracking.
+         *
+         * Unique to each constructed atlas and never 0. A copy gets a new
+         * identity; a move hands its identity to the target. Revisions of
+         * atlases with different identities are unrelated.
+         *
+         * @return Identity of the atlas
+         */
+        [[nodiscard]] uint64_t identity() const noexcept { return m_identity; }
+
+        /**
+         * @brief Visit tiles modified after a given revision.
+         *
+         * Calls @p fn with the rectangle of every tile whose last
+         * modification is newer than @p since. Tiles are
+         * dirty_tile_size pixels square, clipped to the atlas bounds,
+         * and visited in row-major order.
+         *
+         * @tparam Fn Callable as `void(glyph_rect)`
+         * @param since Revision previously obtained from revision()
+         * @param fn Callback receiving each dirty tile
+         */
+        template<typename Fn>
+        void for_each_dirty_tile(uint64_t since, Fn&& fn) const {
+            if (since >= m_revision) return;
+
+            for (int ty = 0; ty < m_tiles_y; ++ty) {
+                for (int tx = 0; tx < m_tiles_x; ++tx) {
+                    std::size_t idx = static_cast<std::size_t>(ty) * static_cast<std::size_t>(m_tiles_x) +
+                                      static_cast<std::size_t>(tx);
+                    if (m_tile_revision[idx] > since) {
+                        int x = tx * dirty_tile_size;
+                        int y = ty * dirty_tile_size;
+                        fn(glyph_rect{x, y,
+                                      std::min(dirty_tile_size, m_width - x),
+                                      std::min(dirty_tile_size, m_height - y)});
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Bounding box of all tiles modified after a revision.
+         *
+         * @param since Revision previously obtained from revision()
+         * @return Union of dirty tiles, or an empty rect if nothing changed
+         */
+        [[nodiscard]] glyph_rect dirty_bounds(uint64_t since) const {
+            int x0 = m_width, y0 = m_height, x1 = 0, y1 = 0;
+            for_each_dirty_tile(since, [&](glyph_rect tile) {
+                x0 = std::min(x0, tile.x);
+                y0 = std::min(y0, tile.y);
+                x1 = std::max(x1, tile.x + tile.w);
+                y1 = std::max(y1, tile.y + tile.h);
+            });
+            if (x1 <= x0 || y1 <= y0) return {};
+            return {x0, y0, x1 - x0, y1 - y0};
+        }
+
+    protected:
+        /**
+         * @brief Set up change tracking for an atlas of given dimensions.
+         *
+         * @param width Atlas width in pixels
+         * @param height Atlas height in pixels
+         * @pre width >= 0 && height >= 0
+         */
+        alpha_atlas_base(int width, int height)
+            : m_width(width)
+              , m_height(height)
+              , m_stride(width)
+              , m_tiles_x((width + dirty_tile_size - 1) / dirty_tile_size)
+              , m_tiles_y((height + dirty_tile_size - 1) / dirty_tile_size)
+              , m_tile_revision(static_cast<std::size_t>(m_tiles_x) * static_cast<std::size_t>(m_tiles_y), 0)
+              , m_identity(next_identity()) {
+        }
+
+        alpha_atlas_base(const alpha_atlas_base& other)
+            : m_width(other.m_width)
+              , m_height(other.m_height)
+              , m_stride(other.m_stride)
+              , m_tiles_x(other.m_tiles_x)
+              , m_tiles_y(other.m_tiles_y)
+              , m_data(other.m_data)
+              , m_tile_revision(other.m_tile_revision)
+              , m_revision(other.m_revision)
+              , m_identity(next_identity()) {
+        }
+
+        alpha_atlas_base(alpha_atlas_base&&) noexcept = default;
+
+        alpha_atlas_base& operator=(const alpha_atlas_base& other) {
+            if (this != &other) {
+                alpha_atlas_base copy(other);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        alpha_atlas_base& operator=(alpha_atlas_base&&) noexcept = default;
+        ~alpha_atlas_base() = default;
+
+        /// Point the surface at its pixels (called by derived classes)
+        void attach(uint8_t* data, int stride) noexcept {
+            m_data = data;
+            m_stride = stride;
         }
 
     private:
         int m_width;
         int m_height;
-        std::vector<uint8_t> m_data;
+        int m_stride;
+        int m_tiles_x;
+        int m_tiles_y;
+        uint8_t* m_data = nullptr;
+        std::vector<uint64_t> m_tile_revision;  ///< Last revision touching each tile
+        uint64_t m_revision = 0;
+        uint64_t m_identity;
+
+        /// Draw a process-wide unique, non-zero identity
+        [[nodiscard]] ONYX_FONT_EXPORT static uint64_t next_identity() noexcept;
+
+        /// Stamp all tiles overlapping the region with a new revision
+        void mark_dirty(int x, int y, int w, int h) noexcept {
+            int x0 = std::max(x, 0);
+            int y0 = std::max(y, 0);
+            int x1 = std::min(x + w, m_width);
+            int y1 = std::min(y + h, m_height);
+            if (x1 <= x0 || y1 <= y0) return;
+
+            ++m_revision;
+            for (int ty = y0 / dirty_tile_size; ty <= (y1 - 1) / dirty_tile_size; ++ty) {
+                for (int tx = x0 / dirty_tile_size; tx <= (x1 - 1) / dirty_tile_size; ++tx) {
+                    m_tile_revision[static_cast<std::size_t>(ty) * static_cast<std::size_t>(m_tiles_x) +
+                                    static_cast<std::size_t>(tx)] = m_revision;
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief In-memory atlas surface owning its pixels.
+     *
+     * Stores glyphs in a CPU-side buffer obtained from @p Allocator.
+     * Suitable for testing, software rendering, or as a staging area
+     * before GPU upload. Use memory_atlas for the default allocator.
+     *
+     * @tparam Allocator Allocator for the pixel buffer (value type uint8_t)
+     *
+     * @section memory_atlas_usage Usage
+     *
+     * @code{.cpp}
+     * // Create 512x512 atlas
+     * memory_atlas atlas(512, 512);
+     *
+     * // Write a glyph
+     * atlas.write_alpha(0, 0, glyph.width, glyph.height,
+     *                   glyph.data, glyph.stride);
+     *
+     * // Access data for GPU upload
+     * glTexImage2D(GL_TEXTURE_2D, 0, GL_R8,
+     *              atlas.width(), atlas.height(), 0,
+     *              GL_RED, GL_UNSIGNED_BYTE, atlas.data());
+     *
+     * // Pixels from a pool
+     * basic_memory_atlas<pool_allocator<uint8_t>> pooled(512, 512, pool.allocator());
+     * @endcode
+     */
+    template<typename Allocator = std::allocator<uint8_t>>
+    class basic_memory_atlas : public alpha_atlas_base {
+    public:
+        using allocator_type = Allocator;
+
+        /**
+         * @brief Construct atlas with given dimensions.
+         *
+         * @param width Atlas width in pixels
+         * @param height Atlas height in pixels
+         * @param alloc Allocator for the pixel buffer
+         * @pre width >= 0 && height >= 0
+         */
+        basic_memory_atlas(int width, int height, const Allocator& alloc = Allocator())
+            : alpha_atlas_base(width, height)
+              , m_storage(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), 0, alloc) {
+            attach(m_storage.data(), width);
+        }
+
+        basic_memory_atlas(const basic_memory_atlas& other)
+            : alpha_atlas_base(other)
+              , m_storage(other.m_storage) {
+            attach(m_storage.data(), width());
+        }
+
+        basic_memory_atlas(basic_memory_atlas&& other) noexcept
+            : alpha_atlas_base(std::move(other))
+              , m_storage(std::move(other.m_storage)) {
+            attach(m_storage.data(), width());
+            other.attach(nullptr, other.width());
+        }
+
+        basic_memory_atlas& operator=(const basic_memory_atlas& other) {
+            if (this != &other) {
+                alpha_atlas_base::operator=(other);
+                m_storage = other.m_storage;
+                attach(m_storage.data(), width());
+            }
+            return *this;
+        }
+
+        basic_memory_atlas& operator=(basic_memory_atlas&& other) noexcept(
+            std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+            std::allocator_traits<Allocator>::is_always_equal::value) {
+            if (this != &other) {
+                alpha_atlas_base::operator=(std::move(other));
+                m_storage = std::move(other.m_storage);
+                attach(m_storage.data(), width());
+                other.attach(nullptr, other.width());
+            }
+            return *this;
+        }
+
+        ~basic_memory_atlas() = default;
+
+        /**
+         * @brief Get the pixel buffer allocator.
+         * @return Copy of the allocator
+         */
+        [[nodiscard]] allocator_type get_allocator() const {
+            return m_storage.get_allocator();
+        }
+
+    private:
+        std::vector<uint8_t, Allocator> m_storage;
+    };
+
+    /// In-memory atlas surface using the default allocator
+    using memory_atlas = basic_memory_atlas<>;
+
+    /**
+     * @brief Atlas surface over memory owned by the caller.
+     *
+     * Glyphs are written straight into the supplied buffer, e.g. a
+     * persistently mapped GPU staging buffer, a pooled allocation or a
+     * mapped snapshot file. The buffer must outlive the surface.
+     *
+     * The contents are not cleared on construction: glyph_cache only
+     * writes glyph rectangles, so pass zeroed memory (or call clear()) if
+     * the padding between glyphs must be transparent. Copies of the
+     * surface alias the same memory.
+     *
+     * @code{.cpp}
+     * std::vector<uint8_t> pixels(256 * 256);
+     * external_memory_atlas atlas(pixels.data(), 256, 256);
+     * atlas.write_alpha(0, 0, w, h, glyph, w);  // lands in pixels
+     * @endcode
+     */
+    class external_memory_atlas : public alpha_atlas_base {
+    public:
+        /**
+         * @brief Wrap caller-provided pixels.
+         *
+         * @param pixels Top-left pixel of the buffer
+         * @param width Atlas width in pixels
+         * @param height Atlas height in pixels
+         * @param stride Row stride in bytes (0 = width)
+         * @throws std::invalid_argument if pixels is null for a non-empty
+         *         atlas, or stride is smaller than width
+         */
+        external_memory_atlas(uint8_t* pixels, int width, int height, int stride = 0)
+            : alpha_atlas_base(width, height) {
+            if (stride == 0) {
+                stride = width;
+            }
+            if (stride < width) {
+                throw std::invalid_argument("atlas stride smaller than width");
+            }
+            if (!pixels && width > 0 && height > 0) {
+                throw std::invalid_argument("atlas memory is null");
+            }
+            attach(pixels, stride);
+        }
     };
 
-    // Verify memory_atlas satisfies atlas_surface concept
-    static_assert(atlas_surface<memory_atlas>);
+    // Verify the memory surfaces satisfy the atlas concepts
+    static_assert(sized_atlas_surface<memory_atlas>);
+    static_assert(direct_atlas_surface<memory_atlas>);
+    static_assert(direct_atlas_surface<external_memory_atlas>);
+    static_assert(readable_atlas_surface<memory_atlas>);
 } // namespace onyx_font
@@ -0,0 +1,241 @@
+/**
+ * @file cell_grid.hh
+ * @brief Character-cell renderer for terminal and console emulators.
+ *
+ * A terminal screen is a grid of fixed-size cells, each holding one
+ * character with its own colors. Drawing it with per-string
+ * text_renderer::draw() calls lays out and blends every glyph every
+ * frame. cell_grid instead keeps the cell buffer and a shadow copy of
+ * what was last drawn, and redraws only the cells that differ. Each cell
+ * is drawn with a fixed-size blit of a pre-rendered glyph mask that
+ * writes foreground and background in one pass, so no clearing or
+ * blending with the old pixels is needed.
+ *
+ * @section cell_grid_usage Usage
+ *
+ * @code{.cpp}
+ * auto font = font_factory::load_bitmap(vga_fon, 0);
+ * auto source = font_source::from_bitmap(font);
+ * cell_grid grid(source, 16.0f, 80, 25);
+ *
+ * std::vector<uint32_t> pixels(grid.pixel_width() * grid.pixel_height());
+ * cell_target target{pixels.data(), grid.pixel_width(), grid.pixel_height(), grid.pixel_width()};
+ *
+ * grid.write(0, 0, "C:\\>", 0xFFAAAAAA, 0xFF000000);
+ * grid.render(target);            // draws every cell once
+ * grid.render(target);            // nothing changed: compares and returns 0
+ *
+ * grid.scroll(1);                 // new line at the bottom
+ * grid.render(target);            // moves pixel rows, draws one row
+ * @endcode
+ *
+ * @section cell_grid_pitch Fixed Pitch
+ *
+ * The font must be fixed-pitch: every printable ASCII glyph it has must
+ * advance by the same width, which becomes the cell width. The cell
+ * height is the line height. Glyph pixels outside the cell are clipped.
+ *
+ * Colors are 32-bit ARGB, as for rgba_blend_target.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/text/font_source.hh>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Cell attribute flags (combine with |).
+     */
+    namespace cell_attr {
+        inline constexpr uint8_t none = 0;
+        inline constexpr uint8_t bold = 1 << 0;       ///< Glyph smeared one pixel to the right
+        inline constexpr uint8_t underline = 1 << 1;  ///< Line below the baseline
+        inline constexpr uint8_t inverse = 1 << 2;    ///< Foreground and background swapped
+        inline constexpr uint8_t hidden = 1 << 3;     ///< Background only
+    } // namespace cell_attr
+
+    /**
+     * @brief One character cell.
+     */
+    struct terminal_cell {
+        char32_t codepoint = U' ';
+        uint32_t fg = 0xFFFFFFFF;  ///< Foreground color (ARGB)
+        uint32_t bg = 0xFF000000;  ///< Background color (ARGB)
+        uint8_t attrs = cell_attr::none;
+
+        bool operator==(const terminal_cell&) const = default;
+    };
+
+    /**
+     * @brief 32-bit ARGB pixel buffer a cell_grid draws into.
+     */
+    struct cell_target {
+        uint32_t* pixels = nullptr;
+        int width = 0;    ///< Width in pixels
+        int height = 0;   ///< Height in pixels
+        int stride = 0;   ///< Distance between rows in pixels
+    };
+
+    /**
+     * @brief Shadow-buffered character grid for fixed-pitch fonts.
+     *
+     * Holds a pointer to its font_source, which must outlive the grid.
+     * Not thread-safe.
+     */
+    class ONYX_FONT_EXPORT cell_grid {
+    public:
+        /**
+         * @brief Create a grid of blank cells.
+         *
+         * @param source Fixed-pitch font (must outlive the grid)
+         * @param size Pixel height (ignored by bitmap fonts)
+         * @param columns Number of columns
+         * @param rows Number of rows
+         * @throws std::invalid_argument if the font is not fixed-pitch or
+         *         the grid size is negative
+         */
+        cell_grid(const font_source& source, float size, int columns, int rows);
+
+        /**
+         * @brief Change the number of columns and rows.
+         *
+         * Cells inside both sizes are kept. Everything is redrawn.
+         *
+         * @param columns Number of columns
+         * @param rows Number of rows
+         * @throws std::invalid_argument if the size is negative
+         */
+        void resize(int columns, int rows);
+
+        [[nodiscard]] int columns() const noexcept { return m_columns; }
+        [[nodiscard]] int rows() const noexcept { return m_rows; }
+        [[nodiscard]] int cell_width() const noexcept { return m_cell_w; }
+        [[nodiscard]] int cell_height() const noexcept { return m_cell_h; }
+
+        /// Width of the whole grid in pixels
+        [[nodiscard]] int pixel_width() const noexcept { return m_columns * m_cell_w; }
+
+        /// Height of the whole grid in pixels
+        [[nodiscard]] int pixel_height() const noexcept { return m_rows * m_cell_h; }
+
+        /**
+         * @brief Get the cell buffer, row by row.
+         *
+         * Cells may be modified freely; render() finds the changes.
+         *
+         * @return All cells
+         */
+        [[nodiscard]] std::span<terminal_cell> cells() noexcept { return m_cells; }
+
+        /// @copydoc cells()
+        [[nodiscard]] std::span<const terminal_cell> cells() const noexcept { return m_cells; }
+
+        /**
+         * @brief Get one cell.
+         * @param column Column (must be < columns())
+         * @param row Row (must be < rows())
+         * @return Cell
+         */
+        [[nodiscard]] terminal_cell& at(int column, int row) noexcept {
+            return m_cells[index(column, row)];
+        }
+
+        /// @copydoc at()
+        [[nodiscard]] const terminal_cell& at(int column, int row) const noexcept {
+            return m_cells[index(column, row)];
+        }
+
+        /**
+         * @brief Write UTF-8 text into consecutive cells of a row.
+         *
+         * Text past the end of the row is dropped.
+         *
+         * @param column First column
+         * @param row Row
+         * @param text UTF-8 text (one cell per codepoint)
+         * @param fg Foreground color (ARGB)
+         * @param bg Background color (ARGB)
+         * @param attrs cell_attr flags
+         * @return Number of cells written
+         */
+        int write(int column, int row, std::string_view text,
+                  uint32_t fg, uint32_t bg, uint8_t attrs = cell_attr::none);
+
+        /**
+         * @brief Fill every cell.
+         * @param value Cell to copy everywhere
+         */
+        void fill(const terminal_cell& value);
+
+        /**
+         * @brief Scroll the cell buffer.
+         *
+         * The next render() moves the pixel rows of the target the same way
+         * (memmove) instead of redrawing the moved cells.
+         *
+         * @param lines Rows to scroll; positive moves content up
+         * @param blank Cell for the rows scrolled in
+         */
+        void scroll(int lines, const terminal_cell& blank = {});
+
+        /**
+         * @brief Redraw every cell on the next render().
+         *
+         * Needed when the target's pixels changed outside the grid.
+         */
+        void invalidate() noexcept { m_shadow_valid = false; }
+
+        /**
+         * @brief Draw the cells changed since the last render().
+         *
+         * The grid covers the top-left pixel_width() x pixel_height() of
+         * the target.
+         *
+         * @param target ARGB pixel buffer
+         * @return Number of cells drawn
+         * @throws std::invalid_argument if the target is smaller than the grid
+         */
+        std::size_t render(const cell_target& target);
+
+    private:
+        /// Pre-rendered coverage of one glyph over a whole cell
+        struct glyph_mask {
+            std::vector<uint8_t> normal;
+            std::vector<uint8_t> bold;  ///< Built on first use
+            bool blank = true;          ///< No covered pixel
+        };
+
+        const font_source* m_source;
+        float m_size;
+        int m_cell_w = 0;
+        int m_cell_h = 0;
+        int m_baseline = 0;
+        int m_underline = 0;  ///< Row of the underline within a cell
+        int m_columns = 0;
+        int m_rows = 0;
+        std::vector<terminal_cell> m_cells;
+        std::vector<terminal_cell> m_shadow;  ///< Cells as last drawn
+        bool m_shadow_valid = false;
+        int m_pending_scroll = 0;             ///< Rows the target must move at the next render()
+        std::unordered_map<char32_t, glyph_mask> m_masks;
+
+        [[nodiscard]] std::size_t index(int column, int row) const noexcept {
+            return static_cast<std::size_t>(row) * static_cast<std::size_t>(m_columns) +
+                   static_cast<std::size_t>(column);
+        }
+
+        glyph_mask& mask(char32_t codepoint);
+        void scroll_target(const cell_target& target, int lines);
+        void draw_cell(const cell_target& target, int column, int row, const terminal_cell& cell);
+    };
+} // namespace onyx_font
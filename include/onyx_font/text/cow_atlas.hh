@@ -0,0 +1,309 @@
+/**
+ * @file cow_atlas.hh
+ * @brief Tiled copy-on-write atlas surface with immutable snapshots.
+ *
+ * When one thread adds glyphs to a glyph_cache while another uploads the
+ * atlas, the upload normally has to hold the cache's lock from start to
+ * finish. cow_atlas stores its pixels as reference-counted tiles instead:
+ * snapshot() copies only the tile pointers, and a later write to a tile
+ * still referenced by a snapshot copies that tile first. The reader works
+ * on the snapshot without any lock, and the writer pays one tile copy per
+ * tile it modifies while snapshots are alive.
+ *
+ * @section cow_atlas_usage Usage
+ *
+ * @code{.cpp}
+ * // Layout thread (under the lock guarding the cache)
+ * cache.get(cp);
+ * auto snapshot = cache.snapshot();              // pointer copies only
+ *
+ * // Render thread, lock released
+ * const atlas_snapshot& page = snapshot.atlas(0);
+ * page.for_each_dirty_tile(uploaded_revision, [&](glyph_rect tile) {
+ *     page.copy_region(tile, staging, tile.w);
+ *     upload(tile, staging);
+ * });
+ * uploaded_revision = page.revision();
+ * // Dropping the snapshot never blocks the writer
+ * @endcode
+ *
+ * Never-written tiles are not allocated and read as zero.
+ *
+ * @section cow_atlas_threads Threading
+ *
+ * A cow_atlas itself is not thread-safe: snapshot() must not run
+ * concurrently with writes. A snapshot, once taken, is immutable and may
+ * be read and destroyed on any thread while the atlas keeps changing.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/text/types.hh>
+#include <onyx_font/text/atlas_surface.hh>
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace onyx_font {
+    namespace internal {
+        /**
+         * @brief Check that a writer holds the only reference to shared data.
+         *
+         * The acquire fence pairs with the release of the last other
+         * owner, so the caller may modify the data in place.
+         */
+        template<typename T>
+        [[nodiscard]] bool exclusively_owned(const std::shared_ptr<T>& p) noexcept {
+            if (p.use_count() != 1) {
+                return false;
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return true;
+        }
+    }
+
+    /**
+     * @brief Immutable view of a cow_atlas at one revision.
+     *
+     * Cheap to copy (tile pointers are shared). A default-constructed
+     * snapshot is empty.
+     */
+    class ONYX_FONT_EXPORT atlas_snapshot {
+    public:
+        atlas_snapshot() = default;
+
+        /**
+         * @brief Get atlas width.
+         * @return Width in pixels
+         */
+        [[nodiscard]] int width() const noexcept { return m_width; }
+
+        /**
+         * @brief Get atlas height.
+         * @return Height in pixels
+         */
+        [[nodiscard]] int height() const noexcept { return m_height; }
+
+        /**
+         * @brief Get the tile edge length.
+         * @return Tile size in pixels
+         */
+        [[nodiscard]] int tile_size() const noexcept { return m_tile_size; }
+
+        /**
+         * @brief Get the atlas revision the snapshot was taken at.
+         * @return Revision
+         */
+        [[nodiscard]] uint64_t revision() const noexcept { return m_revision; }
+
+        /**
+         * @brief Get pixel at position.
+         *
+         * @param x X coordinate
+         * @param y Y coordinate
+         * @return Pixel value, or 0 if out of bounds
+         */
+        [[nodiscard]] uint8_t pixel(int x, int y) const noexcept;
+
+        /**
+         * @brief Get the pixels of a tile.
+         *
+         * @param tx Tile column
+         * @param ty Tile row
+         * @return tile_size() x tile_size() pixels (row stride tile_size()),
+         *         or nullptr for a tile that was never written (all zero)
+         */
+        [[nodiscard]] const uint8_t* tile(int tx, int ty) const noexcept;
+
+        /**
+         * @brief Copy a region into a contiguous buffer.
+         *
+         * Parts of the region outside the atlas are written as 0.
+         *
+         * @param region Region to copy
+         * @param dst Destination (region.w x region.h)
+         * @param dst_stride Destination row stride in bytes
+         */
+        void copy_region(glyph_rect region, uint8_t* dst, int dst_stride) const noexcept;
+
+        /**
+         * @brief Visit tiles modified after a given revision.
+         *
+         * @tparam Fn Callable as `void(glyph_rect)`
+         * @param since Revision previously obtained from revision()
+         * @param fn Callback receiving each dirty tile, clipped to the atlas
+         */
+        template<typename Fn>
+        void for_each_dirty_tile(uint64_t since, Fn&& fn) const {
+            if (since >= m_revision) return;
+            for (int ty = 0; ty < m_tiles_y; ++ty) {
+                for (int tx = 0; tx < m_tiles_x; ++tx) {
+                    if (m_tile_revision[index(tx, ty)] > since) {
+                        int x = tx * m_tile_size;
+                        int y = ty * m_tile_size;
+                        fn(glyph_rect{x, y,
+                                      std::min(m_tile_size, m_width - x),
+                                      std::min(m_tile_size, m_height - y)});
+                    }
+                }
+            }
+        }
+
+    private:
+        friend class cow_atlas;
+
+        [[nodiscard]] std::size_t index(int tx, int ty) const noexcept {
+            return static_cast<std::size_t>(ty) * static_cast<std::size_t>(m_tiles_x) +
+                   static_cast<std::size_t>(tx);
+        }
+
+        int m_width = 0;
+        int m_height = 0;
+        int m_tile_size = 0;
+        int m_tiles_x = 0;
+        int m_tiles_y = 0;
+        uint64_t m_revision = 0;
+        std::vector<std::shared_ptr<const std::vector<uint8_t>>> m_tiles;
+        std::vector<uint64_t> m_tile_revision;
+    };
+
+    /**
+     * @brief Atlas surface of copy-on-write tiles.
+     *
+     * Satisfies sized_atlas_surface. It does not expose contiguous
+     * memory, so glyph_cache writes glyphs through write_alpha().
+     */
+    class ONYX_FONT_EXPORT cow_atlas {
+    public:
+        /// Default tile edge length
+        static constexpr int default_tile_size = 64;
+
+        /**
+         * @brief Construct an all-zero atlas.
+         *
+         * @param width Atlas width in pixels
+         * @param height Atlas height in pixels
+         * @param tile_size Tile edge length in pixels
+         * @throws std::invalid_argument if a dimension is negative or
+         *         tile_size is not positive
+         */
+        cow_atlas(int width, int height, int tile_size = default_tile_size);
+
+        /**
+         * @brief Get atlas width.
+         * @return Width in pixels
+         */
+        [[nodiscard]] int width() const noexcept { return m_width; }
+
+        /**
+         * @brief Get atlas height.
+         * @return Height in pixels
+         */
+        [[nodiscard]] int height() const noexcept { return m_height; }
+
+        /**
+         * @brief Get the tile edge length.
+         * @return Tile size in pixels
+         */
+        [[nodiscard]] int tile_size() const noexcept { return m_tile_size; }
+
+        /**
+         * @brief Write alpha data to a region of the atlas.
+         *
+         * Tiles shared with a snapshot are copied before being modified.
+         * The region is clipped to the atlas.
+         *
+         * @param x X position in atlas (left edge)
+         * @param y Y position in atlas (top edge)
+         * @param w Width of region to write
+         * @param h Height of region to write
+         * @param pixels Source pixel data (row-major, 8-bit alpha)
+         * @param stride Source row stride in bytes
+         */
+        void write_alpha(int x, int y, int w, int h, const uint8_t* pixels, int stride);
+
+        /**
+         * @brief Clear the atlas to zero.
+         *
+         * Releases every tile; snapshots keep theirs.
+         */
+        void clear();
+
+        /**
+         * @brief Get pixel at position.
+         *
+         * @param x X coordinate
+         * @param y Y coordinate
+         * @return Pixel value, or 0 if out of bounds
+         */
+        [[nodiscard]] uint8_t pixel(int x, int y) const noexcept;
+
+        /**
+         * @brief Get the modification revision.
+         *
+         * Incremented by every write_alpha() and clear().
+         *
+         * @return Current revision
+         */
+        [[nodiscard]] uint64_t revision() const noexcept { return m_revision; }
+
+        /**
+         * @brief Take an immutable snapshot of the current contents.
+         *
+         * Copies the tile pointers and revisions; no pixels are copied.
+         *
+         * @return Snapshot
+         */
+        [[nodiscard]] atlas_snapshot snapshot() const;
+
+        /**
+         * @brief Get number of tiles allocated so far.
+         *
+         * Counts first writes to a tile and copies of tiles shared with a
+         * snapshot.
+         *
+         * @return Tile allocations
+         */
+        [[nodiscard]] std::size_t tiles_allocated() const noexcept { return m_tiles_allocated; }
+
+    private:
+        /// Tile pixels the atlas may modify, copying or allocating first
+        uint8_t* writable_tile(std::size_t index);
+
+        int m_width;
+        int m_height;
+        int m_tile_size;
+        int m_tiles_x;
+        int m_tiles_y;
+        uint64_t m_revision = 0;
+        std::size_t m_tiles_allocated = 0;
+        std::vector<std::shared_ptr<std::vector<uint8_t>>> m_tiles;
+        std::vector<uint64_t> m_tile_revision;
+    };
+
+    /**
+     * @brief Atlas surface able to produce atlas_snapshot views.
+     *
+     * glyph_cache::snapshot() is available for such surfaces.
+     *
+     * @tparam T Type to check against the concept
+     */
+    template<typename T>
+    concept snapshot_atlas_surface = atlas_surface<T> &&
+        requires(const T& surface)
+    {
+        { surface.snapshot() } -> std::same_as<atlas_snapshot>;
+    };
+
+    static_assert(sized_atlas_surface<cow_atlas>);
+    static_assert(snapshot_atlas_surface<cow_atlas>);
+    static_assert(readable_atlas_surface<cow_atlas>);
+} // namespace onyx_font
@@ -52,6 +52,23 @@
  * auto glyph_m = src1.get_glyph_metrics('A', 16.0f);
  * @endcode
  *
+ * @section source_encoding 8-bit Fonts and Codepages
+ *
+ * Bitmap and vector fonts with 8-bit character codes are indexed in a
+ * legacy codepage. When the font's codepage is known, from_bitmap() and
+ * from_vector() attach the matching codepage_table, and every method
+ * that takes a codepoint maps it to the font's byte with one table
+ * lookup. UTF-8 text with "é" or box-drawing characters then reaches the
+ * right glyphs without translating strings before drawing.
+ *
+ * @code{.cpp}
+ * bitmap_font vga = font_factory::load_raw(data, raw_font_options::vga_8x16());
+ * font_source src = font_source::from_bitmap(vga);  // CP437 attached
+ * src.has_glyph(U'╔');                              // byte 0xC9
+ *
+ * src.set_encoding(nullptr);                        // raw byte values
+ * @endcode
+ *
  * @author Igor
  * @date 21/12/2025
  */
@@ -73,8 +90,8 @@ namespace onyx_font {
      * @brief Unified font wrapper for all font types.
      *
      * Provides consistent access to metrics, glyph information, and
-     * rasterization across bitmap, vector, and TTF fonts. This abstraction
-     * is move-only (not copyable) due to internal resource ownership.
+     * rasterization across bitmap, vector, and TTF fonts. Copies refer to
+     * the same font; a TTF source gives each copy its own rasterizer.
      *
      * @section font_source_features Features
      *
@@ -94,10 +111,17 @@ namespace onyx_font {
      */
     class ONYX_FONT_EXPORT font_source {
     public:
-        /// @cond
-        font_source(const font_source&) = delete;
-        font_source& operator=(const font_source&) = delete;
-        /// @endcond
+        /**
+         * @brief Copy constructor.
+         *
+         * Refers to the same font. A TTF source creates a new rasterizer.
+         */
+        font_source(const font_source& other);
+
+        /**
+         * @brief Copy assignment operator.
+         */
+        font_source& operator=(const font_source& other);
 
         /**
          * @brief Move constructor.
@@ -149,6 +173,34 @@ namespace onyx_font {
          */
         [[nodiscard]] font_source_type type() const;
 
+        /**
+         * @brief Identify the wrapped font.
+         *
+         * Sources created from the same font object return the same
+         * value. Used as a cache key (e.g. by word_width_cache); a value
+         * may be reused once the font is destroyed.
+         *
+         * @return Address of the wrapped font
+         */
+        [[nodiscard]] const void* font_identity() const noexcept;
+
+        /**
+         * @brief Set the codepage used to map codepoints to 8-bit glyphs.
+         *
+         * Only affects bitmap fonts without a sparse Unicode index and
+         * vector fonts. With no table, codepoints below 256 are used as
+         * raw character codes.
+         *
+         * @param table Codepage table (e.g. codepage_table::get()), or nullptr
+         */
+        void set_encoding(const codepage_table* table) noexcept;
+
+        /**
+         * @brief Get the codepage attached to this source.
+         * @return Codepage table, or nullptr if codepoints are raw codes
+         */
+        [[nodiscard]] const codepage_table* encoding() const noexcept;
+
         /**
          * @brief Check if font has a specific glyph.
          *
@@ -254,8 +306,25 @@ namespace onyx_font {
         /// Owned rasterizer for TTF fonts (created internally by from_ttf)
         std::unique_ptr<stb_truetype_font> m_rasterizer;
 
+        /// Codepage of 8-bit fonts (nullptr: raw character codes)
+        const codepage_table* m_encoding = nullptr;
+
         font_source() = default;
 
+        friend class sized_face;
+
+        /// Map a codepoint to the font's character code through m_encoding
+        [[nodiscard]] char32_t to_font_char(char32_t codepoint) const noexcept;
+
+        /// Scale from font units to pixels (1 for bitmap fonts)
+        [[nodiscard]] float scale_for_size(float size) const;
+
+        /// get_glyph_metrics() with the scale already computed
+        [[nodiscard]] glyph_metrics get_glyph_metrics_at_scale(char32_t codepoint, float scale) const;
+
+        /// get_kerning() with the scale already computed
+        [[nodiscard]] float get_kerning_at_scale(char32_t first, char32_t second, float scale) const;
+
         // Internal rasterization helpers (implemented in .cc)
         void rasterize_bitmap_glyph(char32_t codepoint, float size,
                                     void* target, int x, int y,
@@ -0,0 +1,242 @@
+/**
+ * @file glyph_budget.hh
+ * @brief Process-wide memory budget shared by many glyph caches.
+ *
+ * An application with dozens of glyph_cache instances (faces x sizes x
+ * DPI scales) cannot bound its atlas memory with per-cache settings. A
+ * glyph_budget tracks the atlas bytes of every cache registered with it.
+ * When a cache grows past the limit, the least recently used other
+ * caches are evicted: their glyphs are dropped and all their pages but
+ * one are freed. Evicted glyphs are rasterized again on their next use.
+ *
+ * Caches used since the last tick() are never evicted, since the current
+ * frame may still draw their glyphs. The limit is therefore soft: while
+ * every other cache is in use, the total may exceed it until a later
+ * report. Without tick() no cache is ever evicted.
+ *
+ * @section glyph_budget_usage Usage
+ *
+ * @code{.cpp}
+ * auto budget = std::make_shared<glyph_budget>(64 * 1024 * 1024);
+ *
+ * glyph_cache_config config;
+ * config.budget = budget;
+ * config.budget_name = "ui-sans 16px";
+ * glyph_cache<memory_atlas> cache(font_source::from_ttf(font), 16.0f, config);
+ *
+ * // Once per frame, so recency has frame granularity
+ * budget->tick();
+ *
+ * // Monitoring
+ * for (const auto& share : budget->shares()) {
+ *     log("{}: {} bytes", share.name, share.bytes);
+ * }
+ * @endcode
+ *
+ * @section glyph_budget_threads Threading
+ *
+ * The budget's own bookkeeping is thread-safe, but eviction runs the
+ * victim cache's code on the thread whose cache grew. Caches sharing a
+ * budget must therefore be used from one thread, or under one lock.
+ * resizable_glyph_cache follows this rule by keeping a cache built on a
+ * worker out of the budget until it is swapped in.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Atlas memory limit shared by registered caches.
+     */
+    class ONYX_FONT_EXPORT glyph_budget : public std::enable_shared_from_this<glyph_budget> {
+        struct account;
+
+    public:
+        /**
+         * @brief Frees a client's memory.
+         *
+         * Called with the budget locked; must not call back into the
+         * budget. Returns the bytes the client still holds.
+         */
+        using evict_fn = std::function<std::size_t()>;
+
+        /**
+         * @brief Memory held by one registered cache.
+         */
+        struct share {
+            std::string name;        ///< Name given at registration
+            std::size_t bytes = 0;   ///< Atlas bytes currently held
+            uint64_t last_used = 0;  ///< tick() value at the last use
+            std::size_t evictions = 0; ///< Times the cache was evicted
+        };
+
+        /**
+         * @brief Registration of a client; unregisters on destruction.
+         *
+         * Move-only. A default-constructed registration is inactive and
+         * all its members are no-ops.
+         */
+        class ONYX_FONT_EXPORT registration {
+        public:
+            registration() = default;
+            registration(registration&& other) noexcept;
+            registration& operator=(registration&& other) noexcept;
+            registration(const registration&) = delete;
+            registration& operator=(const registration&) = delete;
+            ~registration();
+
+            /**
+             * @brief Check whether the registration is active.
+             * @return true if registered with a budget
+             */
+            [[nodiscard]] explicit operator bool() const noexcept { return m_account != nullptr; }
+
+            /**
+             * @brief Report the client's current size.
+             *
+             * Evicts other clients, least recently used first, while the
+             * total exceeds the limit. The reporting client and clients
+             * used in the current tick are not evicted.
+             *
+             * @param bytes Bytes held by the client
+             */
+            void update(std::size_t bytes);
+
+            /**
+             * @brief Mark the client as used in the current tick.
+             *
+             * Cheap enough to call on every lookup.
+             */
+            void touch() noexcept {
+                if (m_account) {
+                    uint64_t now = m_budget->m_clock.load(std::memory_order_relaxed);
+                    if (m_account->last_used.load(std::memory_order_relaxed) != now) {
+                        m_account->last_used.store(now, std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            /**
+             * @brief Replace the eviction callback (e.g. after the client moved).
+             * @param evict New callback
+             */
+            void rebind(evict_fn evict);
+
+            /**
+             * @brief Unregister now.
+             */
+            void reset() noexcept;
+
+        private:
+            friend class glyph_budget;
+
+            registration(std::shared_ptr<glyph_budget> budget, account* acct) noexcept
+                : m_budget(std::move(budget))
+                  , m_account(acct) {
+            }
+
+            std::shared_ptr<glyph_budget> m_budget;
+            account* m_account = nullptr;
+        };
+
+        /**
+         * @brief Create a budget.
+         *
+         * Must be owned by a std::shared_ptr (registrations keep it alive).
+         *
+         * @param limit_bytes Maximum total atlas bytes
+         */
+        explicit glyph_budget(std::size_t limit_bytes) noexcept
+            : m_limit(limit_bytes) {
+        }
+
+        glyph_budget(const glyph_budget&) = delete;
+        glyph_budget& operator=(const glyph_budget&) = delete;
+
+        /**
+         * @brief Register a client.
+         *
+         * @param name Name reported by shares()
+         * @param evict Frees the client's memory
+         * @return Registration handle
+         */
+        [[nodiscard]] registration add(std::string name, evict_fn evict);
+
+        /**
+         * @brief Advance the recency clock. Call once per frame.
+         */
+        void tick() noexcept { m_clock.fetch_add(1, std::memory_order_relaxed); }
+
+        /**
+         * @brief Get the limit.
+         * @return Maximum total bytes
+         */
+        [[nodiscard]] std::size_t limit() const;
+
+        /**
+         * @brief Change the limit, evicting if the total now exceeds it.
+         *
+         * Clients used in the current tick are not evicted.
+         *
+         * @param limit_bytes Maximum total bytes
+         */
+        void set_limit(std::size_t limit_bytes);
+
+        /**
+         * @brief Get the total bytes held by all clients.
+         * @return Bytes in use
+         */
+        [[nodiscard]] std::size_t used() const;
+
+        /**
+         * @brief Get the number of registered clients.
+         * @return Client count
+         */
+        [[nodiscard]] std::size_t client_count() const;
+
+        /**
+         * @brief Get the total number of evictions so far.
+         * @return Eviction count
+         */
+        [[nodiscard]] std::size_t evictions() const;
+
+        /**
+         * @brief Report every client's share.
+         * @return Shares, largest first
+         */
+        [[nodiscard]] std::vector<share> shares() const;
+
+    private:
+        struct account {
+            std::string name;
+            std::size_t bytes = 0;
+            std::atomic<uint64_t> last_used{0};
+            std::size_t evictions = 0;
+            evict_fn evict;
+        };
+
+        /// Evict least recently used clients (except @p keep) until within the limit
+        void enforce_locked(const account* keep);
+
+        mutable std::mutex m_mutex;
+        std::list<account> m_accounts;
+        std::size_t m_limit;
+        std::size_t m_used = 0;
+        std::size_t m_evictions = 0;
+        std::atomic<uint64_t> m_clock{0};
+    };
+} // namespace onyx_font
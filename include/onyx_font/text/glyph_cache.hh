@@ -13,7 +13,14 @@
  * - Automatic rasterization on first access
  * - Efficient atlas packing with row-based algorithm
  * - Multiple atlas pages when needed
- * - Pre-caching for ASCII and custom character sets
+ * - Optional texture-array layout (same-sized layers, layer limit)
+ * - Optional mip-aligned packing for trilinear-filtered atlases
+ * - Optional downsampling from a shared reference_strike
+ * - Optional per-frame budget for rasterizing cache misses
+ * - Immutable snapshots of pages and glyphs with copy-on-write surfaces
+ * - Optional process-wide memory budget shared with other caches
+ * - Optional compressed second tier that restores dropped glyphs
+ * - Pre-caching for ASCII, custom character sets and usage profiles
  * - Thread safety notes for multi-threaded applications
  *
  * @section cache_architecture Architecture
@@ -68,6 +75,84 @@
  * }
  * @endcode
  *
+ * @subsection cache_frame_budget Frame Budget
+ *
+ * A large block of new text can miss hundreds of glyphs in one frame.
+ * With a miss budget, misses beyond it return a placeholder with the
+ * glyph's real advance and are queued; pump() rasterizes the queue a
+ * budget at a time, one call per frame:
+ *
+ * @code{.cpp}
+ * glyph_cache_config config;
+ * config.miss_budget.time = std::chrono::microseconds(500);
+ * config.pending_style = pending_glyph_style::default_char;
+ *
+ * glyph_cache<memory_atlas> cache(std::move(source), 24.0f, config);
+ *
+ * while (running) {
+ *     if (cache.pump({.time = std::chrono::microseconds(1000)}) > 0) {
+ *         // Placeholders were replaced; text drawn last frame is stale
+ *     }
+ *     draw_ui(cache);
+ * }
+ * @endcode
+ *
+ * @subsection cache_snapshots Snapshots
+ *
+ * With a snapshot_atlas_surface such as cow_atlas, snapshot() captures
+ * the pages and the glyph table at the current generation. It copies
+ * pointers only; the cache then copies the atlas tiles and glyph table
+ * pages it modifies while the snapshot is alive. A render thread can
+ * upload from a snapshot without holding the lock that guards the cache:
+ *
+ * @code{.cpp}
+ * glyph_cache<cow_atlas> cache(std::move(source), 24.0f);
+ *
+ * glyph_cache_snapshot snap;
+ * {
+ *     std::lock_guard lock(cache_mutex);   // short: pointer copies
+ *     snap = cache.snapshot();
+ * }
+ * upload_pages(snap);                       // no lock held
+ * if (const cached_glyph* g = snap.find(U'A')) { ... }
+ * @endcode
+ *
+ * @subsection cache_texture_array Texture Array Layout
+ *
+ * With atlas_layout::texture_array every page is a layer of a single
+ * 2D texture array, so a string spanning several pages can be drawn
+ * with one texture binding (see text_renderer::draw_batched):
+ *
+ * @code{.cpp}
+ * glyph_cache_config config;
+ * config.layout = atlas_layout::texture_array;
+ * config.max_layers = 8;  // Layers allocated for the GPU texture array
+ *
+ * glyph_cache<memory_atlas> cache(std::move(source), 24.0f, config);
+ * // glyph.layer selects the array layer, glyph.rect the region within it
+ * @endcode
+ *
+ * @subsection cache_surface_factory Caller-Provided Atlas Memory
+ *
+ * A surface factory decides where each page lives, for example in a
+ * persistently mapped staging buffer. Surfaces exposing their memory
+ * (memory_atlas, external_memory_atlas) receive glyphs rasterized in
+ * place, with no intermediate copy:
+ *
+ * @code{.cpp}
+ * uint8_t* staging = map_upload_buffer(8 * 512 * 512);
+ *
+ * glyph_cache<external_memory_atlas> cache(
+ *     std::move(source), 24.0f, config,
+ *     [staging](int w, int h, int page) {
+ *         return external_memory_atlas(staging + page * w * h, w, h);
+ *     });
+ *
+ * // Or keep memory_atlas semantics with a custom allocator
+ * glyph_cache<basic_memory_atlas<pool_allocator<uint8_t>>> pooled(
+ *     std::move(other_source), 24.0f, config, pool.allocator());
+ * @endcode
+ *
  * @author Igor
  * @date 21/12/2025
  */
@@ -78,10 +163,23 @@
 #include <onyx_font/text/types.hh>
 #include <onyx_font/text/text_rasterizer.hh>
 #include <onyx_font/text/atlas_surface.hh>
+#include <onyx_font/text/cow_atlas.hh>
+#include <onyx_font/text/glyph_budget.hh>
+#include <onyx_font/text/glyph_store.hh>
+#include <onyx_font/text/supersample.hh>
+#include <onyx_font/text/usage_profile.hh>
 #include <onyx_font/text/utf8.hh>
+#include <memory>
+#include <span>
+#include <string>
 #include <unordered_map>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <functional>
 #include <stdexcept>
 
 namespace onyx_font {
@@ -93,12 +191,151 @@ namespace onyx_font {
      */
     struct cached_glyph {
         int atlas_index = 0;   ///< Index of atlas containing this glyph
+        int layer = 0;         ///< Texture array layer (same as atlas_index)
         glyph_rect rect;       ///< Position and size within the atlas
         float bearing_x = 0;   ///< Left side bearing (pen to glyph left edge)
         float bearing_y = 0;   ///< Top side bearing (baseline to glyph top)
         float advance_x = 0;   ///< Horizontal advance to next glyph
     };
 
+    /**
+     * @brief Fixed block of the glyph table shared by glyph_cache snapshots.
+     *
+     * Holds the glyphs of @ref size consecutive codepoints, so a write
+     * after a snapshot copies one page rather than the whole table.
+     */
+    struct glyph_table_page {
+        static constexpr char32_t size = 64;  ///< Codepoints per page
+
+        uint64_t present = 0;                 ///< Bit i set if glyphs[i] is cached
+        std::array<cached_glyph, size> glyphs{};
+
+        /**
+         * @brief Look up a glyph of this page.
+         * @param codepoint Unicode codepoint belonging to the page
+         * @return Glyph, or nullptr if not cached
+         */
+        [[nodiscard]] const cached_glyph* find(char32_t codepoint) const noexcept {
+            char32_t slot = codepoint % size;
+            return (present >> slot) & 1u ? &glyphs[slot] : nullptr;
+        }
+    };
+
+    /// Glyph table pages by codepoint / glyph_table_page::size
+    using glyph_table_directory = std::unordered_map<char32_t, std::shared_ptr<glyph_table_page>>;
+
+    /**
+     * @brief Immutable view of a glyph_cache's pages and glyphs.
+     *
+     * Produced by glyph_cache::snapshot() for snapshot_atlas_surface
+     * caches. May be read, copied and destroyed on any thread while the
+     * cache keeps changing; destruction never blocks the cache.
+     */
+    class glyph_cache_snapshot {
+    public:
+        glyph_cache_snapshot() = default;
+
+        /**
+         * @brief Get the cache generation the snapshot was taken at.
+         *
+         * The generation counts glyphs added to the cache, so equal
+         * generations mean identical contents.
+         *
+         * @return Generation
+         */
+        [[nodiscard]] uint64_t generation() const noexcept { return m_generation; }
+
+        /**
+         * @brief Get number of atlas pages.
+         * @return Page count
+         */
+        [[nodiscard]] int atlas_count() const noexcept { return static_cast<int>(m_atlases.size()); }
+
+        /**
+         * @brief Get an atlas page.
+         *
+         * @param index Page index (0 to atlas_count() - 1)
+         * @return Page snapshot
+         * @throws std::out_of_range if index is invalid
+         */
+        [[nodiscard]] const atlas_snapshot& atlas(int index) const {
+            if (index < 0 || static_cast<std::size_t>(index) >= m_atlases.size()) {
+                throw std::out_of_range("atlas index out of range");
+            }
+            return m_atlases[static_cast<std::size_t>(index)];
+        }
+
+        /**
+         * @brief Look up a glyph.
+         *
+         * @param codepoint Unicode codepoint
+         * @return Glyph as cached at the snapshot, or nullptr
+         */
+        [[nodiscard]] const cached_glyph* find(char32_t codepoint) const noexcept {
+            if (!m_directory) return nullptr;
+            auto it = m_directory->find(codepoint / glyph_table_page::size);
+            return it != m_directory->end() ? it->second->find(codepoint) : nullptr;
+        }
+
+    private:
+        template<atlas_surface Surface>
+        friend class glyph_cache;
+
+        uint64_t m_generation = 0;
+        std::vector<atlas_snapshot> m_atlases;
+        std::shared_ptr<const glyph_table_directory> m_directory;
+    };
+
+    /**
+     * @brief How atlas pages are presented to the GPU.
+     */
+    enum class atlas_layout {
+        pages,         ///< Independent textures, one per atlas page
+        texture_array  ///< Same-sized layers of a single 2D texture array
+    };
+
+    /**
+     * @brief Limits on glyph rasterization within one frame.
+     *
+     * A zero field is unlimited; with both zero there is no limit. The
+     * budget is checked before each glyph, so at least one glyph is
+     * rasterized per frame and the time limit can be overshot by one
+     * glyph.
+     */
+    struct frame_budget {
+        std::chrono::microseconds time{0};  ///< Rasterization time
+        int glyphs = 0;                     ///< Number of glyphs
+
+        /**
+         * @brief Check whether the budget imposes no limit.
+         * @return true if both limits are zero
+         */
+        [[nodiscard]] bool unlimited() const noexcept {
+            return time.count() <= 0 && glyphs <= 0;
+        }
+    };
+
+    /**
+     * @brief What glyph_cache::get() returns for a glyph queued by the frame budget.
+     */
+    enum class pending_glyph_style {
+        empty,        ///< Nothing drawn; bearings and advance of the real glyph
+        default_char  ///< The font's default character, with the real glyph's advance
+    };
+
+    /**
+     * @brief Lookup counters of a glyph_cache, per tier.
+     *
+     * Atlas counters count get() calls. Store counters count misses that
+     * consulted config.backing_store, including pre-caching.
+     */
+    struct glyph_cache_stats {
+        uint64_t atlas_hits = 0;    ///< get() found the glyph in the atlas
+        uint64_t atlas_misses = 0;  ///< get() had to add the glyph
+        uint64_t store_hits = 0;    ///< Glyph decoded from the backing store
+        uint64_t store_misses = 0;  ///< Glyph not in the backing store, rasterized
+    };
+
     /**
      * @brief Configuration for glyph cache.
      *
@@ -129,8 +366,122 @@ namespace onyx_font {
          * want to control pre-caching manually.
          */
         bool pre_cache_ascii = true;
+
+        /**
+         * @brief Atlas page layout.
+         *
+         * With atlas_layout::texture_array all pages are atlas_size x
+         * atlas_size layers of one texture array, and text_renderer
+         * submits a whole string as a single batch regardless of how
+         * many layers it touches.
+         */
+        atlas_layout layout = atlas_layout::pages;
+
+        /**
+         * @brief Maximum number of layers for atlas_layout::texture_array.
+         *
+         * Texture arrays are allocated with a fixed layer count, so the
+         * cache refuses to grow beyond it. 0 means unlimited.
+         */
+        int max_layers = 0;
+
+        /**
+         * @brief Number of mip levels the packing must stay clean for.
+         *
+         * padding only protects against bilinear bleeding at full
+         * resolution. With mip_levels = k > 0 every glyph starts on a
+         * 2^k pixel boundary, its footprint is rounded up to whole 2^k
+         * blocks and neighbours are separated by a gutter of at least one
+         * block, so minified sampling down to level k never mixes glyphs.
+         * Pair with atlas_mip_chain to generate the levels.
+         */
+        int mip_levels = 0;
+
+        /**
+         * @brief Shared reference strike to downsample glyphs from.
+         *
+         * When set and the strike supports the cache's size, glyphs are
+         * filtered down from the strike's reference rasterization instead
+         * of being rasterized at this size, and their bearings and advance
+         * are the reference metrics scaled to the size. Share one strike
+         * between the caches of a font at many sizes. nullptr (default)
+         * rasterizes directly.
+         */
+        std::shared_ptr<reference_strike> reference;
+
+        /**
+         * @brief Usage counter fed by every get().
+         *
+         * Records how often each codepoint is drawn so the session can be
+         * saved as a usage_profile and replayed with warm_up() on the next
+         * start. Pre-caching does not count. nullptr (default) records
+         * nothing.
+         */
+        std::shared_ptr<usage_counter> usage;
+
+        /**
+         * @brief Per-frame budget for rasterizing misses in get().
+         *
+         * Once a frame (the time since the last pump()) has spent the
+         * budget, further misses are queued and get() returns a
+         * placeholder styled by pending_style until pump() rasterizes
+         * them. Pre-caching is never budgeted. Unlimited by default.
+         */
+        frame_budget miss_budget;
+
+        /**
+         * @brief Placeholder returned for queued glyphs.
+         */
+        pending_glyph_style pending_style = pending_glyph_style::empty;
+
+        /**
+         * @brief Memory budget shared with other caches.
+         *
+         * The cache reports its atlas bytes whenever it adds a page, and
+         * may be cleared (see glyph_cache::clear()) when another cache
+         * pushes the total over the limit while this one is the least
+         * recently used. nullptr (default) means no shared budget.
+         */
+        std::shared_ptr<glyph_budget> budget;
+
+        /**
+         * @brief Name reported in glyph_budget::shares().
+         */
+        std::string budget_name;
+
+        /**
+         * @brief Second tier for glyphs the cache drops.
+         *
+         * When the cache is cleared (by clear() or the shared budget), the
+         * bitmaps of its glyphs are compressed into this store, and a later
+         * miss decodes the glyph back into the atlas instead of rasterizing
+         * it. Requires a readable_atlas_surface; ignored otherwise. May be
+         * shared by caches of any size. nullptr (default) means no second
+         * tier.
+         */
+        std::shared_ptr<glyph_store> backing_store;
+
+        /**
+         * @brief Word width memo for wrapping with this cache.
+         *
+         * Installed on the cache's rasterizer (see
+         * text_rasterizer::set_word_cache()). May be shared by all caches.
+         * nullptr (default) measures every word glyph by glyph.
+         */
+        std::shared_ptr<word_width_cache> words;
     };
 
+    /**
+     * @brief Creates atlas pages for a glyph_cache.
+     *
+     * Called with the page width, height and index each time the cache
+     * needs a new page.
+     *
+     * @tparam Surface Atlas surface type
+     */
+    template<typename Surface>
+    using atlas_surface_factory = std::function<Surface(int width, int height, int page_index)>;
+
     /**
      * @brief Glyph cache with texture atlas.
      *
@@ -174,15 +525,66 @@ namespace onyx_font {
         /**
          * @brief Create cache for a font at a specific size.
          *
+         * Atlas pages are constructed as `Surface(width, height)`.
+         *
          * @param source Font source to rasterize from (moves ownership)
          * @param size Pixel height for rasterization
          * @param config Cache configuration
          */
         glyph_cache(font_source source, float size,
                     glyph_cache_config config = {})
+            requires sized_atlas_surface<Surface>
+            : glyph_cache(std::move(source), size, config,
+                          [](int width, int height, int) { return Surface(width, height); }) {
+        }
+
+        /**
+         * @brief Create cache whose pages are constructed with an allocator.
+         *
+         * Atlas pages are constructed as `Surface(width, height, alloc)`,
+         * e.g. basic_memory_atlas over a pool allocator.
+         *
+         * @tparam Alloc Allocator type accepted by the surface
+         * @param source Font source to rasterize from (moves ownership)
+         * @param size Pixel height for rasterization
+         * @param config Cache configuration
+         * @param alloc Allocator passed to every page
+         */
+        template<typename Alloc>
+            requires std::constructible_from<Surface, int, int, const Alloc&>
+        glyph_cache(font_source source, float size,
+                    glyph_cache_config config, const Alloc& alloc)
+            : glyph_cache(std::move(source), size, config,
+                          [alloc](int width, int height, int) { return Surface(width, height, alloc); }) {
+        }
+
+        /**
+         * @brief Create cache whose pages come from a factory.
+         *
+         * Use this for surfaces over caller-owned memory, such as
+         * external_memory_atlas on a mapped upload buffer.
+         *
+         * @param source Font source to rasterize from (moves ownership)
+         * @param size Pixel height for rasterization
+         * @param config Cache configuration
+         * @param factory Creates page @p page_index of the given size
+         * @throws std::invalid_argument if factory is empty or returns a
+         *         surface of the wrong size
+         */
+        glyph_cache(font_source source, float size,
+                    glyph_cache_config config, atlas_surface_factory<Surface> factory)
             : m_rasterizer(std::move(source))
-              , m_config(config) {
+              , m_config(config)
+              , m_factory(std::move(factory)) {
+            if (!m_factory) {
+                throw std::invalid_argument("atlas surface factory is empty");
+            }
             m_rasterizer.set_size(size);
+            m_rasterizer.set_word_cache(m_config.words);
+
+            if (m_config.budget) {
+                m_budget = m_config.budget->add(m_config.budget_name, evict_callback());
+            }
 
             // Create first atlas
             add_atlas();
@@ -193,6 +595,53 @@ namespace onyx_font {
             }
         }
 
+        glyph_cache(const glyph_cache&) = delete;
+        glyph_cache& operator=(const glyph_cache&) = delete;
+
+        glyph_cache(glyph_cache&& other)
+            : m_rasterizer(std::move(other.m_rasterizer))
+              , m_config(std::move(other.m_config))
+              , m_factory(std::move(other.m_factory))
+              , m_atlases(std::move(other.m_atlases))
+              , m_cache(std::move(other.m_cache))
+              , m_generation(other.m_generation)
+              , m_directory(std::move(other.m_directory))
+              , m_frame(other.m_frame)
+              , m_pending_queue(std::move(other.m_pending_queue))
+              , m_pending(std::move(other.m_pending))
+              , m_budget(std::move(other.m_budget))
+              , m_stats(other.m_stats)
+              , m_pack_x(other.m_pack_x)
+              , m_pack_y(other.m_pack_y)
+              , m_row_height(other.m_row_height) {
+            // The budget's eviction callback must point at the new object
+            m_budget.rebind(evict_callback());
+        }
+
+        glyph_cache& operator=(glyph_cache&& other) {
+            if (this != &other) {
+                m_budget = std::move(other.m_budget);
+                m_rasterizer = std::move(other.m_rasterizer);
+                m_config = std::move(other.m_config);
+                m_factory = std::move(other.m_factory);
+                m_atlases = std::move(other.m_atlases);
+                m_cache = std::move(other.m_cache);
+                m_generation = other.m_generation;
+                m_directory = std::move(other.m_directory);
+                m_frame = other.m_frame;
+                m_pending_queue = std::move(other.m_pending_queue);
+                m_pending = std::move(other.m_pending);
+                m_stats = other.m_stats;
+                m_pack_x = other.m_pack_x;
+                m_pack_y = other.m_pack_y;
+                m_row_height = other.m_row_height;
+                m_budget.rebind(evict_callback());
+            }
+            return *this;
+        }
+
+        ~glyph_cache() = default;
+
         /**
          * @brief Get cached glyph (rasterizes and caches if not present).
          *
@@ -205,11 +654,78 @@ namespace onyx_font {
          * @warning Not thread-safe. May modify internal state.
          */
         const cached_glyph& get(char32_t codepoint) {
+            if (m_config.usage) {
+                m_config.usage->add(codepoint);
+            }
+            m_budget.touch();
             auto it = m_cache.find(codepoint);
             if (it != m_cache.end()) {
+                ++m_stats.atlas_hits;
                 return it->second;
             }
-            return cache_glyph(codepoint);
+            ++m_stats.atlas_misses;
+            if (m_config.miss_budget.unlimited()) {
+                return cache_glyph(codepoint);
+            }
+            return budgeted_miss(codepoint);
+        }
+
+        /**
+         * @brief Mark the cache as used without a lookup.
+         *
+         * For callers that replay glyphs obtained earlier (e.g. a
+         * layout_cache hit), so the shared glyph_budget still sees the
+         * cache as recently used.
+         */
+        void touch() noexcept {
+            m_budget.touch();
+        }
+
+        /**
+         * @brief Rasterize queued glyphs and start a new frame.
+         *
+         * Drains the glyphs queued by config.miss_budget in request order
+         * until @p budget is spent, then resets the miss budget for the
+         * following get() calls. Call once per frame, before drawing.
+         * Placeholder references returned by get() for the rasterized
+         * glyphs become invalid.
+         *
+         * @param budget Limit for this call (unlimited drains the queue)
+         * @return Number of glyphs rasterized; non-zero means text drawn
+         *         with placeholders should be redrawn
+         */
+        std::size_t pump(const frame_budget& budget = {}) {
+            miss_meter meter;
+            std::size_t added = 0;
+            while (!m_pending_queue.empty() && !exhausted(meter, budget)) {
+                char32_t cp = m_pending_queue.front();
+                m_pending_queue.pop_front();
+                m_pending.erase(cp);
+                if (!is_cached(cp)) {
+                    timed_cache_glyph(cp, meter);
+                    ++added;
+                }
+            }
+            m_frame = {};
+            return added;
+        }
+
+        /**
+         * @brief Check if a glyph is queued for pump().
+         *
+         * @param codepoint Unicode codepoint
+         * @return true if get() currently returns a placeholder for it
+         */
+        [[nodiscard]] bool is_pending(char32_t codepoint) const noexcept {
+            return m_pending.find(codepoint) != m_pending.end();
+        }
+
+        /**
+         * @brief Get number of glyphs queued for pump().
+         * @return Queue length
+         */
+        [[nodiscard]] std::size_t pending_count() const noexcept {
+            return m_pending_queue.size();
         }
 
         /**
@@ -222,6 +738,79 @@ namespace onyx_font {
             return m_cache.find(codepoint) != m_cache.end();
         }
 
+        /**
+         * @brief Drop every glyph and all pages but a fresh first one.
+         *
+         * Invalidates all cached_glyph references and atlas contents.
+         * Queued glyphs of the frame budget are dropped too. With
+         * config.backing_store the glyphs are first compressed into the
+         * store. Called by the shared glyph_budget on eviction.
+         */
+        void clear() {
+            reset_pages();
+            m_budget.update(memory_bytes());
+        }
+
+        /**
+         * @brief Join (or leave) a shared memory budget.
+         *
+         * Replaces config.budget and config.budget_name. Reports the
+         * current atlas bytes at once, which may evict other caches of the
+         * budget, so call it on the thread that uses those caches.
+         *
+         * @param budget Budget to join; nullptr leaves the current one
+         * @param name Name reported in glyph_budget::shares()
+         */
+        void set_budget(std::shared_ptr<glyph_budget> budget, std::string name = {}) {
+            m_budget.reset();
+            m_config.budget = std::move(budget);
+            m_config.budget_name = std::move(name);
+            if (m_config.budget) {
+                m_budget = m_config.budget->add(m_config.budget_name, evict_callback());
+                m_budget.update(memory_bytes());
+            }
+        }
+
+        /**
+         * @brief Get the lookup counters.
+         * @return Counters since creation or the last reset_stats()
+         */
+        [[nodiscard]] const glyph_cache_stats& stats() const noexcept {
+            return m_stats;
+        }
+
+        /**
+         * @brief Zero the lookup counters.
+         */
+        void reset_stats() noexcept {
+            m_stats = {};
+        }
+
+        /**
+         * @brief Get the atlas memory of the cache.
+         * @return Page count times atlas_size squared, in bytes
+         */
+        [[nodiscard]] std::size_t memory_bytes() const noexcept {
+            auto side = static_cast<std::size_t>(m_config.atlas_size);
+            return m_atlases.size() * side * side;
+        }
+
+        /**
+         * @brief Get all cached codepoints.
+         *
+         * Used to seed a cache for another size with the same glyphs.
+         *
+         * @return Codepoints in unspecified order
+         */
+        [[nodiscard]] std::vector<char32_t> cached_codepoints() const {
+            std::vector<char32_t> result;
+            result.reserve(m_cache.size());
+            for (const auto& entry : m_cache) {
+                result.push_back(entry.first);
+            }
+            return result;
+        }
+
         /**
          * @brief Pre-cache a range of characters.
          *
@@ -249,6 +838,58 @@ namespace onyx_font {
             }
         }
 
+        /**
+         * @brief Pre-cache a list of characters.
+         *
+         * Used by warm_up() with the top codepoints of a usage_profile.
+         *
+         * @param codepoints Codepoints to cache
+         * @return Number of glyphs newly cached
+         */
+        std::size_t cache_codepoints(std::span<const char32_t> codepoints) {
+            std::size_t added = 0;
+            for (char32_t cp : codepoints) {
+                if (!is_cached(cp)) {
+                    cache_glyph(cp);
+                    ++added;
+                }
+            }
+            return added;
+        }
+
+        /**
+         * @brief Capture the pages and glyph table.
+         *
+         * Only pointers are copied. Pages the cache writes to afterwards
+         * are copied tile by tile, and glyph table pages one
+         * glyph_table_page at a time, while the snapshot is alive.
+         * Must not run concurrently with other members.
+         *
+         * @return Snapshot at the current generation
+         */
+        [[nodiscard]] glyph_cache_snapshot snapshot() const
+            requires snapshot_atlas_surface<Surface> {
+            glyph_cache_snapshot s;
+            s.m_generation = m_generation;
+            s.m_atlases.reserve(m_atlases.size());
+            for (const auto& surface : m_atlases) {
+                s.m_atlases.push_back(surface.snapshot());
+            }
+            s.m_directory = m_directory;
+            return s;
+        }
+
+        /**
+         * @brief Get the cache generation.
+         *
+         * Incremented every time a glyph is added.
+         *
+         * @return Generation
+         */
+        [[nodiscard]] uint64_t generation() const noexcept {
+            return m_generation;
+        }
+
         /**
          * @brief Get number of atlas pages.
          * @return Number of atlas surfaces
@@ -271,6 +912,14 @@ namespace onyx_font {
             return m_atlases[static_cast<std::size_t>(index)];
         }
 
+        /**
+         * @brief Get atlas page layout.
+         * @return Layout from the cache configuration
+         */
+        [[nodiscard]] atlas_layout layout() const noexcept {
+            return m_config.layout;
+        }
+
         /**
          * @brief Get the underlying rasterizer.
          *
@@ -282,6 +931,18 @@ namespace onyx_font {
             return m_rasterizer;
         }
 
+        /**
+         * @brief Get the font at the cache's size.
+         *
+         * Scale, metrics and ASCII advances are computed once when the
+         * cache is created.
+         *
+         * @return Sized face of the rasterizer
+         */
+        [[nodiscard]] const sized_face& face() const noexcept {
+            return m_rasterizer.face();
+        }
+
         /**
          * @brief Measure text (delegates to rasterizer).
          *
@@ -311,26 +972,274 @@ namespace onyx_font {
     private:
         text_rasterizer m_rasterizer;
         glyph_cache_config m_config;
+        atlas_surface_factory<Surface> m_factory;
         std::vector<Surface> m_atlases;
         std::unordered_map<char32_t, cached_glyph> m_cache;
+        uint64_t m_generation = 0;
+        std::shared_ptr<glyph_table_directory> m_directory;  ///< Snapshot surfaces only
+
+        /// Rasterization spent against a frame_budget
+        struct miss_meter {
+            std::chrono::steady_clock::duration spent{};
+            int glyphs = 0;
+        };
+
+        miss_meter m_frame;                                   ///< Misses since the last pump()
+        std::deque<char32_t> m_pending_queue;                 ///< Deferred misses, oldest first
+        std::unordered_map<char32_t, cached_glyph> m_pending; ///< Placeholders of deferred misses
+
+        glyph_budget::registration m_budget;                  ///< Inactive without config.budget
+        glyph_cache_stats m_stats;
 
         // Packing state for current atlas
         int m_pack_x = 0;
         int m_pack_y = 0;
         int m_row_height = 0;
 
+        /// Alignment of glyph positions and sizes (2^mip_levels)
+        [[nodiscard]] int pack_alignment() const noexcept {
+            return m_config.mip_levels > 0 ? 1 << m_config.mip_levels : 1;
+        }
+
+        /// Space between glyphs (and from the page edge)
+        [[nodiscard]] int pack_gutter() const noexcept {
+            int align = pack_alignment();
+            if (align == 1) return m_config.padding;
+            return align_up(std::max(m_config.padding, align), align);
+        }
+
+        [[nodiscard]] static int align_up(int value, int align) noexcept {
+            return (value + align - 1) / align * align;
+        }
+
+        [[nodiscard]] static bool exhausted(const miss_meter& meter, const frame_budget& budget) noexcept {
+            return (budget.glyphs > 0 && meter.glyphs >= budget.glyphs) ||
+                   (budget.time.count() > 0 && meter.spent >= budget.time);
+        }
+
+        /// Rasterize a glyph and charge it to a meter
+        cached_glyph& timed_cache_glyph(char32_t codepoint, miss_meter& meter) {
+            auto start = std::chrono::steady_clock::now();
+            cached_glyph& glyph = cache_glyph(codepoint);
+            meter.spent += std::chrono::steady_clock::now() - start;
+            ++meter.glyphs;
+            return glyph;
+        }
+
+        /// Miss under a frame budget: rasterize, or queue and return a placeholder
+        const cached_glyph& budgeted_miss(char32_t codepoint) {
+            if (auto it = m_pending.find(codepoint); it != m_pending.end()) {
+                return it->second;
+            }
+            if (!exhausted(m_frame, m_config.miss_budget)) {
+                return timed_cache_glyph(codepoint, m_frame);
+            }
+
+            // Metrics are cheap next to rasterization and keep layout stable
+            glyph_metrics metrics = m_config.reference && m_config.reference->supports(m_rasterizer.size())
+                                        ? m_config.reference->get_glyph_metrics(codepoint, m_rasterizer.size())
+                                        : m_rasterizer.face().get_glyph_metrics(codepoint);
+            cached_glyph placeholder;
+            placeholder.bearing_x = metrics.bearing_x;
+            placeholder.bearing_y = metrics.bearing_y;
+
+            if (m_config.pending_style == pending_glyph_style::default_char) {
+                char32_t fallback = m_rasterizer.source().default_char();
+                if (fallback != codepoint) {
+                    auto it = m_cache.find(fallback);
+                    placeholder = it != m_cache.end() ? it->second : cache_glyph(fallback);
+                }
+            }
+            placeholder.advance_x = metrics.advance_x;
+
+            m_pending_queue.push_back(codepoint);
+            return m_pending.emplace(codepoint, placeholder).first->second;
+        }
+
+        /// Eviction callback for the shared budget
+        glyph_budget::evict_fn evict_callback() {
+            return [this] {
+                reset_pages();
+                return memory_bytes();
+            };
+        }
+
+        /// Drop glyphs and pages, keeping one fresh page (no budget report)
+        void reset_pages() {
+            spill();
+            m_cache.clear();
+            m_pending.clear();
+            m_pending_queue.clear();
+            m_atlases.clear();
+            if constexpr (snapshot_atlas_surface<Surface>) {
+                // Snapshots keep the old table
+                m_directory.reset();
+            }
+            ++m_generation;
+            m_atlases.push_back(make_page());
+            m_pack_x = pack_gutter();
+            m_pack_y = pack_gutter();
+            m_row_height = 0;
+        }
+
+        /// Compress every cached glyph into the backing store
+        void spill() {
+            if constexpr (readable_atlas_surface<Surface>) {
+                if (!m_config.backing_store) return;
+                const void* font = m_rasterizer.source().font_identity();
+                std::vector<uint8_t> buffer;
+                for (const auto& [codepoint, glyph] : m_cache) {
+                    stored_glyph info;
+                    info.width = glyph.rect.w;
+                    info.height = glyph.rect.h;
+                    info.bearing_x = glyph.bearing_x;
+                    info.bearing_y = glyph.bearing_y;
+                    info.advance_x = glyph.advance_x;
+                    buffer.resize(static_cast<std::size_t>(std::max(info.width, 0)) *
+                                  static_cast<std::size_t>(std::max(info.height, 0)));
+                    const auto& surface = m_atlases[static_cast<std::size_t>(glyph.atlas_index)];
+                    for (int y = 0; y < info.height; ++y) {
+                        for (int x = 0; x < info.width; ++x) {
+                            buffer[static_cast<std::size_t>(y) * static_cast<std::size_t>(info.width) +
+                                   static_cast<std::size_t>(x)] =
+                                static_cast<uint8_t>(surface.pixel(glyph.rect.x + x, glyph.rect.y + y));
+                        }
+                    }
+                    m_config.backing_store->put(font, codepoint, m_rasterizer.size(), info,
+                                                buffer.data(), info.width);
+                }
+            }
+        }
+
+        /// Copy a glyph from the backing store into the atlas, if held there
+        cached_glyph* restore(char32_t codepoint) {
+            if constexpr (readable_atlas_surface<Surface>) {
+                stored_glyph info;
+                std::vector<uint8_t> pixels;
+                if (!m_config.backing_store->fetch(m_rasterizer.source().font_identity(), codepoint,
+                                                  m_rasterizer.size(), info, pixels) ||
+                    info.width > m_config.atlas_size || info.height > m_config.atlas_size) {
+                    ++m_stats.store_misses;
+                    return nullptr;
+                }
+                ++m_stats.store_hits;
+
+                cached_glyph glyph;
+                glyph.bearing_x = info.bearing_x;
+                glyph.bearing_y = info.bearing_y;
+                glyph.advance_x = info.advance_x;
+                if (info.width > 0 && info.height > 0) {
+                    int glyph_x = 0;
+                    int glyph_y = 0;
+                    int atlas_index = place(info.width, info.height, glyph_x, glyph_y);
+                    m_atlases[static_cast<std::size_t>(atlas_index)].write_alpha(
+                        glyph_x, glyph_y, info.width, info.height, pixels.data(), info.width);
+                    glyph.atlas_index = atlas_index;
+                    glyph.layer = atlas_index;
+                    glyph.rect = {glyph_x, glyph_y, info.width, info.height};
+                }
+                return &store(codepoint, glyph);
+            } else {
+                (void)codepoint;
+                return nullptr;
+            }
+        }
+
+        /// Create the next atlas page
+        Surface make_page() {
+            if (m_config.layout == atlas_layout::texture_array &&
+                m_config.max_layers > 0 &&
+                static_cast<int>(m_atlases.size()) >= m_config.max_layers) {
+                throw std::length_error("texture array layer limit reached");
+            }
+            Surface surface = m_factory(m_config.atlas_size, m_config.atlas_size,
+                                        static_cast<int>(m_atlases.size()));
+            if (static_cast<int>(surface.width()) < m_config.atlas_size ||
+                static_cast<int>(surface.height()) < m_config.atlas_size) {
+                throw std::invalid_argument("atlas surface smaller than atlas_size");
+            }
+            return surface;
+        }
+
         /// Add a new atlas page
         void add_atlas() {
-            m_atlases.emplace_back(m_config.atlas_size, m_config.atlas_size);
-            m_pack_x = m_config.padding;
-            m_pack_y = m_config.padding;
+            m_atlases.push_back(make_page());
+            m_pack_x = pack_gutter();
+            m_pack_y = pack_gutter();
             m_row_height = 0;
+            m_budget.update(memory_bytes());
+        }
+
+        /**
+         * Reserve a glyph_w x glyph_h rectangle, opening a new row or page
+         * as needed. Returns the page index.
+         */
+        int place(int glyph_w, int glyph_h, int& glyph_x, int& glyph_y) {
+            // Footprint rounded to the mip block size (no-op without mip_levels)
+            int align = pack_alignment();
+            int gutter = pack_gutter();
+            int padded_w = align_up(glyph_w, align) + gutter;
+            int padded_h = align_up(glyph_h, align) + gutter;
+
+            // Check if glyph fits in current row
+            if (m_pack_x + padded_w > m_config.atlas_size) {
+                // Move to next row
+                m_pack_x = gutter;
+                m_pack_y += m_row_height + gutter;
+                m_row_height = 0;
+            }
+
+            // Check if we need a new atlas
+            if (m_pack_y + padded_h > m_config.atlas_size) {
+                add_atlas();
+            }
+
+            glyph_x = m_pack_x;
+            glyph_y = m_pack_y;
+
+            // Update packing state
+            m_pack_x += padded_w;
+            m_row_height = std::max(m_row_height, padded_h);
+
+            return static_cast<int>(m_atlases.size()) - 1;
+        }
+
+        /// Insert a glyph into the table (and the snapshot pages, if any)
+        cached_glyph& store(char32_t codepoint, const cached_glyph& glyph) {
+            ++m_generation;
+            if constexpr (snapshot_atlas_surface<Surface>) {
+                // Copy the directory and the page if a snapshot shares them
+                if (!m_directory) {
+                    m_directory = std::make_shared<glyph_table_directory>();
+                } else if (!internal::exclusively_owned(m_directory)) {
+                    m_directory = std::make_shared<glyph_table_directory>(*m_directory);
+                }
+                auto& page = (*m_directory)[codepoint / glyph_table_page::size];
+                if (!page) {
+                    page = std::make_shared<glyph_table_page>();
+                } else if (!internal::exclusively_owned(page)) {
+                    page = std::make_shared<glyph_table_page>(*page);
+                }
+                char32_t slot = codepoint % glyph_table_page::size;
+                page->glyphs[slot] = glyph;
+                page->present |= uint64_t{1} << slot;
+            }
+            return m_cache.emplace(codepoint, glyph).first->second;
         }
 
         /// Rasterize and cache a single glyph
         cached_glyph& cache_glyph(char32_t codepoint) {
+            if (m_config.backing_store) {
+                if (cached_glyph* restored = restore(codepoint)) {
+                    return *restored;
+                }
+            }
+            if (m_config.reference && m_config.reference->supports(m_rasterizer.size())) {
+                return cache_downsampled_glyph(codepoint);
+            }
+
             // Get glyph metrics
-            auto metrics = m_rasterizer.measure_glyph(codepoint);
+            auto metrics = m_rasterizer.face().get_glyph_metrics(codepoint);
 
             // Validate and clamp dimensions
             int glyph_w = static_cast<int>(std::ceil(metrics.width));
@@ -344,61 +1253,105 @@ namespace onyx_font {
             if (glyph_w <= 0 || glyph_h <= 0) {
                 cached_glyph glyph;
                 glyph.atlas_index = 0;
+                glyph.layer = 0;
                 glyph.rect = {0, 0, 0, 0};
                 glyph.bearing_x = metrics.bearing_x;
                 glyph.bearing_y = metrics.bearing_y;
                 glyph.advance_x = metrics.advance_x;
-                return m_cache.emplace(codepoint, glyph).first->second;
-            }
-
-            int padded_w = glyph_w + m_config.padding;
-            int padded_h = glyph_h + m_config.padding;
-
-            // Check if glyph fits in current row
-            if (m_pack_x + padded_w > m_config.atlas_size) {
-                // Move to next row
-                m_pack_x = m_config.padding;
-                m_pack_y += m_row_height + m_config.padding;
-                m_row_height = 0;
-            }
-
-            // Check if we need a new atlas
-            if (m_pack_y + padded_h > m_config.atlas_size) {
-                add_atlas();
+                return store(codepoint, glyph);
             }
 
-            int atlas_index = static_cast<int>(m_atlases.size()) - 1;
-            int glyph_x = m_pack_x;
-            int glyph_y = m_pack_y;
-
-            // Rasterize glyph to temporary buffer
-            std::vector<uint8_t> buffer(
-                static_cast<std::size_t>(glyph_w) * static_cast<std::size_t>(glyph_h), 0);
-            grayscale_target target(buffer.data(), glyph_w, glyph_h);
+            int glyph_x = 0;
+            int glyph_y = 0;
+            int atlas_index = place(glyph_w, glyph_h, glyph_x, glyph_y);
 
-            // Rasterize at position (0, bearing_y) so glyph is at top of buffer
+            // Rasterize at position (0, bearing_y) so glyph is at top of its rect
             int baseline_y = static_cast<int>(std::ceil(metrics.bearing_y));
-            m_rasterizer.rasterize_glyph(codepoint, target, 0, baseline_y);
+            auto& surface = m_atlases[static_cast<std::size_t>(atlas_index)];
 
-            // Copy to atlas
-            m_atlases[static_cast<std::size_t>(atlas_index)].write_alpha(
-                glyph_x, glyph_y, glyph_w, glyph_h,
-                buffer.data(), glyph_w
-            );
-
-            // Update packing state
-            m_pack_x += padded_w;
-            m_row_height = std::max(m_row_height, padded_h);
+            if constexpr (direct_atlas_surface<Surface>) {
+                // Rasterize in place; the target only writes covered pixels
+                int stride = static_cast<int>(surface.stride());
+                uint8_t* dst = surface.data() + static_cast<std::size_t>(glyph_y) * static_cast<std::size_t>(stride) +
+                               static_cast<std::size_t>(glyph_x);
+                for (int row = 0; row < glyph_h; ++row) {
+                    std::memset(dst + static_cast<std::size_t>(row) * static_cast<std::size_t>(stride),
+                                0, static_cast<std::size_t>(glyph_w));
+                }
+                grayscale_target target(dst, glyph_w, glyph_h, stride);
+                m_rasterizer.rasterize_glyph(codepoint, target, 0, baseline_y);
+                surface.invalidate(glyph_x, glyph_y, glyph_w, glyph_h);
+            } else {
+                // Rasterize glyph to temporary buffer, then copy to atlas
+                std::vector<uint8_t> buffer(
+                    static_cast<std::size_t>(glyph_w) * static_cast<std::size_t>(glyph_h), 0);
+                grayscale_target target(buffer.data(), glyph_w, glyph_h);
+                m_rasterizer.rasterize_glyph(codepoint, target, 0, baseline_y);
+                surface.write_alpha(glyph_x, glyph_y, glyph_w, glyph_h,
+                                    buffer.data(), glyph_w);
+            }
 
             // Create cached glyph entry
             cached_glyph glyph;
             glyph.atlas_index = atlas_index;
+            glyph.layer = atlas_index;
             glyph.rect = {glyph_x, glyph_y, glyph_w, glyph_h};
             glyph.bearing_x = metrics.bearing_x;
             glyph.bearing_y = metrics.bearing_y;
             glyph.advance_x = metrics.advance_x;
 
-            return m_cache.emplace(codepoint, glyph).first->second;
+            return store(codepoint, glyph);
+        }
+
+        /// Cache a glyph downsampled from the reference strike
+        cached_glyph& cache_downsampled_glyph(char32_t codepoint) {
+            reference_strike& strike = *m_config.reference;
+            float size = m_rasterizer.size();
+            auto metrics = strike.get_glyph_metrics(codepoint, size);
+            glyph_rect box = strike.box(codepoint, size);
+
+            int glyph_w = std::min(box.w, m_config.atlas_size);
+            int glyph_h = std::min(box.h, m_config.atlas_size);
+
+            cached_glyph glyph;
+            glyph.advance_x = metrics.advance_x;
+
+            if (glyph_w <= 0 || glyph_h <= 0) {
+                glyph.bearing_x = metrics.bearing_x;
+                glyph.bearing_y = metrics.bearing_y;
+                return store(codepoint, glyph);
+            }
+
+            int glyph_x = 0;
+            int glyph_y = 0;
+            int atlas_index = place(glyph_w, glyph_h, glyph_x, glyph_y);
+            auto& surface = m_atlases[static_cast<std::size_t>(atlas_index)];
+
+            // The box is pen-relative, so the pen sits at (-box.x, -box.y)
+            float pen_x = static_cast<float>(-box.x);
+            float pen_y = static_cast<float>(-box.y);
+
+            if constexpr (direct_atlas_surface<Surface>) {
+                int stride = static_cast<int>(surface.stride());
+                uint8_t* dst = surface.data() + static_cast<std::size_t>(glyph_y) * static_cast<std::size_t>(stride) +
+                               static_cast<std::size_t>(glyph_x);
+                strike.draw(codepoint, size, dst, glyph_w, glyph_h, stride, pen_x, pen_y);
+                surface.invalidate(glyph_x, glyph_y, glyph_w, glyph_h);
+            } else {
+                std::vector<uint8_t> buffer(
+                    static_cast<std::size_t>(glyph_w) * static_cast<std::size_t>(glyph_h), 0);
+                strike.draw(codepoint, size, buffer.data(), glyph_w, glyph_h, glyph_w, pen_x, pen_y);
+                surface.write_alpha(glyph_x, glyph_y, glyph_w, glyph_h,
+                                    buffer.data(), glyph_w);
+            }
+
+            glyph.atlas_index = atlas_index;
+            glyph.layer = atlas_index;
+            glyph.rect = {glyph_x, glyph_y, glyph_w, glyph_h};
+            glyph.bearing_x = static_cast<float>(box.x);
+            glyph.bearing_y = static_cast<float>(-box.y);
+
+            return store(codepoint, glyph);
         }
     };
 } // namespace onyx_font
@@ -0,0 +1,222 @@
+/**
+ * @file glyph_store.hh
+ * @brief Compressed CPU-side second tier for evicted glyphs.
+ *
+ * A glyph_cache that is cleared (by clear() or a shared glyph_budget)
+ * loses every rasterized glyph, and drawing them again means rasterizing
+ * them again - expensive for complex outlines such as CJK. A glyph_store
+ * keeps the bitmaps of dropped glyphs in CPU memory, run-length encoded
+ * and bounded by its own byte budget. On the next miss the cache copies
+ * the glyph back into the atlas instead of rasterizing it.
+ *
+ * @section glyph_store_usage Usage
+ *
+ * @code{.cpp}
+ * auto store = std::make_shared<glyph_store>(8 * 1024 * 1024);
+ *
+ * glyph_cache_config config;
+ * config.budget = budget;        // Clears the cache under memory pressure
+ * config.backing_store = store;  // ...but keeps its glyphs here
+ * glyph_cache<memory_atlas> cache(font_source::from_ttf(font), 24.0f, config);
+ *
+ * auto s = cache.stats();
+ * log("atlas {}/{} store {}/{}", s.atlas_hits, s.atlas_misses,
+ *     s.store_hits, s.store_misses);
+ * @endcode
+ *
+ * @section glyph_store_encoding Encoding
+ *
+ * Glyph bitmaps are mostly zero, with runs of full coverage. Both
+ * encodings are PackBits-style run-length codes: a control byte below 128
+ * announces that many plus one literal bytes; from 128 up it announces a
+ * run of (control - 125) copies of the next byte. glyph_store_encoding::rle4
+ * first quantizes coverage to 4 bits and packs two pixels per byte, which
+ * halves the size again at the cost of 16 coverage levels.
+ *
+ * Entries are keyed by font (font_source::font_identity()), codepoint and
+ * pixel size, so one store can back the caches of several fonts and
+ * sizes. Call clear() after destroying a font the store holds glyphs of,
+ * as its identity may be reused. It is thread-safe.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Bitmap encoding of a glyph_store.
+     */
+    enum class glyph_store_encoding {
+        rle,  ///< Lossless run-length encoding of 8-bit coverage
+        rle4  ///< Coverage quantized to 4 bits, two pixels per byte, then run-length encoded
+    };
+
+    /**
+     * @brief Metrics of a glyph kept in a glyph_store.
+     */
+    struct stored_glyph {
+        int width = 0;          ///< Bitmap width in pixels
+        int height = 0;         ///< Bitmap height in pixels
+        float bearing_x = 0;    ///< Left side bearing
+        float bearing_y = 0;    ///< Top side bearing
+        float advance_x = 0;    ///< Horizontal advance
+    };
+
+    /**
+     * @brief Counters of a glyph_store.
+     */
+    struct glyph_store_stats {
+        uint64_t hits = 0;          ///< fetch() calls that found the glyph
+        uint64_t misses = 0;        ///< fetch() calls that did not
+        uint64_t evictions = 0;     ///< Entries dropped to stay within the budget
+        std::size_t glyphs = 0;     ///< Entries currently held
+        std::size_t bytes = 0;      ///< Bytes charged against the budget
+        std::size_t raw_bytes = 0;  ///< Uncompressed size of the held bitmaps
+    };
+
+    /**
+     * @brief Size-bounded store of compressed glyph bitmaps.
+     *
+     * Least recently used entries are dropped when the budget is
+     * exceeded. Each entry is charged its encoded size plus a fixed
+     * per-entry overhead.
+     */
+    class ONYX_FONT_EXPORT glyph_store {
+    public:
+        /// Bytes charged per entry in addition to its encoded bitmap
+        static constexpr std::size_t entry_overhead = 64;
+
+        /**
+         * @brief Create an empty store.
+         *
+         * @param budget_bytes Maximum bytes held
+         * @param encoding Bitmap encoding of new entries
+         */
+        explicit glyph_store(std::size_t budget_bytes,
+                             glyph_store_encoding encoding = glyph_store_encoding::rle) noexcept
+            : m_budget(budget_bytes)
+              , m_encoding(encoding) {
+        }
+
+        glyph_store(const glyph_store&) = delete;
+        glyph_store& operator=(const glyph_store&) = delete;
+
+        /**
+         * @brief Add a glyph.
+         *
+         * A glyph already held is only marked as recently used; its
+         * bitmap is not encoded again. Glyphs larger than the whole budget
+         * are not stored.
+         *
+         * @param font Font the glyph belongs to (font_source::font_identity())
+         * @param codepoint Unicode codepoint
+         * @param size Pixel size the glyph was rasterized at
+         * @param glyph Metrics and bitmap dimensions
+         * @param pixels Bitmap (glyph.width x glyph.height, 8-bit coverage);
+         *               may be nullptr for an empty bitmap
+         * @param stride Row stride of @p pixels in bytes
+         * @return true if the glyph is held afterwards
+         */
+        bool put(const void* font, char32_t codepoint, float size, const stored_glyph& glyph,
+                 const uint8_t* pixels, int stride);
+
+        /**
+         * @brief Decode a glyph.
+         *
+         * @param font Font the glyph belongs to
+         * @param codepoint Unicode codepoint
+         * @param size Pixel size
+         * @param glyph Receives the metrics
+         * @param pixels Receives the bitmap, glyph.width x glyph.height,
+         *               row stride glyph.width
+         * @return true if found; counted as a hit or a miss
+         */
+        bool fetch(const void* font, char32_t codepoint, float size,
+                   stored_glyph& glyph, std::vector<uint8_t>& pixels);
+
+        /**
+         * @brief Check whether a glyph is held (not counted as a lookup).
+         *
+         * @param font Font the glyph belongs to
+         * @param codepoint Unicode codepoint
+         * @param size Pixel size
+         * @return true if held
+         */
+        [[nodiscard]] bool contains(const void* font, char32_t codepoint, float size) const;
+
+        /**
+         * @brief Drop every entry. Counters are kept.
+         */
+        void clear();
+
+        /**
+         * @brief Get the budget.
+         * @return Maximum bytes held
+         */
+        [[nodiscard]] std::size_t budget() const;
+
+        /**
+         * @brief Change the budget, dropping entries if needed.
+         * @param budget_bytes Maximum bytes held
+         */
+        void set_budget(std::size_t budget_bytes);
+
+        /**
+         * @brief Get the encoding of new entries.
+         * @return Encoding
+         */
+        [[nodiscard]] glyph_store_encoding encoding() const noexcept { return m_encoding; }
+
+        /**
+         * @brief Get the counters.
+         * @return Snapshot of the counters
+         */
+        [[nodiscard]] glyph_store_stats stats() const;
+
+    private:
+        struct key {
+            const void* font;
+            char32_t codepoint;
+            uint32_t size_64;
+
+            bool operator==(const key&) const = default;
+        };
+
+        struct key_hash {
+            std::size_t operator()(const key& k) const noexcept;
+        };
+
+        struct entry {
+            key k{};
+            stored_glyph glyph;
+            std::vector<uint8_t> data;  ///< Encoded bitmap
+        };
+
+        [[nodiscard]] static key make_key(const void* font, char32_t codepoint, float size) noexcept;
+        [[nodiscard]] static std::size_t charge(const entry& e) noexcept;
+
+        /// Drop least recently used entries until within the budget
+        void trim_locked();
+
+        mutable std::mutex m_mutex;
+        std::list<entry> m_lru;  ///< Most recently used first
+        std::unordered_map<key, std::list<entry>::iterator, key_hash> m_index;
+        std::size_t m_budget;
+        glyph_store_encoding m_encoding;
+        std::size_t m_bytes = 0;
+        std::size_t m_raw_bytes = 0;
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+        uint64_t m_evictions = 0;
+    };
+} // namespace onyx_font
@@ -0,0 +1,192 @@
+/**
+ * @file layout_cache.hh
+ * @brief Cache of measured and positioned strings for text_renderer.
+ *
+ * Immediate-mode UIs measure and draw the same labels every frame, and
+ * each call walks the string, decodes UTF-8, looks up kerning and glyphs.
+ * A layout_cache stores the result per string: its extents and its glyph
+ * quads relative to the origin. On a repeated call text_renderer hashes
+ * the string, finds the entry and replays the quads at the new position.
+ *
+ * @section layout_cache_usage Usage
+ *
+ * @code{.cpp}
+ * text_renderer renderer(cache);
+ * renderer.set_layout_cache(std::make_shared<layout_cache>(1024));
+ *
+ * // Every frame: after the first, a lookup and a copy of quads
+ * renderer.draw("File", 10, 10, blit);
+ * renderer.draw_wrapped(tooltip, box, text_align::left, blit);
+ * @endcode
+ *
+ * @section layout_cache_validity Validity
+ *
+ * Entries are keyed by the text, the glyph cache, the font, the size,
+ * the wrap width and the alignment. Quads are only replayed while the
+ * glyph cache's generation() equals the one they were laid out at, so a
+ * cleared or grown cache re-lays the string out. Replayed draws do not
+ * go through glyph_cache::get() and are not seen by
+ * glyph_cache_config::usage.
+ *
+ * Not thread-safe. Call clear() after destroying a glyph_cache the
+ * layout cache has served, as its address may be reused.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/text/types.hh>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Kind of layout stored in a layout_cache entry.
+     */
+    enum class layout_kind : uint8_t {
+        measure,          ///< text_renderer::measure()
+        measure_wrapped,  ///< text_renderer::measure_wrapped()
+        line,             ///< Single line, as drawn by draw() / draw_batched()
+        wrapped           ///< Wrapped lines, as drawn by draw_wrapped()
+    };
+
+    /**
+     * @brief Identifies one layout of a string.
+     */
+    struct layout_key {
+        std::string_view text;
+        const void* cache = nullptr;      ///< Glyph cache the layout belongs to
+        const void* font = nullptr;       ///< font_source::font_identity()
+        float size = 0;                   ///< Pixel size
+        float wrap_width = 0;             ///< Line width for wrapped kinds, else 0
+        text_align align = text_align::left;
+        layout_kind kind = layout_kind::line;
+
+        bool operator==(const layout_key&) const = default;
+    };
+
+    /**
+     * @brief Hash of a layout_key (text contents and every field).
+     */
+    struct ONYX_FONT_EXPORT layout_key_hash {
+        std::size_t operator()(const layout_key& key) const noexcept;
+    };
+
+    /**
+     * @brief Stored layout of a string.
+     *
+     * Quad positions are relative to the draw origin (top-left of the
+     * text or of the wrapping box).
+     */
+    struct layout_entry {
+        text_extents extents;               ///< Result of the measure kinds
+        float width = 0;                    ///< Advance width (line kind)
+        uint64_t generation = 0;            ///< Glyph cache generation of the quads
+        std::vector<glyph_quad> quads;      ///< Visible glyphs in draw order
+        std::vector<std::size_t> line_ends; ///< End of each line in quads (wrapped kind)
+    };
+
+    /**
+     * @brief Bounded LRU cache of string layouts.
+     */
+    class ONYX_FONT_EXPORT layout_cache {
+    public:
+        /// Default number of layouts held
+        static constexpr std::size_t default_capacity = 1024;
+
+        /**
+         * @brief Create an empty cache.
+         * @param capacity Maximum number of layouts held
+         */
+        explicit layout_cache(std::size_t capacity = default_capacity) noexcept
+            : m_capacity(capacity) {
+        }
+
+        layout_cache(const layout_cache&) = delete;
+        layout_cache& operator=(const layout_cache&) = delete;
+
+        /**
+         * @brief Look up a layout.
+         *
+         * Counts a hit or a miss.
+         *
+         * @param key Layout identity
+         * @param generation Required layout_entry::generation; std::nullopt
+         *                   accepts any (for the measure kinds)
+         * @return Entry, valid until the next insert() or clear(); nullptr
+         *         if absent or stale
+         */
+        [[nodiscard]] const layout_entry* find(const layout_key& key,
+                                               std::optional<uint64_t> generation = std::nullopt);
+
+        /**
+         * @brief Add (or reset) the entry of a layout.
+         *
+         * May drop the least recently used layout.
+         *
+         * @param key Layout identity
+         * @return Empty entry to fill, valid until the next insert() or
+         *         clear(); nullptr if the capacity is 0
+         */
+        layout_entry* insert(const layout_key& key);
+
+        /**
+         * @brief Drop every layout. Counters are kept.
+         */
+        void clear();
+
+        /**
+         * @brief Get the capacity.
+         * @return Maximum number of layouts held
+         */
+        [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+
+        /**
+         * @brief Get the number of layouts held.
+         * @return Layout count
+         */
+        [[nodiscard]] std::size_t size() const noexcept { return m_lru.size(); }
+
+        /**
+         * @brief Get the number of lookups that found a usable layout.
+         * @return Hit count
+         */
+        [[nodiscard]] uint64_t hits() const noexcept { return m_hits; }
+
+        /**
+         * @brief Get the number of lookups that had to lay the text out.
+         * @return Miss count
+         */
+        [[nodiscard]] uint64_t misses() const noexcept { return m_misses; }
+
+    private:
+        struct node {
+            std::size_t hash = 0;
+            std::string text;
+            const void* cache = nullptr;
+            const void* font = nullptr;
+            float size = 0;
+            float wrap_width = 0;
+            text_align align = text_align::left;
+            layout_kind kind = layout_kind::line;
+            layout_entry entry;
+
+            [[nodiscard]] bool matches(const layout_key& key) const noexcept;
+        };
+
+        std::size_t m_capacity;
+        std::list<node> m_lru;  ///< Most recently used first
+        std::unordered_multimap<std::size_t, std::list<node>::iterator> m_index;
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+    };
+} // namespace onyx_font
@@ -0,0 +1,256 @@
+/**
+ * @file resizable_cache.hh
+ * @brief Glyph cache whose size changes without stalling the caller.
+ *
+ * Changing the size (or DPI scale) of a glyph_cache means creating a new
+ * cache, and every glyph on screen is then rasterized again on the first
+ * frame that draws it. resizable_glyph_cache builds the cache for the new
+ * size on a worker instead, seeded with every codepoint resident in the
+ * current cache. The current cache keeps serving get(), measure() and
+ * metrics() until poll() swaps the finished cache in, so everything a
+ * frame queries comes from one size.
+ *
+ * @section resizable_cache_usage Usage
+ *
+ * @code{.cpp}
+ * resizable_glyph_cache<memory_atlas> fonts(
+ *     [&font] { return font_source::from_ttf(font); }, 16.0f);
+ *
+ * // On a size or DPI change
+ * fonts.resize(16.0f * dpi_scale);
+ *
+ * // Every frame, before drawing
+ * if (fonts.poll()) {
+ *     renderer = text_renderer(fonts.active());  // new cache, new atlas
+ * }
+ * draw_ui(fonts.active());
+ * @endcode
+ *
+ * A source factory is taken instead of a font_source because each build
+ * needs its own (a TTF font_source owns per-font rasterizer state); it
+ * runs on the worker.
+ *
+ * With config.budget, the cache under construction stays outside the
+ * budget and joins it when poll() swaps it in, so evictions only run on
+ * the owning thread.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/text/glyph_cache.hh>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Double-buffered glyph_cache with background size changes.
+     *
+     * All members must be called from the thread owning the object; only
+     * the build of the next cache runs elsewhere. The destructor waits for
+     * a build started without an executor.
+     *
+     * @tparam Surface Atlas surface type constructible from (width, height)
+     */
+    template<sized_atlas_surface Surface>
+    class resizable_glyph_cache {
+    public:
+        using cache_type = glyph_cache<Surface>;
+
+        /// Creates a font_source for each cache (called on the build thread)
+        using source_factory = std::function<font_source()>;
+
+        /// Runs a build job (thread pool, task system, ...)
+        using executor = std::function<void(std::function<void()>)>;
+
+        /**
+         * @brief Create the cache for an initial size.
+         *
+         * The first cache is built synchronously.
+         *
+         * @param make_source Source factory
+         * @param size Initial pixel size
+         * @param config Configuration of every cache
+         * @param exec Executor for builds; empty uses std::async
+         * @throws std::invalid_argument if make_source is empty
+         */
+        resizable_glyph_cache(source_factory make_source, float size,
+                              glyph_cache_config config = {}, executor exec = {})
+            : m_make_source(std::move(make_source))
+              , m_config(std::move(config))
+              , m_executor(std::move(exec)) {
+            if (!m_make_source) {
+                throw std::invalid_argument("font source factory is empty");
+            }
+            m_active = std::make_unique<cache_type>(m_make_source(), size, m_config);
+        }
+
+        resizable_glyph_cache(const resizable_glyph_cache&) = delete;
+        resizable_glyph_cache& operator=(const resizable_glyph_cache&) = delete;
+
+        /**
+         * @brief Get the cache serving the current size.
+         *
+         * The reference stays valid until poll() or finish() swaps.
+         *
+         * @return Active cache
+         */
+        [[nodiscard]] cache_type& active() noexcept { return *m_active; }
+
+        /// @copydoc active()
+        [[nodiscard]] const cache_type& active() const noexcept { return *m_active; }
+
+        /**
+         * @brief Get the size of the active cache.
+         * @return Pixel size
+         */
+        [[nodiscard]] float size() const noexcept { return m_active->rasterizer().size(); }
+
+        /**
+         * @brief Get the size the cache will have once builds complete.
+         * @return Latest requested size
+         */
+        [[nodiscard]] float target_size() const noexcept {
+            if (m_queued_size) return *m_queued_size;
+            if (m_build.valid()) return m_build_size;
+            return size();
+        }
+
+        /**
+         * @brief Check whether a build is in flight.
+         * @return true until the last requested size is active
+         */
+        [[nodiscard]] bool resizing() const noexcept { return m_build.valid(); }
+
+        /**
+         * @brief Get the number of swaps so far.
+         *
+         * Objects holding a reference to active() (e.g. text_renderer)
+         * must be recreated when this changes.
+         *
+         * @return Swap count
+         */
+        [[nodiscard]] uint64_t generation() const noexcept { return m_generation; }
+
+        /**
+         * @brief Request a new size.
+         *
+         * Starts a build seeded with the active cache's codepoints. While
+         * a build is in flight, only the latest request is kept and built
+         * after it.
+         *
+         * @param new_size Pixel size
+         */
+        void resize(float new_size) {
+            if (new_size == target_size()) {
+                return;
+            }
+            if (m_build.valid()) {
+                m_queued_size = new_size;
+                return;
+            }
+            start_build(new_size);
+        }
+
+        /**
+         * @brief Swap in a finished build. Call once per frame.
+         *
+         * Glyphs the active cache gained during the build are added to
+         * the new cache before the swap.
+         *
+         * @return true if the active cache changed
+         * @throws Any exception thrown by the build; the active cache is
+         *         kept
+         */
+        bool poll() {
+            if (!m_build.valid() ||
+                m_build.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return false;
+            }
+            std::unique_ptr<cache_type> next;
+            try {
+                next = m_build.get();
+            } catch (...) {
+                m_queued_size.reset();
+                throw;
+            }
+            swap_in(std::move(next));
+            return true;
+        }
+
+        /**
+         * @brief Wait for all requested sizes and swap in the last one.
+         * @return true if the active cache changed
+         */
+        bool finish() {
+            bool swapped = false;
+            while (m_build.valid()) {
+                m_build.wait();
+                swapped |= poll();
+            }
+            return swapped;
+        }
+
+    private:
+        source_factory m_make_source;
+        glyph_cache_config m_config;
+        executor m_executor;
+
+        std::unique_ptr<cache_type> m_active;
+        std::future<std::unique_ptr<cache_type>> m_build;
+        float m_build_size = 0.0f;
+        std::optional<float> m_queued_size;
+        uint64_t m_generation = 0;
+
+        void start_build(float new_size) {
+            // The job owns everything it touches, so the owner may keep
+            // using (or growing) the active cache meanwhile. The new cache
+            // joins the shared budget in swap_in(): registered here, its
+            // growth would evict the owner's caches from the build thread.
+            glyph_cache_config config = m_config;
+            config.budget.reset();
+            auto job = [make_source = m_make_source, config = std::move(config), new_size,
+                        seed = m_active->cached_codepoints()] {
+                auto next = std::make_unique<cache_type>(make_source(), new_size, config);
+                next->cache_codepoints(seed);
+                return next;
+            };
+
+            m_build_size = new_size;
+            if (m_executor) {
+                auto task = std::make_shared<std::packaged_task<std::unique_ptr<cache_type>()>>(std::move(job));
+                m_build = task->get_future();
+                m_executor(std::function<void()>([task] { (*task)(); }));
+            } else {
+                m_build = std::async(std::launch::async, std::move(job));
+            }
+        }
+
+        void swap_in(std::unique_ptr<cache_type> next) {
+            auto seed = m_active->cached_codepoints();
+            m_active = std::move(next);  // the old cache leaves the budget first
+            if (m_config.budget) {
+                m_active->set_budget(m_config.budget, m_config.budget_name);
+            }
+            m_active->cache_codepoints(seed);
+            ++m_generation;
+
+            if (m_queued_size) {
+                float queued = *m_queued_size;
+                m_queued_size.reset();
+                if (queued != size()) {
+                    start_build(queued);
+                }
+            }
+        }
+    };
+} // namespace onyx_font
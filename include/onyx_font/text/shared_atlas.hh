@@ -0,0 +1,250 @@
+/**
+ * @file shared_atlas.hh
+ * @brief Glyph atlas shared between processes through named shared memory.
+ *
+ * When several processes on a host render with the same font and size,
+ * each glyph_cache rasterizes and stores an identical atlas.
+ * shared_glyph_atlas places the atlas pages and the glyph table in a named
+ * POSIX shared-memory region instead: the first process to need a glyph
+ * rasterizes it, and every other process attached to the region reuses it.
+ *
+ * @section shared_atlas_design Design
+ *
+ * @code
+ * +-----------+----------------------+----------+----------+-----+
+ * | header    | glyph table          | page 0   | page 1   | ... |
+ * | (atomics) | (open addressing)    | (R8)     | (R8)     |     |
+ * +-----------+----------------------+----------+----------+-----+
+ * @endcode
+ *
+ * - **Glyph table**: lock-free open addressing. A process claims a slot by
+ *   CAS-ing the codepoint and its lease into it, rasterizes, then publishes
+ *   the entry with a release store. Readers that find a claimed but
+ *   unpublished slot wait for it; if the claiming attachment is gone, the
+ *   slot is taken over.
+ * - **Leases**: every attachment draws a lease number from the header and
+ *   holds a write lock on that byte of the shared-memory object for as long
+ *   as it is mapped. The kernel drops the lock when the attachment closes or
+ *   its process dies, so liveness does not depend on pids: it works across
+ *   PID namespaces (containers sharing /dev/shm) and is not fooled by
+ *   recycled pids. On Linux these are open file description locks; where
+ *   those are missing, classic record locks are used, which belong to the
+ *   whole process - attach to a region at most once per process there.
+ * - **Region allocator**: a row packer whose whole state (page, x, y, row
+ *   height) lives in one 64-bit atomic updated by CAS, so concurrent
+ *   allocations from different processes never overlap.
+ * - **Validation**: the header records the atlas geometry and a fingerprint
+ *   of the font and size; attaching with a different font throws.
+ *
+ * Only POSIX systems are supported (shm_open/mmap). A named object is used
+ * rather than memfd because unrelated processes must find the region by
+ * name.
+ *
+ * shared_glyph_atlas is a standalone cache, not a glyph_cache surface: it
+ * cannot back glyph_cache or text_renderer, so kerning, wrapping, layout
+ * caching and layer batching are not available for it. Callers lay out
+ * text themselves from get() and rasterizer(), as in the example below.
+ *
+ * @section shared_atlas_usage Usage
+ *
+ * @code{.cpp}
+ * // In every renderer process
+ * shared_glyph_atlas atlas("/myapp_arial_24", font_source::from_ttf(font), 24.0f);
+ *
+ * float x = 10.0f;
+ * for (char32_t cp : utf8_view("Hello")) {
+ *     cached_glyph g = atlas.get(cp);  // rasterized by whichever process came first
+ *     draw_quad(atlas.page_data(g.atlas_index), g.rect,
+ *               x + g.bearing_x, baseline - g.bearing_y);
+ *     x += g.advance_x;
+ * }
+ *
+ * // When the last user is done
+ * shared_glyph_atlas::remove("/myapp_arial_24");
+ * @endcode
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/text/glyph_cache.hh>
+#include <onyx_font/text/text_rasterizer.hh>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace onyx_font {
+    /**
+     * @brief Geometry of a shared glyph atlas.
+     *
+     * All processes attaching to the same region must use the same values;
+     * the creator's configuration is stored in the region and checked.
+     */
+    struct shared_atlas_config {
+        int atlas_size = 512;       ///< Page size in pixels (square)
+        int max_pages = 4;          ///< Pages reserved in the region
+        int padding = 1;            ///< Pixels between glyphs
+        int table_capacity = 4096;  ///< Glyph slots (rounded up to a power of two)
+    };
+
+    /**
+     * @brief Glyph atlas living in named shared memory.
+     *
+     * The atlas is fixed-size: pages are reserved when the region is
+     * created. get() throws std::length_error once the pages or the glyph
+     * table are exhausted.
+     *
+     * All member functions are safe to call concurrently from several
+     * processes. Within one process, an instance may be shared between
+     * threads as well, since all shared state is accessed atomically.
+     */
+    class ONYX_FONT_EXPORT shared_glyph_atlas {
+    public:
+        /**
+         * @brief Create or attach to a named shared atlas.
+         *
+         * @param name Shared-memory object name (e.g. "/app_font_24")
+         * @param source Font used to rasterize missing glyphs (moves ownership)
+         * @param size Pixel height for rasterization
+         * @param config Atlas geometry
+         * @throws std::runtime_error if the region cannot be created, is
+         *         incompatible, or shared memory is unavailable
+         */
+        shared_glyph_atlas(const std::string& name, font_source source, float size,
+                           shared_atlas_config config = {});
+
+        ~shared_glyph_atlas();
+
+        shared_glyph_atlas(const shared_glyph_atlas&) = delete;
+        shared_glyph_atlas& operator=(const shared_glyph_atlas&) = delete;
+        shared_glyph_atlas(shared_glyph_atlas&& other) noexcept;
+        shared_glyph_atlas& operator=(shared_glyph_atlas&& other) noexcept;
+
+        /**
+         * @brief Remove a named region.
+         *
+         * Processes still attached keep their mapping; new instances will
+         * create a fresh region.
+         *
+         * @param name Shared-memory object name
+         * @return true if the object existed and was removed
+         */
+        static bool remove(const std::string& name) noexcept;
+
+        /**
+         * @brief Get a glyph, rasterizing it if no process has yet.
+         *
+         * @param codepoint Unicode codepoint
+         * @return Glyph placement (atlas_index is the page index)
+         * @throws std::length_error if the atlas or glyph table is full
+         */
+        cached_glyph get(char32_t codepoint);
+
+        /**
+         * @brief Check whether a glyph is published in the shared table.
+         *
+         * @param codepoint Unicode codepoint
+         * @return true if any process has cached the glyph
+         */
+        [[nodiscard]] bool is_cached(char32_t codepoint) const noexcept;
+
+        /**
+         * @brief Pre-cache a range of characters.
+         *
+         * @param first First codepoint (inclusive)
+         * @param last Last codepoint (inclusive)
+         */
+        void cache_range(char32_t first, char32_t last);
+
+        /**
+         * @brief Pre-cache all characters in a string.
+         *
+         * @param utf8_text UTF-8 encoded text
+         */
+        void cache_string(std::string_view utf8_text);
+
+        /**
+         * @brief Get number of pages that contain glyphs.
+         * @return Used page count
+         */
+        [[nodiscard]] int page_count() const noexcept;
+
+        /**
+         * @brief Get page size.
+         * @return Page width and height in pixels
+         */
+        [[nodiscard]] int page_size() const noexcept;
+
+        /**
+         * @brief Access page pixels.
+         *
+         * Pixels of a glyph are complete once get() or is_cached() has
+         * observed it as published.
+         *
+         * @param index Page index (0 to the configured max_pages - 1)
+         * @return Pointer to page_size() x page_size() 8-bit pixels
+         * @throws std::out_of_range if index is invalid
+         */
+        [[nodiscard]] const uint8_t* page_data(int index) const;
+
+        /**
+         * @brief Get number of glyphs published by all processes.
+         * @return Glyph count
+         */
+        [[nodiscard]] int glyph_count() const noexcept;
+
+        /**
+         * @brief Check whether this instance created the region.
+         * @return true for the creating process
+         */
+        [[nodiscard]] bool is_creator() const noexcept { return m_creator; }
+
+        /**
+         * @brief Get the underlying rasterizer.
+         * @return Reference to text rasterizer
+         */
+        [[nodiscard]] const text_rasterizer& rasterizer() const noexcept {
+            return m_rasterizer;
+        }
+
+        /**
+         * @brief Measure text (delegates to rasterizer).
+         *
+         * @param text UTF-8 encoded text
+         * @return Text extents
+         */
+        [[nodiscard]] text_extents measure(std::string_view text) const {
+            return m_rasterizer.measure_text(text);
+        }
+
+        /**
+         * @brief Get font metrics.
+         * @return Scaled font metrics
+         */
+        [[nodiscard]] scaled_metrics metrics() const {
+            return m_rasterizer.get_metrics();
+        }
+
+        /**
+         * @brief Get line height.
+         * @return Line height in pixels
+         */
+        [[nodiscard]] float line_height() const {
+            return m_rasterizer.line_height();
+        }
+
+    private:
+        text_rasterizer m_rasterizer;
+        void* m_base = nullptr;
+        std::size_t m_mapped_size = 0;
+        int m_fd = -1;          ///< Shared-memory descriptor holding the lease lock
+        uint32_t m_lease = 0;   ///< Lease of this attachment, stored in its claims
+        bool m_creator = false;
+
+        void unmap() noexcept;
+    };
+} // namespace onyx_font
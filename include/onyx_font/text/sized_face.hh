@@ -0,0 +1,175 @@
+/**
+ * @file sized_face.hh
+ * @brief Font face bound to one pixel size, with cached size-dependent data.
+ *
+ * Every size-based font_source query recomputes the scale from font units
+ * to pixels, and for TTF fonts re-reads the font tables. Text layout asks
+ * the same questions thousands of times at a single size, so sized_face
+ * answers them from values computed once per (face, size):
+ *
+ * - the scale factor
+ * - scaled font metrics and line height
+ * - metrics (advance, bearings, box) of the printable ASCII glyphs
+ *
+ * Everything else (non-ASCII glyphs, kerning) is forwarded to the font with
+ * the cached scale.
+ *
+ * @section sized_face_usage Usage
+ *
+ * @code{.cpp}
+ * auto source = font_source::from_ttf(font);
+ * sized_face face(source, 24.0f);
+ *
+ * float pen_x = 0;
+ * char32_t prev = 0;
+ * for (char32_t cp : utf8_view("Hello")) {
+ *     if (prev) pen_x += face.kerning(prev, cp);
+ *     pen_x += face.advance(cp);  // table lookup for ASCII
+ *     prev = cp;
+ * }
+ * float line = face.line_height();
+ * @endcode
+ *
+ * text_rasterizer owns a sized_face for its current size, so glyph_cache,
+ * text_renderer and font_converter use it implicitly.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/text/types.hh>
+#include <onyx_font/text/font_source.hh>
+#include <array>
+
+namespace onyx_font {
+    /**
+     * @brief Font source at a fixed pixel size.
+     *
+     * Holds a pointer to its font_source: the source must outlive the face
+     * and, if it is moved or copied, the face must be rebind()-ed to the
+     * new object. All queries are const and the face is immutable after
+     * construction, so it can be read from several threads.
+     */
+    class ONYX_FONT_EXPORT sized_face {
+    public:
+        /// First codepoint with precomputed glyph metrics
+        static constexpr char32_t cached_first = 32;
+
+        /// Last codepoint with precomputed glyph metrics
+        static constexpr char32_t cached_last = 126;
+
+        /**
+         * @brief Compute the size-dependent data for a font.
+         *
+         * @param source Font source (must outlive the face)
+         * @param size Pixel height (ignored by bitmap fonts)
+         */
+        sized_face(const font_source& source, float size);
+
+        /**
+         * @brief Point the face at a font source moved from the original.
+         *
+         * The cached values depend only on the underlying font, which a
+         * moved font_source still refers to.
+         *
+         * @param source New location of the font source
+         */
+        void rebind(const font_source& source) noexcept { m_source = &source; }
+
+        /**
+         * @brief Get the font source.
+         * @return Reference to the font source
+         */
+        [[nodiscard]] const font_source& source() const noexcept { return *m_source; }
+
+        /**
+         * @brief Get the pixel size.
+         * @return Pixel height the face was created for
+         */
+        [[nodiscard]] float size() const noexcept { return m_size; }
+
+        /**
+         * @brief Get the scale from font units to pixels.
+         *
+         * Font units are design units for TTF fonts and native pixels for
+         * vector fonts; bitmap fonts always have scale 1.
+         *
+         * @return Scale factor
+         */
+        [[nodiscard]] float scale() const noexcept { return m_scale; }
+
+        /**
+         * @brief Get font metrics at this size.
+         *
+         * Bitmap fonts report their native metrics.
+         *
+         * @return Scaled font metrics
+         */
+        [[nodiscard]] const scaled_metrics& metrics() const noexcept { return m_metrics; }
+
+        /**
+         * @brief Get line height at this size.
+         * @return Line height in pixels
+         */
+        [[nodiscard]] float line_height() const noexcept { return m_metrics.line_height; }
+
+        /**
+         * @brief Get glyph metrics at this size.
+         *
+         * Served from the table for cached_first..cached_last.
+         *
+         * @param codepoint Unicode codepoint
+         * @return Glyph metrics (zero for missing glyphs without fallback)
+         */
+        [[nodiscard]] glyph_metrics get_glyph_metrics(char32_t codepoint) const {
+            if (codepoint >= cached_first && codepoint <= cached_last) {
+                return m_ascii[codepoint - cached_first];
+            }
+            return m_source->get_glyph_metrics_at_scale(codepoint, m_scale);
+        }
+
+        /**
+         * @brief Get horizontal advance of a glyph.
+         *
+         * @param codepoint Unicode codepoint
+         * @return Advance in pixels
+         */
+        [[nodiscard]] float advance(char32_t codepoint) const {
+            return get_glyph_metrics(codepoint).advance_x;
+        }
+
+        /**
+         * @brief Get kerning between two codepoints at this size.
+         *
+         * @param first First codepoint
+         * @param second Second codepoint
+         * @return Kerning adjustment (add to advance_x)
+         */
+        [[nodiscard]] float kerning(char32_t first, char32_t second) const {
+            if (!m_has_kerning) {
+                return 0.0f;
+            }
+            return m_source->get_kerning_at_scale(first, second, m_scale);
+        }
+
+        /**
+         * @brief Check whether the font can have kerning.
+         *
+         * False for bitmap and vector fonts, whose kerning is always zero.
+         *
+         * @return true if kerning() may return non-zero values
+         */
+        [[nodiscard]] bool has_kerning() const noexcept { return m_has_kerning; }
+
+    private:
+        const font_source* m_source;
+        float m_size;
+        float m_scale;
+        bool m_has_kerning;
+        scaled_metrics m_metrics;
+        std::array<glyph_metrics, cached_last - cached_first + 1> m_ascii{};
+    };
+} // namespace onyx_font
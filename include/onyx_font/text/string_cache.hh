@@ -0,0 +1,384 @@
+/**
+ * @file string_cache.hh
+ * @brief Cache of whole strings rendered into their own alpha images.
+ *
+ * Even with batching, a label costs one quad per glyph every frame, with
+ * overlapping quads blended one by one. Labels that never change (menu
+ * entries, button captions, axis titles) can instead be composed once
+ * from the glyph atlas into a single alpha image and drawn as one quad.
+ * string_texture_cache keeps such images, keyed like layout_cache entries
+ * (text, glyph cache, font, size, wrap width, alignment), and drops the
+ * least recently used ones beyond its capacity.
+ *
+ * @section string_cache_usage Usage
+ *
+ * @code{.cpp}
+ * string_texture_cache<memory_atlas> labels(256);
+ *
+ * // Every frame
+ * labels.draw(cache, "Settings", 10, 10,
+ *     [&](const rendered_string& s, float x, float y) {
+ *         // Upload s.image once per s.id, then draw one quad
+ *         draw_textured_quad(texture_for(s), x, y, s.image.width(), s.image.height());
+ *     });
+ * @endcode
+ *
+ * @section string_cache_images Images
+ *
+ * Each image is the max-composite of the string's glyph quads, with quad
+ * positions rounded to whole pixels. rendered_string::id is unique per
+ * composition, so GPU code can key its textures by it and release them
+ * once the id is no longer returned. Strings containing glyphs that are
+ * still pending in the glyph cache (see frame_budget) are composed again
+ * on the next call until every glyph is present. Strings without visible
+ * pixels (e.g. only spaces) get an empty image and are not drawn.
+ *
+ * Not thread-safe. Call clear() after destroying a glyph_cache the
+ * string cache has served, as its address may be reused.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/text/glyph_cache.hh>
+#include <onyx_font/text/layout_cache.hh>
+#include <onyx_font/text/raster_target.hh>
+#include <onyx_font/text/text_renderer.hh>
+#include <onyx_font/text/utf8.hh>
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief A string composed into one alpha image.
+     */
+    struct rendered_string {
+        owned_grayscale_target image{0, 0};  ///< Coverage of the whole string
+        float offset_x = 0;                  ///< Image left edge relative to the draw origin
+        float offset_y = 0;                  ///< Image top edge relative to the draw origin
+        float width = 0;                     ///< Advance width (single line)
+        int lines = 0;                       ///< Number of lines
+        uint64_t id = 0;                     ///< Unique per composition
+    };
+
+    /**
+     * @brief Concept for callbacks drawing a rendered string.
+     *
+     * The callback signature is:
+     * `void callback(const rendered_string& s, float dst_x, float dst_y)`
+     * where (dst_x, dst_y) is the top-left of s.image.
+     */
+    template<typename F>
+    concept rendered_string_callback = requires(F func, const rendered_string& s, float dst_x, float dst_y)
+    {
+        { func(s, dst_x, dst_y) } -> std::same_as<void>;
+    };
+
+    /**
+     * @brief Bounded LRU cache of strings rendered into alpha images.
+     *
+     * One cache may serve several glyph caches; the glyph cache is part of
+     * every key.
+     *
+     * @tparam Surface Atlas surface type whose pixels can be read back
+     */
+    template<readable_atlas_surface Surface>
+    class string_texture_cache {
+    public:
+        /// Default number of strings held
+        static constexpr std::size_t default_capacity = 256;
+
+        /**
+         * @brief Create an empty cache.
+         *
+         * @param capacity Maximum number of strings held (at least 1)
+         * @param max_bytes Maximum total image size in bytes; 0 is unlimited.
+         *                  The most recent string is always kept.
+         */
+        explicit string_texture_cache(std::size_t capacity = default_capacity,
+                                      std::size_t max_bytes = 0) noexcept
+            : m_capacity(std::max<std::size_t>(capacity, 1))
+              , m_max_bytes(max_bytes) {
+        }
+
+        string_texture_cache(const string_texture_cache&) = delete;
+        string_texture_cache& operator=(const string_texture_cache&) = delete;
+
+        /**
+         * @brief Get a single line of text as one image, composing it on a miss.
+         *
+         * @param cache Glyph cache providing the glyphs
+         * @param text UTF-8 text
+         * @return Rendered string, valid until the next get, draw or clear()
+         */
+        const rendered_string& get(glyph_cache<Surface>& cache, std::string_view text) {
+            return lookup(cache, make_key(cache, text, layout_kind::line, 0.0f, text_align::left));
+        }
+
+        /**
+         * @brief Get word-wrapped text as one image, composing it on a miss.
+         *
+         * Lines are wrapped and aligned as text_renderer::draw_wrapped()
+         * does within a box of @p width.
+         *
+         * @param cache Glyph cache providing the glyphs
+         * @param text UTF-8 text
+         * @param width Line width
+         * @param align Horizontal alignment of each line
+         * @return Rendered string, valid until the next get, draw or clear()
+         */
+        const rendered_string& get_wrapped(glyph_cache<Surface>& cache, std::string_view text,
+                                           float width, text_align align = text_align::left) {
+            return lookup(cache, make_key(cache, text, layout_kind::wrapped, width, align));
+        }
+
+        /**
+         * @brief Draw a single line of text as one image.
+         *
+         * @tparam DrawFn Rendered string callback type
+         * @param cache Glyph cache providing the glyphs
+         * @param text UTF-8 text
+         * @param x X position
+         * @param y Y position (top of text, as text_renderer::draw())
+         * @param draw_fn Callback receiving the image and its top-left
+         * @return Width of the text
+         */
+        template<rendered_string_callback DrawFn>
+        float draw(glyph_cache<Surface>& cache, std::string_view text, float x, float y, DrawFn&& draw_fn) {
+            const rendered_string& s = get(cache, text);
+            if (s.image.width() > 0 && s.image.height() > 0) {
+                draw_fn(s, x + s.offset_x, y + s.offset_y);
+            }
+            return s.width;
+        }
+
+        /**
+         * @brief Draw word-wrapped text as one image.
+         *
+         * Unlike text_renderer::draw_wrapped(), lines are not clipped to
+         * a box height.
+         *
+         * @tparam DrawFn Rendered string callback type
+         * @param cache Glyph cache providing the glyphs
+         * @param text UTF-8 text
+         * @param x Left edge of the wrapping box
+         * @param y Top edge of the wrapping box
+         * @param width Line width
+         * @param align Horizontal alignment of each line
+         * @param draw_fn Callback receiving the image and its top-left
+         * @return Number of lines
+         */
+        template<rendered_string_callback DrawFn>
+        int draw_wrapped(glyph_cache<Surface>& cache, std::string_view text, float x, float y,
+                         float width, text_align align, DrawFn&& draw_fn) {
+            const rendered_string& s = get_wrapped(cache, text, width, align);
+            if (s.image.width() > 0 && s.image.height() > 0) {
+                draw_fn(s, x + s.offset_x, y + s.offset_y);
+            }
+            return s.lines;
+        }
+
+        /**
+         * @brief Drop every string. Counters are kept.
+         */
+        void clear() {
+            m_index.clear();
+            m_lru.clear();
+            m_bytes = 0;
+        }
+
+        /**
+         * @brief Get the capacity.
+         * @return Maximum number of strings held
+         */
+        [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+
+        /**
+         * @brief Get the number of strings held.
+         * @return String count
+         */
+        [[nodiscard]] std::size_t size() const noexcept { return m_lru.size(); }
+
+        /**
+         * @brief Get the total size of the held images.
+         * @return Bytes of alpha pixels
+         */
+        [[nodiscard]] std::size_t memory_bytes() const noexcept { return m_bytes; }
+
+        /**
+         * @brief Get the number of lookups served from the cache.
+         * @return Hit count
+         */
+        [[nodiscard]] uint64_t hits() const noexcept { return m_hits; }
+
+        /**
+         * @brief Get the number of lookups that composed the string.
+         * @return Miss count
+         */
+        [[nodiscard]] uint64_t misses() const noexcept { return m_misses; }
+
+    private:
+        struct entry {
+            std::string text;       ///< Owned text viewed by key.text
+            layout_key key;
+            rendered_string value;
+            bool complete = false;  ///< No glyph was pending when composed
+        };
+
+        using lru_list = std::list<entry>;
+
+        std::size_t m_capacity;
+        std::size_t m_max_bytes;
+        std::size_t m_bytes = 0;
+        lru_list m_lru;  ///< Most recently used first
+        std::unordered_map<layout_key, typename lru_list::iterator, layout_key_hash> m_index;
+        std::vector<glyph_quad> m_quads;  ///< Reused layout buffer
+        uint64_t m_next_id = 1;
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+
+        [[nodiscard]] static layout_key make_key(const glyph_cache<Surface>& cache, std::string_view text,
+                                                 layout_kind kind, float wrap_width,
+                                                 text_align align) noexcept {
+            layout_key key;
+            key.text = text;
+            key.cache = &cache;
+            key.font = cache.rasterizer().source().font_identity();
+            key.size = cache.rasterizer().size();
+            key.wrap_width = wrap_width;
+            key.align = align;
+            key.kind = kind;
+            return key;
+        }
+
+        [[nodiscard]] static std::size_t image_bytes(const rendered_string& s) noexcept {
+            return static_cast<std::size_t>(s.image.width()) * static_cast<std::size_t>(s.image.height());
+        }
+
+        const rendered_string& lookup(glyph_cache<Surface>& cache, const layout_key& key) {
+            if (auto it = m_index.find(key); it != m_index.end()) {
+                entry& e = *it->second;
+                m_lru.splice(m_lru.begin(), m_lru, it->second);
+                if (e.complete) {
+                    ++m_hits;
+                    cache.touch();
+                    return e.value;
+                }
+                ++m_misses;
+                m_bytes -= image_bytes(e.value);
+                compose(cache, e);
+                m_bytes += image_bytes(e.value);
+                evict();
+                return e.value;
+            }
+
+            ++m_misses;
+            m_lru.emplace_front();
+            entry& e = m_lru.front();
+            e.text.assign(key.text);
+            e.key = key;
+            e.key.text = e.text;
+            compose(cache, e);
+            m_bytes += image_bytes(e.value);
+            m_index.emplace(e.key, m_lru.begin());
+            evict();
+            return e.value;
+        }
+
+        /// Drop least recently used strings beyond the limits, keeping the newest
+        void evict() {
+            while (m_lru.size() > 1 &&
+                   (m_lru.size() > m_capacity || (m_max_bytes != 0 && m_bytes > m_max_bytes))) {
+                entry& victim = m_lru.back();
+                m_bytes -= image_bytes(victim.value);
+                m_index.erase(victim.key);
+                m_lru.pop_back();
+            }
+        }
+
+        /// Lay the string out and compose its glyphs into e.value
+        void compose(glyph_cache<Surface>& cache, entry& e) {
+            text_renderer<Surface> renderer(cache);
+            m_quads.clear();
+            auto collect = [this](std::span<const glyph_quad> quads) {
+                m_quads.insert(m_quads.end(), quads.begin(), quads.end());
+            };
+
+            rendered_string& s = e.value;
+            if (e.key.kind == layout_kind::wrapped) {
+                text_box box{0.0f, 0.0f, e.key.wrap_width, std::numeric_limits<float>::max()};
+                s.lines = renderer.draw_wrapped_batched(e.text, box, e.key.align, collect);
+                s.width = 0.0f;
+            } else {
+                s.width = renderer.draw_batched(e.text, 0.0f, 0.0f, collect);
+                s.lines = e.text.empty() ? 0 : 1;
+            }
+
+            e.complete = true;
+            for (char32_t codepoint : utf8_view(e.text)) {
+                if (cache.is_pending(codepoint)) {
+                    e.complete = false;
+                    break;
+                }
+            }
+
+            s.id = m_next_id++;
+            if (m_quads.empty()) {
+                s.image = owned_grayscale_target(0, 0);
+                s.offset_x = 0.0f;
+                s.offset_y = 0.0f;
+                return;
+            }
+
+            float min_x = std::numeric_limits<float>::max();
+            float min_y = std::numeric_limits<float>::max();
+            float max_x = std::numeric_limits<float>::lowest();
+            float max_y = std::numeric_limits<float>::lowest();
+            for (const auto& q : m_quads) {
+                min_x = std::min(min_x, q.dst_x);
+                min_y = std::min(min_y, q.dst_y);
+                max_x = std::max(max_x, q.dst_x + static_cast<float>(q.src.w));
+                max_y = std::max(max_y, q.dst_y + static_cast<float>(q.src.h));
+            }
+            s.offset_x = std::floor(min_x);
+            s.offset_y = std::floor(min_y);
+            int w = static_cast<int>(std::ceil(max_x - s.offset_x));
+            int h = static_cast<int>(std::ceil(max_y - s.offset_y));
+            s.image = owned_grayscale_target(w, h);
+
+            // Max-composite: overlapping glyphs keep the stronger coverage
+            bool lit = false;
+            for (const auto& q : m_quads) {
+                const Surface& atlas = cache.atlas(q.layer);
+                int ox = static_cast<int>(std::lround(q.dst_x - s.offset_x));
+                int oy = static_cast<int>(std::lround(q.dst_y - s.offset_y));
+                for (int row = 0; row < q.src.h; ++row) {
+                    for (int col = 0; col < q.src.w; ++col) {
+                        auto alpha = static_cast<uint8_t>(atlas.pixel(q.src.x + col, q.src.y + row));
+                        if (alpha > s.image.pixel(ox + col, oy + row)) {
+                            s.image.put_pixel(ox + col, oy + row, alpha);
+                            lit = true;
+                        }
+                    }
+                }
+            }
+            if (!lit) {
+                // Blank glyphs only (e.g. spaces): nothing to draw
+                s.image = owned_grayscale_target(0, 0);
+            }
+        }
+    };
+} // namespace onyx_font
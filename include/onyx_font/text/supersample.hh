@@ -0,0 +1,246 @@
+/**
+ * @file supersample.hh
+ * @brief Multi-size glyph strikes downsampled from one reference rasterization.
+ *
+ * Zoomable UIs often need the same font at many sizes (e.g. every pixel
+ * size from 8 to 48). Rasterizing the outlines again at each size repeats
+ * the expensive work. A reference_strike rasterizes every glyph once at a
+ * large reference size and produces any smaller size by filtering the
+ * reference coverage down; glyph metrics are the reference metrics scaled
+ * by size / reference size.
+ *
+ * @section supersample_filters Filters
+ *
+ * | Filter  | Kernel                                | Character              |
+ * |---------|---------------------------------------|------------------------|
+ * | area    | Exact pixel-footprint average (box)   | Coverage-preserving    |
+ * | lanczos | Lanczos-2 scaled to the footprint     | Sharper, slight ringing|
+ *
+ * Both are separable. The vertical pass, which touches every intermediate
+ * sample, uses SSE2 when available.
+ *
+ * @section supersample_usage Usage
+ *
+ * @code{.cpp}
+ * auto strike = std::make_shared<reference_strike>(font_source::from_ttf(font), 96.0f);
+ *
+ * glyph_cache_config config;
+ * config.reference = strike;
+ *
+ * // All sizes share the reference rasterization
+ * std::vector<glyph_cache<memory_atlas>> caches;
+ * for (int px = 8; px <= 48; ++px) {
+ *     caches.emplace_back(font_source::from_ttf(font), float(px), config);
+ * }
+ * @endcode
+ *
+ * Only outline (TTF) sources are downsampled: stroke fonts draw 1-pixel
+ * lines at every size and bitmap fonts have a single size, so for them
+ * supports() is false and callers rasterize directly.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/text/types.hh>
+#include <onyx_font/text/font_source.hh>
+#include <onyx_font/text/sized_face.hh>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Reconstruction filter used when shrinking coverage.
+     */
+    enum class downsample_filter {
+        area,    ///< Box filter over each destination pixel's footprint
+        lanczos  ///< Lanczos-2 windowed sinc, widened by the scale factor
+    };
+
+    /**
+     * @brief Separable resampler for 8-bit coverage images.
+     *
+     * Keeps its weight tables and intermediate rows between calls, so a
+     * long-lived downsampler does not allocate once warm. Not thread-safe.
+     */
+    class ONYX_FONT_EXPORT alpha_downsampler {
+    public:
+        /**
+         * @brief Resample @p src into @p dst.
+         *
+         * Source pixel (u, v) covers destination area
+         * [offset_x + u*scale, offset_x + (u+1)*scale) horizontally (and
+         * likewise vertically). Samples outside the source are zero.
+         * Every destination pixel is written.
+         *
+         * @param src Source coverage (row-major)
+         * @param src_w Source width
+         * @param src_h Source height
+         * @param src_stride Source row stride in bytes
+         * @param dst Destination coverage
+         * @param dst_w Destination width
+         * @param dst_h Destination height
+         * @param dst_stride Destination row stride in bytes
+         * @param scale Destination pixels per source pixel (0 < scale <= 1)
+         * @param offset_x Destination X of the source's left edge
+         * @param offset_y Destination Y of the source's top edge
+         * @param filter Reconstruction filter
+         */
+        void resample(const uint8_t* src, int src_w, int src_h, int src_stride,
+                      uint8_t* dst, int dst_w, int dst_h, int dst_stride,
+                      float scale, float offset_x, float offset_y,
+                      downsample_filter filter = downsample_filter::area);
+
+    private:
+        /// Source taps of one destination pixel along an axis
+        struct span_weights {
+            int first = 0;
+            int count = 0;
+            std::size_t offset = 0;  ///< Index of the first weight
+        };
+
+        std::vector<span_weights> m_columns;
+        std::vector<span_weights> m_rows;
+        std::vector<float> m_weights;
+        std::vector<float> m_horizontal;  ///< src_h rows of dst_w samples
+        std::vector<float> m_row;         ///< One vertically filtered row
+    };
+
+    /**
+     * @brief Check whether the SIMD resampling path is compiled in.
+     * @return true if alpha_downsampler uses SSE2
+     */
+    [[nodiscard]] ONYX_FONT_EXPORT bool downsample_has_simd() noexcept;
+
+    /**
+     * @brief Glyph coverage rasterized once at a reference size.
+     *
+     * Serves glyph metrics and coverage at any smaller size. Intended to be
+     * shared (e.g. through std::shared_ptr) by the glyph caches or
+     * converter runs of one font at different sizes. All members are
+     * thread-safe; reference glyphs are rasterized on first use.
+     *
+     * The object holds the font_source and a sized_face pointing at it, so
+     * it is neither copyable nor movable.
+     */
+    class ONYX_FONT_EXPORT reference_strike {
+    public:
+        /**
+         * @brief Create an empty strike.
+         *
+         * @param source Font to rasterize
+         * @param reference_size Pixel height to rasterize at
+         * @param filter Filter used for smaller sizes
+         */
+        reference_strike(font_source source, float reference_size,
+                         downsample_filter filter = downsample_filter::area);
+
+        reference_strike(const reference_strike&) = delete;
+        reference_strike& operator=(const reference_strike&) = delete;
+
+        /**
+         * @brief Check whether a size can be produced from this strike.
+         * @param size Target pixel height
+         * @return true for outline sources and 0 < size < reference_size()
+         */
+        [[nodiscard]] bool supports(float size) const noexcept;
+
+        /**
+         * @brief Get the reference pixel height.
+         * @return Reference size
+         */
+        [[nodiscard]] float reference_size() const noexcept { return m_reference_size; }
+
+        /**
+         * @brief Get the downsampling filter.
+         * @return Filter
+         */
+        [[nodiscard]] downsample_filter filter() const noexcept { return m_filter; }
+
+        /**
+         * @brief Get the font.
+         * @return Font the strike rasterizes
+         */
+        [[nodiscard]] const font_source& source() const noexcept { return m_source; }
+
+        /**
+         * @brief Font metrics at a size, scaled from the reference.
+         * @param size Target pixel height
+         * @return Scaled metrics
+         */
+        [[nodiscard]] scaled_metrics metrics(float size) const noexcept;
+
+        /**
+         * @brief Glyph metrics at a size, scaled from the reference.
+         * @param codepoint Unicode codepoint
+         * @param size Target pixel height
+         * @return Scaled metrics
+         */
+        [[nodiscard]] glyph_metrics get_glyph_metrics(char32_t codepoint, float size) const;
+
+        /**
+         * @brief Pixel box of the glyph at a size.
+         *
+         * Relative to the pen on the baseline, Y down: the glyph drawn
+         * with draw() and the pen at (-box.x, -box.y) fits in a
+         * box.w x box.h image. Empty glyphs have a zero-sized box.
+         *
+         * @param codepoint Unicode codepoint
+         * @param size Target pixel height
+         * @return Integer box
+         */
+        [[nodiscard]] glyph_rect box(char32_t codepoint, float size);
+
+        /**
+         * @brief Draw a glyph downsampled to a size.
+         *
+         * Overwrites the whole destination rectangle; pixels the glyph does
+         * not reach become 0.
+         *
+         * @param codepoint Unicode codepoint
+         * @param size Target pixel height
+         * @param dst Destination coverage
+         * @param width Destination width
+         * @param height Destination height
+         * @param stride Destination row stride in bytes
+         * @param pen_x Pen X in destination pixels
+         * @param pen_y Baseline Y in destination pixels
+         */
+        void draw(char32_t codepoint, float size,
+                  uint8_t* dst, int width, int height, int stride,
+                  float pen_x, float pen_y);
+
+        /**
+         * @brief Get number of reference glyphs rasterized so far.
+         * @return Glyph count
+         */
+        [[nodiscard]] std::size_t glyph_count() const;
+
+    private:
+        /// Reference coverage cropped to its non-zero pixels
+        struct entry {
+            std::vector<uint8_t> alpha;
+            int width = 0;
+            int height = 0;
+            int origin_x = 0;  ///< Pen X within the crop
+            int origin_y = 0;  ///< Baseline Y within the crop
+        };
+
+        const entry& reference_glyph(char32_t codepoint);
+
+        font_source m_source;
+        float m_reference_size;
+        downsample_filter m_filter;
+        sized_face m_face;
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<char32_t, entry> m_glyphs;
+        alpha_downsampler m_downsampler;
+    };
+} // namespace onyx_font
@@ -13,6 +13,9 @@
  * - Glyph rasterization with proper positioning
  * - Kerning between adjacent characters
  * - Size-independent operation via font_source
+ * - Size-dependent data (scale, metrics, ASCII advances) computed once
+ *   per set_size() in a sized_face
+ * - Optional word_width_cache for wrapping
  *
  * @section rasterizer_usage Usage Examples
  *
@@ -51,8 +54,11 @@
 #include <onyx_font/export.h>
 #include <onyx_font/text/types.hh>
 #include <onyx_font/text/font_source.hh>
+#include <onyx_font/text/sized_face.hh>
 #include <onyx_font/text/raster_target.hh>
 #include <onyx_font/text/utf8.hh>
+#include <onyx_font/text/word_cache.hh>
+#include <memory>
 #include <string_view>
 #include <cmath>
 
@@ -84,11 +90,35 @@ namespace onyx_font {
          */
         explicit text_rasterizer(font_source source);
 
+        /**
+         * @brief Copy constructor.
+         *
+         * The copy has its own font_source and sized_face; the word width
+         * memo is shared.
+         */
+        text_rasterizer(const text_rasterizer& other);
+
+        /**
+         * @brief Copy assignment operator.
+         */
+        text_rasterizer& operator=(const text_rasterizer& other);
+
+        /**
+         * @brief Move constructor.
+         */
+        text_rasterizer(text_rasterizer&& other) noexcept;
+
+        /**
+         * @brief Move assignment operator.
+         */
+        text_rasterizer& operator=(text_rasterizer&& other) noexcept;
+
         /**
          * @brief Set the rendering size in pixels.
          *
          * Sets the target pixel height for text rendering and measurement.
          * For bitmap fonts, this may be ignored if the font is not scalable.
+         * Rebuilds the sized_face when the size changes.
          *
          * @param pixels Font height in pixels
          */
@@ -100,6 +130,38 @@ namespace onyx_font {
          */
         [[nodiscard]] float size() const { return m_size; }
 
+        /**
+         * @brief Get the underlying font source.
+         * @return Reference to font source
+         */
+        [[nodiscard]] const font_source& source() const noexcept { return m_source; }
+
+        /**
+         * @brief Get the font at the current size.
+         * @return Sized face with cached metrics
+         */
+        [[nodiscard]] const sized_face& face() const noexcept { return m_face; }
+
+        /**
+         * @brief Use a word width memo for wrapped measurement.
+         *
+         * measure_wrapped() and text_renderer's wrapping then add whole
+         * cached words where no glyph of the word can wrap. Line breaks
+         * match those without the memo, up to float rounding.
+         *
+         * @param words Memo (may be shared by many rasterizers); nullptr
+         *              disables it
+         */
+        void set_word_cache(std::shared_ptr<word_width_cache> words) noexcept {
+            m_words = std::move(words);
+        }
+
+        /**
+         * @brief Get the word width memo.
+         * @return Memo, or nullptr if none is set
+         */
+        [[nodiscard]] word_width_cache* word_cache() const noexcept { return m_words.get(); }
+
         /**
          * @brief Get scaled font metrics at current size.
          * @return Font metrics (ascent, descent, line gap, line height)
@@ -154,7 +216,7 @@ namespace onyx_font {
          * @return Kerning adjustment (usually negative for tightening)
          */
         [[nodiscard]] float get_kerning(char32_t first, char32_t second) const {
-            return m_source.get_kerning(first, second, m_size);
+            return m_face.kerning(first, second);
         }
 
         /**
@@ -224,6 +286,8 @@ namespace onyx_font {
     private:
         font_source m_source;
         float m_size = 12.0f;
+        sized_face m_face;
+        std::shared_ptr<word_width_cache> m_words;
     };
 
     // Template implementations
@@ -254,11 +318,11 @@ namespace onyx_font {
         for (char32_t codepoint : utf8_view(text)) {
             // Apply kerning
             if (prev_codepoint != 0) {
-                pen_x += m_source.get_kerning(prev_codepoint, codepoint, m_size);
+                pen_x += m_face.kerning(prev_codepoint, codepoint);
             }
 
             // Get glyph metrics
-            auto metrics = m_source.get_glyph_metrics(codepoint, m_size);
+            auto metrics = m_face.get_glyph_metrics(codepoint);
 
             // Rasterize glyph
             int glyph_x = static_cast<int>(std::round(pen_x));
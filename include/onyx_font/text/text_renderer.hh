@@ -75,6 +75,30 @@
  * std::cout << "Rendered " << lines << " lines\n";
  * @endcode
  *
+ * @subsection renderer_layout_cache Repeated Strings
+ *
+ * With a layout_cache, measuring or drawing a string seen before (same
+ * font, size, wrap width and alignment) replays its stored quads:
+ *
+ * @code{.cpp}
+ * renderer.set_layout_cache(std::make_shared<layout_cache>());
+ * @endcode
+ *
+ * @subsection renderer_batched Batched Drawing
+ *
+ * draw() emits glyphs in text order, which forces a texture rebind every
+ * time consecutive glyphs live on different atlas pages. draw_batched()
+ * lays the string out first and hands over quads grouped by layer:
+ *
+ * @code{.cpp}
+ * renderer.draw_batched("Hello World", 100, 100,
+ *     [](std::span<const glyph_quad> quads) {
+ *         // pages layout: all quads share quads[0].layer
+ *         // texture_array layout: one call for the whole string
+ *         submit_quads(quads);
+ *     });
+ * @endcode
+ *
  * @author Igor
  * @date 21/12/2025
  */
@@ -84,8 +108,12 @@
 #include <onyx_font/export.h>
 #include <onyx_font/text/types.hh>
 #include <onyx_font/text/glyph_cache.hh>
+#include <onyx_font/text/layout_cache.hh>
 #include <onyx_font/text/utf8.hh>
+#include <algorithm>
 #include <concepts>
+#include <memory>
+#include <span>
 #include <vector>
 #include <string_view>
 
@@ -109,6 +137,23 @@ namespace onyx_font {
         { func(atlas, src, dst_x, dst_y) } -> std::same_as<void>;
     };
 
+    /**
+     * @brief Concept for batch callback functions.
+     *
+     * A batch callback receives a contiguous run of positioned glyph
+     * quads. Used by text_renderer::draw_batched().
+     *
+     * @tparam F Callback type
+     *
+     * The callback signature is:
+     * `void callback(std::span<const glyph_quad> quads)`
+     */
+    template<typename F>
+    concept batch_callback = requires(F func, std::span<const glyph_quad> quads)
+    {
+        { func(quads) } -> std::same_as<void>;
+    };
+
     /**
      * @brief High-level text renderer with caching, alignment, and wrapping.
      *
@@ -124,6 +169,7 @@ namespace onyx_font {
      * - **Word wrapping**: Automatic line breaking at word boundaries
      * - **Kerning**: Proper spacing between character pairs
      * - **Flexible output**: Uses blit callback for GPU integration
+     * - **Layout caching**: Optional reuse of layouts of repeated strings
      *
      * @section text_renderer_threading Thread Safety
      *
@@ -143,6 +189,28 @@ namespace onyx_font {
             : m_cache(&cache) {
         }
 
+        /**
+         * @brief Reuse layouts of repeated strings.
+         *
+         * measure(), measure_wrapped() and every draw member then look the
+         * string up first and replay its stored layout while the glyph
+         * cache's generation is unchanged.
+         *
+         * @param layouts Layout cache (may be shared by renderers); nullptr
+         *                disables caching
+         */
+        void set_layout_cache(std::shared_ptr<layout_cache> layouts) noexcept {
+            m_layouts = std::move(layouts);
+        }
+
+        /**
+         * @brief Get the layout cache.
+         * @return Layout cache, or nullptr if none is set
+         */
+        [[nodiscard]] layout_cache* layouts() const noexcept {
+            return m_layouts.get();
+        }
+
         /**
          * @brief Draw text at position.
          *
@@ -160,6 +228,11 @@ namespace onyx_font {
         float draw(std::string_view text, float x, float y, BlitFn&& blit) {
             if (text.empty()) return 0.0f;
 
+            if (const layout_entry* layout = cached_line(text)) {
+                replay(layout->quads, x, y, blit);
+                return layout->width;
+            }
+
             float baseline_y = y + m_cache->metrics().ascent;
             return draw_baseline(text, x, baseline_y, std::forward<BlitFn>(blit));
         }
@@ -183,21 +256,7 @@ namespace onyx_font {
                           float width, text_align align, BlitFn&& blit) {
             if (text.empty()) return;
 
-            float text_width = m_cache->measure(text).width;
-            float offset_x = 0.0f;
-
-            switch (align) {
-                case text_align::left:
-                    offset_x = 0.0f;
-                    break;
-                case text_align::center:
-                    offset_x = (width - text_width) / 2.0f;
-                    break;
-                case text_align::right:
-                    offset_x = width - text_width;
-                    break;
-            }
-
+            float offset_x = align == text_align::left ? 0.0f : align_offset(measure(text).width, width, align);
             draw(text, x + offset_x, y, std::forward<BlitFn>(blit));
         }
 
@@ -219,6 +278,13 @@ namespace onyx_font {
                          text_align align, BlitFn&& blit) {
             if (text.empty()) return 0;
 
+            if (const layout_entry* layout = cached_wrapped(text, box.w, align)) {
+                int lines_drawn = visible_lines(*layout, box);
+                replay(std::span(layout->quads).first(quads_of_lines(*layout, lines_drawn)),
+                       box.x, box.y, blit);
+                return lines_drawn;
+            }
+
             auto lines = wrap_lines(text, box.w);
             float line_h = m_cache->line_height();
             float current_y = box.y;
@@ -287,6 +353,127 @@ namespace onyx_font {
             return pen_x - x;
         }
 
+        /**
+         * @brief Draw text as layer-grouped batches.
+         *
+         * Lays out the whole string, then invokes @p batch with the glyph
+         * quads grouped by layer. For atlas_layout::pages the callback is
+         * called once per atlas page used by the string (every quad in a
+         * call shares the same layer). For atlas_layout::texture_array it
+         * is called once with all quads, each carrying its own layer.
+         *
+         * Empty glyphs (e.g. space) produce no quads. The quad buffer is
+         * reused between calls, so steady-state drawing does not allocate.
+         *
+         * @tparam BatchFn Batch callback type
+         * @param text UTF-8 text
+         * @param x X position
+         * @param y Y position (top of text, not baseline)
+         * @param batch Callback receiving quad batches
+         * @return Width of drawn text
+         */
+        template<batch_callback BatchFn>
+        float draw_batched(std::string_view text, float x, float y, BatchFn&& batch) {
+            if (text.empty()) return 0.0f;
+
+            if (const layout_entry* layout = cached_line(text)) {
+                place_quads(layout->quads, x, y);
+                flush_batches(batch);
+                return layout->width;
+            }
+
+            m_quads.clear();
+            float width = layout_quads(text, x, y + m_cache->metrics().ascent, m_quads);
+            flush_batches(batch);
+            return width;
+        }
+
+        /**
+         * @brief Draw word-wrapped text in a box as layer-grouped batches.
+         *
+         * Same layout as draw_wrapped(), but all lines are collected first
+         * and submitted through @p batch exactly as draw_batched() does.
+         *
+         * @tparam BatchFn Batch callback type
+         * @param text UTF-8 text
+         * @param box Bounding box for text
+         * @param align Horizontal alignment for each line
+         * @param batch Callback receiving quad batches
+         * @return Number of lines drawn
+         */
+        template<batch_callback BatchFn>
+        int draw_wrapped_batched(std::string_view text, const text_box& box,
+                                 text_align align, BatchFn&& batch) {
+            if (text.empty()) return 0;
+
+            if (const layout_entry* layout = cached_wrapped(text, box.w, align)) {
+                int lines_drawn = visible_lines(*layout, box);
+                place_quads(std::span(layout->quads).first(quads_of_lines(*layout, lines_drawn)),
+                            box.x, box.y);
+                flush_batches(batch);
+                return lines_drawn;
+            }
+
+            auto lines = wrap_lines(text, box.w);
+            float line_h = m_cache->line_height();
+            float ascent = m_cache->metrics().ascent;
+            float current_y = box.y;
+            int lines_drawn = 0;
+
+            m_quads.clear();
+            for (const auto& line : lines) {
+                if (current_y + line_h > box.y + box.h) {
+                    break;
+                }
+
+                float offset_x = align_offset(line, box.w, align);
+                layout_quads(line, box.x + offset_x, current_y + ascent, m_quads);
+
+                current_y += line_h;
+                ++lines_drawn;
+            }
+
+            flush_batches(batch);
+            return lines_drawn;
+        }
+
+        /**
+         * @brief Lay out text into positioned glyph quads.
+         *
+         * Appends one quad per visible glyph to @p out in text order,
+         * applying kerning exactly like draw_baseline(). Useful for
+         * building custom vertex buffers.
+         *
+         * @param text UTF-8 text
+         * @param x X position
+         * @param y Baseline Y position
+         * @param out Quad buffer to append to
+         * @return Advance width of the laid out text
+         */
+        float layout_quads(std::string_view text, float x, float y,
+                           std::vector<glyph_quad>& out) {
+            float pen_x = x;
+            char32_t prev_codepoint = 0;
+
+            for (char32_t codepoint : utf8_view(text)) {
+                if (prev_codepoint != 0) {
+                    pen_x += m_cache->rasterizer().get_kerning(prev_codepoint, codepoint);
+                }
+
+                const auto& glyph = m_cache->get(codepoint);
+
+                if (glyph.rect.w > 0 && glyph.rect.h > 0) {
+                    out.push_back({glyph.layer, glyph.rect,
+                                   pen_x + glyph.bearing_x, y - glyph.bearing_y});
+                }
+
+                pen_x += glyph.advance_x;
+                prev_codepoint = codepoint;
+            }
+
+            return pen_x - x;
+        }
+
         /**
          * @brief Measure text.
          *
@@ -294,7 +481,18 @@ namespace onyx_font {
          * @return Text extents (width, height, ascent, descent)
          */
         [[nodiscard]] text_extents measure(std::string_view text) const {
-            return m_cache->measure(text);
+            if (!m_layouts) {
+                return m_cache->measure(text);
+            }
+            layout_key key = make_key(text, layout_kind::measure, 0.0f, text_align::left);
+            if (const layout_entry* hit = m_layouts->find(key)) {
+                return hit->extents;
+            }
+            text_extents extents = m_cache->measure(text);
+            if (layout_entry* entry = m_layouts->insert(key)) {
+                entry->extents = extents;
+            }
+            return extents;
         }
 
         /**
@@ -305,7 +503,18 @@ namespace onyx_font {
          * @return Extents of wrapped text
          */
         [[nodiscard]] text_extents measure_wrapped(std::string_view text, float max_width) const {
-            return m_cache->rasterizer().measure_wrapped(text, max_width);
+            if (!m_layouts) {
+                return m_cache->rasterizer().measure_wrapped(text, max_width);
+            }
+            layout_key key = make_key(text, layout_kind::measure_wrapped, max_width, text_align::left);
+            if (const layout_entry* hit = m_layouts->find(key)) {
+                return hit->extents;
+            }
+            text_extents extents = m_cache->rasterizer().measure_wrapped(text, max_width);
+            if (layout_entry* entry = m_layouts->insert(key)) {
+                entry->extents = extents;
+            }
+            return extents;
         }
 
         /**
@@ -326,12 +535,157 @@ namespace onyx_font {
 
     private:
         glyph_cache<Surface>* m_cache;
+        std::vector<glyph_quad> m_quads;  ///< Reused layout buffer for batched drawing
+        std::shared_ptr<layout_cache> m_layouts;
+
+        /// Horizontal offset of a line within @p width for the given alignment
+        [[nodiscard]] float align_offset(std::string_view line, float width,
+                                         text_align align) const {
+            if (align == text_align::left) {
+                return 0.0f;
+            }
+            return align_offset(m_cache->measure(line).width, width, align);
+        }
+
+        /// Horizontal offset of a line of @p line_width within @p width
+        [[nodiscard]] static float align_offset(float line_width, float width, text_align align) noexcept {
+            switch (align) {
+                case text_align::center:
+                    return (width - line_width) / 2.0f;
+                case text_align::right:
+                    return width - line_width;
+                case text_align::left:
+                    break;
+            }
+            return 0.0f;
+        }
+
+        [[nodiscard]] layout_key make_key(std::string_view text, layout_kind kind,
+                                          float wrap_width, text_align align) const noexcept {
+            layout_key key;
+            key.text = text;
+            key.cache = m_cache;
+            key.font = m_cache->rasterizer().source().font_identity();
+            key.size = m_cache->rasterizer().size();
+            key.wrap_width = wrap_width;
+            key.align = align;
+            key.kind = kind;
+            return key;
+        }
+
+        /// Layout of a single line at (0, 0), or nullptr without a layout cache
+        const layout_entry* cached_line(std::string_view text) {
+            if (!m_layouts) return nullptr;
+
+            layout_key key = make_key(text, layout_kind::line, 0.0f, text_align::left);
+            if (const layout_entry* hit = m_layouts->find(key, m_cache->generation())) {
+                m_cache->touch();
+                return hit;
+            }
+            layout_entry* entry = m_layouts->insert(key);
+            if (!entry) return nullptr;
+            entry->width = layout_quads(text, 0.0f, m_cache->metrics().ascent, entry->quads);
+            entry->generation = m_cache->generation();
+            return entry;
+        }
+
+        /// Layout of wrapped lines in a box at (0, 0), or nullptr without a layout cache
+        const layout_entry* cached_wrapped(std::string_view text, float width, text_align align) {
+            if (!m_layouts) return nullptr;
+
+            layout_key key = make_key(text, layout_kind::wrapped, width, align);
+            if (const layout_entry* hit = m_layouts->find(key, m_cache->generation())) {
+                m_cache->touch();
+                return hit;
+            }
+            layout_entry* entry = m_layouts->insert(key);
+            if (!entry) return nullptr;
+
+            // Measured without the layout cache: inserting would recycle entry
+            float line_h = m_cache->line_height();
+            float ascent = m_cache->metrics().ascent;
+            float current_y = 0.0f;
+            for (const auto& line : wrap_lines(text, width)) {
+                layout_quads(line, align_offset(line, width, align), current_y + ascent, entry->quads);
+                entry->line_ends.push_back(entry->quads.size());
+                current_y += line_h;
+            }
+            entry->generation = m_cache->generation();
+            return entry;
+        }
+
+        /// Number of wrapped lines that fit in the box height
+        [[nodiscard]] int visible_lines(const layout_entry& layout, const text_box& box) const {
+            float line_h = m_cache->line_height();
+            float current_y = box.y;
+            int lines = 0;
+            for (std::size_t i = 0; i < layout.line_ends.size(); ++i) {
+                if (current_y + line_h > box.y + box.h) {
+                    break;
+                }
+                current_y += line_h;
+                ++lines;
+            }
+            return lines;
+        }
+
+        [[nodiscard]] static std::size_t quads_of_lines(const layout_entry& layout, int lines) noexcept {
+            return lines > 0 ? layout.line_ends[static_cast<std::size_t>(lines - 1)] : 0;
+        }
+
+        /// Blit stored quads offset by (x, y)
+        template<typename BlitFn>
+        void replay(std::span<const glyph_quad> quads, float x, float y, BlitFn& blit) {
+            for (const auto& q : quads) {
+                blit(m_cache->atlas(q.layer), q.src, x + q.dst_x, y + q.dst_y);
+            }
+        }
+
+        /// Copy stored quads offset by (x, y) into m_quads
+        void place_quads(std::span<const glyph_quad> quads, float x, float y) {
+            m_quads.assign(quads.begin(), quads.end());
+            for (auto& q : m_quads) {
+                q.dst_x += x;
+                q.dst_y += y;
+            }
+        }
+
+        /// Submit m_quads grouped by layer
+        template<typename BatchFn>
+        void flush_batches(BatchFn& batch) {
+            if (m_quads.empty()) return;
+
+            auto by_layer = [](const glyph_quad& a, const glyph_quad& b) {
+                return a.layer < b.layer;
+            };
+            if (!std::is_sorted(m_quads.begin(), m_quads.end(), by_layer)) {
+                std::stable_sort(m_quads.begin(), m_quads.end(), by_layer);
+            }
+
+            std::span<const glyph_quad> quads(m_quads);
+            if (m_cache->layout() == atlas_layout::texture_array) {
+                batch(quads);
+                return;
+            }
+
+            std::size_t begin = 0;
+            while (begin < quads.size()) {
+                std::size_t end = begin + 1;
+                while (end < quads.size() && quads[end].layer == quads[begin].layer) {
+                    ++end;
+                }
+                batch(quads.subspan(begin, end - begin));
+                begin = end;
+            }
+        }
 
         /**
          * @brief Word-wrap helper: split text into lines.
          *
          * Splits text at word boundaries (spaces) to fit within
-         * the specified maximum width.
+         * the specified maximum width. Widths include kerning, like
+         * drawing does. With a word_width_cache on the rasterizer, words
+         * that fit whole are added from the cache.
          *
          * @param text UTF-8 text to wrap
          * @param max_width Maximum line width
@@ -345,13 +699,17 @@ namespace onyx_font {
                 return lines;
             }
 
+            const sized_face& face = m_cache->face();
+            word_width_cache* words = m_cache->rasterizer().word_cache();
+
             const char* line_start = text.data();
             const char* word_start = text.data();
             const char* current = text.data();
             const char* text_end = text.data() + text.size();
 
             float line_width = 0.0f;
-            float word_width = 0.0f;
+            float word_width = 0.0f;  // From word_start, without kerning before it
+            char32_t prev_codepoint = 0;
 
             auto flush_line = [&]() {
                 if (current > line_start) {
@@ -369,6 +727,22 @@ namespace onyx_font {
             };
 
             while (current < text_end) {
+                // Add a whole cached word when none of its glyphs can wrap
+                if (words && current == word_start && *current != ' ' && *current != '\n') {
+                    const char* word_end = std::find_if(current, text_end,
+                                                        [](char c) { return c == ' ' || c == '\n'; });
+                    word_metrics word = words->measure(
+                        face, std::string_view(current, static_cast<std::size_t>(word_end - current)));
+                    float kern = prev_codepoint != 0 ? face.kerning(prev_codepoint, word.first) : 0.0f;
+                    if (line_width + kern + word.peak <= max_width) {
+                        line_width += kern + word.width;
+                        word_width = word.width;
+                        prev_codepoint = word.last;
+                        current = word_end;
+                        continue;
+                    }
+                }
+
                 // Decode next codepoint
                 auto [cp, bytes] = utf8_decode_one(
                     std::string_view(current, static_cast<std::size_t>(text_end - current)));
@@ -381,11 +755,16 @@ namespace onyx_font {
                     line_start = current;
                     word_start = current;
                     word_width = 0.0f;
+                    prev_codepoint = 0;
                     continue;
                 }
 
-                // Get glyph advance
-                float advance = m_cache->rasterizer().measure_glyph(cp).advance_x;
+                // Get glyph advance, kerned against the previous glyph
+                float glyph_advance = face.advance(cp);
+                float advance = glyph_advance;
+                if (prev_codepoint != 0) {
+                    advance += face.kerning(prev_codepoint, cp);
+                }
 
                 // Check for word boundary (space)
                 if (cp == ' ') {
@@ -404,16 +783,23 @@ namespace onyx_font {
                         current = saved_current;
                         line_start = word_start;
                         line_width = word_width;
+                        if (word_start == current) {
+                            advance = glyph_advance;
+                        }
                     } else {
                         // No word boundary, break at current position
                         flush_line();
                         line_start = current;
                         line_width = 0.0f;
+                        advance = glyph_advance;
                     }
                 }
 
-                word_width += advance;
+                if (cp != ' ') {
+                    word_width += current == word_start ? glyph_advance : advance;
+                }
                 line_width += advance;
+                prev_codepoint = cp;
                 current += bytes;
             }
 
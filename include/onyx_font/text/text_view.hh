@@ -0,0 +1,488 @@
+/**
+ * @file text_view.hh
+ * @brief Multi-line text view that redraws only changed lines.
+ *
+ * Redrawing a whole text panel because one line changed (a blinking
+ * cursor, a typed character, an appended log line) costs fill rate and
+ * CPU for every unchanged line. text_view keeps the lines of a panel and,
+ * per visible row, the hash and ink extent of what it last drew into a
+ * retained surface (a render texture, a window back buffer, ...). Each
+ * render() clears and redraws only the rows whose content changed and
+ * returns the damaged rectangles, e.g. for a partial present.
+ *
+ * @section text_view_usage Usage
+ *
+ * @code{.cpp}
+ * text_view<memory_atlas> view(cache, text_box{0, 0, 640, 480});
+ * view.set_text(document);
+ *
+ * // Every frame
+ * view.set_line(cursor_line, edited_line);
+ * for (const text_box& rect : view.render(clear_rect, blit)) {
+ *     present_region(rect);
+ * }
+ * @endcode
+ *
+ * @section text_view_log Logs
+ *
+ * For append-only logs, set_max_lines() drops the oldest lines and
+ * set_follow_tail() keeps the last line in view. Given a scroll callback,
+ * render() moves the retained pixels up instead of redrawing every row
+ * when lines scroll, so an append draws one row:
+ *
+ * @code{.cpp}
+ * view.set_max_lines(10000);
+ * view.set_follow_tail(true);
+ * view.append_line("connected");
+ * view.render(clear_rect, blit, [&](const text_box& region, float dy) {
+ *     surface.move_rows(region, dy);   // dy < 0 moves content up
+ * });
+ * @endcode
+ *
+ * Lines are split at '\n' and drawn left-aligned without wrapping;
+ * clipping long lines to the view is up to the blit callback. Rows with
+ * glyphs still pending in the glyph cache (see frame_budget) are drawn
+ * again on the next render().
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/text/glyph_cache.hh>
+#include <onyx_font/text/text_renderer.hh>
+#include <onyx_font/text/types.hh>
+#include <onyx_font/text/utf8.hh>
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Concept for callbacks clearing a region of the retained surface.
+     *
+     * The callback signature is:
+     * `void callback(const text_box& region)`
+     */
+    template<typename F>
+    concept clear_callback = requires(F func, const text_box& region)
+    {
+        { func(region) } -> std::same_as<void>;
+    };
+
+    /**
+     * @brief Concept for callbacks scrolling the retained surface.
+     *
+     * The callback signature is:
+     * `void callback(const text_box& region, float dy)`
+     * and moves the pixels of @p region vertically by @p dy (negative
+     * moves up), clipped to the region. Uncovered pixels may keep any
+     * value; text_view clears them.
+     */
+    template<typename F>
+    concept scroll_callback = requires(F func, const text_box& region, float dy)
+    {
+        { func(region, dy) } -> std::same_as<void>;
+    };
+
+    /**
+     * @brief Damage-tracked multi-line text view.
+     *
+     * Not thread-safe, like text_renderer.
+     *
+     * @tparam Surface Atlas surface type
+     */
+    template<atlas_surface Surface>
+    class text_view {
+    public:
+        /**
+         * @brief Create an empty view.
+         *
+         * @param cache Glyph cache to draw with (must outlive the view)
+         * @param bounds Area of the view on the retained surface
+         */
+        text_view(glyph_cache<Surface>& cache, const text_box& bounds)
+            : m_cache(&cache)
+              , m_renderer(cache)
+              , m_bounds(bounds) {
+        }
+
+        /**
+         * @brief Move or resize the view. Everything is redrawn.
+         * @param bounds New area on the retained surface
+         */
+        void set_bounds(const text_box& bounds) {
+            m_bounds = bounds;
+            invalidate();
+        }
+
+        /**
+         * @brief Get the area of the view.
+         * @return View bounds
+         */
+        [[nodiscard]] const text_box& bounds() const noexcept { return m_bounds; }
+
+        /**
+         * @brief Get the number of whole lines that fit in the view.
+         * @return Visible row count
+         */
+        [[nodiscard]] std::size_t rows() const {
+            float line_h = m_cache->line_height();
+            if (line_h <= 0.0f || m_bounds.h <= 0.0f) return 0;
+            return static_cast<std::size_t>(std::floor(m_bounds.h / line_h));
+        }
+
+        /**
+         * @brief Replace all lines.
+         *
+         * Rows whose line is unchanged are not redrawn.
+         *
+         * @param text UTF-8 text, lines separated by '\n'
+         */
+        void set_text(std::string_view text) {
+            m_lines.clear();
+            split_lines(text);
+            trim();
+        }
+
+        /**
+         * @brief Replace one line.
+         *
+         * @param index Line index
+         * @param text UTF-8 text of the line (no '\n')
+         * @throws std::out_of_range if index >= line_count()
+         */
+        void set_line(std::size_t index, std::string_view text) {
+            if (index >= m_lines.size()) {
+                throw std::out_of_range("text_view line index out of range");
+            }
+            m_lines[index].assign(text);
+        }
+
+        /**
+         * @brief Add a line at the end.
+         * @param text UTF-8 text of the line (no '\n')
+         */
+        void append_line(std::string_view text) {
+            m_lines.emplace_back().assign(text);
+            trim();
+        }
+
+        /**
+         * @brief Append streamed text to the last line.
+         *
+         * Each '\n' in @p text starts a new line, so output can be fed in
+         * arbitrary chunks.
+         *
+         * @param text UTF-8 text
+         */
+        void append(std::string_view text) {
+            if (m_lines.empty()) {
+                m_lines.emplace_back();
+            }
+            std::size_t newline = text.find('\n');
+            m_lines.back().append(text.substr(0, newline));
+            if (newline != std::string_view::npos) {
+                split_lines(text.substr(newline + 1));
+            }
+            trim();
+        }
+
+        /**
+         * @brief Remove all lines.
+         */
+        void clear() {
+            m_lines.clear();
+            m_top = 0;
+        }
+
+        /**
+         * @brief Limit the number of lines kept.
+         *
+         * The oldest lines are dropped beyond the limit.
+         *
+         * @param max_lines Maximum line count; 0 is unlimited
+         */
+        void set_max_lines(std::size_t max_lines) {
+            m_max_lines = max_lines;
+            trim();
+        }
+
+        /**
+         * @brief Keep the last line in view as lines are added.
+         * @param follow true to scroll to the end on every render()
+         */
+        void set_follow_tail(bool follow) noexcept { m_follow_tail = follow; }
+
+        /**
+         * @brief Scroll to a line.
+         *
+         * Ignored while following the tail.
+         *
+         * @param index Index of the first visible line
+         */
+        void set_top_line(std::size_t index) noexcept { m_top = index; }
+
+        /**
+         * @brief Get the first visible line.
+         * @return Line index
+         */
+        [[nodiscard]] std::size_t top_line() const {
+            if (m_follow_tail) {
+                std::size_t visible = rows();
+                return m_lines.size() > visible ? m_lines.size() - visible : 0;
+            }
+            return std::min(m_top, m_lines.size());
+        }
+
+        /**
+         * @brief Get the number of lines.
+         * @return Line count
+         */
+        [[nodiscard]] std::size_t line_count() const noexcept { return m_lines.size(); }
+
+        /**
+         * @brief Get a line.
+         * @param index Line index (must be < line_count())
+         * @return UTF-8 text of the line
+         */
+        [[nodiscard]] std::string_view line(std::size_t index) const { return m_lines[index].text; }
+
+        /**
+         * @brief Redraw every row on the next render().
+         *
+         * Needed when the retained surface lost its contents.
+         */
+        void invalidate() noexcept {
+            m_drawn.clear();
+        }
+
+        /**
+         * @brief Check whether render() would draw anything.
+         * @return true if some visible row differs from what was drawn
+         */
+        [[nodiscard]] bool dirty() const {
+            std::size_t visible = rows();
+            if (m_drawn.size() != visible) return visible > 0;
+            std::size_t top = top_line();
+            for (std::size_t r = 0; r < visible; ++r) {
+                if (!m_drawn[r].matches(row_hash(top + r))) return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Redraw the rows that changed since the last render().
+         *
+         * Each damaged row is cleared (up to the wider of its old and new
+         * ink) and its line is drawn again.
+         *
+         * @tparam ClearFn Clear callback type
+         * @tparam BlitFn Blit callback type
+         * @param clear Clears a region of the retained surface
+         * @param blit Draws one glyph, as for text_renderer::draw()
+         * @return Damaged rectangles, adjacent rows merged; valid until the
+         *         next render()
+         */
+        template<clear_callback ClearFn, blit_callback<Surface> BlitFn>
+        std::span<const text_box> render(ClearFn&& clear, BlitFn&& blit) {
+            return render_rows(clear, blit, no_scroll{});
+        }
+
+        /**
+         * @brief Redraw changed rows, scrolling retained pixels where possible.
+         *
+         * When the first visible line moved by fewer lines than the view
+         * holds (e.g. after appending to a log that follows its tail), the
+         * retained pixels are moved with @p scroll and only the rows
+         * scrolled in are drawn. The whole view is then reported damaged.
+         *
+         * @tparam ClearFn Clear callback type
+         * @tparam BlitFn Blit callback type
+         * @tparam ScrollFn Scroll callback type
+         * @param clear Clears a region of the retained surface
+         * @param blit Draws one glyph, as for text_renderer::draw()
+         * @param scroll Moves the pixels of a region vertically
+         * @return Damaged rectangles; valid until the next render()
+         */
+        template<clear_callback ClearFn, blit_callback<Surface> BlitFn, scroll_callback ScrollFn>
+        std::span<const text_box> render(ClearFn&& clear, BlitFn&& blit, ScrollFn&& scroll) {
+            return render_rows(clear, blit, scroll);
+        }
+
+    private:
+        /// Placeholder for render() without a scroll callback
+        struct no_scroll {};
+
+        struct line_data {
+            std::string text;
+            std::size_t hash = empty_hash();
+
+            void assign(std::string_view value) {
+                text.assign(value);
+                hash = std::hash<std::string_view>{}(text);
+            }
+
+            void append(std::string_view value) {
+                text.append(value);
+                hash = std::hash<std::string_view>{}(text);
+            }
+        };
+
+        /// What was last drawn into one row of the retained surface
+        struct row_state {
+            std::size_t hash = 0;
+            float ink = 0;          ///< Right edge of the drawn pixels, relative to bounds.x
+            bool complete = false;  ///< No glyph was pending when drawn
+
+            [[nodiscard]] bool matches(std::size_t line_hash) const noexcept {
+                return complete && hash == line_hash;
+            }
+        };
+
+        glyph_cache<Surface>* m_cache;
+        text_renderer<Surface> m_renderer;
+        text_box m_bounds;
+        std::deque<line_data> m_lines;
+        std::size_t m_top = 0;
+        std::size_t m_max_lines = 0;
+        bool m_follow_tail = false;
+        uint64_t m_dropped = 0;               ///< Lines trimmed from the front so far
+        std::vector<row_state> m_drawn;       ///< Per visible row; empty = nothing retained
+        uint64_t m_drawn_top = 0;             ///< Absolute index of the line drawn in row 0
+        std::vector<text_box> m_damage;
+        std::vector<glyph_quad> m_quads;
+
+        [[nodiscard]] static std::size_t empty_hash() noexcept {
+            return std::hash<std::string_view>{}(std::string_view{});
+        }
+
+        /// Hash of the line shown at @p index (an empty line past the end)
+        [[nodiscard]] std::size_t row_hash(std::size_t index) const noexcept {
+            return index < m_lines.size() ? m_lines[index].hash : empty_hash();
+        }
+
+        void split_lines(std::string_view text) {
+            while (true) {
+                std::size_t newline = text.find('\n');
+                m_lines.emplace_back().assign(text.substr(0, newline));
+                if (newline == std::string_view::npos) break;
+                text.remove_prefix(newline + 1);
+            }
+        }
+
+        void trim() {
+            if (m_max_lines == 0 || m_lines.size() <= m_max_lines) return;
+            std::size_t drop = m_lines.size() - m_max_lines;
+            m_lines.erase(m_lines.begin(), m_lines.begin() + static_cast<std::ptrdiff_t>(drop));
+            m_dropped += drop;
+            m_top = m_top > drop ? m_top - drop : 0;
+        }
+
+        /// Move retained rows to follow the first visible line
+        template<typename ScrollFn>
+        void scroll_rows(uint64_t top, float line_h, ScrollFn& scroll) {
+            auto rows = static_cast<int64_t>(m_drawn.size());
+            auto delta = static_cast<int64_t>(top) - static_cast<int64_t>(m_drawn_top);
+            if (delta == 0 || delta >= rows || -delta >= rows) return;
+
+            text_box region{m_bounds.x, m_bounds.y, m_bounds.w, static_cast<float>(rows) * line_h};
+            scroll(region, -static_cast<float>(delta) * line_h);
+            m_damage.push_back(region);
+
+            // Rows scrolled in hold stale pixels: clear them whole
+            if (delta > 0) {
+                std::rotate(m_drawn.begin(), m_drawn.begin() + delta, m_drawn.end());
+                std::fill(m_drawn.end() - delta, m_drawn.end(), row_state{0, m_bounds.w, false});
+            } else {
+                std::rotate(m_drawn.begin(), m_drawn.end() + delta, m_drawn.end());
+                std::fill(m_drawn.begin(), m_drawn.begin() - delta, row_state{0, m_bounds.w, false});
+            }
+            m_drawn_top = top;
+        }
+
+        template<typename ClearFn, typename BlitFn, typename ScrollFn>
+        std::span<const text_box> render_rows(ClearFn& clear, BlitFn& blit, ScrollFn&& scroll) {
+            m_damage.clear();
+            float line_h = m_cache->line_height();
+            std::size_t visible = rows();
+            std::size_t top = top_line();
+            uint64_t absolute_top = m_dropped + top;
+
+            if (m_drawn.size() != visible) {
+                // Nothing usable retained: clear every row whole
+                m_drawn.assign(visible, row_state{0, m_bounds.w, false});
+            } else if constexpr (!std::is_same_v<std::remove_cvref_t<ScrollFn>, no_scroll>) {
+                scroll_rows(absolute_top, line_h, scroll);
+            }
+            // A scroll already reported the whole view
+            bool scrolled = !m_damage.empty();
+
+            float ascent = m_cache->metrics().ascent;
+            for (std::size_t r = 0; r < visible; ++r) {
+                std::size_t index = top + r;
+                row_state& row = m_drawn[r];
+                std::size_t hash = row_hash(index);
+                if (row.matches(hash)) continue;
+
+                float row_y = m_bounds.y + static_cast<float>(r) * line_h;
+                m_quads.clear();
+                if (index < m_lines.size()) {
+                    m_renderer.layout_quads(m_lines[index].text, m_bounds.x, row_y + ascent, m_quads);
+                }
+                float ink = 0.0f;
+                for (const auto& q : m_quads) {
+                    ink = std::max(ink, std::ceil(q.dst_x + static_cast<float>(q.src.w) - m_bounds.x));
+                }
+
+                text_box rect{m_bounds.x, row_y, std::min(std::max(row.ink, ink), m_bounds.w), line_h};
+                if (rect.w > 0.0f) {
+                    clear(rect);
+                    if (!scrolled) add_damage(rect);
+                }
+                for (const auto& q : m_quads) {
+                    blit(m_cache->atlas(q.layer), q.src, q.dst_x, q.dst_y);
+                }
+
+                row.hash = hash;
+                row.ink = ink;
+                row.complete = index >= m_lines.size() || !has_pending(m_lines[index].text);
+            }
+            m_drawn_top = absolute_top;
+            return m_damage;
+        }
+
+        /// Record a damaged row, merging it with the row above
+        void add_damage(const text_box& rect) {
+            if (!m_damage.empty()) {
+                text_box& last = m_damage.back();
+                if (last.y + last.h == rect.y) {
+                    last.h += rect.h;
+                    last.w = std::max(last.w, rect.w);
+                    return;
+                }
+            }
+            m_damage.push_back(rect);
+        }
+
+        [[nodiscard]] bool has_pending(std::string_view text) const {
+            if (m_cache->pending_count() == 0) return false;
+            for (char32_t codepoint : utf8_view(text)) {
+                if (m_cache->is_pending(codepoint)) return true;
+            }
+            return false;
+        }
+    };
+} // namespace onyx_font
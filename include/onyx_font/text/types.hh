@@ -9,7 +9,7 @@
  * @section types_overview Overview
  *
  * The types are organized into several categories:
- * - **Geometric types**: glyph_rect, text_box
+ * - **Geometric types**: glyph_rect, text_box, glyph_quad
  * - **Metrics types**: glyph_metrics, text_extents, scaled_metrics
  * - **Alignment enums**: text_align, text_valign
  * - **Font identification**: font_source_type
@@ -165,6 +165,20 @@ namespace onyx_font {
         float h = 0;  ///< Height (for vertical alignment and clipping)
     };
 
+    /**
+     * @brief A positioned glyph quad ready for batched drawing.
+     *
+     * Produced by text_renderer when laying out a string for batched
+     * submission. The source rectangle addresses the atlas page (or
+     * texture array layer) given by @c layer.
+     */
+    struct ONYX_FONT_EXPORT glyph_quad {
+        int layer = 0;      ///< Atlas page / texture array layer
+        glyph_rect src;     ///< Source rectangle in the atlas
+        float dst_x = 0;    ///< Destination left edge
+        float dst_y = 0;    ///< Destination top edge
+    };
+
     /**
      * @brief Font type identifier.
      *
@@ -0,0 +1,290 @@
+/**
+ * @file usage_profile.hh
+ * @brief Codepoint usage profiles for guided glyph cache warm-up.
+ *
+ * glyph_cache_config::pre_cache_ascii warms a cache with the printable
+ * ASCII range, which misses Cyrillic or CJK text entirely and wastes atlas
+ * space on a digits-only HUD. A usage_profile records which codepoints a
+ * session actually draws, per (font, size), and is saved to a compact
+ * file so that the next start can pre-cache exactly those glyphs.
+ *
+ * @section usage_profile_record Recording
+ *
+ * @code{.cpp}
+ * usage_profile profile = usage_profile::load("glyphs.prof");  // or empty
+ *
+ * glyph_cache_config config;
+ * config.pre_cache_ascii = false;
+ * config.usage = profile.counter("ui-sans", 18.0f);   // fed by every get()
+ *
+ * glyph_cache<memory_atlas> cache(font_source::from_ttf(font), 18.0f, config);
+ * // ... run the session ...
+ * profile.save("glyphs.prof");
+ * @endcode
+ *
+ * @section usage_profile_warm Warm-up
+ *
+ * @code{.cpp}
+ * // Synchronously, before the first frame
+ * warm_up(cache, profile, "ui-sans", 512);
+ *
+ * // Or on a worker while a loading screen runs; the cache must not be
+ * // used until the future is ready
+ * auto ready = warm_up_async(cache, profile, "ui-sans", 512,
+ *                            [&pool](std::function<void()> job) { pool.submit(std::move(job)); });
+ * @endcode
+ *
+ * @section usage_profile_format File Format
+ *
+ * Little-endian, LEB128 varints:
+ *
+ * | Field        | Encoding                                            |
+ * |--------------|-----------------------------------------------------|
+ * | magic        | "OXUP"                                              |
+ * | version      | u8 (1)                                              |
+ * | entry count  | varint                                              |
+ * | per entry    | name length + bytes, size in 1/64 px, glyph count   |
+ * | per glyph    | codepoint delta from previous, count                |
+ *
+ * Codepoints are stored in ascending order, so a typical script block costs
+ * two or three bytes per glyph.
+ *
+ * Neither class is thread-safe: feed a counter from one thread, and save
+ * while the caches using it are idle.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Codepoint frequencies for one (font, size).
+     */
+    class ONYX_FONT_EXPORT usage_counter {
+    public:
+        /**
+         * @brief Count uses of a codepoint.
+         * @param codepoint Unicode codepoint
+         * @param n Number of uses (counts saturate at UINT32_MAX)
+         */
+        void add(char32_t codepoint, uint32_t n = 1) {
+            uint32_t& count = m_counts[codepoint];
+            count = n > UINT32_MAX - count ? UINT32_MAX : count + n;
+        }
+
+        /**
+         * @brief Count every codepoint of a UTF-8 string.
+         * @param utf8_text Text
+         */
+        void add_text(std::string_view utf8_text);
+
+        /**
+         * @brief Add all counts of another counter.
+         * @param other Counter to merge
+         */
+        void merge(const usage_counter& other);
+
+        /**
+         * @brief Get the count of a codepoint.
+         * @param codepoint Unicode codepoint
+         * @return Number of recorded uses
+         */
+        [[nodiscard]] uint32_t count(char32_t codepoint) const noexcept;
+
+        /**
+         * @brief Get the number of distinct codepoints.
+         * @return Codepoint count
+         */
+        [[nodiscard]] std::size_t size() const noexcept { return m_counts.size(); }
+
+        /**
+         * @brief Get the most used codepoints.
+         *
+         * @param k Maximum number of codepoints
+         * @return Codepoints by descending count (ties by ascending codepoint)
+         */
+        [[nodiscard]] std::vector<char32_t> top(std::size_t k) const;
+
+        /**
+         * @brief Get all counts.
+         * @return Map from codepoint to count
+         */
+        [[nodiscard]] const std::unordered_map<char32_t, uint32_t>& counts() const noexcept {
+            return m_counts;
+        }
+
+    private:
+        std::unordered_map<char32_t, uint32_t> m_counts;
+    };
+
+    /**
+     * @brief Set of usage counters keyed by font identifier and size.
+     *
+     * The font identifier is chosen by the application (file name, family
+     * name, asset id); sizes are matched to 1/64 pixel.
+     */
+    class ONYX_FONT_EXPORT usage_profile {
+    public:
+        /**
+         * @brief Get the counter for a font and size, creating it if needed.
+         *
+         * @param font Application-defined font identifier
+         * @param size Pixel size
+         * @return Counter shared with the profile
+         */
+        std::shared_ptr<usage_counter> counter(std::string_view font, float size);
+
+        /**
+         * @brief Find an existing counter.
+         *
+         * @param font Application-defined font identifier
+         * @param size Pixel size
+         * @return Counter, or nullptr if nothing was recorded
+         */
+        [[nodiscard]] std::shared_ptr<const usage_counter> find(std::string_view font, float size) const;
+
+        /**
+         * @brief Get the most used codepoints of a font at a size.
+         *
+         * Falls back to the font's counts summed over all recorded sizes
+         * when that exact size was never recorded.
+         *
+         * @param font Application-defined font identifier
+         * @param size Pixel size
+         * @param k Maximum number of codepoints
+         * @return Codepoints by descending count
+         */
+        [[nodiscard]] std::vector<char32_t> top(std::string_view font, float size, std::size_t k) const;
+
+        /**
+         * @brief Add all counters of another profile.
+         * @param other Profile to merge
+         */
+        void merge(const usage_profile& other);
+
+        /**
+         * @brief Get the number of (font, size) entries.
+         * @return Entry count
+         */
+        [[nodiscard]] std::size_t size() const noexcept { return m_counters.size(); }
+
+        /**
+         * @brief Encode the profile.
+         * @return File contents
+         */
+        [[nodiscard]] std::vector<uint8_t> serialize() const;
+
+        /**
+         * @brief Decode a profile.
+         *
+         * @param data File contents
+         * @return Decoded profile
+         * @throws std::runtime_error If the data is not a valid profile
+         */
+        [[nodiscard]] static usage_profile deserialize(std::span<const uint8_t> data);
+
+        /**
+         * @brief Write the profile to a file.
+         * @param path Destination file
+         * @throws std::runtime_error If the file cannot be written
+         */
+        void save(const std::filesystem::path& path) const;
+
+        /**
+         * @brief Read a profile from a file.
+         *
+         * A missing file yields an empty profile, so the first run of an
+         * application needs no special case.
+         *
+         * @param path Source file
+         * @return Profile
+         * @throws std::runtime_error If the file exists but is not a valid profile
+         */
+        [[nodiscard]] static usage_profile load(const std::filesystem::path& path);
+
+    private:
+        /// (font identifier, size in 1/64 px)
+        using key = std::pair<std::string, uint32_t>;
+
+        [[nodiscard]] static uint32_t size_key(float size) noexcept;
+
+        std::map<key, std::shared_ptr<usage_counter>> m_counters;
+    };
+
+    /**
+     * @brief Pre-cache the most used glyphs of a profile.
+     *
+     * @tparam Cache glyph_cache instantiation
+     * @param cache Cache to fill (its size selects the profile entry)
+     * @param profile Recorded profile
+     * @param font Font identifier used when recording
+     * @param top_k Maximum number of glyphs to cache
+     * @return Number of glyphs newly cached
+     */
+    template<typename Cache>
+    std::size_t warm_up(Cache& cache, const usage_profile& profile,
+                        std::string_view font, std::size_t top_k) {
+        return cache.cache_codepoints(profile.top(font, cache.rasterizer().size(), top_k));
+    }
+
+    /**
+     * @brief Pre-cache the most used glyphs of a profile on an executor.
+     *
+     * The codepoint list is taken from @p profile before returning; the
+     * rasterization runs as one job on @p executor. glyph_cache is not
+     * thread-safe, so the cache must not be used until the returned
+     * future is ready.
+     *
+     * @tparam Cache glyph_cache instantiation
+     * @tparam Executor Callable taking a std::function<void()> job
+     * @param cache Cache to fill
+     * @param profile Recorded profile
+     * @param font Font identifier used when recording
+     * @param top_k Maximum number of glyphs to cache
+     * @param executor Submits the job (thread pool, task system, ...)
+     * @return Future with the number of glyphs newly cached
+     */
+    template<typename Cache, typename Executor>
+    std::future<std::size_t> warm_up_async(Cache& cache, const usage_profile& profile,
+                                           std::string_view font, std::size_t top_k,
+                                           Executor&& executor) {
+        auto task = std::make_shared<std::packaged_task<std::size_t()>>(
+            [&cache, codepoints = profile.top(font, cache.rasterizer().size(), top_k)] {
+                return cache.cache_codepoints(codepoints);
+            });
+        auto result = task->get_future();
+        std::forward<Executor>(executor)(std::function<void()>([task] { (*task)(); }));
+        return result;
+    }
+
+    /**
+     * @brief Pre-cache the most used glyphs of a profile on a new thread.
+     *
+     * Same as the executor overload, using std::async.
+     */
+    template<typename Cache>
+    std::future<std::size_t> warm_up_async(Cache& cache, const usage_profile& profile,
+                                           std::string_view font, std::size_t top_k) {
+        return std::async(std::launch::async,
+                          [&cache, codepoints = profile.top(font, cache.rasterizer().size(), top_k)] {
+                              return cache.cache_codepoints(codepoints);
+                          });
+    }
+} // namespace onyx_font
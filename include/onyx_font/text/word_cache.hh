@@ -0,0 +1,161 @@
+/**
+ * @file word_cache.hh
+ * @brief Memo of word widths for reflow-heavy layout.
+ *
+ * Reflowing a document (e.g. on every window resize) measures every word
+ * glyph by glyph, although the set of distinct words is small. A
+ * word_width_cache remembers the width of each word per font and size,
+ * so text_rasterizer::measure_wrapped() and text_renderer's wrapping add
+ * one cached width per word instead of one advance and one kerning
+ * lookup per glyph.
+ *
+ * @section word_cache_usage Usage
+ *
+ * @code{.cpp}
+ * auto words = std::make_shared<word_width_cache>();
+ *
+ * glyph_cache_config config;
+ * config.words = words;   // Used by the cache's rasterizer
+ * glyph_cache<memory_atlas> cache(font_source::from_ttf(font), 16.0f, config);
+ * text_renderer renderer(cache);
+ *
+ * // Every resize: wrapping adds cached word widths
+ * renderer.draw_wrapped(document, box, blit);
+ * @endcode
+ *
+ * @section word_cache_kerning Kerning
+ *
+ * A word's width includes the kerning between its own glyphs. Kerning
+ * against the glyph before the word (usually a space) depends on the
+ * context and is added by the wrapping code from word_metrics::first.
+ * word_metrics::peak is the widest prefix of the word, so a word is only
+ * added whole when no glyph of it would have wrapped; otherwise the
+ * wrapping falls back to glyph by glyph. Line breaks therefore match
+ * wrapping without the cache, up to float rounding of the summed widths.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace onyx_font {
+    class sized_face;
+
+    /**
+     * @brief Measured width of one word.
+     */
+    struct word_metrics {
+        float width = 0;      ///< Sum of advances and inner kerning
+        float peak = 0;       ///< Largest width of any prefix of the word
+        char32_t first = 0;   ///< First codepoint (for kerning before the word)
+        char32_t last = 0;    ///< Last codepoint (for kerning after the word)
+    };
+
+    /**
+     * @brief Bounded, thread-safe memo of word widths.
+     *
+     * Keyed by the word's bytes, the pixel size and the font
+     * (font_source::font_identity()). Least recently used words are
+     * dropped beyond the capacity. Call clear() after destroying a font
+     * the cache has measured, as its identity may be reused.
+     */
+    class ONYX_FONT_EXPORT word_width_cache {
+    public:
+        /// Default number of words held
+        static constexpr std::size_t default_capacity = 8192;
+
+        /**
+         * @brief Create an empty cache.
+         * @param capacity Maximum number of words held
+         */
+        explicit word_width_cache(std::size_t capacity = default_capacity) noexcept
+            : m_capacity(capacity) {
+        }
+
+        word_width_cache(const word_width_cache&) = delete;
+        word_width_cache& operator=(const word_width_cache&) = delete;
+
+        /**
+         * @brief Get the metrics of a word, measuring it on a miss.
+         *
+         * @param face Font at the size to measure with
+         * @param word UTF-8 word (no spaces or newlines expected)
+         * @return Word metrics
+         */
+        [[nodiscard]] word_metrics measure(const sized_face& face, std::string_view word);
+
+        /**
+         * @brief Measure a word without the cache.
+         *
+         * @param face Font at the size to measure with
+         * @param word UTF-8 word
+         * @return Word metrics
+         */
+        [[nodiscard]] static word_metrics measure_uncached(const sized_face& face, std::string_view word);
+
+        /**
+         * @brief Drop every word. Counters are kept.
+         */
+        void clear();
+
+        /**
+         * @brief Get the capacity.
+         * @return Maximum number of words held
+         */
+        [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+
+        /**
+         * @brief Get the number of words held.
+         * @return Word count
+         */
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * @brief Get the number of lookups served from the cache.
+         * @return Hit count
+         */
+        [[nodiscard]] uint64_t hits() const;
+
+        /**
+         * @brief Get the number of lookups that measured the word.
+         * @return Miss count
+         */
+        [[nodiscard]] uint64_t misses() const;
+
+    private:
+        struct key {
+            std::size_t hash;
+            uint32_t size_64;
+            const void* font;
+
+            bool operator==(const key&) const = default;
+        };
+
+        struct key_hash {
+            std::size_t operator()(const key& k) const noexcept;
+        };
+
+        struct entry {
+            key k;
+            std::string word;  ///< Guards against hash collisions
+            word_metrics metrics;
+        };
+
+        std::size_t m_capacity;
+        mutable std::mutex m_mutex;
+        std::list<entry> m_lru;  ///< Most recently used first
+        std::unordered_map<key, std::list<entry>::iterator, key_hash> m_index;
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+    };
+} // namespace onyx_font
@@ -376,6 +376,26 @@ namespace onyx_font {
          */
         [[nodiscard]] ttf_font_metrics get_metrics(float pixel_height) const;
 
+        /**
+         * @brief Get the scale factor from font units to pixels.
+         *
+         * Callers issuing many queries at one size compute this once and
+         * use the *_at_scale variants, which skip the per-call scale
+         * computation.
+         *
+         * @param pixel_height Desired font size in pixels
+         * @return Scale factor, or 0 if the font is invalid
+         */
+        [[nodiscard]] float scale_for_pixel_height(float pixel_height) const;
+
+        /**
+         * @brief Get font metrics for a precomputed scale.
+         *
+         * @param scale Scale from scale_for_pixel_height()
+         * @return Scaled font metrics
+         */
+        [[nodiscard]] ttf_font_metrics get_metrics_at_scale(float scale) const;
+
         /**
          * @brief Get glyph metrics for text layout.
          *
@@ -392,6 +412,18 @@ namespace onyx_font {
             float pixel_height
         ) const;
 
+        /**
+         * @brief Get glyph metrics for a precomputed scale.
+         *
+         * @param codepoint Unicode codepoint
+         * @param scale Scale from scale_for_pixel_height()
+         * @return Glyph metrics, or nullopt if glyph not found
+         */
+        [[nodiscard]] std::optional<ttf_glyph_metrics> get_glyph_metrics_at_scale(
+            uint32_t codepoint,
+            float scale
+        ) const;
+
         /**
          * @brief Get glyph outline shape.
          *
@@ -407,6 +439,18 @@ namespace onyx_font {
             float pixel_height
         ) const;
 
+        /**
+         * @brief Get glyph outline for a precomputed scale.
+         *
+         * @param codepoint Unicode codepoint
+         * @param scale Scale from scale_for_pixel_height()
+         * @return Glyph shape with vertices, or nullopt if not found
+         */
+        [[nodiscard]] std::optional<ttf_glyph_shape> get_glyph_shape_at_scale(
+            uint32_t codepoint,
+            float scale
+        ) const;
+
         /**
          * @brief Get kerning adjustment between two characters.
          *
@@ -430,6 +474,20 @@ namespace onyx_font {
             float pixel_height
         ) const;
 
+        /**
+         * @brief Get kerning adjustment for a precomputed scale.
+         *
+         * @param first First character codepoint
+         * @param second Second character codepoint
+         * @param scale Scale from scale_for_pixel_height()
+         * @return Kerning adjustment (add to advance_x)
+         */
+        [[nodiscard]] float get_kerning_at_scale(
+            uint32_t first,
+            uint32_t second,
+            float scale
+        ) const;
+
         /**
          * @brief Check if font contains a specific glyph.
          *
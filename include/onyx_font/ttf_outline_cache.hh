@@ -0,0 +1,319 @@
+/**
+ * @file ttf_outline_cache.hh
+ * @brief Cache of unscaled TTF glyph outlines and per-size flattened polylines.
+ *
+ * ttf_font::get_glyph_shape() parses the glyf/CFF data and allocates a
+ * scaled vertex vector on every call. Consumers that walk outlines
+ * repeatedly (SDF generation, custom rasterizers, vector export) pay that
+ * cost for every glyph, at every size.
+ *
+ * @section outline_cache_layers Layers
+ *
+ * - **ttf_outline_cache** parses each glyph once and stores its outline in
+ *   font units: verbs as one byte each, coordinates as int16, packed into
+ *   a block arena. Scaled shapes are produced from the arena into a
+ *   caller-owned ttf_glyph_shape, reusing its capacity.
+ * - **flattened_outline_cache** sits on top for one pixel size and keeps
+ *   each glyph's contours as polylines within a flatness tolerance.
+ *
+ * Pointers and spans returned by either cache stay valid for the lifetime
+ * of the cache: arena blocks are never moved.
+ *
+ * @section outline_cache_usage Usage
+ *
+ * @code{.cpp}
+ * ttf_font font(data);
+ * ttf_outline_cache outlines(font);
+ *
+ * // Scaled shape without re-parsing the font
+ * ttf_glyph_shape shape;
+ * outlines.get_shape('A', 48.0f, shape);
+ *
+ * // Polylines for an SDF generator at 32px
+ * flattened_outline_cache flat(outlines, 32.0f);
+ * if (const flattened_glyph* g = flat.get('A')) {
+ *     std::size_t start = 0;
+ *     for (uint32_t end : g->contour_ends) {
+ *         auto contour = g->points.subspan(start, end - start);  // closed loop
+ *         start = end;
+ *     }
+ * }
+ * @endcode
+ *
+ * Neither cache is thread-safe; use one per thread or synchronize.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/ttf_font.hh>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace onyx_font {
+    namespace internal {
+        /**
+         * @brief Append-only storage whose elements never move.
+         *
+         * Memory is taken from fixed-size blocks; a request larger than a
+         * block gets a block of its own.
+         *
+         * @tparam T Trivially copyable element type
+         */
+        template<typename T>
+        class block_arena {
+        public:
+            explicit block_arena(std::size_t block_elements = 4096)
+                : m_block_elements(block_elements) {}
+
+            /// Copy @p values into the arena and return the stored copy
+            std::span<const T> append(std::span<const T> values) {
+                if (values.empty()) {
+                    return {};
+                }
+                if (m_blocks.empty() || m_used + values.size() > m_capacity) {
+                    m_capacity = std::max(m_block_elements, values.size());
+                    m_blocks.push_back(std::make_unique<T[]>(m_capacity));
+                    m_used = 0;
+                    m_reserved += m_capacity;
+                }
+                T* dst = m_blocks.back().get() + m_used;
+                std::copy(values.begin(), values.end(), dst);
+                m_used += values.size();
+                return {dst, values.size()};
+            }
+
+            /// Elements reserved across all blocks
+            [[nodiscard]] std::size_t reserved() const noexcept { return m_reserved; }
+
+        private:
+            std::vector<std::unique_ptr<T[]>> m_blocks;
+            std::size_t m_block_elements;
+            std::size_t m_used = 0;
+            std::size_t m_capacity = 0;
+            std::size_t m_reserved = 0;
+        };
+    }
+
+    /**
+     * @brief Unscaled glyph outline stored in a ttf_outline_cache.
+     *
+     * Coordinates are in font units, Y up. Each verb consumes coordinate
+     * pairs from @p coords in order:
+     *
+     * | Verb     | Coordinates             |
+     * |----------|-------------------------|
+     * | MOVE_TO  | x, y                    |
+     * | LINE_TO  | x, y                    |
+     * | CURVE_TO | cx, cy, x, y            |
+     * | CUBIC_TO | cx, cy, cx1, cy1, x, y  |
+     */
+    struct ONYX_FONT_EXPORT glyph_outline {
+        std::span<const ttf_vertex_type> verbs;  ///< Path commands
+        std::span<const int16_t> coords;         ///< Packed coordinates
+        int16_t x0 = 0;             ///< Bounding box left
+        int16_t y0 = 0;             ///< Bounding box bottom
+        int16_t x1 = 0;             ///< Bounding box right
+        int16_t y1 = 0;             ///< Bounding box top
+        int32_t advance_x = 0;      ///< Horizontal advance
+        int32_t bearing_x = 0;      ///< Left side bearing
+    };
+
+    /**
+     * @brief Point of a flattened outline.
+     */
+    struct flat_point {
+        float x;  ///< X in pixels
+        float y;  ///< Y in pixels (up, baseline at 0)
+    };
+
+    /**
+     * @brief Glyph outline flattened to closed polylines at one size.
+     *
+     * Contour i spans points [contour_ends[i-1], contour_ends[i]) (the
+     * first starts at 0) and is implicitly closed.
+     */
+    struct ONYX_FONT_EXPORT flattened_glyph {
+        std::span<const flat_point> points;       ///< All contour points
+        std::span<const uint32_t> contour_ends;   ///< One past each contour's last point
+        float advance_x = 0;   ///< Horizontal advance in pixels
+        float bearing_x = 0;   ///< Left side bearing in pixels
+        float x0 = 0;          ///< Bounding box left
+        float y0 = 0;          ///< Bounding box bottom
+        float x1 = 0;          ///< Bounding box right
+        float y1 = 0;          ///< Bounding box top
+    };
+
+    /**
+     * @brief Flatten an outline into closed polylines.
+     *
+     * Curves are split uniformly into the fewest segments keeping the
+     * chord error below @p tolerance pixels. Consecutive duplicate points
+     * are dropped, as is the closing point when it repeats the first one.
+     *
+     * @param outline Unscaled outline
+     * @param scale Font units to pixels
+     * @param tolerance Maximum deviation from the curve in pixels (> 0)
+     * @param points Receives the points (cleared first)
+     * @param contour_ends Receives contour end indices (cleared first)
+     */
+    ONYX_FONT_EXPORT void flatten_outline(const glyph_outline& outline, float scale, float tolerance,
+                                          std::vector<flat_point>& points,
+                                          std::vector<uint32_t>& contour_ends);
+
+    /**
+     * @brief Cache of unscaled glyph outlines for one ttf_font.
+     *
+     * The font must outlive the cache.
+     */
+    class ONYX_FONT_EXPORT ttf_outline_cache {
+    public:
+        /**
+         * @brief Create an empty cache.
+         * @param font Font to read outlines from (must remain valid)
+         */
+        explicit ttf_outline_cache(const ttf_font& font);
+
+        /**
+         * @brief Get the unscaled outline, parsing it on first use.
+         *
+         * @param codepoint Unicode codepoint
+         * @return Outline, or nullptr if the font has no such glyph
+         */
+        const glyph_outline* get(char32_t codepoint);
+
+        /**
+         * @brief Produce a scaled shape from the cached outline.
+         *
+         * Equivalent to ttf_font::get_glyph_shape(), but the font is parsed
+         * only once per glyph and @p out keeps its vertex capacity, so
+         * repeated calls do not allocate.
+         *
+         * @param codepoint Unicode codepoint
+         * @param pixel_height Desired font size in pixels
+         * @param out Receives the shape
+         * @return false if the font has no such glyph (out is untouched)
+         */
+        bool get_shape(char32_t codepoint, float pixel_height, ttf_glyph_shape& out);
+
+        /**
+         * @brief Get the scale for a pixel height.
+         * @param pixel_height Desired font size in pixels
+         * @return Font units to pixels
+         */
+        [[nodiscard]] float scale_for_pixel_height(float pixel_height) const {
+            return m_font->scale_for_pixel_height(pixel_height);
+        }
+
+        /**
+         * @brief Get the font.
+         * @return Font the outlines come from
+         */
+        [[nodiscard]] const ttf_font& font() const noexcept { return *m_font; }
+
+        /**
+         * @brief Get number of cached entries (including missing glyphs).
+         * @return Entry count
+         */
+        [[nodiscard]] std::size_t glyph_count() const noexcept { return m_glyphs.size(); }
+
+        /**
+         * @brief Get memory reserved for outline data.
+         * @return Bytes held by the verb and coordinate arenas
+         */
+        [[nodiscard]] std::size_t arena_bytes() const noexcept {
+            return m_verbs.reserved() * sizeof(ttf_vertex_type) + m_coords.reserved() * sizeof(int16_t);
+        }
+
+    private:
+        struct entry {
+            glyph_outline outline;
+            bool present = false;
+        };
+
+        const ttf_font* m_font;
+        std::unordered_map<char32_t, entry> m_glyphs;
+        internal::block_arena<ttf_vertex_type> m_verbs;
+        internal::block_arena<int16_t> m_coords;
+
+        // Scratch buffers reused while packing a glyph
+        std::vector<ttf_vertex_type> m_verb_scratch;
+        std::vector<int16_t> m_coord_scratch;
+    };
+
+    /**
+     * @brief Per-size cache of flattened outlines.
+     *
+     * The outline cache must outlive this cache.
+     */
+    class ONYX_FONT_EXPORT flattened_outline_cache {
+    public:
+        /**
+         * @brief Create an empty cache for one size.
+         *
+         * @param outlines Source of unscaled outlines (must remain valid)
+         * @param pixel_height Font size in pixels
+         * @param tolerance Maximum deviation from the curves in pixels
+         */
+        flattened_outline_cache(ttf_outline_cache& outlines, float pixel_height,
+                                float tolerance = 0.25f);
+
+        /**
+         * @brief Get the flattened glyph, flattening it on first use.
+         *
+         * @param codepoint Unicode codepoint
+         * @return Flattened glyph, or nullptr if the font has no such glyph
+         */
+        const flattened_glyph* get(char32_t codepoint);
+
+        /**
+         * @brief Get the pixel size.
+         * @return Pixel height
+         */
+        [[nodiscard]] float pixel_height() const noexcept { return m_pixel_height; }
+
+        /**
+         * @brief Get the scale.
+         * @return Font units to pixels
+         */
+        [[nodiscard]] float scale() const noexcept { return m_scale; }
+
+        /**
+         * @brief Get the flatness tolerance.
+         * @return Maximum deviation in pixels
+         */
+        [[nodiscard]] float tolerance() const noexcept { return m_tolerance; }
+
+        /**
+         * @brief Get number of cached entries (including missing glyphs).
+         * @return Entry count
+         */
+        [[nodiscard]] std::size_t glyph_count() const noexcept { return m_glyphs.size(); }
+
+    private:
+        struct entry {
+            flattened_glyph glyph;
+            bool present = false;
+        };
+
+        ttf_outline_cache* m_outlines;
+        float m_pixel_height;
+        float m_scale;
+        float m_tolerance;
+        std::unordered_map<char32_t, entry> m_glyphs;
+        internal::block_arena<flat_point> m_points;
+        internal::block_arena<uint32_t> m_contours;
+
+        // Scratch buffers reused while flattening a glyph
+        std::vector<flat_point> m_point_scratch;
+        std::vector<uint32_t> m_contour_scratch;
+    };
+} // namespace onyx_font
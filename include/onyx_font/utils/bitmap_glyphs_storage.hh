@@ -96,6 +96,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <span>
 #include <vector>
 
@@ -309,8 +310,9 @@ namespace onyx_font {
      * render_glyph(glyph);
      * @endcode
      *
-     * @note bitmap_storage is move-only. It owns its data and provides
-     *       views that reference into it.
+     * @note bitmap_storage owns its data and provides views that
+     *       reference into it, unless created by wrap_uniform(), in which
+     *       case it shares ownership of the wrapped bytes.
      *
      * @see bitmap_builder For constructing storage
      * @see bitmap_view For accessing glyph pixel data
@@ -375,6 +377,57 @@ namespace onyx_font {
          */
         [[nodiscard]] std::span<const std::byte> blob_bytes() const noexcept;
 
+        /**
+         * @brief Wrap glyph bytes owned elsewhere without copying them.
+         *
+         * Serves fonts whose file layout already matches the packed layout
+         * (for example PSF console fonts): @p glyph_count glyphs of
+         * @p width x @p height pixels stored back to back. The storage
+         * keeps @p owner alive for as long as it (or a copy) exists, so
+         * @p bytes may point into a memory-mapped file.
+         *
+         * @param owner Keeps @p bytes valid (must not be null)
+         * @param bytes Packed glyph bytes
+         * @param glyph_count Number of glyphs
+         * @param width Glyph width in pixels
+         * @param height Glyph height in pixels
+         * @param order Bit order of the bytes
+         * @return Storage viewing @p bytes
+         * @throws std::invalid_argument if @p bytes is too small
+         */
+        static bitmap_storage wrap_uniform(std::shared_ptr<const void> owner,
+                                           std::span<const std::byte> bytes,
+                                           std::size_t glyph_count,
+                                           std::uint16_t width,
+                                           std::uint16_t height,
+                                           bit_order order = bit_order::msb_first);
+
+        /**
+         * @brief Wrap glyphs of varying size owned elsewhere without copying them.
+         *
+         * The bytes must hold the glyphs back to back in the packed layout
+         * that bitmap_builder produces: glyph i is @p glyphs[i].height rows
+         * of packed_stride(@p glyphs[i].width) bytes. Used for font bundles,
+         * whose glyph blobs are read straight from the mapped file.
+         *
+         * @param owner Keeps @p bytes valid (must not be null)
+         * @param bytes Packed glyph bytes
+         * @param glyphs Dimensions of each glyph, in storage order
+         * @param order Bit order of the bytes
+         * @return Storage viewing @p bytes
+         * @throws std::invalid_argument if @p bytes is too small
+         */
+        static bitmap_storage wrap(std::shared_ptr<const void> owner,
+                                   std::span<const std::byte> bytes,
+                                   std::span<const glyph_dimensions> glyphs,
+                                   bit_order order = bit_order::msb_first);
+
+        /**
+         * @brief Check whether the glyph bytes are owned elsewhere.
+         * @return True for storage created by wrap_uniform() or wrap()
+         */
+        [[nodiscard]] bool is_borrowed() const noexcept;
+
     private:
         friend class bitmap_builder;
 
@@ -390,6 +443,10 @@ namespace onyx_font {
         bit_order m_order = bit_order::msb_first;
         std::vector<std::byte> m_blob;
         std::vector<glyph_internal> m_glyphs;
+        std::shared_ptr<const void> m_owner;      ///< Set when the bytes are borrowed
+        std::span<const std::byte> m_borrowed;    ///< Borrowed glyph bytes
+
+        [[nodiscard]] std::span<const std::byte> bytes() const noexcept;
     };
 
     /**
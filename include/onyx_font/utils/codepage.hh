@@ -0,0 +1,129 @@
+/**
+ * @file codepage.hh
+ * @brief Built-in 8-bit codepage tables with O(1) Unicode lookup.
+ *
+ * Windows FON, BGI and raw BIOS fonts index their glyphs by byte value in
+ * a legacy codepage (CP437 on the VGA BIOS, CP1252 for ANSI Windows
+ * fonts, ...). Text arrives as UTF-8, so each codepoint has to be turned
+ * back into the font's byte before the glyph can be found. A
+ * codepage_table does that with one array read: the reverse table is
+ * indexed directly by codepoint and covers every codepoint up to the
+ * highest one the codepage uses (about 10 KB per table).
+ *
+ * @code
+ *   byte -> Unicode   decode[256]           0x82 -> U+00E9 'é'
+ *   Unicode -> byte   encode[max + 1]       U+00E9 -> 0x82
+ *                     (0 = unmapped, except for U+0000)
+ * @endcode
+ *
+ * Tables are built on first use and live for the program's lifetime, so
+ * references returned by codepage_table::get() never dangle.
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Supported 8-bit codepages.
+     *
+     * The DOS codepages decode bytes 0x01-0x1F and 0x7F to the PC graphic
+     * characters (☺, ♥, ►, ⌂, ...) that VGA fonts draw there.
+     */
+    enum class codepage : uint8_t {
+        cp437,   ///< IBM PC / DOS United States (VGA BIOS, BGI, OEM fonts)
+        cp850,   ///< DOS Western European
+        cp866,   ///< DOS Cyrillic
+        cp1250,  ///< Windows Central European
+        cp1251,  ///< Windows Cyrillic
+        cp1252   ///< Windows Western European (ANSI)
+    };
+
+    /**
+     * @brief Bidirectional byte <-> Unicode table for one codepage.
+     *
+     * @code{.cpp}
+     * const auto& cp437 = codepage_table::get(codepage::cp437);
+     *
+     * cp437.decode(0xC4);            // U+2500 '─'
+     * cp437.encode(U'─');            // 0xC4
+     * cp437.encode(U'中');           // nullopt
+     * @endcode
+     *
+     * Attach a table to a font_source to render UTF-8 text with an 8-bit
+     * font; font_source does this automatically when the font's charset
+     * is known.
+     */
+    class ONYX_FONT_EXPORT codepage_table {
+    public:
+        /**
+         * @brief Get the built-in table for a codepage.
+         * @param cp Codepage
+         * @return Table (valid for the program's lifetime)
+         */
+        static const codepage_table& get(codepage cp);
+
+        /**
+         * @brief Map a Windows font charset to a codepage.
+         *
+         * Handles ANSI_CHARSET (0), OEM_CHARSET (255), RUSSIAN_CHARSET (204)
+         * and EASTEUROPE_CHARSET (238).
+         *
+         * @param charset dfCharSet value from a Windows font resource
+         * @return Codepage, or nullopt for symbol and unknown charsets
+         */
+        static std::optional<codepage> from_windows_charset(uint8_t charset) noexcept;
+
+        /// Codepage this table describes
+        [[nodiscard]] codepage id() const noexcept { return m_id; }
+
+        /**
+         * @brief Convert a byte to its Unicode codepoint.
+         * @param byte Character code in this codepage
+         * @return Unicode codepoint
+         */
+        [[nodiscard]] char32_t decode(uint8_t byte) const noexcept {
+            return m_decode[byte];
+        }
+
+        /**
+         * @brief Convert a Unicode codepoint to a byte.
+         *
+         * C0 control codes and U+007F map to their own byte even where
+         * decode() returns a graphic character, so text that already uses
+         * raw byte values keeps working.
+         *
+         * @param codepoint Unicode codepoint
+         * @return Byte in this codepage, or nullopt if it has none
+         */
+        [[nodiscard]] std::optional<uint8_t> encode(char32_t codepoint) const noexcept {
+            if (codepoint >= m_encode.size()) {
+                return std::nullopt;
+            }
+            const uint8_t byte = m_encode[codepoint];
+            if (byte == 0 && codepoint != 0) {
+                return std::nullopt;
+            }
+            return byte;
+        }
+
+        /// Bytes used by the decode and encode tables
+        [[nodiscard]] std::size_t memory_usage() const noexcept;
+
+    private:
+        codepage m_id;
+        std::array<char32_t, 256> m_decode{};
+        std::vector<uint8_t> m_encode;   ///< Indexed by codepoint (0 = unmapped)
+
+        codepage_table(codepage id, const char16_t (&high)[128], bool dos_graphics);
+    };
+} // namespace onyx_font
@@ -0,0 +1,136 @@
+/**
+ * @file codepoint_index.hh
+ * @brief Sparse Unicode codepoint to glyph index map with O(1) lookup.
+ *
+ * Fonts that cover more than a contiguous 8-bit range (PSF console fonts
+ * with Unicode tables, CJK bitmap strikes) need to find the glyph for an
+ * arbitrary codepoint quickly. A hash map costs a hash and a probe per
+ * character; a sorted table costs a binary search. codepoint_index is a
+ * two-level page table instead: the high bits of the codepoint select a
+ * 256-entry page, the low 8 bits select the slot. A lookup is two array
+ * reads, and only the pages that hold mappings take memory.
+ *
+ * @code
+ *   codepoint  U+4E2D
+ *              |  |
+ *     block = 0x4E    slot = 0x2D
+ *              |
+ *   directory[0x4E] -> page 3
+ *                        pages[3 * 256 + 0x2D] -> glyph 1234
+ * @endcode
+ *
+ * Blocks without mappings point at a shared page of npos entries, so
+ * lookups never branch on "page present".
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace onyx_font {
+    /**
+     * @brief Two-level page table mapping codepoints to glyph indices.
+     *
+     * @code{.cpp}
+     * codepoint_index index;
+     * index.insert_range(U' ', U'~', 32);  // ASCII at glyphs 32..126
+     * index.insert(U'é', 130);
+     *
+     * auto glyph = index.find(U'é');  // 130
+     * if (index.find(U'中') == codepoint_index::npos) { ... }
+     * @endcode
+     */
+    class ONYX_FONT_EXPORT codepoint_index {
+    public:
+        /// Returned by find() for unmapped codepoints
+        static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+        /// Codepoints per page
+        static constexpr std::size_t page_size = 256;
+
+        /**
+         * @brief Construct an empty index.
+         */
+        codepoint_index();
+
+        /**
+         * @brief Map a codepoint to a glyph.
+         *
+         * An existing mapping for the codepoint is kept.
+         *
+         * @param codepoint Unicode codepoint (<= U+10FFFF)
+         * @param glyph Glyph index (must not be npos)
+         * @return True if the mapping was added
+         */
+        bool insert(char32_t codepoint, std::uint32_t glyph);
+
+        /**
+         * @brief Map consecutive codepoints to consecutive glyphs.
+         *
+         * @param first First codepoint
+         * @param last Last codepoint (inclusive)
+         * @param first_glyph Glyph index for @p first
+         */
+        void insert_range(char32_t first, char32_t last, std::uint32_t first_glyph);
+
+        /**
+         * @brief Look up the glyph for a codepoint.
+         * @param codepoint Unicode codepoint
+         * @return Glyph index, or npos if unmapped
+         */
+        [[nodiscard]] std::uint32_t find(char32_t codepoint) const noexcept {
+            const std::size_t block = static_cast<std::size_t>(codepoint) >> 8;
+            if (block >= m_directory.size()) {
+                return npos;
+            }
+            return m_pages[static_cast<std::size_t>(m_directory[block]) * page_size + (codepoint & 0xFFu)];
+        }
+
+        /**
+         * @brief Check whether a codepoint is mapped.
+         * @param codepoint Unicode codepoint
+         * @return True if find() would return a glyph
+         */
+        [[nodiscard]] bool contains(char32_t codepoint) const noexcept {
+            return find(codepoint) != npos;
+        }
+
+        /// Number of mapped codepoints
+        [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+        /// True if no codepoint is mapped
+        [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+        /// Lowest mapped codepoint (0 if empty)
+        [[nodiscard]] char32_t min_codepoint() const noexcept { return m_min; }
+
+        /// Highest mapped codepoint (0 if empty)
+        [[nodiscard]] char32_t max_codepoint() const noexcept { return m_max; }
+
+        /// Number of allocated pages, including the shared empty page
+        [[nodiscard]] std::size_t page_count() const noexcept { return m_pages.size() / page_size; }
+
+        /// Bytes used by the directory and pages
+        [[nodiscard]] std::size_t memory_usage() const noexcept;
+
+        /**
+         * @brief Remove all mappings and release the pages.
+         */
+        void clear() noexcept;
+
+    private:
+        std::vector<std::uint16_t> m_directory;  ///< Page number per block (0 = shared empty page)
+        std::vector<std::uint32_t> m_pages;      ///< page_count() * page_size glyph indices
+        std::size_t m_size = 0;
+        char32_t m_min = 0;
+        char32_t m_max = 0;
+
+        std::uint32_t& slot(char32_t codepoint);
+    };
+} // namespace onyx_font
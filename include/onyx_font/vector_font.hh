@@ -93,12 +93,15 @@
 #include <onyx_font/export.h>
 #include <string>
 #include <cstdint>
+#include <optional>
 #include <vector>
+#include <onyx_font/utils/codepage.hh>
 
 namespace onyx_font {
     namespace internal {
         struct win_vector_fon_loader;
         struct bgi_font_loader;
+        struct bundle_font_codec;
     }
 
     /**
@@ -300,6 +303,7 @@ namespace onyx_font {
     class ONYX_FONT_EXPORT vector_font {
         friend struct internal::win_vector_fon_loader;
         friend struct internal::bgi_font_loader;
+        friend struct internal::bundle_font_codec;
 
     public:
         /**
@@ -334,6 +338,15 @@ namespace onyx_font {
          */
         [[nodiscard]] uint8_t get_default_char() const;
 
+        /**
+         * @brief Get the codepage of the font's character codes.
+         *
+         * CP437 for BGI fonts; derived from the charset for Windows fonts.
+         *
+         * @return Codepage, or nullopt if unknown
+         */
+        [[nodiscard]] std::optional<codepage> get_codepage() const;
+
         /**
          * @brief Get font-level metrics.
          * @return Reference to font metrics
@@ -363,6 +376,7 @@ namespace onyx_font {
         uint8_t m_first_char{};          ///< First character in font
         uint8_t m_last_char{};           ///< Last character in font
         uint8_t m_default_char{};        ///< Fallback character
+        std::optional<codepage> m_codepage;  ///< Encoding of character codes
 
         vector_font_metrics m_metrics{}; ///< Font-level metrics
         std::vector<vector_glyph> m_glyphs;  ///< Glyph data
@@ -0,0 +1,188 @@
+/**
+ * @file vector_geometry.hh
+ * @brief GPU-ready line geometry for stroke-based vector fonts.
+ *
+ * Vector fonts are made of straight segments, so a string can be drawn by
+ * the GPU as lines or thin quads at any size and under any transform,
+ * without rasterizing glyphs into an atlas.
+ *
+ * build_line_geometry() lays out a string with a vector_font and writes a
+ * flat vertex and index buffer:
+ *
+ * | Mode            | Per segment                | Draw as                 |
+ * |-----------------|----------------------------|-------------------------|
+ * | thickness == 0  | 2 vertices, 2 indices      | GL_LINES / LineList     |
+ * | thickness > 0   | 4 vertices, 6 indices      | GL_TRIANGLES / TriList  |
+ *
+ * Layout space is in pixels, Y down, with the pen starting at the left of
+ * the first baseline. The transform is applied to every vertex (SSE2 when
+ * available); thick quads are expanded afterwards, so thickness is in
+ * output units regardless of rotation or scale.
+ *
+ * @section line_geometry_usage Usage
+ *
+ * @code{.cpp}
+ * line_geometry geometry;  // Reuse across frames: no allocation once warm
+ *
+ * line_geometry_options options;
+ * options.size = 32.0f;
+ * options.thickness = 1.5f;
+ * options.transform = affine_transform::translation(100, 200)
+ *                   * affine_transform::rotation(0.2f);
+ *
+ * build_line_geometry(font, "Hello", options, geometry);
+ * upload(geometry.vertices, geometry.indices);
+ * @endcode
+ *
+ * @author Igor
+ * @date 18/10/2026
+ */
+
+#pragma once
+
+#include <onyx_font/export.h>
+#include <onyx_font/vector_font.hh>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace onyx_font {
+
+    /**
+     * @brief 2D vertex of exported line geometry.
+     *
+     * Tightly packed (8 bytes) so the vertex array can be uploaded as is.
+     */
+    struct line_vertex {
+        float x;  ///< X position
+        float y;  ///< Y position
+    };
+
+    static_assert(sizeof(line_vertex) == 2 * sizeof(float), "line_vertex must be tightly packed");
+
+    /**
+     * @brief 2D affine transform.
+     *
+     * Maps (x, y) to (a*x + c*y + tx, b*x + d*y + ty). Composition with
+     * operator* applies the right-hand transform first.
+     */
+    struct ONYX_FONT_EXPORT affine_transform {
+        float a = 1.0f;   ///< X scale / rotation
+        float b = 0.0f;   ///< Y shear / rotation
+        float c = 0.0f;   ///< X shear / rotation
+        float d = 1.0f;   ///< Y scale / rotation
+        float tx = 0.0f;  ///< X translation
+        float ty = 0.0f;  ///< Y translation
+
+        /// Translation by (x, y)
+        [[nodiscard]] static affine_transform translation(float x, float y) noexcept;
+
+        /// Non-uniform scale about the origin
+        [[nodiscard]] static affine_transform scaling(float sx, float sy) noexcept;
+
+        /// Rotation about the origin (radians, clockwise on a Y-down screen)
+        [[nodiscard]] static affine_transform rotation(float radians) noexcept;
+
+        /// Apply to a single point
+        [[nodiscard]] line_vertex apply(line_vertex p) const noexcept {
+            return {a * p.x + c * p.y + tx, b * p.x + d * p.y + ty};
+        }
+
+        /// Composition: (lhs * rhs).apply(p) == lhs.apply(rhs.apply(p))
+        [[nodiscard]] affine_transform operator*(const affine_transform& rhs) const noexcept;
+    };
+
+    /**
+     * @brief Options for build_line_geometry().
+     */
+    struct ONYX_FONT_EXPORT line_geometry_options {
+        /**
+         * @brief Font size in pixels.
+         *
+         * 0 uses the font's native pixel height.
+         */
+        float size = 0.0f;
+
+        /**
+         * @brief Stroke width in output units.
+         *
+         * 0 emits a line list; a positive value emits one quad (two
+         * triangles) per segment.
+         */
+        float thickness = 0.0f;
+
+        /// Transform from layout space to output space
+        affine_transform transform{};
+    };
+
+    /**
+     * @brief Reusable output buffer for build_line_geometry().
+     *
+     * Building into the same object again keeps the vector capacities, so
+     * once the buffer has grown to the largest string no allocation occurs.
+     */
+    struct ONYX_FONT_EXPORT line_geometry {
+        std::vector<line_vertex> vertices;  ///< Vertex buffer
+        std::vector<uint32_t> indices;      ///< Index buffer
+        std::size_t segment_count = 0;      ///< Number of stroke segments
+        bool triangles = false;             ///< true for quads, false for a line list
+        float advance = 0.0f;               ///< Layout-space width of the widest line
+
+        /// Empty the buffers, keeping their capacity
+        void clear() noexcept {
+            vertices.clear();
+            indices.clear();
+            segment_count = 0;
+            triangles = false;
+            advance = 0.0f;
+        }
+    };
+
+    /**
+     * @brief Lay out a string and export its strokes as line geometry.
+     *
+     * Follows the same pen rules as the CPU rasterizer: the pen starts
+     * down, MOVE_TO moves without drawing, END lifts the pen. Codepoints
+     * are encoded through the font's codepage (vector_font::get_codepage())
+     * as font_source does, so both paths pick the same glyphs. Characters
+     * outside the font use its default character; codepoints the codepage
+     * cannot encode (or above 255 without one) are skipped. A newline returns the pen to x = 0 and moves it down
+     * by one line (the font size).
+     *
+     * @param font Vector font
+     * @param text UTF-8 text
+     * @param options Size, thickness and transform
+     * @param out Receives the geometry (previous contents are replaced)
+     */
+    ONYX_FONT_EXPORT void build_line_geometry(const vector_font& font, std::string_view text,
+                                              const line_geometry_options& options,
+                                              line_geometry& out);
+
+    /**
+     * @brief Transform vertices in place.
+     * @param vertices Vertices to transform
+     * @param transform Transform to apply
+     */
+    ONYX_FONT_EXPORT void transform_vertices(std::span<line_vertex> vertices,
+                                             const affine_transform& transform) noexcept;
+
+    /**
+     * @brief Transform vertices in place without SIMD.
+     *
+     * Reference implementation; results match transform_vertices() up to
+     * floating-point rounding.
+     *
+     * @param vertices Vertices to transform
+     * @param transform Transform to apply
+     */
+    ONYX_FONT_EXPORT void transform_vertices_scalar(std::span<line_vertex> vertices,
+                                                    const affine_transform& transform) noexcept;
+
+    /**
+     * @brief Check whether the SIMD transform path is compiled in.
+     * @return true if transform_vertices() uses SSE2
+     */
+    [[nodiscard]] ONYX_FONT_EXPORT bool line_geometry_has_simd() noexcept;
+} // namespace onyx_font
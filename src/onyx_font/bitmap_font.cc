@@ -12,38 +12,85 @@ namespace onyx_font {
         return m_name;
     }
 
-    uint8_t bitmap_font::get_first_char() const {
+    char32_t bitmap_font::get_first_char() const {
         return m_first_char;
     }
 
-    uint8_t bitmap_font::get_last_char() const {
+    char32_t bitmap_font::get_last_char() const {
         return m_last_char;
     }
 
-    uint8_t bitmap_font::get_default_char() const {
+    char32_t bitmap_font::get_default_char() const {
         return m_default_char;
     }
 
-    uint8_t bitmap_font::get_break_char() const {
+    char32_t bitmap_font::get_break_char() const {
         return m_break_char;
     }
 
+    std::optional<codepage> bitmap_font::get_codepage() const {
+        return m_codepage;
+    }
+
     const font_metrics& bitmap_font::get_metrics() const {
         return m_metrics;
     }
 
-    const glyph_spacing& bitmap_font::get_spacing(uint8_t ch) const {
-        if (ch < m_first_char || ch > m_last_char) {
+    bool bitmap_font::has_glyph(char32_t ch) const {
+        return find_glyph(ch).has_value();
+    }
+
+    const glyph_spacing& bitmap_font::get_spacing(char32_t ch) const {
+        auto idx = find_glyph(ch);
+        if (!idx || *idx >= m_spacing.size()) {
             THROW_OUT_OF_RANGE("Character is out of range for font", m_name);
         }
-        return m_spacing[ch - m_first_char];
+        return m_spacing[*idx];
     }
 
-    bitmap_view bitmap_font::get_glyph(uint8_t ch) const {
-        if (ch < m_first_char || ch > m_last_char) {
+    bitmap_view bitmap_font::get_glyph(char32_t ch) const {
+        auto idx = find_glyph(ch);
+        if (!idx) {
             THROW_OUT_OF_RANGE("Character is out of range for font", m_name);
         }
+        return m_storage.view(*idx);
+    }
+
+    std::size_t bitmap_font::get_glyph_count() const {
+        return m_storage.glyph_count();
+    }
+
+    bool bitmap_font::has_unicode_table() const {
+        return !m_index.empty();
+    }
+
+    std::optional<std::size_t> bitmap_font::find_glyph(char32_t ch) const {
+        if (!m_index.empty()) {
+            const auto glyph = m_index.find(ch);
+            if (glyph == codepoint_index::npos) {
+                return std::nullopt;
+            }
+            return glyph;
+        }
+        if (ch < m_first_char || ch > m_last_char) {
+            return std::nullopt;
+        }
         const std::size_t idx = ch - m_first_char;
-        return m_storage.view(idx);
+        if (idx >= m_storage.glyph_count()) {
+            return std::nullopt;
+        }
+        return idx;
+    }
+
+    bitmap_view bitmap_font::get_glyph_by_index(std::size_t index) const {
+        if (index >= m_storage.glyph_count()) {
+            THROW_OUT_OF_RANGE("Glyph index is out of range for font", m_name);
+        }
+        return m_storage.view(index);
+    }
+
+    void bitmap_font::use_index() {
+        m_first_char = m_index.min_codepoint();
+        m_last_char = m_index.max_codepoint();
     }
 }
@@ -0,0 +1,547 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/font_bundle.hh>
+#include <failsafe/failsafe.hh>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+#include "loader/loaders.hh"
+
+namespace onyx_font {
+    namespace {
+        constexpr uint8_t BUNDLE_MAGIC[4] = {'O', 'X', 'F', 'B'};
+        constexpr uint32_t BUNDLE_VERSION = 1;
+        constexpr std::size_t PAYLOAD_ALIGNMENT = 64;
+        constexpr uint32_t NO_FONT = UINT32_MAX;
+
+        struct bundle_header {
+            uint8_t magic[4];
+            uint32_t version;
+            uint32_t font_count;
+            uint32_t atlas_count;
+            uint64_t fonts_offset;       ///< font_count font_record
+            uint64_t atlases_offset;     ///< atlas_count atlas_record
+            uint64_t strings_offset;     ///< Names, not terminated
+            uint64_t strings_size;
+            uint64_t file_size;
+            uint64_t reserved;
+        };
+
+        struct font_record {
+            uint32_t name_offset;        ///< Relative to the string pool
+            uint32_t name_length;
+            uint8_t type;                ///< font_type
+            uint8_t italic;
+            uint16_t weight;
+            uint16_t pixel_height;
+            uint16_t point_size;
+            uint32_t face_index;         ///< Face within a TrueType collection
+            uint32_t reserved;
+            uint64_t data_offset;
+            uint64_t data_size;
+        };
+
+        struct atlas_record {
+            uint32_t name_offset;
+            uint32_t name_length;
+            uint32_t font;               ///< Face id or NO_FONT
+            float size;
+            int32_t width;
+            int32_t height;
+            uint32_t glyph_count;
+            uint32_t reserved;
+            uint64_t glyphs_offset;      ///< glyph_count baked_glyph
+            uint64_t pixels_offset;      ///< width * height bytes
+        };
+
+        static_assert(sizeof(bundle_header) == 64);
+        static_assert(sizeof(font_record) == 40);
+        static_assert(sizeof(atlas_record) == 48);
+        static_assert(sizeof(baked_glyph) == 32 && std::is_trivially_copyable_v<baked_glyph> &&
+                      std::is_standard_layout_v<baked_glyph>);
+
+        char fold(char c) {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        // ASCII case-insensitive three-way comparison
+        int compare_folded(std::string_view a, std::string_view b) {
+            const std::size_t n = std::min(a.size(), b.size());
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto ca = static_cast<unsigned char>(fold(a[i]));
+                const auto cb = static_cast<unsigned char>(fold(b[i]));
+                if (ca != cb) {
+                    return ca < cb ? -1 : 1;
+                }
+            }
+            return a.size() == b.size() ? 0 : (a.size() < b.size() ? -1 : 1);
+        }
+
+        std::size_t align_up(std::size_t value, std::size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        template<typename T>
+        void put(std::vector<uint8_t>& out, std::size_t offset, const T& value) {
+            std::memcpy(out.data() + offset, &value, sizeof(T));
+        }
+
+        // True if [offset, offset + size) lies within a buffer of total bytes
+        bool in_bounds(uint64_t offset, uint64_t size, std::size_t total) {
+            return offset <= total && size <= total - offset;
+        }
+
+        // True if the rectangle lies within a width x height atlas
+        bool inside_atlas(const glyph_rect& r, int width, int height) {
+            return r.x >= 0 && r.y >= 0 && r.w >= 0 && r.h >= 0 &&
+                   r.x <= width - r.w && r.y <= height - r.h;
+        }
+
+        const font_record& font_at(std::span<const uint8_t> bytes, std::size_t table, std::size_t id) {
+            return reinterpret_cast<const font_record*>(bytes.data() + table)[id];
+        }
+
+        const atlas_record& atlas_at(std::span<const uint8_t> bytes, std::size_t table, std::size_t index) {
+            return reinterpret_cast<const atlas_record*>(bytes.data() + table)[index];
+        }
+    }
+
+    // =========================================================================
+    // baked_atlas
+    // =========================================================================
+
+    const baked_glyph* baked_atlas::find(char32_t codepoint) const noexcept {
+        auto it = std::lower_bound(glyphs.begin(), glyphs.end(), codepoint,
+                                   [](const baked_glyph& g, char32_t cp) { return g.codepoint < cp; });
+        return it != glyphs.end() && it->codepoint == codepoint ? &*it : nullptr;
+    }
+
+    // =========================================================================
+    // font_bundle_writer
+    // =========================================================================
+
+    font_bundle_writer::font_handle font_bundle_writer::add_ttf(std::span<const uint8_t> data, std::size_t index) {
+        const auto info = font_factory::analyze(data);
+        THROW_IF(info.format != container_format::TTF && info.format != container_format::OTF &&
+                 info.format != container_format::TTC,
+                 std::runtime_error, "Not a TTF/OTF/TTC font file");
+        if (index >= info.fonts.size()) {
+            THROW_OUT_OF_RANGE("Font index", index, "out of range (have", info.fonts.size(), "fonts)");
+        }
+
+        // Faces of one collection share the stored file
+        std::shared_ptr<const std::vector<uint8_t>> payload;
+        for (const auto& f : m_fonts) {
+            if (f.entry.type == font_type::OUTLINE && f.payload->size() == data.size() &&
+                std::equal(data.begin(), data.end(), f.payload->begin())) {
+                payload = f.payload;
+                break;
+            }
+        }
+        if (!payload) {
+            payload = std::make_shared<const std::vector<uint8_t>>(data.begin(), data.end());
+        }
+
+        m_fonts.push_back({info.fonts[index], static_cast<uint32_t>(index), std::move(payload)});
+        return m_fonts.size() - 1;
+    }
+
+    font_bundle_writer::font_handle font_bundle_writer::add_bitmap(const bitmap_font& font,
+                                                                   const std::optional<font_entry>& entry) {
+        font_entry e{font.get_name(), font_type::BITMAP, font.get_metrics().pixel_height, 0, 400, false};
+        if (entry) {
+            e.name = entry->name;
+            e.point_size = entry->point_size;
+            e.weight = entry->weight;
+            e.italic = entry->italic;
+        }
+        auto payload = std::make_shared<const std::vector<uint8_t>>(internal::bundle_font_codec::encode(font));
+        m_fonts.push_back({std::move(e), 0, std::move(payload)});
+        return m_fonts.size() - 1;
+    }
+
+    font_bundle_writer::font_handle font_bundle_writer::add_vector(const vector_font& font,
+                                                                   const std::optional<font_entry>& entry) {
+        font_entry e{font.get_name(), font_type::VECTOR, font.get_metrics().pixel_height, 0, 400, false};
+        if (entry) {
+            e.name = entry->name;
+            e.point_size = entry->point_size;
+            e.weight = entry->weight;
+            e.italic = entry->italic;
+        }
+        auto payload = std::make_shared<const std::vector<uint8_t>>(internal::bundle_font_codec::encode(font));
+        m_fonts.push_back({std::move(e), 0, std::move(payload)});
+        return m_fonts.size() - 1;
+    }
+
+    void font_bundle_writer::add_atlas(std::string name, std::optional<font_handle> font, float size,
+                                       int width, int height, std::span<const uint8_t> pixels, int stride,
+                                       std::vector<baked_glyph> glyphs) {
+        THROW_IF(width <= 0 || height <= 0 || stride < width, std::invalid_argument,
+                 "Invalid atlas geometry", width, "x", height, "stride", stride);
+        const auto w = static_cast<std::size_t>(width);
+        const auto h = static_cast<std::size_t>(height);
+        const auto row_bytes = static_cast<std::size_t>(stride);
+        THROW_IF(pixels.size() < row_bytes * (h - 1) + w, std::invalid_argument,
+                 "Atlas pixels too small:", pixels.size(), "bytes");
+        if (font && *font >= m_fonts.size()) {
+            THROW_OUT_OF_RANGE("Font handle", *font, "out of range (have", m_fonts.size(), "fonts)");
+        }
+
+        std::sort(glyphs.begin(), glyphs.end(),
+                  [](const baked_glyph& a, const baked_glyph& b) { return a.codepoint < b.codepoint; });
+        for (std::size_t i = 0; i < glyphs.size(); ++i) {
+            THROW_IF(!inside_atlas(glyphs[i].rect, width, height),
+                     std::invalid_argument, "Glyph", static_cast<uint32_t>(glyphs[i].codepoint),
+                     "lies outside the atlas");
+            THROW_IF(i > 0 && glyphs[i - 1].codepoint == glyphs[i].codepoint, std::invalid_argument,
+                     "Glyph", static_cast<uint32_t>(glyphs[i].codepoint), "appears twice in atlas", name);
+        }
+
+        std::vector<uint8_t> tight(w * h);
+        for (std::size_t y = 0; y < h; ++y) {
+            std::memcpy(tight.data() + y * w, pixels.data() + y * row_bytes, w);
+        }
+        m_atlases.push_back({std::move(name), font, size, width, height, std::move(tight), std::move(glyphs)});
+    }
+
+    std::vector<uint8_t> font_bundle_writer::serialize() const {
+        // Tables are sorted by name so the reader can binary search them
+        std::vector<std::size_t> font_order(m_fonts.size());
+        std::iota(font_order.begin(), font_order.end(), std::size_t{0});
+        std::stable_sort(font_order.begin(), font_order.end(), [this](std::size_t a, std::size_t b) {
+            const auto& ea = m_fonts[a].entry;
+            const auto& eb = m_fonts[b].entry;
+            const int c = compare_folded(ea.name, eb.name);
+            return c != 0 ? c < 0 : ea.pixel_height < eb.pixel_height;
+        });
+        std::vector<uint32_t> face_id(m_fonts.size());
+        for (std::size_t i = 0; i < font_order.size(); ++i) {
+            face_id[font_order[i]] = static_cast<uint32_t>(i);
+        }
+
+        std::vector<std::size_t> atlas_order(m_atlases.size());
+        std::iota(atlas_order.begin(), atlas_order.end(), std::size_t{0});
+        std::stable_sort(atlas_order.begin(), atlas_order.end(), [this](std::size_t a, std::size_t b) {
+            return compare_folded(m_atlases[a].name, m_atlases[b].name) < 0;
+        });
+
+        // Front matter: header, tables, string pool
+        std::size_t offset = sizeof(bundle_header);
+        const std::size_t fonts_offset = offset;
+        offset += m_fonts.size() * sizeof(font_record);
+        const std::size_t atlases_offset = offset;
+        offset += m_atlases.size() * sizeof(atlas_record);
+        const std::size_t strings_offset = offset;
+
+        std::string strings;
+        std::vector<std::pair<uint32_t, uint32_t>> font_names(m_fonts.size());
+        for (std::size_t i : font_order) {
+            font_names[i] = {static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(m_fonts[i].entry.name.size())};
+            strings += m_fonts[i].entry.name;
+        }
+        std::vector<std::pair<uint32_t, uint32_t>> atlas_names(m_atlases.size());
+        for (std::size_t i : atlas_order) {
+            atlas_names[i] = {static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(m_atlases[i].name.size())};
+            strings += m_atlases[i].name;
+        }
+        THROW_IF(strings.size() > UINT32_MAX, std::runtime_error, "Bundle names too large");
+        offset += strings.size();
+
+        // Payloads, each on its own 64-byte boundary; shared payloads are stored once
+        std::map<const std::vector<uint8_t>*, uint64_t> payload_offsets;
+        for (std::size_t i : font_order) {
+            const auto* payload = m_fonts[i].payload.get();
+            if (payload_offsets.emplace(payload, align_up(offset, PAYLOAD_ALIGNMENT)).second) {
+                offset = align_up(offset, PAYLOAD_ALIGNMENT) + payload->size();
+            }
+        }
+        std::vector<std::pair<uint64_t, uint64_t>> atlas_offsets(m_atlases.size());
+        for (std::size_t i : atlas_order) {
+            const auto& a = m_atlases[i];
+            atlas_offsets[i].first = align_up(offset, PAYLOAD_ALIGNMENT);
+            offset = atlas_offsets[i].first + a.glyphs.size() * sizeof(baked_glyph);
+            atlas_offsets[i].second = align_up(offset, PAYLOAD_ALIGNMENT);
+            offset = atlas_offsets[i].second + a.pixels.size();
+        }
+        const std::size_t file_size = align_up(offset, PAYLOAD_ALIGNMENT);
+
+        std::vector<uint8_t> out(file_size);
+
+        bundle_header header{};
+        std::memcpy(header.magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC));
+        header.version = BUNDLE_VERSION;
+        header.font_count = static_cast<uint32_t>(m_fonts.size());
+        header.atlas_count = static_cast<uint32_t>(m_atlases.size());
+        header.fonts_offset = fonts_offset;
+        header.atlases_offset = atlases_offset;
+        header.strings_offset = strings_offset;
+        header.strings_size = strings.size();
+        header.file_size = file_size;
+        put(out, 0, header);
+
+        for (std::size_t id = 0; id < font_order.size(); ++id) {
+            const auto& f = m_fonts[font_order[id]];
+            font_record r{};
+            r.name_offset = font_names[font_order[id]].first;
+            r.name_length = font_names[font_order[id]].second;
+            r.type = static_cast<uint8_t>(f.entry.type);
+            r.italic = f.entry.italic ? 1 : 0;
+            r.weight = f.entry.weight;
+            r.pixel_height = f.entry.pixel_height;
+            r.point_size = f.entry.point_size;
+            r.face_index = f.face_index;
+            r.data_offset = payload_offsets.at(f.payload.get());
+            r.data_size = f.payload->size();
+            put(out, fonts_offset + id * sizeof(font_record), r);
+        }
+
+        for (std::size_t id = 0; id < atlas_order.size(); ++id) {
+            const auto& a = m_atlases[atlas_order[id]];
+            atlas_record r{};
+            r.name_offset = atlas_names[atlas_order[id]].first;
+            r.name_length = atlas_names[atlas_order[id]].second;
+            r.font = a.font ? face_id[*a.font] : NO_FONT;
+            r.size = a.size;
+            r.width = a.width;
+            r.height = a.height;
+            r.glyph_count = static_cast<uint32_t>(a.glyphs.size());
+            r.glyphs_offset = atlas_offsets[atlas_order[id]].first;
+            r.pixels_offset = atlas_offsets[atlas_order[id]].second;
+            put(out, atlases_offset + id * sizeof(atlas_record), r);
+        }
+
+        std::memcpy(out.data() + strings_offset, strings.data(), strings.size());
+        for (const auto& [payload, at] : payload_offsets) {
+            std::memcpy(out.data() + at, payload->data(), payload->size());
+        }
+        for (std::size_t i = 0; i < m_atlases.size(); ++i) {
+            const auto& a = m_atlases[i];
+            if (!a.glyphs.empty()) {
+                std::memcpy(out.data() + atlas_offsets[i].first, a.glyphs.data(), a.glyphs.size() * sizeof(baked_glyph));
+            }
+            std::memcpy(out.data() + atlas_offsets[i].second, a.pixels.data(), a.pixels.size());
+        }
+        return out;
+    }
+
+    void font_bundle_writer::save(const std::filesystem::path& path) const {
+        auto data = serialize();
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        THROW_IF(!file, std::runtime_error, "Cannot open file:", path.string());
+        THROW_IF(!file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size())),
+                 std::runtime_error, "Failed to write file:", path.string());
+    }
+
+    // =========================================================================
+    // font_bundle
+    // =========================================================================
+
+    font_bundle font_bundle::open(const std::filesystem::path& path) {
+        auto file = internal::map_file(path);
+        return {std::move(file.owner), file.bytes};
+    }
+
+    font_bundle::font_bundle(std::vector<uint8_t> data)
+        : font_bundle(std::make_shared<const std::vector<uint8_t>>(std::move(data))) {
+    }
+
+    font_bundle::font_bundle(std::shared_ptr<const std::vector<uint8_t>> data)
+        : font_bundle(data, std::span<const uint8_t>(*data)) {
+    }
+
+    font_bundle::font_bundle(std::shared_ptr<const void> owner, std::span<const uint8_t> bytes)
+        : m_owner(std::move(owner)),
+          m_bytes(bytes) {
+        THROW_IF(std::endian::native != std::endian::little, std::runtime_error,
+                 "Font bundles require a little-endian machine");
+        THROW_IF(m_bytes.size() < sizeof(bundle_header) ||
+                 !std::equal(std::begin(BUNDLE_MAGIC), std::end(BUNDLE_MAGIC), m_bytes.begin()),
+                 std::runtime_error, "Not a font bundle");
+        THROW_IF(reinterpret_cast<std::uintptr_t>(m_bytes.data()) % alignof(uint64_t) != 0,
+                 std::runtime_error, "Font bundle memory is misaligned");
+
+        bundle_header header{};
+        std::memcpy(&header, m_bytes.data(), sizeof(header));
+        THROW_IF(header.version != BUNDLE_VERSION, std::runtime_error,
+                 "Unsupported font bundle version:", header.version);
+        THROW_IF(header.file_size != m_bytes.size(), std::runtime_error,
+                 "Font bundle is truncated: expected", header.file_size, "bytes, got", m_bytes.size());
+
+        const std::size_t total = m_bytes.size();
+        THROW_IF(header.fonts_offset % alignof(font_record) != 0 ||
+                 !in_bounds(header.fonts_offset, uint64_t{header.font_count} * sizeof(font_record), total) ||
+                 header.atlases_offset % alignof(atlas_record) != 0 ||
+                 !in_bounds(header.atlases_offset, uint64_t{header.atlas_count} * sizeof(atlas_record), total) ||
+                 !in_bounds(header.strings_offset, header.strings_size, total),
+                 std::runtime_error, "Font bundle tables out of bounds");
+
+        m_font_count = header.font_count;
+        m_atlas_count = header.atlas_count;
+        m_fonts_offset = static_cast<std::size_t>(header.fonts_offset);
+        m_atlases_offset = static_cast<std::size_t>(header.atlases_offset);
+        const auto strings = m_bytes.subspan(static_cast<std::size_t>(header.strings_offset),
+                                             static_cast<std::size_t>(header.strings_size));
+
+        // Validate every record once so accessors can trust them
+        const auto* fonts = reinterpret_cast<const font_record*>(m_bytes.data() + m_fonts_offset);
+        for (std::size_t i = 0; i < m_font_count; ++i) {
+            const auto& r = fonts[i];
+            THROW_IF(!in_bounds(r.name_offset, r.name_length, strings.size()) ||
+                     !in_bounds(r.data_offset, r.data_size, total) ||
+                     (r.type != static_cast<uint8_t>(font_type::BITMAP) &&
+                      r.type != static_cast<uint8_t>(font_type::VECTOR) &&
+                      r.type != static_cast<uint8_t>(font_type::OUTLINE)),
+                     std::runtime_error, "Font bundle has an invalid face record", i);
+        }
+        const auto* atlases = reinterpret_cast<const atlas_record*>(m_bytes.data() + m_atlases_offset);
+        for (std::size_t i = 0; i < m_atlas_count; ++i) {
+            const auto& r = atlases[i];
+            THROW_IF(!in_bounds(r.name_offset, r.name_length, strings.size()) ||
+                     (r.font != NO_FONT && r.font >= m_font_count) ||
+                     r.width <= 0 || r.height <= 0 ||
+                     r.glyphs_offset % alignof(baked_glyph) != 0 ||
+                     !in_bounds(r.glyphs_offset, uint64_t{r.glyph_count} * sizeof(baked_glyph), total) ||
+                     !in_bounds(r.pixels_offset, uint64_t(r.width) * uint64_t(r.height), total),
+                     std::runtime_error, "Font bundle has an invalid atlas record", i);
+
+            // baked_atlas::find() binary-searches, and callers index pixels by rect
+            const auto* glyphs = reinterpret_cast<const baked_glyph*>(m_bytes.data() + r.glyphs_offset);
+            for (uint32_t g = 0; g < r.glyph_count; ++g) {
+                THROW_IF(!inside_atlas(glyphs[g].rect, r.width, r.height) ||
+                         (g > 0 && glyphs[g - 1].codepoint >= glyphs[g].codepoint),
+                         std::runtime_error, "Font bundle atlas", i, "has an invalid glyph", g);
+            }
+        }
+        m_strings_offset = static_cast<std::size_t>(header.strings_offset);
+    }
+
+    std::string_view font_bundle::record_name(uint32_t offset, uint32_t length) const {
+        return {reinterpret_cast<const char*>(m_bytes.data() + m_strings_offset + offset), length};
+    }
+
+    std::string_view font_bundle::name(face_id id) const {
+        check_face(id, font_type::UNKNOWN);
+        const auto& r = font_at(m_bytes, m_fonts_offset, id);
+        return record_name(r.name_offset, r.name_length);
+    }
+
+    font_entry font_bundle::entry(face_id id) const {
+        check_face(id, font_type::UNKNOWN);
+        const auto& r = font_at(m_bytes, m_fonts_offset, id);
+        return {std::string(record_name(r.name_offset, r.name_length)), static_cast<font_type>(r.type),
+                r.pixel_height, r.point_size, r.weight, r.italic != 0};
+    }
+
+    std::optional<font_bundle::face_id> font_bundle::find(std::string_view name, uint16_t pixel_height) const {
+        // Faces are sorted by (folded name, pixel height)
+        std::size_t lo = 0;
+        std::size_t hi = m_font_count;
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            const auto& r = font_at(m_bytes, m_fonts_offset, mid);
+            if (compare_folded(record_name(r.name_offset, r.name_length), name) < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        std::optional<face_id> best;
+        int best_distance = 0;
+        for (std::size_t id = lo; id < m_font_count; ++id) {
+            const auto& r = font_at(m_bytes, m_fonts_offset, id);
+            if (compare_folded(record_name(r.name_offset, r.name_length), name) != 0) {
+                break;
+            }
+            const bool scalable = r.type == static_cast<uint8_t>(font_type::OUTLINE);
+            const int distance = pixel_height == 0 || scalable
+                                     ? 0
+                                     : std::abs(static_cast<int>(r.pixel_height) - static_cast<int>(pixel_height));
+            if (!best || distance < best_distance) {
+                best = id;
+                best_distance = distance;
+            }
+        }
+        return best;
+    }
+
+    std::span<const uint8_t> font_bundle::data(face_id id) const {
+        check_face(id, font_type::UNKNOWN);
+        const auto& r = font_at(m_bytes, m_fonts_offset, id);
+        return m_bytes.subspan(static_cast<std::size_t>(r.data_offset), static_cast<std::size_t>(r.data_size));
+    }
+
+    bitmap_font font_bundle::load_bitmap(face_id id) const {
+        check_face(id, font_type::BITMAP);
+        return internal::bundle_font_codec::decode_bitmap(data(id), std::string(name(id)), m_owner);
+    }
+
+    vector_font font_bundle::load_vector(face_id id) const {
+        check_face(id, font_type::VECTOR);
+        return internal::bundle_font_codec::decode_vector(data(id), std::string(name(id)));
+    }
+
+    ttf_font font_bundle::load_ttf(face_id id) const {
+        check_face(id, font_type::OUTLINE);
+        return ttf_font(data(id), static_cast<int>(font_at(m_bytes, m_fonts_offset, id).face_index));
+    }
+
+    baked_atlas font_bundle::atlas(std::size_t index) const {
+        if (index >= m_atlas_count) {
+            THROW_OUT_OF_RANGE("Atlas index", index, "out of range (have", m_atlas_count, "atlases)");
+        }
+        const auto& r = atlas_at(m_bytes, m_atlases_offset, index);
+
+        baked_atlas a;
+        a.name = record_name(r.name_offset, r.name_length);
+        if (r.font != NO_FONT) {
+            a.font = r.font;
+        }
+        a.size = r.size;
+        a.width = r.width;
+        a.height = r.height;
+        a.pixels = m_bytes.subspan(static_cast<std::size_t>(r.pixels_offset),
+                                   static_cast<std::size_t>(r.width) * static_cast<std::size_t>(r.height));
+        a.glyphs = {reinterpret_cast<const baked_glyph*>(m_bytes.data() + r.glyphs_offset), r.glyph_count};
+        return a;
+    }
+
+    std::optional<std::size_t> font_bundle::find_atlas(std::string_view name) const {
+        std::size_t lo = 0;
+        std::size_t hi = m_atlas_count;
+        while (lo < hi) {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            const auto& r = atlas_at(m_bytes, m_atlases_offset, mid);
+            if (compare_folded(record_name(r.name_offset, r.name_length), name) < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo < m_atlas_count) {
+            const auto& r = atlas_at(m_bytes, m_atlases_offset, lo);
+            if (compare_folded(record_name(r.name_offset, r.name_length), name) == 0) {
+                return lo;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void font_bundle::check_face(face_id id, font_type type) const {
+        if (id >= m_font_count) {
+            THROW_OUT_OF_RANGE("Face id", id, "out of range (have", m_font_count, "faces)");
+        }
+        const auto& r = font_at(m_bytes, m_fonts_offset, id);
+        THROW_IF(type != font_type::UNKNOWN && r.type != static_cast<uint8_t>(type), std::invalid_argument,
+                 record_name(r.name_offset, r.name_length), "has a different font type");
+    }
+} // namespace onyx_font
@@ -0,0 +1,273 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/font_collection.hh>
+#include <failsafe/failsafe.hh>
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+#include <cstdlib>
+#include <tuple>
+#include <utility>
+
+namespace onyx_font {
+    namespace {
+        std::string fold_name(std::string_view name) {
+            std::string key(name);
+            std::transform(key.begin(), key.end(), key.begin(), [](char c) {
+                return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+            });
+            return key;
+        }
+
+        // Bitmap strikes first: at their own size they beat scaled outlines
+        int type_rank(font_type type) {
+            switch (type) {
+                case font_type::BITMAP: return 0;
+                case font_type::OUTLINE: return 1;
+                case font_type::VECTOR: return 2;
+                default: return 3;
+            }
+        }
+
+        // Family order: (type, italic, weight, pixel_height)
+        auto sort_key(const font_entry& e) {
+            return std::make_tuple(type_rank(e.type), e.italic, e.weight, e.pixel_height);
+        }
+
+        // First n elements of a tuple
+        template<std::size_t N, typename Tuple>
+        auto key_prefix(const Tuple& t) {
+            return [&]<std::size_t... I>(std::index_sequence<I...>) {
+                return std::make_tuple(std::get<I>(t)...);
+            }(std::make_index_sequence<N>{});
+        }
+
+        // Distance with a half step for the less preferred direction
+        int weight_penalty(uint16_t requested, uint16_t actual) {
+            const int distance = std::abs(static_cast<int>(actual) - static_cast<int>(requested));
+            const bool heavier = actual > requested;
+            const bool wrong_way = requested <= 500 ? heavier : (actual < requested);
+            return distance * 2 + (wrong_way ? 1 : 0);
+        }
+
+        int size_penalty(const font_entry& e, uint16_t requested) {
+            if (e.type != font_type::BITMAP || requested == 0) {
+                return 0;
+            }
+            const int distance = std::abs(static_cast<int>(e.pixel_height) - static_cast<int>(requested));
+            return distance * 2 + (e.pixel_height > requested ? 1 : 0);
+        }
+
+        std::vector<uint8_t> read_file(const std::filesystem::path& path) {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            THROW_IF(!file, std::runtime_error, "Cannot open file:", path.string());
+
+            auto size = file.tellg();
+            file.seekg(0, std::ios::beg);
+
+            std::vector<uint8_t> data(static_cast<size_t>(size));
+            THROW_IF(!file.read(reinterpret_cast<char*>(data.data()), size),
+                     std::runtime_error, "Failed to read file:", path.string());
+            return data;
+        }
+    }
+
+    font_collection::font_collection() = default;
+
+    font_collection::font_collection(font_collection&&) noexcept = default;
+
+    font_collection& font_collection::operator=(font_collection&&) noexcept = default;
+
+    font_collection::~font_collection() = default;
+
+    std::size_t font_collection::add(const std::filesystem::path& path) {
+        auto info = font_factory::analyze(path);
+        m_containers.push_back({path, nullptr});
+        return index_container(info);
+    }
+
+    std::size_t font_collection::add(std::vector<uint8_t> data) {
+        auto bytes = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+        auto info = font_factory::analyze(*bytes);
+        m_containers.push_back({{}, std::move(bytes)});
+        return index_container(info);
+    }
+
+    std::size_t font_collection::index_container(const container_info& info) {
+        const std::size_t container = m_containers.size() - 1;
+        std::array<std::size_t, 4> per_type{};
+
+        std::size_t added = 0;
+        for (const auto& entry : info.fonts) {
+            if (entry.type == font_type::UNKNOWN) {
+                continue;
+            }
+            const auto id = m_faces.size();
+            auto& face = m_faces.emplace_back();
+            face.entry = entry;
+            face.container = container;
+            face.index = per_type[static_cast<std::size_t>(entry.type)]++;
+
+            // Keep the family sorted so find() can binary search it
+            auto& family = m_families[fold_name(entry.name)];
+            auto pos = std::upper_bound(family.begin(), family.end(), sort_key(entry),
+                                        [this](const auto& key, face_id other) {
+                                            return key < sort_key(m_faces[other].entry);
+                                        });
+            family.insert(pos, id);
+            ++added;
+        }
+        return added;
+    }
+
+    const font_collection::face_record& font_collection::checked(face_id id) const {
+        if (id >= m_faces.size()) {
+            THROW_OUT_OF_RANGE("Face id", id, "out of range (have", m_faces.size(), "faces)");
+        }
+        return m_faces[id];
+    }
+
+    const font_entry& font_collection::entry(face_id id) const {
+        return checked(id).entry;
+    }
+
+    std::optional<font_collection::face_id> font_collection::find(const font_query& query) const {
+        auto it = m_families.find(fold_name(query.name));
+        if (it == m_families.end()) {
+            return std::nullopt;
+        }
+        const auto& family = it->second;
+
+        // Faces in [first, last) whose sort key starts with prefix
+        auto equal_prefix = [this](auto first, auto last, const auto& prefix) {
+            constexpr auto n = std::tuple_size_v<std::decay_t<decltype(prefix)>>;
+            auto head = [this](face_id id) { return key_prefix<n>(sort_key(m_faces[id].entry)); };
+            auto begin = std::lower_bound(first, last, prefix,
+                                          [&](face_id id, const auto& k) { return head(id) < k; });
+            auto end = std::upper_bound(begin, last, prefix,
+                                        [&](const auto& k, face_id id) { return k < head(id); });
+            return std::make_pair(begin, end);
+        };
+
+        std::optional<face_id> best;
+        std::tuple<int, int, int, int> best_score{};
+        auto consider = [&](face_id id) {
+            const auto& e = m_faces[id].entry;
+            std::tuple<int, int, int, int> score{e.italic != query.italic ? 1 : 0,
+                                                  weight_penalty(query.weight, e.weight),
+                                                  size_penalty(e, query.pixel_height),
+                                                  type_rank(e.type)};
+            if (!best || score < best_score) {
+                best = id;
+                best_score = score;
+            }
+        };
+
+        for (font_type type : {font_type::BITMAP, font_type::OUTLINE, font_type::VECTOR}) {
+            if (query.type && *query.type != type) {
+                continue;
+            }
+            const int rank = type_rank(type);
+            for (bool italic : {query.italic, !query.italic}) {
+                auto [group_begin, group_end] = equal_prefix(family.begin(), family.end(),
+                                                             std::make_tuple(rank, italic));
+                if (group_begin == group_end) {
+                    continue;
+                }
+
+                // The nearest weights at or above and below the request
+                auto heavier = std::lower_bound(group_begin, group_end, query.weight,
+                                                [this](face_id id, uint16_t w) {
+                                                    return m_faces[id].entry.weight < w;
+                                                });
+                for (auto w : {heavier, heavier == group_begin ? group_end : std::prev(heavier)}) {
+                    if (w == group_end) {
+                        continue;
+                    }
+                    auto [strikes_begin, strikes_end] = equal_prefix(
+                        group_begin, group_end, std::make_tuple(rank, italic, m_faces[*w].entry.weight));
+
+                    // The nearest strikes at or above and below the requested size
+                    auto larger = std::lower_bound(strikes_begin, strikes_end, query.pixel_height,
+                                                   [this](face_id id, uint16_t h) {
+                                                       return m_faces[id].entry.pixel_height < h;
+                                                   });
+                    if (larger != strikes_end) {
+                        consider(*larger);
+                    }
+                    if (larger != strikes_begin) {
+                        consider(*std::prev(larger));
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+    bool font_collection::is_loaded(face_id id) const {
+        const auto& face = checked(id);
+        return face.bitmap || face.vector || face.ttf;
+    }
+
+    std::span<const uint8_t> font_collection::container_data(std::size_t index) {
+        auto& container = m_containers[index];
+        if (!container.data) {
+            container.data = std::make_shared<const std::vector<uint8_t>>(read_file(container.path));
+        }
+        return *container.data;
+    }
+
+    const bitmap_font& font_collection::get_bitmap(face_id id) {
+        checked(id);
+        auto& face = m_faces[id];
+        THROW_IF(face.entry.type != font_type::BITMAP, std::invalid_argument,
+                 face.entry.name, "is not a bitmap font");
+        if (!face.bitmap) {
+            const auto& container = m_containers[face.container];
+            // Files go through the path overload so PSF glyphs stay memory-mapped
+            face.bitmap = std::make_unique<bitmap_font>(
+                container.data ? font_factory::load_bitmap(*container.data, face.index)
+                               : font_factory::load_bitmap(container.path, face.index));
+        }
+        return *face.bitmap;
+    }
+
+    const vector_font& font_collection::get_vector(face_id id) {
+        checked(id);
+        auto& face = m_faces[id];
+        THROW_IF(face.entry.type != font_type::VECTOR, std::invalid_argument,
+                 face.entry.name, "is not a vector font");
+        if (!face.vector) {
+            face.vector = std::make_unique<vector_font>(
+                font_factory::load_vector(container_data(face.container), face.index));
+        }
+        return *face.vector;
+    }
+
+    const ttf_font& font_collection::get_ttf(face_id id) {
+        checked(id);
+        auto& face = m_faces[id];
+        THROW_IF(face.entry.type != font_type::OUTLINE, std::invalid_argument,
+                 face.entry.name, "is not an outline font");
+        if (!face.ttf) {
+            // The container bytes outlive the font: the collection keeps them
+            face.ttf = std::make_unique<ttf_font>(
+                font_factory::load_ttf(container_data(face.container), face.index));
+        }
+        return *face.ttf;
+    }
+
+    font_source font_collection::source(face_id id) {
+        const auto type = checked(id).entry.type;
+        if (type == font_type::BITMAP) {
+            return font_source::from_bitmap(get_bitmap(id));
+        }
+        if (type == font_type::VECTOR) {
+            return font_source::from_vector(get_vector(id));
+        }
+        return font_source::from_ttf(get_ttf(id));
+    }
+} // namespace onyx_font
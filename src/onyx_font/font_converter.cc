@@ -8,8 +8,10 @@
 #include <../../include/onyx_font/utils/stb_truetype_font.hh>
 #include <onyx_font/text/glyph_rasterizer.hh>
 #include <onyx_font/text/raster_target.hh>
+#include <onyx_font/text/sized_face.hh>
 #include <cmath>
 #include <algorithm>
+#include <memory>
 
 namespace onyx_font {
 
@@ -74,8 +76,8 @@ bitmap_font font_converter::from_vector(
 
     // Get source font info
     const auto& src_metrics = font.get_metrics();
-    uint8_t first_char = options.first_char;
-    uint8_t last_char = options.last_char;
+    char32_t first_char = options.first_char;
+    char32_t last_char = options.last_char;
 
     // Clamp to font's actual range
     if (first_char < font.get_first_char()) {
@@ -97,6 +99,7 @@ bitmap_font font_converter::from_vector(
     result.m_first_char = first_char;
     result.m_last_char = last_char;
     result.m_default_char = font.get_default_char();
+    result.m_codepage = font.get_codepage();
     result.m_break_char = ' ';
 
     // Convert font metrics
@@ -123,9 +126,9 @@ bitmap_font font_converter::from_vector(
         : internal::raster_mode::aliased;
 
     // Convert each glyph
-    for (uint8_t ch = first_char; ch <= last_char; ++ch) {
+    for (char32_t ch = first_char; ch <= last_char; ++ch) {
         size_t idx = ch - first_char;
-        const vector_glyph* glyph = font.get_glyph(ch);
+        const vector_glyph* glyph = font.get_glyph(static_cast<uint8_t>(ch));
 
         if (!glyph || glyph->strokes.empty()) {
             // Empty glyph - create 1x1 placeholder
@@ -181,6 +184,47 @@ bitmap_font font_converter::from_ttf(
     const ttf_font& font,
     float pixel_height,
     const conversion_options& options)
+{
+    return convert_ttf(font, pixel_height, nullptr, options);
+}
+
+bitmap_font font_converter::from_ttf(
+    const ttf_font& font,
+    float pixel_height,
+    reference_strike& strike,
+    const conversion_options& options)
+{
+    return convert_ttf(font, pixel_height, strike.supports(pixel_height) ? &strike : nullptr, options);
+}
+
+std::vector<bitmap_font> font_converter::from_ttf(
+    const ttf_font& font,
+    std::span<const float> pixel_heights,
+    const conversion_options& options)
+{
+    std::vector<bitmap_font> result;
+    result.reserve(pixel_heights.size());
+
+    // One reference rasterization shared by every smaller size
+    std::unique_ptr<reference_strike> strike;
+    if (options.supersample_size > 0.0f && font.is_valid()) {
+        strike = std::make_unique<reference_strike>(font_source::from_ttf(font),
+                                                    options.supersample_size,
+                                                    options.supersample_filter);
+    }
+
+    for (float pixel_height : pixel_heights) {
+        reference_strike* use = strike && strike->supports(pixel_height) ? strike.get() : nullptr;
+        result.push_back(convert_ttf(font, pixel_height, use, options));
+    }
+    return result;
+}
+
+bitmap_font font_converter::convert_ttf(
+    const ttf_font& font,
+    float pixel_height,
+    reference_strike* strike,
+    const conversion_options& options)
 {
     bitmap_font result;
 
@@ -194,8 +238,8 @@ bitmap_font font_converter::from_ttf(
         return result;
     }
 
-    uint8_t first_char = options.first_char;
-    uint8_t last_char = options.last_char;
+    char32_t first_char = options.first_char;
+    char32_t last_char = std::min<char32_t>(options.last_char, 0x10FFFF);
 
     // Find actual character range in font
     while (first_char < last_char && !font.has_glyph(first_char)) {
@@ -209,8 +253,17 @@ bitmap_font font_converter::from_ttf(
         return result; // No glyphs found
     }
 
-    // Get font metrics
-    auto metrics = font.get_metrics(pixel_height);
+    // Wide ranges keep only the glyphs the font has, behind a sparse index
+    const bool sparse = last_char - first_char >= 256;
+
+    // Scale, metrics and ASCII advances are computed once for the size;
+    // with a strike they are the reference values scaled down
+    auto source = font_source::from_ttf(font);
+    sized_face face(source, pixel_height);
+    const scaled_metrics metrics = strike ? strike->metrics(pixel_height) : face.metrics();
+    auto advance_of = [&](char32_t c) {
+        return strike ? strike->get_glyph_metrics(c, pixel_height).advance_x : face.advance(c);
+    };
 
     // Set up result font
     result.m_name = "TTF Font (bitmap)";
@@ -230,10 +283,11 @@ bitmap_font font_converter::from_ttf(
     float total_width = 0;
     float max_width = 0;
     int sample_count = 0;
-    for (char c = 'a'; c <= 'z'; ++c) {
-        if (auto gm = font.get_glyph_metrics(static_cast<uint32_t>(c), pixel_height)) {
-            total_width += gm->advance_x;
-            max_width = std::max(max_width, gm->advance_x);
+    for (char32_t c = 'a'; c <= 'z'; ++c) {
+        if (font.has_glyph(static_cast<uint32_t>(c))) {
+            float advance = advance_of(c);
+            total_width += advance;
+            max_width = std::max(max_width, advance);
             ++sample_count;
         }
     }
@@ -244,59 +298,94 @@ bitmap_font font_converter::from_ttf(
 
     // Prepare spacing and storage
     size_t char_count = static_cast<size_t>(last_char - first_char + 1);
-    result.m_spacing.resize(char_count);
+    if (!sparse) {
+        result.m_spacing.reserve(char_count);
+    }
 
     bitmap_builder builder(bit_order::msb_first);
-    builder.reserve_glyphs(char_count);
+    if (!sparse) {
+        builder.reserve_glyphs(char_count);
+    }
 
-    // Convert each glyph
-    for (uint8_t ch = first_char; ch <= last_char; ++ch) {
-        size_t idx = ch - first_char;
+    // Coverage of the current glyph, from the rasterizer or the strike
+    std::vector<uint8_t> pixels;
 
-        // Try to rasterize the glyph
-        auto bitmap = rasterizer.rasterize(static_cast<uint32_t>(ch), pixel_height);
+    // Convert each glyph
+    for (char32_t ch = first_char; ch <= last_char; ++ch) {
+        if (sparse) {
+            if (!font.has_glyph(ch)) {
+                continue;
+            }
+            result.m_index.insert(ch, static_cast<uint32_t>(result.m_spacing.size()));
+        }
+        size_t idx = result.m_spacing.size();
+        result.m_spacing.emplace_back();
+
+        int glyph_w = 0;
+        int glyph_h = 0;
+        int offset_x = 0;
+        float advance_x = 0;
+
+        if (strike) {
+            glyph_rect box = strike->box(ch, pixel_height);
+            if (box.w > 0 && box.h > 0) {
+                glyph_w = box.w;
+                glyph_h = box.h;
+                offset_x = box.x;
+                advance_x = strike->get_glyph_metrics(ch, pixel_height).advance_x;
+                pixels.resize(static_cast<size_t>(glyph_w * glyph_h));
+                strike->draw(ch, pixel_height, pixels.data(), glyph_w, glyph_h, glyph_w,
+                             static_cast<float>(-box.x), static_cast<float>(-box.y));
+            }
+        } else if (auto bitmap = rasterizer.rasterize(static_cast<uint32_t>(ch), pixel_height)) {
+            glyph_w = bitmap->width;
+            glyph_h = bitmap->height;
+            offset_x = bitmap->offset_x;
+            advance_x = bitmap->advance_x;
+            pixels = std::move(bitmap->bitmap);
+        }
 
-        if (!bitmap || bitmap->width == 0 || bitmap->height == 0) {
+        if (glyph_w == 0 || glyph_h == 0) {
             // Empty glyph - create 1x1 placeholder
             (void)builder.reserve_glyph(1, 1);
 
             // Get advance if available
-            if (auto gm = font.get_glyph_metrics(static_cast<uint32_t>(ch), pixel_height)) {
-                result.m_spacing[idx].b_space = static_cast<uint16_t>(std::ceil(gm->advance_x));
+            if (font.has_glyph(ch)) {
+                result.m_spacing[idx].b_space = static_cast<uint16_t>(std::ceil(advance_of(ch)));
             } else {
                 result.m_spacing[idx].b_space = std::uint16_t{1};
             }
             continue;
         }
 
-        int glyph_w = bitmap->width;
-        int glyph_h = bitmap->height;
-
         // Convert grayscale to 1-bit using threshold
         auto writer = builder.reserve_glyph(static_cast<uint16_t>(glyph_w),
                                             static_cast<uint16_t>(glyph_h));
 
         for (int y = 0; y < glyph_h; ++y) {
             for (int x = 0; x < glyph_w; ++x) {
-                if (bitmap->bitmap[static_cast<size_t>(y * glyph_w + x)] >= options.threshold) {
+                if (pixels[static_cast<size_t>(y * glyph_w + x)] >= options.threshold) {
                     writer.set_pixel(static_cast<uint16_t>(x),
                                     static_cast<uint16_t>(y), true);
                 }
             }
         }
 
-        // Set spacing info based on STB offsets
-        result.m_spacing[idx].a_space = static_cast<int16_t>(bitmap->offset_x);
+        // Set spacing info based on the glyph offset
+        result.m_spacing[idx].a_space = static_cast<int16_t>(offset_x);
         result.m_spacing[idx].b_space = static_cast<uint16_t>(glyph_w);
 
         // Calculate c_space from advance
-        int c_space_int = static_cast<int>(std::ceil(bitmap->advance_x))
-                        - bitmap->offset_x
+        int c_space_int = static_cast<int>(std::ceil(advance_x))
+                        - offset_x
                         - glyph_w;
         result.m_spacing[idx].c_space = static_cast<int16_t>(c_space_int);
     }
 
     result.m_storage = std::move(builder).build();
+    if (sparse) {
+        result.use_index();
+    }
     return result;
 }
 
@@ -8,6 +8,7 @@
 #include <failsafe/failsafe.hh>
 #include <fstream>
 #include <cstring>
+#include <memory>
 
 #include "loader/loaders.hh"
 
@@ -75,6 +76,23 @@ namespace onyx_font {
             return data;
         }
 
+        // Analyze PSF1/PSF2 console font
+        container_info analyze_psf(const internal::psf_header& header) {
+            container_info info;
+            info.format = container_format::PSF;
+
+            font_entry entry;
+            entry.name = internal::psf_font_loader::name(header);
+            entry.type = font_type::BITMAP;
+            entry.pixel_height = static_cast<uint16_t>(header.height);
+            entry.point_size = 0;
+            entry.weight = 400;
+            entry.italic = false;
+
+            info.fonts.push_back(entry);
+            return info;
+        }
+
         // Create font_entry from libexe::font_data
         font_entry make_entry_from_font_data(const libexe::font_data& fd) {
             font_entry entry;
@@ -122,7 +140,7 @@ namespace onyx_font {
             fd.underline = false;
             fd.strikeout = false;
             fd.weight = static_cast<uint16_t>(os2.metrics.weight_class / 10);  // Convert 1000-9000 to 100-900
-            fd.charset = 0;  // Default charset
+            fd.charset = 1;  // DEFAULT_CHARSET: OS/2 code pages are not Windows charsets
 
             // Dimensions
             fd.pixel_width = static_cast<uint16_t>(os2.metrics.ave_char_width);
@@ -289,6 +307,130 @@ namespace onyx_font {
             return info;
         }
 
+        uint16_t read_be16(std::span<const uint8_t> data, std::size_t offset) {
+            return static_cast<uint16_t>((data[offset] << 8) | data[offset + 1]);
+        }
+
+        uint32_t read_be32(std::span<const uint8_t> data, std::size_t offset) {
+            return (static_cast<uint32_t>(data[offset]) << 24) |
+                   (static_cast<uint32_t>(data[offset + 1]) << 16) |
+                   (static_cast<uint32_t>(data[offset + 2]) << 8) |
+                   static_cast<uint32_t>(data[offset + 3]);
+        }
+
+        // Table of the face whose table directory starts at face_offset
+        std::span<const uint8_t> find_sfnt_table(std::span<const uint8_t> data, std::size_t face_offset,
+                                                 const char (&tag)[5]) {
+            if (face_offset + 12 > data.size()) return {};
+            const std::size_t count = read_be16(data, face_offset + 4);
+            for (std::size_t i = 0; i < count; ++i) {
+                const std::size_t record = face_offset + 12 + i * 16;
+                if (record + 16 > data.size()) break;
+                if (std::memcmp(data.data() + record, tag, 4) != 0) continue;
+                const std::size_t offset = read_be32(data, record + 8);
+                const std::size_t length = read_be32(data, record + 12);
+                if (offset > data.size() || length > data.size() - offset) return {};
+                return data.subspan(offset, length);
+            }
+            return {};
+        }
+
+        void append_utf8(std::string& out, char32_t cp) {
+            if (cp < 0x80) {
+                out += static_cast<char>(cp);
+            } else if (cp < 0x800) {
+                out += static_cast<char>(0xC0 | (cp >> 6));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else if (cp < 0x10000) {
+                out += static_cast<char>(0xE0 | (cp >> 12));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (cp >> 18));
+                out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (cp & 0x3F));
+            }
+        }
+
+        // Family name: typographic family (16) over legacy family (1),
+        // Windows Unicode English over other Windows languages over Mac Roman
+        std::string read_sfnt_family(std::span<const uint8_t> name) {
+            if (name.size() < 6) return {};
+            const std::size_t count = read_be16(name, 2);
+            const std::size_t strings = read_be16(name, 4);
+
+            int best_rank = -1;
+            std::string best;
+            for (std::size_t i = 0; i < count; ++i) {
+                const std::size_t record = 6 + i * 12;
+                if (record + 12 > name.size()) break;
+                const uint16_t platform = read_be16(name, record);
+                const uint16_t language = read_be16(name, record + 4);
+                const uint16_t name_id = read_be16(name, record + 6);
+                const std::size_t length = read_be16(name, record + 8);
+                const std::size_t offset = strings + read_be16(name, record + 10);
+                if ((name_id != 1 && name_id != 16) || (platform != 1 && platform != 3) ||
+                    offset + length > name.size()) {
+                    continue;
+                }
+
+                const int rank = (name_id == 16 ? 4 : 0) +
+                                 (platform == 3 ? (language == 0x409 ? 2 : 1) : 0);
+                if (rank <= best_rank) continue;
+
+                std::string value;
+                if (platform == 3) {
+                    // UTF-16BE
+                    for (std::size_t p = offset; p + 1 < offset + length; p += 2) {
+                        char32_t cp = read_be16(name, p);
+                        if (cp >= 0xD800 && cp < 0xE000) {
+                            // Only a high surrogate followed by a low one forms a pair
+                            const char32_t low = p + 3 < offset + length ? read_be16(name, p + 2) : 0;
+                            if (cp < 0xDC00 && low >= 0xDC00 && low < 0xE000) {
+                                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                                p += 2;
+                            } else {
+                                cp = 0xFFFD;
+                            }
+                        }
+                        append_utf8(value, cp);
+                    }
+                } else {
+                    // Mac Roman: keep the ASCII subset
+                    for (std::size_t p = offset; p < offset + length; ++p) {
+                        value += name[p] < 0x80 ? static_cast<char>(name[p]) : '?';
+                    }
+                }
+                if (!value.empty()) {
+                    best_rank = rank;
+                    best = std::move(value);
+                }
+            }
+            return best;
+        }
+
+        // Fill name, weight and italic of an outline font entry
+        bool read_sfnt_style(std::span<const uint8_t> data, int index, font_entry& entry) {
+            std::size_t face_offset = 0;
+            if (starts_with(data, TTC_MAGIC)) {
+                const std::size_t record = 12 + static_cast<std::size_t>(index) * 4;
+                if (record + 4 > data.size()) return false;
+                face_offset = read_be32(data, record);
+            }
+
+            if (auto os2 = find_sfnt_table(data, face_offset, "OS/2"); os2.size() >= 64) {
+                entry.weight = read_be16(os2, 4);                   // usWeightClass
+                entry.italic = (read_be16(os2, 62) & 0x0201) != 0;  // fsSelection ITALIC | OBLIQUE
+            } else if (auto head = find_sfnt_table(data, face_offset, "head"); head.size() >= 46) {
+                entry.weight = (read_be16(head, 44) & 0x01) ? 700 : 400;  // macStyle bold
+                entry.italic = (read_be16(head, 44) & 0x02) != 0;          // macStyle italic
+            }
+
+            entry.name = read_sfnt_family(find_sfnt_table(data, face_offset, "name"));
+            return !entry.name.empty();
+        }
+
         // Analyze TTF/OTF/TTC
         container_info analyze_ttf(std::span<const uint8_t> data) {
             container_info info;
@@ -310,15 +452,8 @@ namespace onyx_font {
                 entry.weight = 400;
                 entry.italic = false;
 
-                // Try to get font name by loading it briefly
-                try {
-                    ttf_font font(data, i);
-                    if (font.is_valid()) {
-                        // stb_truetype doesn't provide a direct way to get the name
-                        // We could parse the name table, but for now use a placeholder
-                        entry.name = "Font " + std::to_string(i);
-                    }
-                } catch (...) {
+                // Family name and style from the name, OS/2 and head tables
+                if (!read_sfnt_style(data, i, entry)) {
                     entry.name = "Font " + std::to_string(i);
                 }
 
@@ -453,6 +588,11 @@ namespace onyx_font {
             return analyze_bgi(data);
         }
 
+        // Check for PSF console font
+        if (auto psf = internal::psf_font_loader::parse_header(data)) {
+            return analyze_psf(*psf);
+        }
+
         // Check for Windows/OS2 executable (MZ header)
         if (data[0] == 'M' && data[1] == 'Z') {
             try {
@@ -498,6 +638,15 @@ namespace onyx_font {
     bitmap_font font_factory::load_bitmap(std::span<const uint8_t> data, size_t index) {
         THROW_IF(data.size() < 4, std::runtime_error, "Invalid font data: too small");
 
+        // PSF glyphs keep their packed layout; copy the file once so the font owns it
+        if (internal::psf_font_loader::parse_header(data)) {
+            THROW_IF(index != 0, std::invalid_argument,
+                     "PSF files contain only one font (index must be 0)");
+            auto copy = std::make_shared<const std::vector<uint8_t>>(data.begin(), data.end());
+            std::span<const uint8_t> bytes(*copy);
+            return internal::psf_font_loader::load(bytes, std::move(copy));
+        }
+
         // Check for raw FNT file first
         if (is_fnt_file(data)) {
             THROW_IF(index != 0, std::invalid_argument,
@@ -549,6 +698,19 @@ namespace onyx_font {
         return internal::win_bitmap_fon_loader::load(bitmap_fonts[index]);
     }
 
+    bitmap_font font_factory::load_bitmap(const std::filesystem::path& path, size_t index) {
+        auto file = internal::map_file(path);
+
+        // PSF glyphs are served straight from the mapping
+        if (internal::psf_font_loader::parse_header(file.bytes)) {
+            THROW_IF(index != 0, std::invalid_argument,
+                     "PSF files contain only one font (index must be 0)");
+            return internal::psf_font_loader::load(file.bytes, std::move(file.owner));
+        }
+
+        return load_bitmap(file.bytes, index);
+    }
+
     vector_font font_factory::load_vector(std::span<const uint8_t> data, size_t index) {
         THROW_IF(data.size() < 4, std::runtime_error, "Invalid font data: too small");
 
@@ -636,6 +798,12 @@ namespace onyx_font {
             return result;
         }
 
+        // Check for PSF console font
+        if (internal::psf_font_loader::parse_header(data)) {
+            result.push_back(load_bitmap(data, 0));
+            return result;
+        }
+
         // Check for raw FNT file
         if (is_fnt_file(data)) {
             auto opt_font = libexe::font_parser::parse(data);
@@ -754,6 +922,7 @@ namespace onyx_font {
             case container_format::FON_PE: return "Windows 32/64-bit Font Resource";
             case container_format::FON_LX: return "OS/2 Font Resource";
             case container_format::BGI: return "Borland Graphics Interface";
+            case container_format::PSF: return "PC Screen Font";
             default: return "Unknown";
         }
     }
@@ -786,9 +955,10 @@ namespace onyx_font {
         // Set font metadata
         result.m_name = options.name;
         result.m_first_char = options.first_char;
-        result.m_last_char = static_cast<uint8_t>(options.first_char + options.char_count - 1);
+        result.m_last_char = static_cast<char32_t>(options.first_char + options.char_count - 1);
         result.m_default_char = '?';
         result.m_break_char = ' ';
+        result.m_codepage = options.encoding;
 
         // Set metrics
         result.m_metrics.pixel_height = options.char_height;
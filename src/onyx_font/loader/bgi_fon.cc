@@ -86,6 +86,7 @@ namespace onyx_font::internal {
             font_data.header.start_char + font_data.header.char_count - 1
         );
         result.m_default_char = font_data.header.start_char;
+        result.m_codepage = codepage::cp437;  // Borland fonts follow the PC character set
 
         // Populate metrics
         result.m_metrics.ascent = font_data.header.origin_to_ascender;
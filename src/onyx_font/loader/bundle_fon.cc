@@ -0,0 +1,343 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Native bitmap/vector font encoding stored in font bundles
+//
+
+#include "loaders.hh"
+#include <failsafe/failsafe.hh>
+#include <cstring>
+#include <type_traits>
+
+namespace onyx_font::internal {
+    namespace {
+        constexpr uint32_t BITMAP_MAGIC = 0x4642'584F;  // "OXBF"
+        constexpr uint32_t VECTOR_MAGIC = 0x4656'584F;  // "OXVF"
+        constexpr uint8_t NO_CODEPAGE = 0xFF;
+
+        // All offsets are relative to the start of the payload
+        struct bitmap_header {
+            uint32_t magic;
+            uint32_t glyph_count;
+            uint32_t first_char;
+            uint32_t last_char;
+            uint32_t default_char;
+            uint32_t break_char;
+            uint16_t ascent;
+            uint16_t pixel_height;
+            uint16_t internal_leading;
+            uint16_t external_leading;
+            uint16_t avg_width;
+            uint16_t max_width;
+            uint8_t order;
+            uint8_t codepage;
+            uint16_t reserved;
+            uint32_t range_count;        ///< 0: contiguous first..last
+            uint32_t spacing_offset;     ///< glyph_count spacing_record
+            uint32_t dims_offset;        ///< glyph_count glyph_dimensions
+            uint32_t ranges_offset;      ///< range_count range_record
+            uint32_t glyphs_offset;      ///< Packed glyph bytes, back to back
+            uint64_t glyph_bytes;
+        };
+
+        struct spacing_record {
+            int16_t a_space;
+            uint16_t b_space;
+            int16_t c_space;
+            uint8_t present;             ///< Bit 0: a, bit 1: b, bit 2: c
+            uint8_t reserved;
+        };
+
+        struct range_record {
+            uint32_t first;
+            uint32_t last;
+            uint32_t first_glyph;
+        };
+
+        struct vector_header {
+            uint32_t magic;
+            uint8_t first_char;
+            uint8_t last_char;
+            uint8_t default_char;
+            uint8_t codepage;
+            int16_t ascent;
+            int16_t descent;
+            int16_t baseline;
+            uint16_t pixel_height;
+            uint16_t avg_width;
+            uint16_t max_width;
+            uint32_t glyph_count;
+            uint32_t stroke_count;
+            uint32_t glyphs_offset;      ///< glyph_count glyph_record
+            uint32_t strokes_offset;     ///< stroke_count stroke_record
+        };
+
+        struct glyph_record {
+            uint16_t width;
+            uint16_t reserved;
+            uint32_t first_stroke;
+            uint32_t stroke_count;
+        };
+
+        struct stroke_record {
+            uint8_t type;
+            int8_t dx;
+            int8_t dy;
+        };
+
+        static_assert(sizeof(bitmap_header) == 72);
+        static_assert(sizeof(spacing_record) == 8);
+        static_assert(sizeof(glyph_dimensions) == 4 && std::is_trivially_copyable_v<glyph_dimensions>);
+        static_assert(sizeof(vector_header) == 36);
+        static_assert(sizeof(stroke_record) == 3);
+
+        uint8_t encode_codepage(const std::optional<codepage>& cp) {
+            return cp ? static_cast<uint8_t>(*cp) : NO_CODEPAGE;
+        }
+
+        std::optional<codepage> decode_codepage(uint8_t value) {
+            if (value == NO_CODEPAGE) {
+                return std::nullopt;
+            }
+            THROW_IF(value > static_cast<uint8_t>(codepage::cp1252), std::runtime_error,
+                     "Bundled font has unknown codepage", static_cast<int>(value));
+            return static_cast<codepage>(value);
+        }
+
+        // Pad the payload to an alignment and return the new end offset
+        uint32_t pad_to(std::vector<uint8_t>& out, std::size_t alignment) {
+            out.resize((out.size() + alignment - 1) / alignment * alignment);
+            THROW_IF(out.size() > UINT32_MAX, std::runtime_error, "Font too large for bundle");
+            return static_cast<uint32_t>(out.size());
+        }
+
+        // Append aligned records and return their offset
+        template<typename T>
+        uint32_t append(std::vector<uint8_t>& out, const std::vector<T>& records) {
+            const auto offset = pad_to(out, 8);
+            out.resize(offset + records.size() * sizeof(T));
+            if (!records.empty()) {
+                std::memcpy(out.data() + offset, records.data(), records.size() * sizeof(T));
+            }
+            return offset;
+        }
+
+        template<typename Header>
+        Header read_header(std::span<const uint8_t> data, uint32_t magic) {
+            Header h{};
+            THROW_IF(data.size() < sizeof(Header), std::runtime_error, "Bundled font is truncated");
+            std::memcpy(&h, data.data(), sizeof(Header));
+            THROW_IF(h.magic != magic, std::runtime_error, "Bundled font has the wrong type");
+            return h;
+        }
+
+        // Checked view of count records at offset; the bundle aligns every table
+        template<typename T>
+        std::span<const T> records(std::span<const uint8_t> data, uint32_t offset, std::size_t count) {
+            THROW_IF(offset % alignof(T) != 0, std::runtime_error, "Bundled font table is misaligned");
+            THROW_IF(offset > data.size() || count > (data.size() - offset) / sizeof(T),
+                     std::runtime_error, "Bundled font is truncated");
+            return {reinterpret_cast<const T*>(data.data() + offset), count};
+        }
+    }
+
+    std::vector<uint8_t> bundle_font_codec::encode(const bitmap_font& font) {
+        const std::size_t count = font.m_storage.glyph_count();
+        THROW_IF(font.m_spacing.size() != count, std::invalid_argument,
+                 "Font", font.m_name, "has", font.m_spacing.size(), "spacings for", count, "glyphs");
+
+        bitmap_header h{};
+        h.magic = BITMAP_MAGIC;
+        h.glyph_count = static_cast<uint32_t>(count);
+        h.first_char = font.m_first_char;
+        h.last_char = font.m_last_char;
+        h.default_char = font.m_default_char;
+        h.break_char = font.m_break_char;
+        h.ascent = font.m_metrics.ascent;
+        h.pixel_height = font.m_metrics.pixel_height;
+        h.internal_leading = font.m_metrics.internal_leading;
+        h.external_leading = font.m_metrics.external_leading;
+        h.avg_width = font.m_metrics.avg_width;
+        h.max_width = font.m_metrics.max_width;
+        h.order = static_cast<uint8_t>(font.m_storage.order());
+        h.codepage = encode_codepage(font.m_codepage);
+
+        std::vector<spacing_record> spacing(count);
+        std::vector<glyph_dimensions> dims(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& sp = font.m_spacing[i];
+            spacing[i] = {sp.a_space.value_or(0), sp.b_space.value_or(0), sp.c_space.value_or(0),
+                          static_cast<uint8_t>((sp.a_space ? 1 : 0) | (sp.b_space ? 2 : 0) | (sp.c_space ? 4 : 0)),
+                          0};
+            dims[i] = font.m_storage.dimensions(i);
+        }
+
+        // Collapse the sparse index into runs of consecutive glyphs
+        std::vector<range_record> ranges;
+        if (!font.m_index.empty()) {
+            for (char32_t cp = font.m_index.min_codepoint(); cp <= font.m_index.max_codepoint(); ++cp) {
+                const uint32_t glyph = font.m_index.find(cp);
+                if (glyph == codepoint_index::npos) {
+                    continue;
+                }
+                if (!ranges.empty()) {
+                    auto& run = ranges.back();
+                    if (run.last + 1 == cp && run.first_glyph + (cp - run.first) == glyph) {
+                        run.last = cp;
+                        continue;
+                    }
+                }
+                ranges.push_back({cp, cp, glyph});
+            }
+        }
+        h.range_count = static_cast<uint32_t>(ranges.size());
+
+        std::vector<uint8_t> out(sizeof(bitmap_header));
+        h.spacing_offset = append(out, spacing);
+        h.dims_offset = append(out, dims);
+        h.ranges_offset = append(out, ranges);
+        h.glyphs_offset = pad_to(out, 16);
+
+        // Rows are re-packed at the minimal stride, as bitmap_builder stores them
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto view = font.m_storage.view(i);
+            const auto stride = bitmap_builder::packed_stride(view.width());
+            for (uint16_t y = 0; y < view.height(); ++y) {
+                const auto row = view.row(y);
+                const auto* bytes = reinterpret_cast<const uint8_t*>(row.data());
+                out.insert(out.end(), bytes, bytes + stride);
+            }
+        }
+        h.glyph_bytes = out.size() - h.glyphs_offset;
+
+        std::memcpy(out.data(), &h, sizeof(h));
+        return out;
+    }
+
+    std::vector<uint8_t> bundle_font_codec::encode(const vector_font& font) {
+        vector_header h{};
+        h.magic = VECTOR_MAGIC;
+        h.first_char = font.m_first_char;
+        h.last_char = font.m_last_char;
+        h.default_char = font.m_default_char;
+        h.codepage = encode_codepage(font.m_codepage);
+        h.ascent = font.m_metrics.ascent;
+        h.descent = font.m_metrics.descent;
+        h.baseline = font.m_metrics.baseline;
+        h.pixel_height = font.m_metrics.pixel_height;
+        h.avg_width = font.m_metrics.avg_width;
+        h.max_width = font.m_metrics.max_width;
+
+        std::vector<glyph_record> glyphs;
+        std::vector<stroke_record> strokes;
+        glyphs.reserve(font.m_glyphs.size());
+        for (const auto& g : font.m_glyphs) {
+            glyphs.push_back({g.width, 0, static_cast<uint32_t>(strokes.size()),
+                              static_cast<uint32_t>(g.strokes.size())});
+            for (const auto& s : g.strokes) {
+                strokes.push_back({static_cast<uint8_t>(s.type), s.dx, s.dy});
+            }
+        }
+        h.glyph_count = static_cast<uint32_t>(glyphs.size());
+        h.stroke_count = static_cast<uint32_t>(strokes.size());
+
+        std::vector<uint8_t> out(sizeof(vector_header));
+        h.glyphs_offset = append(out, glyphs);
+        h.strokes_offset = append(out, strokes);
+
+        std::memcpy(out.data(), &h, sizeof(h));
+        return out;
+    }
+
+    bitmap_font bundle_font_codec::decode_bitmap(std::span<const uint8_t> data, std::string name,
+                                                 std::shared_ptr<const void> owner) {
+        const auto h = read_header<bitmap_header>(data, BITMAP_MAGIC);
+        THROW_IF(h.order > static_cast<uint8_t>(bit_order::lsb_first), std::runtime_error,
+                 "Bundled font has unknown bit order");
+
+        const auto spacing = records<spacing_record>(data, h.spacing_offset, h.glyph_count);
+        const auto dims = records<glyph_dimensions>(data, h.dims_offset, h.glyph_count);
+        const auto ranges = records<range_record>(data, h.ranges_offset, h.range_count);
+        THROW_IF(h.glyphs_offset > data.size() || h.glyph_bytes > data.size() - h.glyphs_offset,
+                 std::runtime_error, "Bundled font is truncated");
+
+        bitmap_font font;
+        font.m_name = std::move(name);
+        font.m_codepage = decode_codepage(h.codepage);
+        font.m_first_char = h.first_char;
+        font.m_last_char = h.last_char;
+        font.m_default_char = h.default_char;
+        font.m_break_char = h.break_char;
+        font.m_metrics.ascent = h.ascent;
+        font.m_metrics.pixel_height = h.pixel_height;
+        font.m_metrics.internal_leading = h.internal_leading;
+        font.m_metrics.external_leading = h.external_leading;
+        font.m_metrics.avg_width = h.avg_width;
+        font.m_metrics.max_width = h.max_width;
+
+        font.m_spacing.reserve(h.glyph_count);
+        for (const auto& sp : spacing) {
+            auto& out = font.m_spacing.emplace_back();
+            if (sp.present & 1) out.a_space = sp.a_space;
+            if (sp.present & 2) out.b_space = sp.b_space;
+            if (sp.present & 4) out.c_space = sp.c_space;
+        }
+
+        for (const auto& r : ranges) {
+            THROW_IF(r.first > r.last || r.last > 0x10FFFF ||
+                     r.first_glyph >= h.glyph_count || r.last - r.first >= h.glyph_count - r.first_glyph,
+                     std::runtime_error, "Bundled font has an invalid character range");
+            font.m_index.insert_range(r.first, r.last, r.first_glyph);
+        }
+        if (!font.m_index.empty()) {
+            font.use_index();
+        }
+
+        const auto* glyphs = reinterpret_cast<const std::byte*>(data.data() + h.glyphs_offset);
+        try {
+            font.m_storage = bitmap_storage::wrap(std::move(owner),
+                                                  {glyphs, static_cast<std::size_t>(h.glyph_bytes)},
+                                                  dims, static_cast<bit_order>(h.order));
+        } catch (const std::invalid_argument&) {
+            THROW_RUNTIME("Bundled font is truncated");
+        }
+        return font;
+    }
+
+    vector_font bundle_font_codec::decode_vector(std::span<const uint8_t> data, std::string name) {
+        const auto h = read_header<vector_header>(data, VECTOR_MAGIC);
+        const auto glyphs = records<glyph_record>(data, h.glyphs_offset, h.glyph_count);
+        const auto strokes = records<stroke_record>(data, h.strokes_offset, h.stroke_count);
+        // vector_font indexes its glyphs by ch - first_char
+        THROW_IF(h.last_char >= h.first_char && h.glyph_count < h.last_char - h.first_char + 1u,
+                 std::runtime_error, "Bundled font is missing glyphs");
+
+        vector_font font;
+        font.m_name = std::move(name);
+        font.m_codepage = decode_codepage(h.codepage);
+        font.m_first_char = h.first_char;
+        font.m_last_char = h.last_char;
+        font.m_default_char = h.default_char;
+        font.m_metrics.ascent = h.ascent;
+        font.m_metrics.descent = h.descent;
+        font.m_metrics.baseline = h.baseline;
+        font.m_metrics.pixel_height = h.pixel_height;
+        font.m_metrics.avg_width = h.avg_width;
+        font.m_metrics.max_width = h.max_width;
+
+        font.m_glyphs.reserve(h.glyph_count);
+        for (const auto& g : glyphs) {
+            THROW_IF(g.first_stroke > h.stroke_count || g.stroke_count > h.stroke_count - g.first_stroke,
+                     std::runtime_error, "Bundled font has an invalid stroke range");
+            auto& out = font.m_glyphs.emplace_back();
+            out.width = g.width;
+            out.strokes.reserve(g.stroke_count);
+            for (const auto& s : strokes.subspan(g.first_stroke, g.stroke_count)) {
+                THROW_IF(s.type > static_cast<uint8_t>(stroke_type::END), std::runtime_error,
+                         "Bundled font has an unknown stroke command");
+                out.strokes.push_back({static_cast<stroke_type>(s.type), s.dx, s.dy});
+            }
+        }
+        return font;
+    }
+}  // namespace onyx_font::internal
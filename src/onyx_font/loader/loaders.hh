@@ -9,10 +9,25 @@
 #include <onyx_font/bitmap_font.hh>
 #include <onyx_font/vector_font.hh>
 #include <libexe/resources/parsers/font_parser.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
 #include <span>
+#include <string>
+#include <vector>
 
 namespace onyx_font::internal {
 
+    /// Read-only bytes of a whole file; owner keeps them valid
+    struct mapped_file {
+        std::shared_ptr<const void> owner;
+        std::span<const uint8_t> bytes;
+    };
+
+    /// Memory-map a file where supported, otherwise read it
+    mapped_file map_file(const std::filesystem::path& path);
+
     /// Load bitmap font from Windows FNT data
     struct win_bitmap_fon_loader {
         static bitmap_font load(const libexe::font_data& fd);
@@ -23,9 +38,43 @@ namespace onyx_font::internal {
         static vector_font load(const libexe::font_data& fd);
     };
 
+    /// Header fields of a PSF1/PSF2 (Linux console) font
+    struct psf_header {
+        uint8_t version = 0;           ///< 1 or 2
+        uint32_t glyph_count = 0;      ///< Number of glyphs
+        uint32_t glyph_bytes = 0;      ///< Bytes per glyph
+        uint32_t width = 0;            ///< Glyph width in pixels
+        uint32_t height = 0;           ///< Glyph height in pixels
+        uint32_t glyph_offset = 0;     ///< Offset of the first glyph
+        bool has_unicode_table = false;
+    };
+
+    /// Load bitmap font from PSF1/PSF2 data without copying the glyphs
+    struct psf_font_loader {
+        /// Parse and validate the header; nullopt if data is not a usable PSF font
+        static std::optional<psf_header> parse_header(std::span<const uint8_t> data);
+
+        /// Display name for a PSF font (PSF has no name field)
+        static std::string name(const psf_header& header);
+
+        /// Glyphs are served from data in place; owner must keep data alive
+        static bitmap_font load(std::span<const uint8_t> data, std::shared_ptr<const void> owner);
+    };
+
     /// Load vector font from BGI CHR data
     struct bgi_font_loader {
         static vector_font load(std::span<const uint8_t> data);
     };
 
+    /// Native bitmap/vector font encoding used by font bundles
+    struct bundle_font_codec {
+        static std::vector<uint8_t> encode(const bitmap_font& font);
+        static std::vector<uint8_t> encode(const vector_font& font);
+
+        /// Glyph bytes stay in data; owner must keep data alive
+        static bitmap_font decode_bitmap(std::span<const uint8_t> data, std::string name,
+                                         std::shared_ptr<const void> owner);
+        static vector_font decode_vector(std::span<const uint8_t> data, std::string name);
+    };
+
 }  // namespace onyx_font::internal
@@ -0,0 +1,61 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Read-only file mapping shared by the PSF and bundle loaders
+//
+
+#include "loaders.hh"
+#include <failsafe/failsafe.hh>
+#include <fstream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ONYX_FONT_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace onyx_font::internal {
+    namespace {
+        std::vector<uint8_t> read_file(const std::filesystem::path& path) {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            THROW_IF(!file, std::runtime_error, "Cannot open file:", path.string());
+
+            auto size = file.tellg();
+            file.seekg(0, std::ios::beg);
+
+            std::vector<uint8_t> data(static_cast<size_t>(size));
+            THROW_IF(!file.read(reinterpret_cast<char*>(data.data()), size),
+                     std::runtime_error, "Failed to read file:", path.string());
+
+            return data;
+        }
+    }
+
+    mapped_file map_file(const std::filesystem::path& path) {
+#if defined(ONYX_FONT_HAS_MMAP)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        THROW_IF(fd < 0, std::runtime_error, "Cannot open file:", path.string());
+
+        struct stat st{};
+        const bool has_size = ::fstat(fd, &st) == 0 && st.st_size > 0;
+        void* base = has_size
+                         ? ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0)
+                         : MAP_FAILED;
+        ::close(fd);
+
+        if (base != MAP_FAILED) {
+            auto size = static_cast<size_t>(st.st_size);
+            std::shared_ptr<const void> owner(base, [size](const void* p) {
+                ::munmap(const_cast<void*>(p), size);
+            });
+            return {std::move(owner), {static_cast<const uint8_t*>(base), size}};
+        }
+#endif
+        auto data = std::make_shared<const std::vector<uint8_t>>(read_file(path));
+        std::span<const uint8_t> bytes(*data);
+        return {std::move(data), bytes};
+    }
+}  // namespace onyx_font::internal
@@ -0,0 +1,178 @@
+//
+// Created by igor on 18/10/2026.
+//
+// PSF1/PSF2 (Linux console) font loader
+//
+
+#include "loaders.hh"
+#include <onyx_font/text/utf8.hh>
+#include <failsafe/failsafe.hh>
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+namespace onyx_font::internal {
+    namespace {
+        constexpr uint8_t PSF1_MAGIC[] = {0x36, 0x04};
+        constexpr uint8_t PSF2_MAGIC[] = {0x72, 0xB5, 0x4A, 0x86};
+
+        constexpr uint8_t PSF1_MODE512 = 0x01;
+        constexpr uint8_t PSF1_MODEHASTAB = 0x02;
+        constexpr uint8_t PSF1_MODESEQ = 0x04;
+        constexpr uint32_t PSF2_HAS_UNICODE_TABLE = 0x01;
+
+        constexpr uint16_t PSF1_SEPARATOR = 0xFFFF;
+        constexpr uint16_t PSF1_STARTSEQ = 0xFFFE;
+        constexpr uint8_t PSF2_SEPARATOR = 0xFF;
+        constexpr uint8_t PSF2_STARTSEQ = 0xFE;
+
+        uint16_t read_u16(std::span<const uint8_t> data, std::size_t offset) {
+            return static_cast<uint16_t>(data[offset] | (data[offset + 1] << 8));
+        }
+
+        uint32_t read_u32(std::span<const uint8_t> data, std::size_t offset) {
+            return static_cast<uint32_t>(data[offset]) |
+                   (static_cast<uint32_t>(data[offset + 1]) << 8) |
+                   (static_cast<uint32_t>(data[offset + 2]) << 16) |
+                   (static_cast<uint32_t>(data[offset + 3]) << 24);
+        }
+
+        // PSF1 table: per glyph, UCS-2 values, then 0xFFFE-led sequences, then 0xFFFF
+        void read_psf1_table(std::span<const uint8_t> table, uint32_t glyph_count, codepoint_index& index) {
+            std::size_t pos = 0;
+            for (uint32_t glyph = 0; glyph < glyph_count && pos + 1 < table.size(); ++glyph) {
+                bool in_sequence = false;
+                while (pos + 1 < table.size()) {
+                    uint16_t value = read_u16(table, pos);
+                    pos += 2;
+                    if (value == PSF1_SEPARATOR) break;
+                    if (value == PSF1_STARTSEQ) {
+                        in_sequence = true;
+                    } else if (!in_sequence) {
+                        index.insert(value, glyph);
+                    }
+                }
+            }
+        }
+
+        // PSF2 table: per glyph, UTF-8 codepoints, then 0xFE-led sequences, then 0xFF
+        void read_psf2_table(std::span<const uint8_t> table, uint32_t glyph_count, codepoint_index& index) {
+            std::size_t pos = 0;
+            for (uint32_t glyph = 0; glyph < glyph_count && pos < table.size(); ++glyph) {
+                std::size_t end = pos;
+                while (end < table.size() && table[end] != PSF2_SEPARATOR && table[end] != PSF2_STARTSEQ) {
+                    ++end;
+                }
+
+                std::string_view singles(reinterpret_cast<const char*>(table.data() + pos), end - pos);
+                while (!singles.empty()) {
+                    auto decoded = utf8_decode_one(singles);
+                    if (decoded.bytes_consumed == 0) break;
+                    if (decoded.codepoint != 0xFFFD) {
+                        index.insert(decoded.codepoint, glyph);
+                    }
+                    singles.remove_prefix(static_cast<std::size_t>(decoded.bytes_consumed));
+                }
+
+                // Skip sequences up to the separator
+                while (end < table.size() && table[end] != PSF2_SEPARATOR) {
+                    ++end;
+                }
+                pos = end + 1;
+            }
+        }
+    }
+
+    std::optional<psf_header> psf_font_loader::parse_header(std::span<const uint8_t> data) {
+        psf_header header;
+
+        if (data.size() >= 4 && data[0] == PSF1_MAGIC[0] && data[1] == PSF1_MAGIC[1]) {
+            const uint8_t mode = data[2];
+            header.version = 1;
+            header.glyph_count = (mode & PSF1_MODE512) ? 512 : 256;
+            header.glyph_bytes = data[3];
+            header.width = 8;
+            header.height = data[3];
+            header.glyph_offset = 4;
+            header.has_unicode_table = (mode & (PSF1_MODEHASTAB | PSF1_MODESEQ)) != 0;
+        } else if (data.size() >= 32 && std::equal(std::begin(PSF2_MAGIC), std::end(PSF2_MAGIC), data.begin())) {
+            header.version = 2;
+            header.glyph_offset = read_u32(data, 8);
+            header.has_unicode_table = (read_u32(data, 12) & PSF2_HAS_UNICODE_TABLE) != 0;
+            header.glyph_count = read_u32(data, 16);
+            header.glyph_bytes = read_u32(data, 20);
+            header.height = read_u32(data, 24);
+            header.width = read_u32(data, 28);
+        } else {
+            return std::nullopt;
+        }
+
+        // Glyph rows must be packed exactly as bitmap_storage expects
+        if (header.width == 0 || header.height == 0 || header.width > 0xFFFF || header.height > 0xFFFF) {
+            return std::nullopt;
+        }
+        const uint64_t stride = (header.width + 7u) / 8u;
+        if (header.glyph_bytes != stride * header.height || header.glyph_count == 0) {
+            return std::nullopt;
+        }
+        const uint64_t glyphs_end = header.glyph_offset +
+                                    static_cast<uint64_t>(header.glyph_count) * header.glyph_bytes;
+        if (header.glyph_offset < (header.version == 1 ? 4u : 32u) || glyphs_end > data.size()) {
+            return std::nullopt;
+        }
+        return header;
+    }
+
+    std::string psf_font_loader::name(const psf_header& header) {
+        return "PSF" + std::to_string(header.version) + " " +
+               std::to_string(header.width) + "x" + std::to_string(header.height);
+    }
+
+    bitmap_font psf_font_loader::load(std::span<const uint8_t> data, std::shared_ptr<const void> owner) {
+        auto header = parse_header(data);
+        THROW_IF(!header, std::runtime_error, "Not a valid PSF font");
+
+        const auto width = static_cast<uint16_t>(header->width);
+        const auto height = static_cast<uint16_t>(header->height);
+        const std::size_t glyphs_size = static_cast<std::size_t>(header->glyph_count) * header->glyph_bytes;
+
+        bitmap_font font;
+        font.m_name = name(*header);
+
+        if (header->has_unicode_table) {
+            auto table = data.subspan(header->glyph_offset + glyphs_size);
+            if (header->version == 1) {
+                read_psf1_table(table, header->glyph_count, font.m_index);
+            } else {
+                read_psf2_table(table, header->glyph_count, font.m_index);
+            }
+        }
+
+        if (!font.m_index.empty()) {
+            font.use_index();
+        } else {
+            // No table: glyphs are addressed by position, as the console does
+            font.m_first_char = 0;
+            font.m_last_char = header->glyph_count - 1;
+        }
+        font.m_break_char = ' ';
+
+        font.m_metrics.pixel_height = height;
+        font.m_metrics.ascent = height;  // PSF has no baseline; match load_raw()
+        font.m_metrics.internal_leading = 0;
+        font.m_metrics.external_leading = 0;
+        font.m_metrics.avg_width = width;
+        font.m_metrics.max_width = width;
+
+        font.m_spacing.resize(header->glyph_count);
+        for (auto& sp : font.m_spacing) {
+            sp.b_space = width;
+        }
+
+        auto glyphs = std::as_bytes(data.subspan(header->glyph_offset, glyphs_size));
+        font.m_storage = bitmap_storage::wrap_uniform(std::move(owner), glyphs, header->glyph_count,
+                                                      width, height, bit_order::msb_first);
+        font.m_default_char = font.has_glyph(U'?') ? U'?' : font.m_first_char;
+        return font;
+    }
+}  // namespace onyx_font::internal
@@ -0,0 +1,128 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/atlas_mipmap.hh>
+#include <failsafe/failsafe.hh>
+#include <algorithm>
+
+namespace onyx_font {
+
+namespace {
+
+/// Box-filter a rectangle of the destination level from its parent level
+void downsample(const uint8_t* src, int src_stride, int src_w, int src_h,
+                uint8_t* dst, int dst_w,
+                int x0, int y0, int x1, int y1) noexcept {
+    for (int y = y0; y < y1; ++y) {
+        int sy0 = std::min(2 * y, src_h - 1);
+        int sy1 = std::min(2 * y + 1, src_h - 1);
+        const uint8_t* row0 = src + static_cast<std::ptrdiff_t>(sy0) * src_stride;
+        const uint8_t* row1 = src + static_cast<std::ptrdiff_t>(sy1) * src_stride;
+        uint8_t* out = dst + static_cast<std::ptrdiff_t>(y) * dst_w;
+
+        for (int x = x0; x < x1; ++x) {
+            int sx0 = std::min(2 * x, src_w - 1);
+            int sx1 = std::min(2 * x + 1, src_w - 1);
+            int sum = row0[sx0] + row0[sx1] + row1[sx0] + row1[sx1];
+            out[x] = static_cast<uint8_t>((sum + 2) >> 2);
+        }
+    }
+}
+
+} // anonymous namespace
+
+atlas_mip_chain::atlas_mip_chain(int width, int height, int levels)
+    : m_width(std::max(width, 0))
+    , m_height(std::max(height, 0)) {
+    int w = m_width;
+    int h = m_height;
+    for (int level = 0; level < levels && (w > 1 || h > 1); ++level) {
+        w = std::max(w / 2, 1);
+        h = std::max(h / 2, 1);
+        m_levels.emplace_back(static_cast<std::size_t>(w) * static_cast<std::size_t>(h), 0);
+    }
+}
+
+int atlas_mip_chain::level_width(int level) const noexcept {
+    int w = m_width;
+    for (int i = 0; i < level; ++i) {
+        w = std::max(w / 2, 1);
+    }
+    return w;
+}
+
+int atlas_mip_chain::level_height(int level) const noexcept {
+    int h = m_height;
+    for (int i = 0; i < level; ++i) {
+        h = std::max(h / 2, 1);
+    }
+    return h;
+}
+
+const uint8_t* atlas_mip_chain::level_data(int level) const {
+    if (level < 1 || level > level_count()) {
+        THROW_OUT_OF_RANGE("Mip level out of range:", level);
+    }
+    return m_levels[static_cast<std::size_t>(level - 1)].data();
+}
+
+void atlas_mip_chain::rebuild(const uint8_t* pixels, int stride) {
+    update_region(pixels, stride, {0, 0, m_width, m_height});
+}
+
+void atlas_mip_chain::update_region(const uint8_t* pixels, int stride, glyph_rect region) {
+    int x0 = std::max(region.x, 0);
+    int y0 = std::max(region.y, 0);
+    int x1 = std::min(region.x + region.w, m_width);
+    int y1 = std::min(region.y + region.h, m_height);
+    if (!pixels || x1 <= x0 || y1 <= y0) return;
+
+    const uint8_t* src = pixels;
+    int src_stride = stride;
+    int src_w = m_width;
+    int src_h = m_height;
+
+    for (std::size_t i = 0; i < m_levels.size(); ++i) {
+        int dst_w = std::max(src_w / 2, 1);
+        int dst_h = std::max(src_h / 2, 1);
+
+        // Parent pixels [x0, x1) feed child pixels [x0/2, ceil(x1/2))
+        x0 = x0 / 2;
+        y0 = y0 / 2;
+        x1 = std::min((x1 + 1) / 2, dst_w);
+        y1 = std::min((y1 + 1) / 2, dst_h);
+
+        uint8_t* dst = m_levels[i].data();
+        downsample(src, src_stride, src_w, src_h, dst, dst_w, x0, y0, x1, y1);
+
+        src = dst;
+        src_stride = dst_w;
+        src_w = dst_w;
+        src_h = dst_h;
+    }
+}
+
+glyph_rect atlas_mip_chain::update(const alpha_atlas_base& atlas) {
+    THROW_IF(atlas.width() != m_width || atlas.height() != m_height, std::invalid_argument,
+             "Mip chain size does not match atlas:", m_width, "x", m_height);
+
+    // Revisions of another atlas (e.g. a page replaced by glyph_cache::clear())
+    // say nothing about what the levels hold
+    if ((m_atlas != 0 && atlas.identity() != m_atlas) || atlas.revision() < m_revision) {
+        rebuild(atlas.data(), atlas.stride());
+        m_atlas = atlas.identity();
+        m_revision = atlas.revision();
+        return {0, 0, m_width, m_height};
+    }
+
+    glyph_rect bounds = atlas.dirty_bounds(m_revision);
+    atlas.for_each_dirty_tile(m_revision, [&](glyph_rect tile) {
+        update_region(atlas.data(), atlas.stride(), tile);
+    });
+    m_atlas = atlas.identity();
+    m_revision = atlas.revision();
+    return bounds;
+}
+
+} // namespace onyx_font
@@ -0,0 +1,15 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/atlas_surface.hh>
+#include <atomic>
+
+namespace onyx_font {
+
+uint64_t alpha_atlas_base::next_identity() noexcept {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // namespace onyx_font
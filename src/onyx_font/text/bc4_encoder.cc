@@ -0,0 +1,368 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/bc4_encoder.hh>
+#include <failsafe/failsafe.hh>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ONYX_FONT_BC4_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace onyx_font {
+
+namespace {
+
+/// Copy a 4x4 block into a contiguous 16-byte array
+void gather_block(const uint8_t* pixels, int stride, uint8_t* block) noexcept {
+    for (int row = 0; row < 4; ++row) {
+        std::memcpy(block + row * 4, pixels + static_cast<std::ptrdiff_t>(row) * stride, 4);
+    }
+}
+
+/// Reciprocal used to quantize (p - lo) into 8 levels: ceil(2^16 / (2 * range))
+uint16_t level_reciprocal(int range) noexcept {
+    return static_cast<uint16_t>((65536 + 2 * range - 1) / (2 * range));
+}
+
+/// Map a quantization level (0 = lo, 7 = hi) to the BC4 8-value mode index
+int level_to_index(int level) noexcept {
+    int idx = (8 - level) & 7;
+    return idx < 2 ? idx ^ 1 : idx;
+}
+
+/// Build the decoded palette for endpoints r0, r1
+void build_palette(int r0, int r1, int* palette) noexcept {
+    palette[0] = r0;
+    palette[1] = r1;
+    if (r0 > r1) {
+        for (int i = 2; i < 8; ++i) {
+            palette[i] = ((8 - i) * r0 + (i - 1) * r1 + 3) / 7;
+        }
+    } else {
+        for (int i = 2; i < 6; ++i) {
+            palette[i] = ((6 - i) * r0 + (i - 1) * r1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+int block_error(const uint8_t* block, const uint8_t* indices, int r0, int r1) noexcept {
+    int palette[8];
+    build_palette(r0, r1, palette);
+    int err = 0;
+    for (int i = 0; i < 16; ++i) {
+        int d = block[i] - palette[indices[i]];
+        err += d * d;
+    }
+    return err;
+}
+
+void min_max_scalar(const uint8_t* block, int& lo, int& hi) noexcept {
+    lo = 255;
+    hi = 0;
+    for (int i = 0; i < 16; ++i) {
+        lo = std::min(lo, static_cast<int>(block[i]));
+        hi = std::max(hi, static_cast<int>(block[i]));
+    }
+}
+
+void indices8_scalar(const uint8_t* block, int lo, int hi, uint8_t* indices) noexcept {
+    int range = hi - lo;
+    uint32_t inv = level_reciprocal(range);
+    for (int i = 0; i < 16; ++i) {
+        uint32_t n = static_cast<uint32_t>((block[i] - lo) * 14 + range);
+        int level = std::min(static_cast<int>((n * inv) >> 16), 7);
+        indices[i] = static_cast<uint8_t>(level_to_index(level));
+    }
+}
+
+#if defined(ONYX_FONT_BC4_SSE2)
+void min_max_sse2(const uint8_t* block, int& lo, int& hi) noexcept {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    __m128i mn = _mm_min_epu8(v, _mm_srli_si128(v, 8));
+    __m128i mx = _mm_max_epu8(v, _mm_srli_si128(v, 8));
+    mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 4));
+    mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 4));
+    mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 2));
+    mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 2));
+    mn = _mm_min_epu8(mn, _mm_srli_si128(mn, 1));
+    mx = _mm_max_epu8(mx, _mm_srli_si128(mx, 1));
+    lo = _mm_cvtsi128_si32(mn) & 0xFF;
+    hi = _mm_cvtsi128_si32(mx) & 0xFF;
+}
+
+__m128i indices8_half(__m128i px16, __m128i lo, __m128i range, __m128i inv) noexcept {
+    const __m128i fourteen = _mm_set1_epi16(14);
+    const __m128i seven = _mm_set1_epi16(7);
+    const __m128i eight = _mm_set1_epi16(8);
+    const __m128i two = _mm_set1_epi16(2);
+    const __m128i one = _mm_set1_epi16(1);
+
+    __m128i n = _mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(px16, lo), fourteen), range);
+    __m128i level = _mm_mulhi_epu16(n, inv);
+    level = _mm_min_epi16(level, seven);
+    __m128i idx = _mm_and_si128(_mm_sub_epi16(eight, level), seven);
+    __m128i swap = _mm_and_si128(_mm_cmplt_epi16(idx, two), one);
+    return _mm_xor_si128(idx, swap);
+}
+
+void indices8_sse2(const uint8_t* block, int lo, int hi, uint8_t* indices) noexcept {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    __m128i lo16 = _mm_set1_epi16(static_cast<short>(lo));
+    __m128i range16 = _mm_set1_epi16(static_cast<short>(hi - lo));
+    __m128i inv16 = _mm_set1_epi16(static_cast<short>(level_reciprocal(hi - lo)));
+
+    __m128i a = indices8_half(_mm_unpacklo_epi8(v, zero), lo16, range16, inv16);
+    __m128i b = indices8_half(_mm_unpackhi_epi8(v, zero), lo16, range16, inv16);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(indices), _mm_packus_epi16(a, b));
+}
+#endif
+
+/// Try the 6-value mode (explicit 0 and 255) using the interior range
+bool try_mode6(const uint8_t* block, uint8_t* indices, int& r0, int& r1) noexcept {
+    int lo = 255;
+    int hi = 0;
+    for (int i = 0; i < 16; ++i) {
+        int p = block[i];
+        if (p != 0 && p != 255) {
+            lo = std::min(lo, p);
+            hi = std::max(hi, p);
+        }
+    }
+    if (lo > hi) return false;
+
+    int palette[8];
+    build_palette(lo, hi, palette);
+    for (int i = 0; i < 16; ++i) {
+        int best = 0;
+        int best_err = 1 << 30;
+        for (int j = 0; j < 8; ++j) {
+            int d = block[i] - palette[j];
+            if (d * d < best_err) {
+                best_err = d * d;
+                best = j;
+            }
+        }
+        indices[i] = static_cast<uint8_t>(best);
+    }
+    r0 = lo;
+    r1 = hi;
+    return true;
+}
+
+void write_block(int r0, int r1, const uint8_t* indices, uint8_t* out) noexcept {
+    out[0] = static_cast<uint8_t>(r0);
+    out[1] = static_cast<uint8_t>(r1);
+    uint64_t bits = 0;
+    for (int i = 0; i < 16; ++i) {
+        bits |= static_cast<uint64_t>(indices[i] & 7) << (3 * i);
+    }
+    for (int i = 0; i < 6; ++i) {
+        out[2 + i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+}
+
+template<bool Simd>
+void encode_block_impl(const uint8_t* pixels, int stride, uint8_t* out) noexcept {
+    uint8_t block[16];
+    gather_block(pixels, stride, block);
+
+    int lo = 0;
+    int hi = 0;
+#if defined(ONYX_FONT_BC4_SSE2)
+    if constexpr (Simd) {
+        min_max_sse2(block, lo, hi);
+    } else {
+        min_max_scalar(block, lo, hi);
+    }
+#else
+    min_max_scalar(block, lo, hi);
+#endif
+
+    uint8_t indices[16] = {};
+    if (lo == hi) {
+        write_block(lo, lo, indices, out);
+        return;
+    }
+
+#if defined(ONYX_FONT_BC4_SSE2)
+    if constexpr (Simd) {
+        indices8_sse2(block, lo, hi, indices);
+    } else {
+        indices8_scalar(block, lo, hi, indices);
+    }
+#else
+    indices8_scalar(block, lo, hi, indices);
+#endif
+
+    int r0 = hi;
+    int r1 = lo;
+
+    // Blocks mixing fully transparent/opaque pixels with edge values are
+    // common in glyphs; the 6-value mode represents 0 and 255 exactly.
+    if (lo == 0 || hi == 255) {
+        uint8_t alt[16];
+        int a0 = 0;
+        int a1 = 0;
+        if (try_mode6(block, alt, a0, a1) &&
+            block_error(block, alt, a0, a1) < block_error(block, indices, r0, r1)) {
+            std::memcpy(indices, alt, sizeof(indices));
+            r0 = a0;
+            r1 = a1;
+        }
+    }
+
+    write_block(r0, r1, indices, out);
+}
+
+} // anonymous namespace
+
+void bc4_encode_block(const uint8_t* pixels, int stride, uint8_t* out) noexcept {
+    encode_block_impl<true>(pixels, stride, out);
+}
+
+void bc4_encode_block_scalar(const uint8_t* pixels, int stride, uint8_t* out) noexcept {
+    encode_block_impl<false>(pixels, stride, out);
+}
+
+void bc4_decode_block(const uint8_t* block, uint8_t* pixels, int stride) noexcept {
+    int palette[8];
+    build_palette(block[0], block[1], palette);
+
+    uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i) {
+        bits |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+    }
+    for (int i = 0; i < 16; ++i) {
+        int idx = static_cast<int>((bits >> (3 * i)) & 7);
+        pixels[static_cast<std::ptrdiff_t>(i / 4) * stride + i % 4] = static_cast<uint8_t>(palette[idx]);
+    }
+}
+
+bool bc4_has_simd() noexcept {
+#if defined(ONYX_FONT_BC4_SSE2)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// ============================================================================
+// bc4_image
+// ============================================================================
+
+bc4_image::bc4_image(int width, int height)
+    : m_width(std::max(width, 0))
+    , m_height(std::max(height, 0))
+    , m_blocks_x((m_width + 3) / 4)
+    , m_blocks_y((m_height + 3) / 4)
+    , m_blocks(static_cast<std::size_t>(m_blocks_x) * static_cast<std::size_t>(m_blocks_y) * bc4_block_bytes, 0) {}
+
+const uint8_t* bc4_image::block(int bx, int by) const noexcept {
+    return m_blocks.data() +
+           (static_cast<std::size_t>(by) * static_cast<std::size_t>(m_blocks_x) +
+            static_cast<std::size_t>(bx)) * bc4_block_bytes;
+}
+
+void bc4_image::encode_block_at(const uint8_t* pixels, int stride, int bx, int by) {
+    uint8_t* out = m_blocks.data() +
+                   (static_cast<std::size_t>(by) * static_cast<std::size_t>(m_blocks_x) +
+                    static_cast<std::size_t>(bx)) * bc4_block_bytes;
+    int x = bx * 4;
+    int y = by * 4;
+
+    if (x + 4 <= m_width && y + 4 <= m_height) {
+        bc4_encode_block(pixels + static_cast<std::ptrdiff_t>(y) * stride + x, stride, out);
+        return;
+    }
+
+    // Partial block at the image edge: replicate the last row/column
+    uint8_t padded[16];
+    for (int row = 0; row < 4; ++row) {
+        int sy = std::min(y + row, m_height - 1);
+        for (int col = 0; col < 4; ++col) {
+            int sx = std::min(x + col, m_width - 1);
+            padded[row * 4 + col] = pixels[static_cast<std::ptrdiff_t>(sy) * stride + sx];
+        }
+    }
+    bc4_encode_block(padded, 4, out);
+}
+
+glyph_rect bc4_image::encode(const uint8_t* pixels, int stride, glyph_rect region) {
+    int x0 = std::max(region.x, 0);
+    int y0 = std::max(region.y, 0);
+    int x1 = std::min(region.x + region.w, m_width);
+    int y1 = std::min(region.y + region.h, m_height);
+    if (!pixels || x1 <= x0 || y1 <= y0) return {};
+
+    int bx0 = x0 / 4;
+    int by0 = y0 / 4;
+    int bx1 = (x1 + 3) / 4;
+    int by1 = (y1 + 3) / 4;
+
+    for (int by = by0; by < by1; ++by) {
+        for (int bx = bx0; bx < bx1; ++bx) {
+            encode_block_at(pixels, stride, bx, by);
+        }
+    }
+
+    return {bx0 * 4, by0 * 4,
+            std::min(bx1 * 4, m_width) - bx0 * 4,
+            std::min(by1 * 4, m_height) - by0 * 4};
+}
+
+void bc4_image::encode(const uint8_t* pixels, int stride) {
+    encode(pixels, stride, {0, 0, m_width, m_height});
+}
+
+glyph_rect bc4_image::update(const alpha_atlas_base& atlas) {
+    THROW_IF(atlas.width() != m_width || atlas.height() != m_height, std::invalid_argument,
+             "BC4 image size does not match atlas:", m_width, "x", m_height);
+
+    // Revisions of another atlas (e.g. a page replaced by glyph_cache::clear())
+    // say nothing about what this image holds
+    if ((m_atlas != 0 && atlas.identity() != m_atlas) || atlas.revision() < m_revision) {
+        encode(atlas.data(), atlas.stride());
+        m_atlas = atlas.identity();
+        m_revision = atlas.revision();
+        return {0, 0, m_width, m_height};
+    }
+
+    int x0 = m_width, y0 = m_height, x1 = 0, y1 = 0;
+    atlas.for_each_dirty_tile(m_revision, [&](glyph_rect tile) {
+        glyph_rect done = encode(atlas.data(), atlas.stride(), tile);
+        x0 = std::min(x0, done.x);
+        y0 = std::min(y0, done.y);
+        x1 = std::max(x1, done.x + done.w);
+        y1 = std::max(y1, done.y + done.h);
+    });
+    m_atlas = atlas.identity();
+    m_revision = atlas.revision();
+
+    if (x1 <= x0 || y1 <= y0) return {};
+    return {x0, y0, x1 - x0, y1 - y0};
+}
+
+void bc4_image::decode(uint8_t* pixels, int stride) const {
+    uint8_t block_pixels[16];
+    for (int by = 0; by < m_blocks_y; ++by) {
+        for (int bx = 0; bx < m_blocks_x; ++bx) {
+            bc4_decode_block(block(bx, by), block_pixels, 4);
+            for (int row = 0; row < 4; ++row) {
+                int y = by * 4 + row;
+                if (y >= m_height) break;
+                int w = std::min(4, m_width - bx * 4);
+                std::memcpy(pixels + static_cast<std::ptrdiff_t>(y) * stride + bx * 4,
+                            block_pixels + row * 4, static_cast<std::size_t>(w));
+            }
+        }
+    }
+}
+
+} // namespace onyx_font
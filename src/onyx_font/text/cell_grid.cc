@@ -0,0 +1,255 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/cell_grid.hh>
+#include <onyx_font/text/raster_target.hh>
+#include <onyx_font/text/sized_face.hh>
+#include <onyx_font/text/utf8.hh>
+#include <failsafe/failsafe.hh>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace onyx_font {
+
+namespace {
+
+/// Shadow value that no real cell equals: forces a redraw
+constexpr terminal_cell unknown_cell{0xFFFFFFFFu, 0, 0, 0xFF};
+
+uint32_t blend(uint32_t fg, uint32_t bg, uint32_t alpha) noexcept {
+    uint32_t inv = 255 - alpha;
+    uint32_t out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint32_t f = (fg >> shift) & 0xFFu;
+        uint32_t b = (bg >> shift) & 0xFFu;
+        out |= ((f * alpha + b * inv + 127) / 255) << shift;
+    }
+    return out;
+}
+
+/// Cell width of a fixed-pitch font, or 0 if printable ASCII advances differ
+int fixed_pitch(const sized_face& face) {
+    float pitch = -1.0f;
+    for (char32_t cp = sized_face::cached_first + 1; cp <= sized_face::cached_last; ++cp) {
+        if (!face.source().has_glyph(cp)) continue;
+        float advance = face.advance(cp);
+        if (pitch < 0.0f) {
+            pitch = advance;
+        } else if (std::abs(advance - pitch) > 0.01f) {
+            return 0;
+        }
+    }
+    return pitch > 0.0f ? static_cast<int>(std::lround(pitch)) : 0;
+}
+
+} // anonymous namespace
+
+cell_grid::cell_grid(const font_source& source, float size, int columns, int rows)
+    : m_source(&source)
+      , m_size(size) {
+    sized_face face(source, size);
+    m_cell_w = fixed_pitch(face);
+    THROW_IF(m_cell_w <= 0, std::invalid_argument, "Font is not fixed-pitch");
+
+    m_cell_h = std::max(1, static_cast<int>(std::lround(face.line_height())));
+    m_baseline = static_cast<int>(std::lround(face.metrics().ascent));
+    m_underline = std::clamp(m_baseline + 1, 0, m_cell_h - 1);
+    resize(columns, rows);
+}
+
+void cell_grid::resize(int columns, int rows) {
+    THROW_IF(columns < 0 || rows < 0, std::invalid_argument, "Grid size must not be negative");
+
+    std::vector<terminal_cell> cells(static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows));
+    int keep_columns = std::min(columns, m_columns);
+    int keep_rows = std::min(rows, m_rows);
+    for (int row = 0; row < keep_rows; ++row) {
+        auto from = m_cells.begin() + static_cast<std::ptrdiff_t>(index(0, row));
+        std::copy(from, from + keep_columns,
+                  cells.begin() + static_cast<std::ptrdiff_t>(row) * columns);
+    }
+
+    m_columns = columns;
+    m_rows = rows;
+    m_cells = std::move(cells);
+    m_shadow.clear();
+    m_shadow_valid = false;
+    m_pending_scroll = 0;
+}
+
+int cell_grid::write(int column, int row, std::string_view text,
+                     uint32_t fg, uint32_t bg, uint8_t attrs) {
+    if (row < 0 || row >= m_rows || column >= m_columns) return 0;
+
+    int written = 0;
+    for (char32_t codepoint : utf8_view(text)) {
+        if (column >= m_columns) break;
+        if (column >= 0) {
+            m_cells[index(column, row)] = terminal_cell{codepoint, fg, bg, attrs};
+            ++written;
+        }
+        ++column;
+    }
+    return written;
+}
+
+void cell_grid::fill(const terminal_cell& value) {
+    std::fill(m_cells.begin(), m_cells.end(), value);
+}
+
+void cell_grid::scroll(int lines, const terminal_cell& blank) {
+    if (lines == 0 || m_rows == 0) return;
+
+    int n = std::min(std::abs(lines), m_rows);
+    auto moved = static_cast<std::ptrdiff_t>(n) * m_columns;
+    if (lines > 0) {
+        std::move(m_cells.begin() + moved, m_cells.end(), m_cells.begin());
+        std::fill(m_cells.end() - moved, m_cells.end(), blank);
+    } else {
+        std::move_backward(m_cells.begin(), m_cells.end() - moved, m_cells.end());
+        std::fill(m_cells.begin(), m_cells.begin() + moved, blank);
+    }
+
+    if (m_shadow_valid) {
+        m_pending_scroll += lines;
+        if (std::abs(m_pending_scroll) >= m_rows) {
+            // Nothing on the target survives the scroll
+            invalidate();
+            m_pending_scroll = 0;
+        }
+    }
+}
+
+std::size_t cell_grid::render(const cell_target& target) {
+    THROW_IF(target.width < pixel_width() || target.height < pixel_height() ||
+             target.stride < pixel_width(), std::invalid_argument, "Cell target is smaller than the grid");
+    THROW_IF(!target.pixels && pixel_width() > 0 && pixel_height() > 0, std::invalid_argument,
+             "Cell target pixels are null");
+
+    if (!m_shadow_valid) {
+        m_shadow.assign(m_cells.size(), unknown_cell);
+        m_shadow_valid = true;
+        m_pending_scroll = 0;
+    } else if (m_pending_scroll != 0) {
+        scroll_target(target, m_pending_scroll);
+        m_pending_scroll = 0;
+    }
+
+    std::size_t drawn = 0;
+    for (int row = 0; row < m_rows; ++row) {
+        auto first = static_cast<std::ptrdiff_t>(index(0, row));
+        auto cells = m_cells.begin() + first;
+        auto shadow = m_shadow.begin() + first;
+        if (std::equal(cells, cells + m_columns, shadow)) {
+            continue;
+        }
+        for (int column = 0; column < m_columns; ++column) {
+            if (cells[column] == shadow[column]) continue;
+            draw_cell(target, column, row, cells[column]);
+            shadow[column] = cells[column];
+            ++drawn;
+        }
+    }
+    return drawn;
+}
+
+void cell_grid::scroll_target(const cell_target& target, int lines) {
+    int n = std::abs(lines);
+    int shift = n * m_cell_h;
+    int height = pixel_height();
+    auto row_bytes = static_cast<std::size_t>(pixel_width()) * sizeof(uint32_t);
+    auto row_ptr = [&target](int y) {
+        return target.pixels + static_cast<std::ptrdiff_t>(y) * target.stride;
+    };
+
+    auto moved = static_cast<std::ptrdiff_t>(n) * m_columns;
+    if (lines > 0) {
+        for (int y = 0; y + shift < height; ++y) {
+            std::memmove(row_ptr(y), row_ptr(y + shift), row_bytes);
+        }
+        std::move(m_shadow.begin() + moved, m_shadow.end(), m_shadow.begin());
+        std::fill(m_shadow.end() - moved, m_shadow.end(), unknown_cell);
+    } else {
+        for (int y = height - 1; y - shift >= 0; --y) {
+            std::memmove(row_ptr(y), row_ptr(y - shift), row_bytes);
+        }
+        std::move_backward(m_shadow.begin(), m_shadow.end() - moved, m_shadow.end());
+        std::fill(m_shadow.begin(), m_shadow.begin() + moved, unknown_cell);
+    }
+}
+
+cell_grid::glyph_mask& cell_grid::mask(char32_t codepoint) {
+    if (auto it = m_masks.find(codepoint); it != m_masks.end()) {
+        return it->second;
+    }
+
+    glyph_mask& m = m_masks[codepoint];
+    char32_t drawn = codepoint;
+    if (!m_source->has_glyph(drawn)) {
+        drawn = m_source->default_char();
+    }
+    owned_grayscale_target cell(m_cell_w, m_cell_h);
+    if (m_source->has_glyph(drawn)) {
+        m_source->rasterize_glyph(drawn, m_size, cell, 0, m_baseline);
+    }
+    const uint8_t* pixels = cell.data();
+    m.normal.assign(pixels, pixels + static_cast<std::ptrdiff_t>(m_cell_w) * m_cell_h);
+    m.blank = std::all_of(m.normal.begin(), m.normal.end(), [](uint8_t a) { return a == 0; });
+    return m;
+}
+
+void cell_grid::draw_cell(const cell_target& target, int column, int row, const terminal_cell& cell) {
+    uint32_t fg = cell.fg;
+    uint32_t bg = cell.bg;
+    if (cell.attrs & cell_attr::inverse) {
+        std::swap(fg, bg);
+    }
+
+    uint32_t* origin = target.pixels + static_cast<std::ptrdiff_t>(row) * m_cell_h * target.stride +
+                       static_cast<std::ptrdiff_t>(column) * m_cell_w;
+    const bool hidden = (cell.attrs & cell_attr::hidden) != 0;
+    const bool underline = (cell.attrs & cell_attr::underline) != 0 && !hidden;
+
+    glyph_mask* m = hidden ? nullptr : &mask(cell.codepoint);
+    if (!m || m->blank) {
+        // Background only: straight fills
+        for (int y = 0; y < m_cell_h; ++y) {
+            uint32_t color = underline && y == m_underline ? fg : bg;
+            std::fill_n(origin + static_cast<std::ptrdiff_t>(y) * target.stride, m_cell_w, color);
+        }
+        return;
+    }
+
+    const std::vector<uint8_t>* alpha = &m->normal;
+    if (cell.attrs & cell_attr::bold) {
+        if (m->bold.empty()) {
+            m->bold = m->normal;
+            for (int y = 0; y < m_cell_h; ++y) {
+                for (int x = 1; x < m_cell_w; ++x) {
+                    auto i = static_cast<std::size_t>(y * m_cell_w + x);
+                    m->bold[i] = std::max(m->normal[i], m->normal[i - 1]);
+                }
+            }
+        }
+        alpha = &m->bold;
+    }
+
+    const uint8_t* a = alpha->data();
+    for (int y = 0; y < m_cell_h; ++y, a += m_cell_w) {
+        uint32_t* dst = origin + static_cast<std::ptrdiff_t>(y) * target.stride;
+        if (underline && y == m_underline) {
+            std::fill_n(dst, m_cell_w, fg);
+            continue;
+        }
+        for (int x = 0; x < m_cell_w; ++x) {
+            uint8_t v = a[x];
+            dst[x] = v == 0 ? bg : v == 255 ? fg : blend(fg, bg, v);
+        }
+    }
+}
+
+} // namespace onyx_font
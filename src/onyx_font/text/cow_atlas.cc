@@ -0,0 +1,159 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/cow_atlas.hh>
+#include <failsafe/failsafe.hh>
+#include <cstring>
+
+namespace onyx_font {
+
+// ===========================================================================
+// atlas_snapshot
+// ===========================================================================
+
+uint8_t atlas_snapshot::pixel(int x, int y) const noexcept {
+    if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
+        return 0;
+    }
+    const auto& t = m_tiles[index(x / m_tile_size, y / m_tile_size)];
+    if (!t) {
+        return 0;
+    }
+    return (*t)[static_cast<std::size_t>(y % m_tile_size) * static_cast<std::size_t>(m_tile_size) +
+                static_cast<std::size_t>(x % m_tile_size)];
+}
+
+const uint8_t* atlas_snapshot::tile(int tx, int ty) const noexcept {
+    if (tx < 0 || tx >= m_tiles_x || ty < 0 || ty >= m_tiles_y) {
+        return nullptr;
+    }
+    const auto& t = m_tiles[index(tx, ty)];
+    return t ? t->data() : nullptr;
+}
+
+void atlas_snapshot::copy_region(glyph_rect region, uint8_t* dst, int dst_stride) const noexcept {
+    for (int row = 0; row < region.h; ++row) {
+        uint8_t* out = dst + static_cast<std::size_t>(row) * static_cast<std::size_t>(dst_stride);
+        std::memset(out, 0, static_cast<std::size_t>(std::max(region.w, 0)));
+
+        int y = region.y + row;
+        if (y < 0 || y >= m_height) continue;
+
+        int x0 = std::max(region.x, 0);
+        int x1 = std::min(region.x + region.w, m_width);
+        // Copy tile by tile along the row
+        for (int x = x0; x < x1;) {
+            int tx = x / m_tile_size;
+            int run = std::min(x1, (tx + 1) * m_tile_size) - x;
+            const auto& t = m_tiles[index(tx, y / m_tile_size)];
+            if (t) {
+                std::memcpy(out + (x - region.x),
+                            t->data() + static_cast<std::size_t>(y % m_tile_size) * static_cast<std::size_t>(m_tile_size) +
+                            static_cast<std::size_t>(x % m_tile_size),
+                            static_cast<std::size_t>(run));
+            }
+            x += run;
+        }
+    }
+}
+
+// ===========================================================================
+// cow_atlas
+// ===========================================================================
+
+cow_atlas::cow_atlas(int width, int height, int tile_size)
+    : m_width(width)
+    , m_height(height)
+    , m_tile_size(tile_size) {
+    THROW_IF(width < 0 || height < 0, std::invalid_argument, "Atlas size must not be negative");
+    THROW_IF(tile_size <= 0, std::invalid_argument, "Tile size must be positive:", tile_size);
+    m_tiles_x = (width + tile_size - 1) / tile_size;
+    m_tiles_y = (height + tile_size - 1) / tile_size;
+    auto count = static_cast<std::size_t>(m_tiles_x) * static_cast<std::size_t>(m_tiles_y);
+    m_tiles.resize(count);
+    m_tile_revision.resize(count, 0);
+}
+
+uint8_t* cow_atlas::writable_tile(std::size_t index) {
+    auto& t = m_tiles[index];
+    if (!t) {
+        t = std::make_shared<std::vector<uint8_t>>(
+            static_cast<std::size_t>(m_tile_size) * static_cast<std::size_t>(m_tile_size), 0);
+        ++m_tiles_allocated;
+    } else if (!internal::exclusively_owned(t)) {
+        // A snapshot still reads this tile; it keeps the old pixels
+        t = std::make_shared<std::vector<uint8_t>>(*t);
+        ++m_tiles_allocated;
+    }
+    return t->data();
+}
+
+void cow_atlas::write_alpha(int x, int y, int w, int h, const uint8_t* pixels, int stride) {
+    if (!pixels || w <= 0 || h <= 0) return;
+
+    int x0 = std::max(x, 0);
+    int y0 = std::max(y, 0);
+    int x1 = std::min(x + w, m_width);
+    int y1 = std::min(y + h, m_height);
+    if (x1 <= x0 || y1 <= y0) return;
+
+    ++m_revision;
+    for (int ty = y0 / m_tile_size; ty <= (y1 - 1) / m_tile_size; ++ty) {
+        int tile_y0 = std::max(y0, ty * m_tile_size);
+        int tile_y1 = std::min(y1, (ty + 1) * m_tile_size);
+        for (int tx = x0 / m_tile_size; tx <= (x1 - 1) / m_tile_size; ++tx) {
+            int tile_x0 = std::max(x0, tx * m_tile_size);
+            int tile_x1 = std::min(x1, (tx + 1) * m_tile_size);
+
+            std::size_t idx = static_cast<std::size_t>(ty) * static_cast<std::size_t>(m_tiles_x) +
+                              static_cast<std::size_t>(tx);
+            uint8_t* tile = writable_tile(idx);
+            m_tile_revision[idx] = m_revision;
+
+            for (int row = tile_y0; row < tile_y1; ++row) {
+                std::memcpy(tile + static_cast<std::size_t>(row - ty * m_tile_size) * static_cast<std::size_t>(m_tile_size) +
+                            static_cast<std::size_t>(tile_x0 - tx * m_tile_size),
+                            pixels + static_cast<std::size_t>(row - y) * static_cast<std::size_t>(stride) +
+                            static_cast<std::size_t>(tile_x0 - x),
+                            static_cast<std::size_t>(tile_x1 - tile_x0));
+            }
+        }
+    }
+}
+
+void cow_atlas::clear() {
+    ++m_revision;
+    for (std::size_t i = 0; i < m_tiles.size(); ++i) {
+        m_tiles[i].reset();
+        m_tile_revision[i] = m_revision;
+    }
+}
+
+uint8_t cow_atlas::pixel(int x, int y) const noexcept {
+    if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
+        return 0;
+    }
+    const auto& t = m_tiles[static_cast<std::size_t>(y / m_tile_size) * static_cast<std::size_t>(m_tiles_x) +
+                            static_cast<std::size_t>(x / m_tile_size)];
+    if (!t) {
+        return 0;
+    }
+    return (*t)[static_cast<std::size_t>(y % m_tile_size) * static_cast<std::size_t>(m_tile_size) +
+                static_cast<std::size_t>(x % m_tile_size)];
+}
+
+atlas_snapshot cow_atlas::snapshot() const {
+    atlas_snapshot s;
+    s.m_width = m_width;
+    s.m_height = m_height;
+    s.m_tile_size = m_tile_size;
+    s.m_tiles_x = m_tiles_x;
+    s.m_tiles_y = m_tiles_y;
+    s.m_revision = m_revision;
+    s.m_tiles.assign(m_tiles.begin(), m_tiles.end());
+    s.m_tile_revision = m_tile_revision;
+    return s;
+}
+
+} // namespace onyx_font
@@ -11,15 +11,26 @@
 
 namespace onyx_font {
 
+namespace {
+    // Beyond Unicode: no font has a glyph for it
+    constexpr char32_t no_font_char = 0x110000;
+}
+
 font_source font_source::from_bitmap(const bitmap_font& font) {
     font_source source;
     source.m_font = bitmap_ref{&font};
+    if (auto cp = font.get_codepage(); cp && !font.has_unicode_table()) {
+        source.m_encoding = &codepage_table::get(*cp);
+    }
     return source;
 }
 
 font_source font_source::from_vector(const vector_font& font) {
     font_source source;
     source.m_font = vector_ref{&font};
+    if (auto cp = font.get_codepage()) {
+        source.m_encoding = &codepage_table::get(*cp);
+    }
     return source;
 }
 
@@ -34,6 +45,22 @@ font_source font_source::from_ttf(const ttf_font& font) {
 
 font_source::~font_source() = default;
 
+font_source::font_source(const font_source& other)
+    : m_font(other.m_font)
+    , m_encoding(other.m_encoding) {
+    if (other.m_rasterizer) {
+        const ttf_font& font = *std::get<ttf_ref>(m_font).font;
+        m_rasterizer = std::make_unique<stb_truetype_font>(font.data(), font.font_index());
+    }
+}
+
+font_source& font_source::operator=(const font_source& other) {
+    if (this != &other) {
+        *this = font_source(other);
+    }
+    return *this;
+}
+
 font_source::font_source(font_source&&) noexcept = default;
 
 font_source& font_source::operator=(font_source&&) noexcept = default;
@@ -48,17 +75,38 @@ font_source_type font_source::type() const {
     }
 }
 
+const void* font_source::font_identity() const noexcept {
+    return std::visit([](const auto& ref) -> const void* { return ref.font; }, m_font);
+}
+
+void font_source::set_encoding(const codepage_table* table) noexcept {
+    m_encoding = table;
+}
+
+const codepage_table* font_source::encoding() const noexcept {
+    return m_encoding;
+}
+
+char32_t font_source::to_font_char(char32_t codepoint) const noexcept {
+    if (!m_encoding) {
+        return codepoint;
+    }
+    if (const auto* ref = std::get_if<bitmap_ref>(&m_font); ref && ref->font->has_unicode_table()) {
+        return codepoint;
+    }
+    const auto byte = m_encoding->encode(codepoint);
+    return byte ? *byte : no_font_char;
+}
+
 bool font_source::has_glyph(char32_t codepoint) const {
-    // For bitmap and vector fonts, only support 8-bit codepoints
     if (std::holds_alternative<bitmap_ref>(m_font)) {
-        if (codepoint > 255) return false;
-        const auto& font = *std::get<bitmap_ref>(m_font).font;
-        auto ch = static_cast<uint8_t>(codepoint);
-        return ch >= font.get_first_char() && ch <= font.get_last_char();
+        return std::get<bitmap_ref>(m_font).font->has_glyph(to_font_char(codepoint));
     } else if (std::holds_alternative<vector_ref>(m_font)) {
-        if (codepoint > 255) return false;
+        // Vector fonts only support 8-bit character codes
+        const char32_t ch = to_font_char(codepoint);
+        if (ch > 255) return false;
         const auto& font = *std::get<vector_ref>(m_font).font;
-        return font.has_glyph(static_cast<uint8_t>(codepoint));
+        return font.has_glyph(static_cast<uint8_t>(ch));
     } else {
         const auto& ref = std::get<ttf_ref>(m_font);
         return ref.font->has_glyph(static_cast<uint32_t>(codepoint));
@@ -67,9 +115,16 @@ bool font_source::has_glyph(char32_t codepoint) const {
 
 char32_t font_source::default_char() const {
     if (std::holds_alternative<bitmap_ref>(m_font)) {
-        return std::get<bitmap_ref>(m_font).font->get_default_char();
+        const auto& font = *std::get<bitmap_ref>(m_font).font;
+        const char32_t ch = font.get_default_char();
+        // Report the codepoint that to_font_char() maps back to the glyph
+        if (m_encoding && !font.has_unicode_table() && ch <= 255) {
+            return m_encoding->decode(static_cast<uint8_t>(ch));
+        }
+        return ch;
     } else if (std::holds_alternative<vector_ref>(m_font)) {
-        return std::get<vector_ref>(m_font).font->get_default_char();
+        const uint8_t ch = std::get<vector_ref>(m_font).font->get_default_char();
+        return m_encoding ? m_encoding->decode(ch) : ch;
     } else {
         // TTF fonts typically use space or question mark as fallback
         return '?';
@@ -105,18 +160,32 @@ scaled_metrics font_source::get_scaled_metrics(float size) const {
     return result;
 }
 
+float font_source::scale_for_size(float size) const {
+    if (std::holds_alternative<vector_ref>(m_font)) {
+        const auto& metrics = std::get<vector_ref>(m_font).font->get_metrics();
+        return size / static_cast<float>(metrics.pixel_height);
+    } else if (std::holds_alternative<ttf_ref>(m_font)) {
+        return std::get<ttf_ref>(m_font).font->scale_for_pixel_height(size);
+    }
+    // Bitmap fonts render at their native size only
+    return 1.0f;
+}
+
 glyph_metrics font_source::get_glyph_metrics(char32_t codepoint, float size) const {
+    return get_glyph_metrics_at_scale(codepoint, scale_for_size(size));
+}
+
+glyph_metrics font_source::get_glyph_metrics_at_scale(char32_t codepoint, float scale) const {
     glyph_metrics result;
 
     if (std::holds_alternative<bitmap_ref>(m_font)) {
-        if (codepoint > 255) return result;
         const auto& font = *std::get<bitmap_ref>(m_font).font;
-        auto ch = static_cast<uint8_t>(codepoint);
+        char32_t ch = to_font_char(codepoint);
 
-        if (ch < font.get_first_char() || ch > font.get_last_char()) {
+        if (!font.has_glyph(ch)) {
             ch = font.get_default_char();
             // Validate default char is also within range
-            if (ch < font.get_first_char() || ch > font.get_last_char()) {
+            if (!font.has_glyph(ch)) {
                 return result;  // Invalid default char, return empty metrics
             }
         }
@@ -141,9 +210,10 @@ glyph_metrics font_source::get_glyph_metrics(char32_t codepoint, float size) con
         result.advance_x = advance;
 
     } else if (std::holds_alternative<vector_ref>(m_font)) {
-        if (codepoint > 255) return result;
+        const char32_t native = to_font_char(codepoint);
+        if (native > 255) return result;
         const auto& font = *std::get<vector_ref>(m_font).font;
-        auto ch = static_cast<uint8_t>(codepoint);
+        auto ch = static_cast<uint8_t>(native);
 
         const vector_glyph* glyph = font.get_glyph(ch);
         if (!glyph) {
@@ -151,9 +221,6 @@ glyph_metrics font_source::get_glyph_metrics(char32_t codepoint, float size) con
             if (!glyph) return result;
         }
 
-        const auto& metrics = font.get_metrics();
-        float scale = size / static_cast<float>(metrics.pixel_height);
-
         result.advance_x = static_cast<float>(glyph->width) * scale;
         result.bearing_x = 0;
 
@@ -182,8 +249,8 @@ glyph_metrics font_source::get_glyph_metrics(char32_t codepoint, float size) con
 
     } else {
         const auto& ref = std::get<ttf_ref>(m_font);
-        auto ttf_metrics = ref.font->get_glyph_metrics(
-            static_cast<uint32_t>(codepoint), size);
+        auto ttf_metrics = ref.font->get_glyph_metrics_at_scale(
+            static_cast<uint32_t>(codepoint), scale);
 
         if (ttf_metrics) {
             result.advance_x = ttf_metrics->advance_x;
@@ -199,12 +266,19 @@ glyph_metrics font_source::get_glyph_metrics(char32_t codepoint, float size) con
 
 float font_source::get_kerning(char32_t first, char32_t second, float size) const {
     // Only TTF fonts support kerning
+    if (std::holds_alternative<ttf_ref>(m_font)) {
+        return get_kerning_at_scale(first, second, scale_for_size(size));
+    }
+    return 0.0f;
+}
+
+float font_source::get_kerning_at_scale(char32_t first, char32_t second, float scale) const {
     if (std::holds_alternative<ttf_ref>(m_font)) {
         const auto& ref = std::get<ttf_ref>(m_font);
-        return ref.font->get_kerning(
+        return ref.font->get_kerning_at_scale(
             static_cast<uint32_t>(first),
             static_cast<uint32_t>(second),
-            size);
+            scale);
     }
     return 0.0f;
 }
@@ -221,15 +295,13 @@ float font_source::native_size() const {
 void font_source::rasterize_bitmap_glyph(char32_t codepoint, float /*size*/,
                                           void* target, int x, int y,
                                           void (*put_pixel)(void*, int, int, uint8_t)) const {
-    if (codepoint > 255) return;
-
     const auto& font = *std::get<bitmap_ref>(m_font).font;
-    auto ch = static_cast<uint8_t>(codepoint);
+    char32_t ch = to_font_char(codepoint);
 
-    if (ch < font.get_first_char() || ch > font.get_last_char()) {
+    if (!font.has_glyph(ch)) {
         ch = font.get_default_char();
         // Validate default char is also within range
-        if (ch < font.get_first_char() || ch > font.get_last_char()) {
+        if (!font.has_glyph(ch)) {
             return;  // Invalid default char, nothing to render
         }
     }
@@ -288,10 +360,11 @@ void font_source::rasterize_vector_glyph(char32_t codepoint, float size,
                                           void* target, int x, int y,
                                           void (*put_pixel)(void*, int, int, uint8_t),
                                           int width, int height) const {
-    if (codepoint > 255) return;
+    const char32_t native = to_font_char(codepoint);
+    if (native > 255) return;
 
     const auto& font = *std::get<vector_ref>(m_font).font;
-    auto ch = static_cast<uint8_t>(codepoint);
+    auto ch = static_cast<uint8_t>(native);
 
     const vector_glyph* glyph = font.get_glyph(ch);
     if (!glyph) {
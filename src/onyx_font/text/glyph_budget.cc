@@ -0,0 +1,150 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/glyph_budget.hh>
+#include <algorithm>
+
+namespace onyx_font {
+
+// ===========================================================================
+// registration
+// ===========================================================================
+
+glyph_budget::registration::registration(registration&& other) noexcept
+    : m_budget(std::move(other.m_budget))
+    , m_account(other.m_account) {
+    other.m_account = nullptr;
+}
+
+glyph_budget::registration& glyph_budget::registration::operator=(registration&& other) noexcept {
+    if (this != &other) {
+        reset();
+        m_budget = std::move(other.m_budget);
+        m_account = other.m_account;
+        other.m_account = nullptr;
+    }
+    return *this;
+}
+
+glyph_budget::registration::~registration() {
+    reset();
+}
+
+void glyph_budget::registration::update(std::size_t bytes) {
+    if (!m_account) return;
+    std::lock_guard lock(m_budget->m_mutex);
+    m_budget->m_used = m_budget->m_used - m_account->bytes + bytes;
+    m_account->bytes = bytes;
+    m_budget->enforce_locked(m_account);
+}
+
+void glyph_budget::registration::rebind(evict_fn evict) {
+    if (!m_account) return;
+    std::lock_guard lock(m_budget->m_mutex);
+    m_account->evict = std::move(evict);
+}
+
+void glyph_budget::registration::reset() noexcept {
+    if (!m_account) return;
+    {
+        std::lock_guard lock(m_budget->m_mutex);
+        m_budget->m_used -= m_account->bytes;
+        m_budget->m_accounts.remove_if([this](const account& a) { return &a == m_account; });
+    }
+    m_account = nullptr;
+    m_budget.reset();
+}
+
+// ===========================================================================
+// glyph_budget
+// ===========================================================================
+
+glyph_budget::registration glyph_budget::add(std::string name, evict_fn evict) {
+    std::lock_guard lock(m_mutex);
+    account& acct = m_accounts.emplace_back();
+    acct.name = std::move(name);
+    acct.evict = std::move(evict);
+    acct.last_used.store(m_clock.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return registration(shared_from_this(), &acct);
+}
+
+std::size_t glyph_budget::limit() const {
+    std::lock_guard lock(m_mutex);
+    return m_limit;
+}
+
+void glyph_budget::set_limit(std::size_t limit_bytes) {
+    std::lock_guard lock(m_mutex);
+    m_limit = limit_bytes;
+    enforce_locked(nullptr);
+}
+
+std::size_t glyph_budget::used() const {
+    std::lock_guard lock(m_mutex);
+    return m_used;
+}
+
+std::size_t glyph_budget::client_count() const {
+    std::lock_guard lock(m_mutex);
+    return m_accounts.size();
+}
+
+std::size_t glyph_budget::evictions() const {
+    std::lock_guard lock(m_mutex);
+    return m_evictions;
+}
+
+std::vector<glyph_budget::share> glyph_budget::shares() const {
+    std::vector<share> result;
+    {
+        std::lock_guard lock(m_mutex);
+        result.reserve(m_accounts.size());
+        for (const auto& a : m_accounts) {
+            result.push_back({a.name, a.bytes, a.last_used.load(std::memory_order_relaxed), a.evictions});
+        }
+    }
+    std::stable_sort(result.begin(), result.end(),
+                     [](const share& a, const share& b) { return a.bytes > b.bytes; });
+    return result;
+}
+
+void glyph_budget::enforce_locked(const account* keep) {
+    if (m_used <= m_limit) {
+        return;
+    }
+
+    // Caches used since the last tick may have quads in flight for the
+    // current frame; clearing them would leave those quads pointing at
+    // freed glyphs, so the total may stay over the limit for now.
+    const uint64_t now = m_clock.load(std::memory_order_relaxed);
+
+    // Least recently used first; among equals, the largest
+    std::vector<account*> victims;
+    for (auto& a : m_accounts) {
+        if (&a != keep && a.evict && a.bytes > 0 &&
+            a.last_used.load(std::memory_order_relaxed) != now) {
+            victims.push_back(&a);
+        }
+    }
+    std::stable_sort(victims.begin(), victims.end(), [](const account* a, const account* b) {
+        uint64_t ua = a->last_used.load(std::memory_order_relaxed);
+        uint64_t ub = b->last_used.load(std::memory_order_relaxed);
+        return ua != ub ? ua < ub : a->bytes > b->bytes;
+    });
+
+    for (account* victim : victims) {
+        if (m_used <= m_limit) {
+            break;
+        }
+        std::size_t remaining = victim->evict();
+        m_used = m_used - victim->bytes + remaining;
+        if (remaining < victim->bytes) {
+            ++victim->evictions;
+            ++m_evictions;
+        }
+        victim->bytes = remaining;
+    }
+}
+
+} // namespace onyx_font
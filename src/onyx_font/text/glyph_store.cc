@@ -0,0 +1,253 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/glyph_store.hh>
+#include <failsafe/failsafe.hh>
+#include <algorithm>
+#include <cmath>
+
+namespace onyx_font {
+
+namespace {
+
+constexpr std::size_t MAX_LITERAL = 128;
+constexpr std::size_t MIN_RUN = 3;
+constexpr std::size_t MAX_RUN = 130;
+
+/// PackBits-style run-length encoding (see glyph_store.hh)
+void rle_encode(const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+    std::size_t i = 0;
+    std::size_t literal_start = 0;
+
+    auto flush_literals = [&](std::size_t end) {
+        while (literal_start < end) {
+            std::size_t n = std::min(end - literal_start, MAX_LITERAL);
+            out.push_back(static_cast<uint8_t>(n - 1));
+            out.insert(out.end(), in.begin() + static_cast<std::ptrdiff_t>(literal_start),
+                       in.begin() + static_cast<std::ptrdiff_t>(literal_start + n));
+            literal_start += n;
+        }
+    };
+
+    while (i < in.size()) {
+        std::size_t run = 1;
+        while (i + run < in.size() && run < MAX_RUN && in[i + run] == in[i]) {
+            ++run;
+        }
+        if (run >= MIN_RUN) {
+            flush_literals(i);
+            out.push_back(static_cast<uint8_t>(run + 125));
+            out.push_back(in[i]);
+            i += run;
+            literal_start = i;
+        } else {
+            i += run;
+        }
+    }
+    flush_literals(in.size());
+}
+
+void rle_decode(const std::vector<uint8_t>& in, std::vector<uint8_t>& out, std::size_t expected) {
+    out.clear();
+    out.reserve(expected);
+    std::size_t i = 0;
+    while (i < in.size()) {
+        uint8_t control = in[i++];
+        if (control < 128) {
+            std::size_t n = std::size_t{control} + 1;
+            THROW_IF(i + n > in.size(), std::runtime_error, "Corrupt glyph store entry");
+            out.insert(out.end(), in.begin() + static_cast<std::ptrdiff_t>(i),
+                       in.begin() + static_cast<std::ptrdiff_t>(i + n));
+            i += n;
+        } else {
+            THROW_IF(i >= in.size(), std::runtime_error, "Corrupt glyph store entry");
+            out.insert(out.end(), std::size_t{control} - 125, in[i++]);
+        }
+    }
+    THROW_IF(out.size() != expected, std::runtime_error, "Corrupt glyph store entry");
+}
+
+/// 8-bit coverage to 4 bits, rounded
+[[nodiscard]] uint8_t quantize4(uint8_t v) noexcept {
+    return static_cast<uint8_t>((v * 15 + 127) / 255);
+}
+
+} // anonymous namespace
+
+// ===========================================================================
+// glyph_store
+// ===========================================================================
+
+std::size_t glyph_store::key_hash::operator()(const key& k) const noexcept {
+    std::size_t h = std::hash<const void*>{}(k.font);
+    h ^= std::hash<uint64_t>{}((static_cast<uint64_t>(k.size_64) << 32) | k.codepoint) +
+         0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    return h;
+}
+
+glyph_store::key glyph_store::make_key(const void* font, char32_t codepoint, float size) noexcept {
+    return {font, codepoint, static_cast<uint32_t>(std::lround(std::max(size, 0.0f) * 64.0f))};
+}
+
+std::size_t glyph_store::charge(const entry& e) noexcept {
+    return e.data.size() + entry_overhead;
+}
+
+bool glyph_store::put(const void* font, char32_t codepoint, float size, const stored_glyph& glyph,
+                      const uint8_t* pixels, int stride) {
+    const key k = make_key(font, codepoint, size);
+    {
+        std::lock_guard lock(m_mutex);
+        if (auto it = m_index.find(k); it != m_index.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return true;
+        }
+    }
+
+    // Encode outside the lock
+    entry e;
+    e.k = k;
+    e.glyph = glyph;
+    e.glyph.width = std::max(glyph.width, 0);
+    e.glyph.height = std::max(glyph.height, 0);
+    if (!pixels) {
+        e.glyph.width = 0;
+        e.glyph.height = 0;
+    }
+
+    auto w = static_cast<std::size_t>(e.glyph.width);
+    auto h = static_cast<std::size_t>(e.glyph.height);
+    if (w > 0 && h > 0) {
+        std::vector<uint8_t> raw;
+        if (m_encoding == glyph_store_encoding::rle4) {
+            raw.reserve((w * h + 1) / 2);
+            uint8_t pending = 0;
+            bool high = true;
+            for (std::size_t y = 0; y < h; ++y) {
+                const uint8_t* row = pixels + y * static_cast<std::size_t>(stride);
+                for (std::size_t x = 0; x < w; ++x) {
+                    uint8_t q = quantize4(row[x]);
+                    if (high) {
+                        pending = static_cast<uint8_t>(q << 4);
+                    } else {
+                        raw.push_back(static_cast<uint8_t>(pending | q));
+                    }
+                    high = !high;
+                }
+            }
+            if (!high) {
+                raw.push_back(pending);
+            }
+        } else {
+            raw.reserve(w * h);
+            for (std::size_t y = 0; y < h; ++y) {
+                const uint8_t* row = pixels + y * static_cast<std::size_t>(stride);
+                raw.insert(raw.end(), row, row + w);
+            }
+        }
+        rle_encode(raw, e.data);
+        e.data.shrink_to_fit();
+    }
+
+    std::lock_guard lock(m_mutex);
+    if (m_index.find(k) != m_index.end()) {
+        // Another thread stored it meanwhile
+        return true;
+    }
+    if (charge(e) > m_budget) {
+        return false;
+    }
+    m_bytes += charge(e);
+    m_raw_bytes += w * h;
+    m_lru.push_front(std::move(e));
+    m_index.emplace(k, m_lru.begin());
+    trim_locked();
+    return true;
+}
+
+bool glyph_store::fetch(const void* font, char32_t codepoint, float size,
+                        stored_glyph& glyph, std::vector<uint8_t>& pixels) {
+    std::vector<uint8_t> data;
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_index.find(make_key(font, codepoint, size));
+        if (it == m_index.end()) {
+            ++m_misses;
+            return false;
+        }
+        ++m_hits;
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        glyph = it->second->glyph;
+        data = it->second->data;
+    }
+
+    // Decode outside the lock
+    auto count = static_cast<std::size_t>(glyph.width) * static_cast<std::size_t>(glyph.height);
+    if (count == 0) {
+        pixels.clear();
+        return true;
+    }
+    if (m_encoding == glyph_store_encoding::rle4) {
+        std::vector<uint8_t> packed;
+        rle_decode(data, packed, (count + 1) / 2);
+        pixels.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            uint8_t b = packed[i / 2];
+            uint8_t q = (i % 2 == 0) ? static_cast<uint8_t>(b >> 4) : static_cast<uint8_t>(b & 0x0F);
+            pixels[i] = static_cast<uint8_t>(q * 17);
+        }
+    } else {
+        rle_decode(data, pixels, count);
+    }
+    return true;
+}
+
+bool glyph_store::contains(const void* font, char32_t codepoint, float size) const {
+    std::lock_guard lock(m_mutex);
+    return m_index.find(make_key(font, codepoint, size)) != m_index.end();
+}
+
+void glyph_store::clear() {
+    std::lock_guard lock(m_mutex);
+    m_lru.clear();
+    m_index.clear();
+    m_bytes = 0;
+    m_raw_bytes = 0;
+}
+
+std::size_t glyph_store::budget() const {
+    std::lock_guard lock(m_mutex);
+    return m_budget;
+}
+
+void glyph_store::set_budget(std::size_t budget_bytes) {
+    std::lock_guard lock(m_mutex);
+    m_budget = budget_bytes;
+    trim_locked();
+}
+
+glyph_store_stats glyph_store::stats() const {
+    std::lock_guard lock(m_mutex);
+    glyph_store_stats s;
+    s.hits = m_hits;
+    s.misses = m_misses;
+    s.evictions = m_evictions;
+    s.glyphs = m_lru.size();
+    s.bytes = m_bytes;
+    s.raw_bytes = m_raw_bytes;
+    return s;
+}
+
+void glyph_store::trim_locked() {
+    while (m_bytes > m_budget && !m_lru.empty()) {
+        const entry& victim = m_lru.back();
+        m_bytes -= charge(victim);
+        m_raw_bytes -= static_cast<std::size_t>(victim.glyph.width) * static_cast<std::size_t>(victim.glyph.height);
+        m_index.erase(victim.k);
+        m_lru.pop_back();
+        ++m_evictions;
+    }
+}
+
+} // namespace onyx_font
@@ -0,0 +1,111 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/layout_cache.hh>
+#include <functional>
+
+namespace onyx_font {
+
+namespace {
+
+void hash_combine(std::size_t& seed, std::size_t value) noexcept {
+    seed ^= value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2);
+}
+
+} // anonymous namespace
+
+bool layout_cache::node::matches(const layout_key& key) const noexcept {
+    return cache == key.cache && font == key.font && size == key.size &&
+           wrap_width == key.wrap_width && align == key.align && kind == key.kind &&
+           text == key.text;
+}
+
+std::size_t layout_key_hash::operator()(const layout_key& key) const noexcept {
+    std::size_t h = std::hash<std::string_view>{}(key.text);
+    hash_combine(h, std::hash<const void*>{}(key.cache));
+    hash_combine(h, std::hash<const void*>{}(key.font));
+    hash_combine(h, std::hash<float>{}(key.size));
+    hash_combine(h, std::hash<float>{}(key.wrap_width));
+    hash_combine(h, static_cast<std::size_t>(key.align) << 8 | static_cast<std::size_t>(key.kind));
+    return h;
+}
+
+const layout_entry* layout_cache::find(const layout_key& key, std::optional<uint64_t> generation) {
+    std::size_t h = layout_key_hash{}(key);
+    auto [first, last] = m_index.equal_range(h);
+    for (auto it = first; it != last; ++it) {
+        if (it->second->matches(key)) {
+            if (generation && it->second->entry.generation != *generation) {
+                // Stale: insert() will reuse the node
+                break;
+            }
+            ++m_hits;
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return &it->second->entry;
+        }
+    }
+    ++m_misses;
+    return nullptr;
+}
+
+layout_entry* layout_cache::insert(const layout_key& key) {
+    if (m_capacity == 0) {
+        return nullptr;
+    }
+
+    std::size_t h = layout_key_hash{}(key);
+    auto [first, last] = m_index.equal_range(h);
+    for (auto it = first; it != last; ++it) {
+        if (it->second->matches(key)) {
+            // Reuse the node (and its quad storage)
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            layout_entry& entry = it->second->entry;
+            entry.extents = {};
+            entry.width = 0;
+            entry.generation = 0;
+            entry.quads.clear();
+            entry.line_ends.clear();
+            return &entry;
+        }
+    }
+
+    if (m_lru.size() >= m_capacity) {
+        // Recycle the least recently used node
+        auto victim = std::prev(m_lru.end());
+        auto [vfirst, vlast] = m_index.equal_range(victim->hash);
+        for (auto it = vfirst; it != vlast; ++it) {
+            if (it->second == victim) {
+                m_index.erase(it);
+                break;
+            }
+        }
+        m_lru.splice(m_lru.begin(), m_lru, victim);
+    } else {
+        m_lru.emplace_front();
+    }
+
+    node& n = m_lru.front();
+    n.hash = h;
+    n.text.assign(key.text);
+    n.cache = key.cache;
+    n.font = key.font;
+    n.size = key.size;
+    n.wrap_width = key.wrap_width;
+    n.align = key.align;
+    n.kind = key.kind;
+    n.entry.extents = {};
+    n.entry.width = 0;
+    n.entry.generation = 0;
+    n.entry.quads.clear();
+    n.entry.line_ends.clear();
+    m_index.emplace(h, m_lru.begin());
+    return &n.entry;
+}
+
+void layout_cache::clear() {
+    m_lru.clear();
+    m_index.clear();
+}
+
+} // namespace onyx_font
@@ -0,0 +1,620 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/shared_atlas.hh>
+#include <failsafe/failsafe.hh>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ONYX_FONT_HAS_SHM 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace onyx_font {
+
+namespace {
+
+constexpr uint32_t shm_magic = 0x4158'4E4F;  // "ONXA"
+constexpr uint32_t shm_version = 3;
+
+enum : uint32_t {
+    slot_pending = 0,
+    slot_ready = 1,
+    slot_failed = 2
+};
+
+struct shm_header {
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> ready;
+    int32_t atlas_size;
+    int32_t max_pages;
+    int32_t padding;
+    uint32_t table_capacity;
+    std::atomic<uint32_t> next_lease;   ///< Last lease handed to an attachment
+    uint64_t fingerprint;
+    std::atomic<uint64_t> pack_state;   ///< page:16 | x:16 | y:16 | row_height:16
+    std::atomic<int32_t> page_count;
+    std::atomic<int32_t> glyph_count;
+};
+
+struct shm_entry {
+    std::atomic<uint64_t> claim;        ///< owner lease:32 | codepoint + 1:32, 0 = empty
+    std::atomic<uint32_t> state;        ///< slot_pending / slot_ready / slot_failed
+    int32_t page;
+    int32_t x;
+    int32_t y;
+    int32_t w;
+    int32_t h;
+    float bearing_x;
+    float bearing_y;
+    float advance_x;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+/// Claim word of a table entry. The owner is part of the claim, so a
+/// slot is never claimed without a lease to check for liveness.
+constexpr uint64_t make_claim(uint32_t key, uint32_t owner) noexcept {
+    return (static_cast<uint64_t>(owner) << 32) | key;
+}
+
+constexpr uint32_t claim_key(uint64_t claim) noexcept {
+    return static_cast<uint32_t>(claim);
+}
+
+constexpr uint32_t claim_owner(uint64_t claim) noexcept {
+    return static_cast<uint32_t>(claim >> 32);
+}
+
+constexpr std::size_t align_to_cache_line(std::size_t value) {
+    return (value + 63) & ~static_cast<std::size_t>(63);
+}
+
+struct shm_layout {
+    std::size_t table_offset;
+    std::size_t pages_offset;
+    std::size_t page_bytes;
+    std::size_t total;
+};
+
+shm_layout compute_layout(const shared_atlas_config& config) {
+    shm_layout layout{};
+    layout.table_offset = align_to_cache_line(sizeof(shm_header));
+    layout.pages_offset = align_to_cache_line(layout.table_offset +
+                                              static_cast<std::size_t>(config.table_capacity) * sizeof(shm_entry));
+    layout.page_bytes = static_cast<std::size_t>(config.atlas_size) * static_cast<std::size_t>(config.atlas_size);
+    layout.total = layout.pages_offset + layout.page_bytes * static_cast<std::size_t>(config.max_pages);
+    return layout;
+}
+
+uint64_t encode_pack(uint64_t page, uint64_t x, uint64_t y, uint64_t row) noexcept {
+    return (page << 48) | (x << 32) | (y << 16) | row;
+}
+
+/// FNV-1a over the values that determine rasterized output
+class fingerprint_builder {
+public:
+    template<typename T>
+    void add(const T& value) noexcept {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (unsigned char b : bytes) {
+            m_hash = (m_hash ^ b) * 0x100000001B3ull;
+        }
+    }
+
+    [[nodiscard]] uint64_t value() const noexcept { return m_hash; }
+
+private:
+    uint64_t m_hash = 0xCBF29CE484222325ull;
+};
+
+uint64_t font_fingerprint(const text_rasterizer& rasterizer, const shared_atlas_config& config) {
+    fingerprint_builder fp;
+    fp.add(rasterizer.size());
+    fp.add(static_cast<int>(rasterizer.source().type()));
+    auto metrics = rasterizer.get_metrics();
+    fp.add(metrics.ascent);
+    fp.add(metrics.descent);
+    fp.add(metrics.line_height);
+    for (char32_t cp : {U'A', U'g', U'W', U'0', U'.'}) {
+        auto gm = rasterizer.measure_glyph(cp);
+        fp.add(gm.advance_x);
+        fp.add(gm.width);
+        fp.add(gm.height);
+    }
+    fp.add(config.padding);
+    return fp.value();
+}
+
+#if defined(ONYX_FONT_HAS_SHM)
+// Open file description locks belong to one attachment and are released
+// by the kernel when it goes away, whatever PID namespace it lives in.
+// Classic record locks are per process (see shared_atlas.hh).
+#if defined(F_OFD_SETLK)
+constexpr int lease_lock = F_OFD_SETLK;
+constexpr int lease_query = F_OFD_GETLK;
+#else
+constexpr int lease_lock = F_SETLK;
+constexpr int lease_query = F_GETLK;
+#endif
+
+/// Byte of the shared-memory object whose write lock is a lease
+struct flock lease_range(uint32_t lease) noexcept {
+    struct flock fl{};
+    fl.l_type = F_WRLCK;
+    fl.l_whence = SEEK_SET;
+    fl.l_start = static_cast<off_t>(lease);
+    fl.l_len = 1;
+    return fl;
+}
+
+bool hold_lease(int fd, uint32_t lease) noexcept {
+    struct flock fl = lease_range(lease);
+    return ::fcntl(fd, lease_lock, &fl) == 0;
+}
+
+/// Whether the attachment holding a lease still exists
+bool lease_alive(int fd, uint32_t lease) noexcept {
+    struct flock fl = lease_range(lease);
+    if (::fcntl(fd, lease_query, &fl) != 0) {
+        return true;  // Unknown: never take over
+    }
+    return fl.l_type != F_UNLCK;
+}
+
+void backoff(int iteration) noexcept {
+    if (iteration < 64) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+#endif
+
+} // anonymous namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+#if defined(ONYX_FONT_HAS_SHM)
+
+shared_glyph_atlas::shared_glyph_atlas(const std::string& name, font_source source, float size,
+                                       shared_atlas_config config)
+    : m_rasterizer(std::move(source)) {
+    m_rasterizer.set_size(size);
+
+    THROW_IF(config.atlas_size <= 0 || config.atlas_size > 0xFFFF, std::invalid_argument,
+             "Shared atlas size out of range:", config.atlas_size);
+    THROW_IF(config.max_pages <= 0 || config.max_pages > 0xFFFF, std::invalid_argument,
+             "Shared atlas page count out of range:", config.max_pages);
+    THROW_IF(config.table_capacity <= 0, std::invalid_argument,
+             "Shared atlas table capacity must be positive");
+    config.table_capacity = static_cast<int>(std::bit_ceil(static_cast<uint32_t>(config.table_capacity)));
+
+    const shm_layout layout = compute_layout(config);
+    const uint64_t fingerprint = font_fingerprint(m_rasterizer, config);
+
+    int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) {
+        m_creator = true;
+        if (::ftruncate(fd, static_cast<off_t>(layout.total)) != 0) {
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            THROW_RUNTIME("Cannot size shared atlas:", name);
+        }
+    } else {
+        THROW_IF(errno != EEXIST, std::runtime_error, "Cannot create shared atlas:", name);
+        fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        THROW_IF(fd < 0, std::runtime_error, "Cannot open shared atlas:", name);
+
+        // The creator may not have sized the object yet (ftruncate is atomic)
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        struct stat st{};
+        for (int i = 0; ; ++i) {
+            if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+                break;
+            }
+            if (std::chrono::steady_clock::now() > deadline) {
+                ::close(fd);
+                THROW_RUNTIME("Timed out waiting for shared atlas creation:", name);
+            }
+            backoff(i);
+        }
+        if (static_cast<std::size_t>(st.st_size) != layout.total) {
+            ::close(fd);
+            THROW_RUNTIME("Shared atlas was created with a different geometry:", name);
+        }
+    }
+
+    void* base = ::mmap(nullptr, layout.total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        ::close(fd);
+        THROW_RUNTIME("Cannot map shared atlas:", name);
+    }
+    // The descriptor stays open: it holds this attachment's lease
+    m_base = base;
+    m_mapped_size = layout.total;
+    m_fd = fd;
+
+    auto* header = static_cast<shm_header*>(m_base);
+    auto* bytes = static_cast<unsigned char*>(m_base);
+
+    if (m_creator) {
+        // Fresh object is zero-filled; construct the shared state in place
+        new (header) shm_header{};
+        header->magic = shm_magic;
+        header->version = shm_version;
+        header->atlas_size = config.atlas_size;
+        header->max_pages = config.max_pages;
+        header->padding = config.padding;
+        header->table_capacity = static_cast<uint32_t>(config.table_capacity);
+        header->fingerprint = fingerprint;
+        header->pack_state.store(encode_pack(0,
+                                             static_cast<uint64_t>(config.padding),
+                                             static_cast<uint64_t>(config.padding), 0),
+                                 std::memory_order_relaxed);
+
+        auto* table = reinterpret_cast<shm_entry*>(bytes + layout.table_offset);
+        for (int i = 0; i < config.table_capacity; ++i) {
+            new (&table[i]) shm_entry{};
+        }
+
+        m_lease = header->next_lease.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (!hold_lease(m_fd, m_lease)) {
+            unmap();
+            ::shm_unlink(name.c_str());
+            THROW_RUNTIME("Cannot lock shared atlas lease:", name);
+        }
+
+        header->ready.store(1, std::memory_order_release);
+        return;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    for (int i = 0; header->ready.load(std::memory_order_acquire) == 0; ++i) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            unmap();
+            THROW_RUNTIME("Timed out waiting for shared atlas initialization:", name);
+        }
+        backoff(i);
+    }
+
+    bool compatible = header->magic == shm_magic &&
+                      header->version == shm_version &&
+                      header->atlas_size == config.atlas_size &&
+                      header->max_pages == config.max_pages &&
+                      header->padding == config.padding &&
+                      header->table_capacity == static_cast<uint32_t>(config.table_capacity) &&
+                      header->fingerprint == fingerprint;
+    if (!compatible) {
+        unmap();
+        THROW_RUNTIME("Shared atlas was created for a different font or geometry:", name);
+    }
+
+    m_lease = header->next_lease.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (!hold_lease(m_fd, m_lease)) {
+        unmap();
+        THROW_RUNTIME("Cannot lock shared atlas lease:", name);
+    }
+}
+
+bool shared_glyph_atlas::remove(const std::string& name) noexcept {
+    return ::shm_unlink(name.c_str()) == 0;
+}
+
+void shared_glyph_atlas::unmap() noexcept {
+    if (m_base) {
+        ::munmap(m_base, m_mapped_size);
+        m_base = nullptr;
+        m_mapped_size = 0;
+    }
+    if (m_fd >= 0) {
+        // Releases the lease
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_lease = 0;
+}
+
+#else
+
+shared_glyph_atlas::shared_glyph_atlas(const std::string& name, font_source source, float size,
+                                       shared_atlas_config)
+    : m_rasterizer(std::move(source)) {
+    m_rasterizer.set_size(size);
+    THROW_RUNTIME("Shared glyph atlas is not supported on this platform:", name);
+}
+
+bool shared_glyph_atlas::remove(const std::string&) noexcept {
+    return false;
+}
+
+void shared_glyph_atlas::unmap() noexcept {
+    m_base = nullptr;
+    m_mapped_size = 0;
+}
+
+#endif
+
+shared_glyph_atlas::~shared_glyph_atlas() {
+    unmap();
+}
+
+shared_glyph_atlas::shared_glyph_atlas(shared_glyph_atlas&& other) noexcept
+    : m_rasterizer(std::move(other.m_rasterizer))
+    , m_base(std::exchange(other.m_base, nullptr))
+    , m_mapped_size(std::exchange(other.m_mapped_size, 0))
+    , m_fd(std::exchange(other.m_fd, -1))
+    , m_lease(std::exchange(other.m_lease, 0))
+    , m_creator(other.m_creator) {}
+
+shared_glyph_atlas& shared_glyph_atlas::operator=(shared_glyph_atlas&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        m_rasterizer = std::move(other.m_rasterizer);
+        m_base = std::exchange(other.m_base, nullptr);
+        m_mapped_size = std::exchange(other.m_mapped_size, 0);
+        m_fd = std::exchange(other.m_fd, -1);
+        m_lease = std::exchange(other.m_lease, 0);
+        m_creator = other.m_creator;
+    }
+    return *this;
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+namespace {
+
+struct shm_view {
+    shm_header* header;
+    shm_entry* table;
+    unsigned char* pages;
+    std::size_t page_bytes;
+};
+
+shm_view view_of(void* base) noexcept {
+    auto* header = static_cast<shm_header*>(base);
+    shared_atlas_config config;
+    config.atlas_size = header->atlas_size;
+    config.max_pages = header->max_pages;
+    config.table_capacity = static_cast<int>(header->table_capacity);
+    shm_layout layout = compute_layout(config);
+    auto* bytes = static_cast<unsigned char*>(base);
+    return {header,
+            reinterpret_cast<shm_entry*>(bytes + layout.table_offset),
+            bytes + layout.pages_offset,
+            layout.page_bytes};
+}
+
+uint32_t slot_hash(char32_t codepoint) noexcept {
+    return static_cast<uint32_t>(codepoint) * 2654435761u;
+}
+
+cached_glyph to_cached(const shm_entry& e) noexcept {
+    cached_glyph glyph;
+    glyph.atlas_index = e.page;
+    glyph.layer = e.page;
+    glyph.rect = {e.x, e.y, e.w, e.h};
+    glyph.bearing_x = e.bearing_x;
+    glyph.bearing_y = e.bearing_y;
+    glyph.advance_x = e.advance_x;
+    return glyph;
+}
+
+} // anonymous namespace
+
+bool shared_glyph_atlas::is_cached(char32_t codepoint) const noexcept {
+    if (!m_base) return false;
+    shm_view v = view_of(m_base);
+    const uint32_t key = static_cast<uint32_t>(codepoint) + 1;
+    const uint32_t mask = v.header->table_capacity - 1;
+
+    for (uint32_t probe = 0; probe <= mask; ++probe) {
+        const shm_entry& e = v.table[(slot_hash(codepoint) + probe) & mask];
+        uint32_t k = claim_key(e.claim.load(std::memory_order_acquire));
+        if (k == key) {
+            return e.state.load(std::memory_order_acquire) == slot_ready;
+        }
+        if (k == 0) {
+            return false;
+        }
+    }
+    return false;
+}
+
+int shared_glyph_atlas::page_count() const noexcept {
+    return m_base ? static_cast<shm_header*>(m_base)->page_count.load(std::memory_order_acquire) : 0;
+}
+
+int shared_glyph_atlas::page_size() const noexcept {
+    return m_base ? static_cast<shm_header*>(m_base)->atlas_size : 0;
+}
+
+int shared_glyph_atlas::glyph_count() const noexcept {
+    return m_base ? static_cast<shm_header*>(m_base)->glyph_count.load(std::memory_order_acquire) : 0;
+}
+
+const uint8_t* shared_glyph_atlas::page_data(int index) const {
+    if (!m_base || index < 0 || index >= static_cast<shm_header*>(m_base)->max_pages) {
+        THROW_OUT_OF_RANGE("Shared atlas page index out of range:", index);
+    }
+    shm_view v = view_of(m_base);
+    return v.pages + v.page_bytes * static_cast<std::size_t>(index);
+}
+
+void shared_glyph_atlas::cache_range(char32_t first, char32_t last) {
+    for (char32_t cp = first; cp <= last; ++cp) {
+        (void)get(cp);
+    }
+}
+
+void shared_glyph_atlas::cache_string(std::string_view utf8_text) {
+    for (char32_t cp : utf8_view(utf8_text)) {
+        (void)get(cp);
+    }
+}
+
+// ============================================================================
+// Lookup and rasterization
+// ============================================================================
+
+#if defined(ONYX_FONT_HAS_SHM)
+
+namespace {
+
+/// Rasterize a claimed slot into freshly allocated atlas space and publish it
+void fill_slot(const text_rasterizer& rasterizer, const shm_view& v, shm_entry& e, char32_t codepoint) {
+    auto metrics = rasterizer.measure_glyph(codepoint);
+    const int size = v.header->atlas_size;
+    const int pad = v.header->padding;
+    int glyph_w = std::clamp(static_cast<int>(std::ceil(metrics.width)), 0, size);
+    int glyph_h = std::clamp(static_cast<int>(std::ceil(metrics.height)), 0, size);
+
+    e.page = 0;
+    e.x = e.y = e.w = e.h = 0;
+    e.bearing_x = metrics.bearing_x;
+    e.bearing_y = metrics.bearing_y;
+    e.advance_x = metrics.advance_x;
+
+    if (glyph_w > 0 && glyph_h > 0) {
+        // Lock-free row packer: the whole cursor is one 64-bit word
+        const uint64_t padded_w = static_cast<uint64_t>(glyph_w + pad);
+        const uint64_t padded_h = static_cast<uint64_t>(glyph_h + pad);
+        const uint64_t limit = static_cast<uint64_t>(size);
+        uint64_t page = 0;
+        uint64_t x = 0;
+        uint64_t y = 0;
+
+        uint64_t old = v.header->pack_state.load(std::memory_order_acquire);
+        for (;;) {
+            page = old >> 48;
+            x = (old >> 32) & 0xFFFF;
+            y = (old >> 16) & 0xFFFF;
+            uint64_t row = old & 0xFFFF;
+
+            if (x + padded_w > limit) {
+                x = static_cast<uint64_t>(pad);
+                y += row + static_cast<uint64_t>(pad);
+                row = 0;
+            }
+            if (y + padded_h > limit) {
+                ++page;
+                x = static_cast<uint64_t>(pad);
+                y = static_cast<uint64_t>(pad);
+                row = 0;
+            }
+            if (page >= static_cast<uint64_t>(v.header->max_pages)) {
+                e.state.store(slot_failed, std::memory_order_release);
+                throw std::length_error("shared atlas is full");
+            }
+
+            uint64_t next = encode_pack(page, x + padded_w, y, std::max(row, padded_h));
+            if (v.header->pack_state.compare_exchange_weak(old, next, std::memory_order_acq_rel)) {
+                break;
+            }
+        }
+
+        // Publish the page as in use (monotonic max)
+        int32_t used = static_cast<int32_t>(page) + 1;
+        int32_t seen = v.header->page_count.load(std::memory_order_relaxed);
+        while (seen < used &&
+               !v.header->page_count.compare_exchange_weak(seen, used, std::memory_order_acq_rel)) {
+        }
+
+        e.page = static_cast<int32_t>(page);
+        e.x = static_cast<int32_t>(x);
+        e.y = static_cast<int32_t>(y);
+        e.w = glyph_w;
+        e.h = glyph_h;
+
+        // Rasterize straight into the shared page
+        uint8_t* dst = v.pages + v.page_bytes * page + y * limit + x;
+        grayscale_target target(dst, glyph_w, glyph_h, size);
+        int baseline_y = static_cast<int>(std::ceil(metrics.bearing_y));
+        rasterizer.rasterize_glyph(codepoint, target, 0, baseline_y);
+    }
+
+    e.state.store(slot_ready, std::memory_order_release);
+    v.header->glyph_count.fetch_add(1, std::memory_order_acq_rel);
+}
+
+} // anonymous namespace
+
+cached_glyph shared_glyph_atlas::get(char32_t codepoint) {
+    THROW_IF(!m_base, std::runtime_error, "Shared atlas is not mapped");
+
+    shm_view v = view_of(m_base);
+    const uint32_t key = static_cast<uint32_t>(codepoint) + 1;
+    const uint32_t mask = v.header->table_capacity - 1;
+    const uint64_t own_claim = make_claim(key, m_lease);
+
+    for (uint32_t probe = 0; probe <= mask; ++probe) {
+        shm_entry& e = v.table[(slot_hash(codepoint) + probe) & mask];
+        uint64_t claim = e.claim.load(std::memory_order_acquire);
+
+        if (claim == 0) {
+            if (e.claim.compare_exchange_strong(claim, own_claim, std::memory_order_acq_rel)) {
+                fill_slot(m_rasterizer, v, e, codepoint);
+                return to_cached(e);
+            }
+            // Lost the race for this slot; claim now holds the winner's
+        }
+        if (claim_key(claim) != key) {
+            continue;
+        }
+
+        // Claimed by someone: wait for publication, taking over from
+        // attachments that went away (their lease lock is released)
+        for (int i = 0; ; ++i) {
+            uint32_t state = e.state.load(std::memory_order_acquire);
+            if (state == slot_ready) {
+                return to_cached(e);
+            }
+            if (state == slot_failed) {
+                throw std::length_error("shared atlas is full");
+            }
+            if (i % 256 == 255) {
+                claim = e.claim.load(std::memory_order_acquire);
+                const uint32_t owner = claim_owner(claim);
+                if (owner != m_lease && !lease_alive(m_fd, owner) &&
+                    e.claim.compare_exchange_strong(claim, own_claim, std::memory_order_acq_rel)) {
+                    fill_slot(m_rasterizer, v, e, codepoint);
+                    return to_cached(e);
+                }
+            }
+            backoff(i);
+        }
+    }
+
+    throw std::length_error("shared atlas glyph table is full");
+}
+
+#else
+
+cached_glyph shared_glyph_atlas::get(char32_t) {
+    THROW_RUNTIME("Shared glyph atlas is not supported on this platform");
+}
+
+#endif
+
+} // namespace onyx_font
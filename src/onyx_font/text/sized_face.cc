@@ -0,0 +1,26 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/sized_face.hh>
+
+namespace onyx_font {
+
+sized_face::sized_face(const font_source& source, float size)
+    : m_source(&source)
+    , m_size(size)
+    , m_scale(source.scale_for_size(size))
+    , m_has_kerning(source.type() == font_source_type::outline) {
+    // Bitmap fonts report native metrics regardless of the requested size
+    float metrics_size = size;
+    if (source.type() == font_source_type::bitmap && source.native_size() > 0) {
+        metrics_size = source.native_size();
+    }
+    m_metrics = source.get_scaled_metrics(metrics_size);
+
+    for (char32_t cp = cached_first; cp <= cached_last; ++cp) {
+        m_ascii[cp - cached_first] = source.get_glyph_metrics_at_scale(cp, m_scale);
+    }
+}
+
+} // namespace onyx_font
@@ -0,0 +1,326 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/supersample.hh>
+#include <onyx_font/text/raster_target.hh>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ONYX_FONT_DOWNSAMPLE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace onyx_font {
+
+namespace {
+
+/// Lanczos window radius in destination pixels
+constexpr float lanczos_radius = 2.0f;
+
+/// Margin, in destination pixels, a filter can spread coverage beyond the source
+int filter_margin(downsample_filter filter) noexcept {
+    // Lanczos-2 is negative between 1 and 2 pixels, which clamps to 0
+    return filter == downsample_filter::lanczos ? 1 : 0;
+}
+
+float sinc(float x) noexcept {
+    if (x == 0.0f) return 1.0f;
+    constexpr float pi = 3.14159265358979f;
+    float px = pi * x;
+    return std::sin(px) / px;
+}
+
+float lanczos(float x) noexcept {
+    if (std::fabs(x) >= lanczos_radius) return 0.0f;
+    return sinc(x) * sinc(x / lanczos_radius);
+}
+
+/**
+ * Append the source taps of one destination pixel. Source pixel u covers
+ * destination [offset + u*scale, offset + (u+1)*scale).
+ */
+template<typename Span>
+Span axis_taps(int dst, int src_n, float scale, float offset,
+               downsample_filter filter, std::vector<float>& weights) {
+    Span span;
+    span.offset = weights.size();
+
+    if (filter == downsample_filter::area) {
+        // Destination pixel [dst, dst + 1) in source coordinates
+        float lo = (static_cast<float>(dst) - offset) / scale;
+        float hi = (static_cast<float>(dst) + 1.0f - offset) / scale;
+        int first = std::max(0, static_cast<int>(std::floor(lo)));
+        int last = std::min(src_n - 1, static_cast<int>(std::ceil(hi)) - 1);
+        span.first = first;
+        for (int u = first; u <= last; ++u) {
+            float overlap = std::min(hi, static_cast<float>(u + 1)) - std::max(lo, static_cast<float>(u));
+            weights.push_back(std::max(0.0f, overlap) * scale);
+        }
+        span.count = std::max(0, last - first + 1);
+        return span;
+    }
+
+    // Lanczos centred on the destination pixel, stretched over the footprint
+    float center = (static_cast<float>(dst) + 0.5f - offset) / scale;
+    float reach = lanczos_radius / scale;
+    int first = static_cast<int>(std::floor(center - reach - 0.5f));
+    int last = static_cast<int>(std::ceil(center + reach - 0.5f));
+
+    float total = 0.0f;
+    for (int u = first; u <= last; ++u) {
+        total += lanczos((static_cast<float>(u) + 0.5f - center) * scale);
+    }
+    if (total == 0.0f) {
+        return span;
+    }
+
+    // Normalize over the full kernel, then keep the taps inside the source
+    int kept_first = std::max(first, 0);
+    int kept_last = std::min(last, src_n - 1);
+    span.first = kept_first;
+    for (int u = kept_first; u <= kept_last; ++u) {
+        weights.push_back(lanczos((static_cast<float>(u) + 0.5f - center) * scale) / total);
+    }
+    span.count = std::max(0, kept_last - kept_first + 1);
+    return span;
+}
+
+/// out[i] += w * in[i]
+void accumulate_row(float* out, const float* in, float w, int n) noexcept {
+    int i = 0;
+#if defined(ONYX_FONT_DOWNSAMPLE_SSE2)
+    const __m128 wv = _mm_set1_ps(w);
+    for (; i + 4 <= n; i += 4) {
+        __m128 acc = _mm_loadu_ps(out + i);
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(in + i), wv));
+        _mm_storeu_ps(out + i, acc);
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] += w * in[i];
+    }
+}
+
+/// Round and clamp a filtered row to 8 bits
+void store_row(uint8_t* dst, const float* row, int n) noexcept {
+    int i = 0;
+#if defined(ONYX_FONT_DOWNSAMPLE_SSE2)
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 8 <= n; i += 8) {
+        // cvttps truncates; values are clamped at 0 first so +0.5 rounds
+        __m128i a = _mm_cvttps_epi32(_mm_add_ps(_mm_max_ps(_mm_loadu_ps(row + i), zero), half));
+        __m128i b = _mm_cvttps_epi32(_mm_add_ps(_mm_max_ps(_mm_loadu_ps(row + i + 4), zero), half));
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_setzero_si128());
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), packed);
+    }
+#endif
+    for (; i < n; ++i) {
+        float v = std::clamp(row[i] + 0.5f, 0.0f, 255.0f);
+        dst[i] = static_cast<uint8_t>(v);
+    }
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// alpha_downsampler
+// ============================================================================
+
+void alpha_downsampler::resample(const uint8_t* src, int src_w, int src_h, int src_stride,
+                                 uint8_t* dst, int dst_w, int dst_h, int dst_stride,
+                                 float scale, float offset_x, float offset_y,
+                                 downsample_filter filter) {
+    if (dst_w <= 0 || dst_h <= 0) {
+        return;
+    }
+    auto width = static_cast<std::size_t>(dst_w);
+
+    if (!src || src_w <= 0 || src_h <= 0 || !(scale > 0.0f)) {
+        for (int y = 0; y < dst_h; ++y) {
+            std::memset(dst + static_cast<std::ptrdiff_t>(y) * dst_stride, 0, width);
+        }
+        return;
+    }
+
+    // Weight tables for both axes
+    m_weights.clear();
+    m_columns.clear();
+    m_rows.clear();
+    for (int x = 0; x < dst_w; ++x) {
+        m_columns.push_back(axis_taps<span_weights>(x, src_w, scale, offset_x, filter, m_weights));
+    }
+    for (int y = 0; y < dst_h; ++y) {
+        m_rows.push_back(axis_taps<span_weights>(y, src_h, scale, offset_y, filter, m_weights));
+    }
+
+    // Horizontal pass: every source row filtered to the destination width
+    m_horizontal.assign(static_cast<std::size_t>(src_h) * width, 0.0f);
+    for (int v = 0; v < src_h; ++v) {
+        const uint8_t* in = src + static_cast<std::ptrdiff_t>(v) * src_stride;
+        float* out = m_horizontal.data() + static_cast<std::size_t>(v) * width;
+        for (int x = 0; x < dst_w; ++x) {
+            const span_weights& col = m_columns[static_cast<std::size_t>(x)];
+            const float* w = m_weights.data() + col.offset;
+            float sum = 0.0f;
+            for (int k = 0; k < col.count; ++k) {
+                sum += w[k] * static_cast<float>(in[col.first + k]);
+            }
+            out[x] = sum;
+        }
+    }
+
+    // Vertical pass: weighted sum of horizontal rows, four samples at a time
+    m_row.resize(width);
+    for (int y = 0; y < dst_h; ++y) {
+        const span_weights& row = m_rows[static_cast<std::size_t>(y)];
+        std::fill(m_row.begin(), m_row.end(), 0.0f);
+        const float* w = m_weights.data() + row.offset;
+        for (int k = 0; k < row.count; ++k) {
+            const float* in = m_horizontal.data() + static_cast<std::size_t>(row.first + k) * width;
+            accumulate_row(m_row.data(), in, w[k], dst_w);
+        }
+        store_row(dst + static_cast<std::ptrdiff_t>(y) * dst_stride, m_row.data(), dst_w);
+    }
+}
+
+bool downsample_has_simd() noexcept {
+#if defined(ONYX_FONT_DOWNSAMPLE_SSE2)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// ============================================================================
+// reference_strike
+// ============================================================================
+
+reference_strike::reference_strike(font_source source, float reference_size,
+                                   downsample_filter filter)
+    : m_source(std::move(source))
+    , m_reference_size(reference_size)
+    , m_filter(filter)
+    , m_face(m_source, reference_size) {}
+
+bool reference_strike::supports(float size) const noexcept {
+    return m_source.type() == font_source_type::outline &&
+           size > 0.0f && size < m_reference_size;
+}
+
+scaled_metrics reference_strike::metrics(float size) const noexcept {
+    float ratio = size / m_reference_size;
+    scaled_metrics result = m_face.metrics();
+    result.ascent *= ratio;
+    result.descent *= ratio;
+    result.line_gap *= ratio;
+    result.line_height *= ratio;
+    return result;
+}
+
+glyph_metrics reference_strike::get_glyph_metrics(char32_t codepoint, float size) const {
+    float ratio = size / m_reference_size;
+    glyph_metrics result = m_face.get_glyph_metrics(codepoint);
+    result.advance_x *= ratio;
+    result.bearing_x *= ratio;
+    result.bearing_y *= ratio;
+    result.width *= ratio;
+    result.height *= ratio;
+    return result;
+}
+
+const reference_strike::entry& reference_strike::reference_glyph(char32_t codepoint) {
+    auto it = m_glyphs.find(codepoint);
+    if (it != m_glyphs.end()) {
+        return it->second;
+    }
+
+    entry e;
+    glyph_metrics m = m_face.get_glyph_metrics(codepoint);
+    if (m.width > 0 && m.height > 0) {
+        // Generous canvas around the metric box; the result is cropped below
+        constexpr int pad = 2;
+        int left = static_cast<int>(std::ceil(std::max(0.0f, -m.bearing_x)));
+        int right = static_cast<int>(std::ceil(std::max(0.0f, m.bearing_x) + m.width));
+        int above = static_cast<int>(std::ceil(std::max(0.0f, m.bearing_y)));
+        int below = static_cast<int>(std::ceil(std::max(0.0f, m.height - m.bearing_y)));
+        int canvas_w = left + right + 2 * pad;
+        int canvas_h = above + below + 2 * pad;
+        int origin_x = pad + left;
+        int origin_y = pad + above;
+
+        std::vector<uint8_t> canvas(static_cast<std::size_t>(canvas_w) * static_cast<std::size_t>(canvas_h), 0);
+        grayscale_target target(canvas.data(), canvas_w, canvas_h);
+        m_source.rasterize_glyph(codepoint, m_reference_size, target, origin_x, origin_y);
+
+        // Crop to the covered pixels
+        int x0 = canvas_w, y0 = canvas_h, x1 = -1, y1 = -1;
+        for (int y = 0; y < canvas_h; ++y) {
+            const uint8_t* row = canvas.data() + static_cast<std::size_t>(y) * static_cast<std::size_t>(canvas_w);
+            for (int x = 0; x < canvas_w; ++x) {
+                if (row[x] != 0) {
+                    x0 = std::min(x0, x);
+                    x1 = std::max(x1, x);
+                    y0 = std::min(y0, y);
+                    y1 = std::max(y1, y);
+                }
+            }
+        }
+
+        if (x1 >= x0) {
+            e.width = x1 - x0 + 1;
+            e.height = y1 - y0 + 1;
+            e.origin_x = origin_x - x0;
+            e.origin_y = origin_y - y0;
+            e.alpha.resize(static_cast<std::size_t>(e.width) * static_cast<std::size_t>(e.height));
+            for (int y = 0; y < e.height; ++y) {
+                std::memcpy(e.alpha.data() + static_cast<std::size_t>(y) * static_cast<std::size_t>(e.width),
+                            canvas.data() + static_cast<std::size_t>(y + y0) * static_cast<std::size_t>(canvas_w) +
+                            static_cast<std::size_t>(x0),
+                            static_cast<std::size_t>(e.width));
+            }
+        }
+    }
+
+    return m_glyphs.emplace(codepoint, std::move(e)).first->second;
+}
+
+glyph_rect reference_strike::box(char32_t codepoint, float size) {
+    std::lock_guard lock(m_mutex);
+    const entry& e = reference_glyph(codepoint);
+    if (e.width == 0 || !(size > 0.0f)) {
+        return {};
+    }
+
+    float ratio = size / m_reference_size;
+    int margin = filter_margin(m_filter);
+    int x0 = static_cast<int>(std::floor(static_cast<float>(-e.origin_x) * ratio)) - margin;
+    int y0 = static_cast<int>(std::floor(static_cast<float>(-e.origin_y) * ratio)) - margin;
+    int x1 = static_cast<int>(std::ceil(static_cast<float>(e.width - e.origin_x) * ratio)) + margin;
+    int y1 = static_cast<int>(std::ceil(static_cast<float>(e.height - e.origin_y) * ratio)) + margin;
+    return {x0, y0, x1 - x0, y1 - y0};
+}
+
+void reference_strike::draw(char32_t codepoint, float size,
+                            uint8_t* dst, int width, int height, int stride,
+                            float pen_x, float pen_y) {
+    std::lock_guard lock(m_mutex);
+    const entry& e = reference_glyph(codepoint);
+
+    float ratio = size / m_reference_size;
+    m_downsampler.resample(e.alpha.empty() ? nullptr : e.alpha.data(), e.width, e.height, e.width,
+                           dst, width, height, stride, ratio,
+                           pen_x - static_cast<float>(e.origin_x) * ratio,
+                           pen_y - static_cast<float>(e.origin_y) * ratio,
+                           m_filter);
+}
+
+std::size_t reference_strike::glyph_count() const {
+    std::lock_guard lock(m_mutex);
+    return m_glyphs.size();
+}
+
+} // namespace onyx_font
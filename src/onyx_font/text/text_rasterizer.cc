@@ -8,25 +8,58 @@
 namespace onyx_font {
 
 text_rasterizer::text_rasterizer(font_source source)
-    : m_source(std::move(source)) {}
+    : m_source(std::move(source))
+    , m_face(m_source, m_size) {}
+
+text_rasterizer::text_rasterizer(const text_rasterizer& other)
+    : m_source(other.m_source)
+    , m_size(other.m_size)
+    , m_face(other.m_face)
+    , m_words(other.m_words) {
+    m_face.rebind(m_source);
+}
+
+text_rasterizer& text_rasterizer::operator=(const text_rasterizer& other) {
+    if (this != &other) {
+        *this = text_rasterizer(other);
+    }
+    return *this;
+}
+
+text_rasterizer::text_rasterizer(text_rasterizer&& other) noexcept
+    : m_source(std::move(other.m_source))
+    , m_size(other.m_size)
+    , m_face(other.m_face)
+    , m_words(std::move(other.m_words)) {
+    m_face.rebind(m_source);
+}
+
+text_rasterizer& text_rasterizer::operator=(text_rasterizer&& other) noexcept {
+    if (this != &other) {
+        m_source = std::move(other.m_source);
+        m_size = other.m_size;
+        m_face = other.m_face;
+        m_face.rebind(m_source);
+        m_words = std::move(other.m_words);
+    }
+    return *this;
+}
 
 void text_rasterizer::set_size(float pixels) {
+    if (pixels == m_size) {
+        return;
+    }
     m_size = pixels;
+    m_face = sized_face(m_source, m_size);
 }
 
 scaled_metrics text_rasterizer::get_metrics() const {
-    // For bitmap fonts, return native metrics regardless of set size
-    if (m_source.type() == font_source_type::bitmap) {
-        float native = m_source.native_size();
-        if (native > 0) {
-            return m_source.get_scaled_metrics(native);
-        }
-    }
-    return m_source.get_scaled_metrics(m_size);
+    // For bitmap fonts the face holds native metrics regardless of set size
+    return m_face.metrics();
 }
 
 glyph_metrics text_rasterizer::measure_glyph(char32_t codepoint) const {
-    return m_source.get_glyph_metrics(codepoint, m_size);
+    return m_face.get_glyph_metrics(codepoint);
 }
 
 text_extents text_rasterizer::measure_text(std::string_view text) const {
@@ -36,7 +69,7 @@ text_extents text_rasterizer::measure_text(std::string_view text) const {
         return result;
     }
 
-    auto metrics = get_metrics();
+    const auto& metrics = m_face.metrics();
     result.ascent = metrics.ascent;
     result.descent = metrics.descent;
     result.height = metrics.line_height;
@@ -47,12 +80,11 @@ text_extents text_rasterizer::measure_text(std::string_view text) const {
     for (char32_t codepoint : utf8_view(text)) {
         // Apply kerning
         if (prev_codepoint != 0) {
-            pen_x += m_source.get_kerning(prev_codepoint, codepoint, m_size);
+            pen_x += m_face.kerning(prev_codepoint, codepoint);
         }
 
-        // Get glyph metrics and advance
-        auto glyph = m_source.get_glyph_metrics(codepoint, m_size);
-        pen_x += glyph.advance_x;
+        // Get glyph advance
+        pen_x += m_face.advance(codepoint);
 
         prev_codepoint = codepoint;
     }
@@ -68,7 +100,7 @@ text_extents text_rasterizer::measure_wrapped(std::string_view text, float max_w
         return result;
     }
 
-    auto metrics = get_metrics();
+    const auto& metrics = m_face.metrics();
     result.ascent = metrics.ascent;
     result.descent = metrics.descent;
 
@@ -78,7 +110,31 @@ text_extents text_rasterizer::measure_wrapped(std::string_view text, float max_w
 
     char32_t prev_codepoint = 0;
 
-    for (char32_t codepoint : utf8_view(text)) {
+    const char* current = text.data();
+    const char* text_end = text.data() + text.size();
+    bool at_word_start = true;
+
+    while (current < text_end) {
+        // Add a whole cached word when none of its glyphs can wrap
+        if (m_words && at_word_start && *current != ' ' && *current != '\n') {
+            const char* word_end = std::find_if(current, text_end, [](char c) { return c == ' ' || c == '\n'; });
+            word_metrics word = m_words->measure(m_face, std::string_view(current, static_cast<std::size_t>(word_end - current)));
+            float kern = prev_codepoint != 0 ? m_face.kerning(prev_codepoint, word.first) : 0.0f;
+            if (max_width <= 0 || line_width + kern + word.peak <= max_width) {
+                line_width += kern + word.width;
+                prev_codepoint = word.last;
+                current = word_end;
+                at_word_start = false;
+                continue;
+            }
+        }
+
+        auto [codepoint, bytes] = utf8_decode_one(
+            std::string_view(current, static_cast<std::size_t>(text_end - current)));
+        if (bytes == 0) break;
+        current += bytes;
+        at_word_start = codepoint == ' ' || codepoint == '\n';
+
         // Check for newline
         if (codepoint == '\n') {
             max_line_width = std::max(max_line_width, line_width);
@@ -91,11 +147,11 @@ text_extents text_rasterizer::measure_wrapped(std::string_view text, float max_w
         // Apply kerning
         float kern = 0.0f;
         if (prev_codepoint != 0) {
-            kern = m_source.get_kerning(prev_codepoint, codepoint, m_size);
+            kern = m_face.kerning(prev_codepoint, codepoint);
         }
 
         // Get glyph advance
-        auto glyph = m_source.get_glyph_metrics(codepoint, m_size);
+        auto glyph = m_face.get_glyph_metrics(codepoint);
         float advance = kern + glyph.advance_x;
 
         // Check if we need to wrap (simple word wrap at any character)
@@ -120,7 +176,7 @@ text_extents text_rasterizer::measure_wrapped(std::string_view text, float max_w
 }
 
 float text_rasterizer::line_height() const {
-    return get_metrics().line_height;
+    return m_face.line_height();
 }
 
 } // namespace onyx_font
@@ -0,0 +1,237 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/usage_profile.hh>
+#include <onyx_font/text/utf8.hh>
+#include <failsafe/failsafe.hh>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace onyx_font {
+
+namespace {
+
+constexpr uint8_t PROFILE_MAGIC[4] = {'O', 'X', 'U', 'P'};
+constexpr uint8_t PROFILE_VERSION = 1;
+
+void write_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/// Bounds-checked reader over the profile bytes
+class profile_reader {
+public:
+    explicit profile_reader(std::span<const uint8_t> data)
+        : m_data(data) {
+    }
+
+    uint8_t byte() {
+        THROW_IF(m_pos >= m_data.size(), std::runtime_error, "Usage profile is truncated");
+        return m_data[m_pos++];
+    }
+
+    uint64_t varint(uint64_t max) {
+        uint64_t value = 0;
+        int shift = 0;
+        uint8_t b = 0;
+        do {
+            THROW_IF(shift > 56, std::runtime_error, "Usage profile varint is too long");
+            b = byte();
+            value |= static_cast<uint64_t>(b & 0x7F) << shift;
+            shift += 7;
+        } while (b & 0x80);
+        THROW_IF(value > max, std::runtime_error, "Usage profile value out of range:", value);
+        return value;
+    }
+
+    std::string string(std::size_t length) {
+        THROW_IF(length > remaining(), std::runtime_error, "Usage profile is truncated");
+        std::string s(reinterpret_cast<const char*>(m_data.data() + m_pos), length);
+        m_pos += length;
+        return s;
+    }
+
+    [[nodiscard]] std::size_t remaining() const noexcept { return m_data.size() - m_pos; }
+
+private:
+    std::span<const uint8_t> m_data;
+    std::size_t m_pos = 0;
+};
+
+} // anonymous namespace
+
+// ===========================================================================
+// usage_counter
+// ===========================================================================
+
+void usage_counter::add_text(std::string_view utf8_text) {
+    for (char32_t cp : utf8_view(utf8_text)) {
+        add(cp);
+    }
+}
+
+void usage_counter::merge(const usage_counter& other) {
+    for (const auto& [cp, n] : other.m_counts) {
+        add(cp, n);
+    }
+}
+
+uint32_t usage_counter::count(char32_t codepoint) const noexcept {
+    auto it = m_counts.find(codepoint);
+    return it != m_counts.end() ? it->second : 0;
+}
+
+std::vector<char32_t> usage_counter::top(std::size_t k) const {
+    std::vector<std::pair<char32_t, uint32_t>> ranked(m_counts.begin(), m_counts.end());
+    k = std::min(k, ranked.size());
+    auto by_use = [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    };
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(k), ranked.end(), by_use);
+
+    std::vector<char32_t> result;
+    result.reserve(k);
+    for (std::size_t i = 0; i < k; ++i) {
+        result.push_back(ranked[i].first);
+    }
+    return result;
+}
+
+// ===========================================================================
+// usage_profile
+// ===========================================================================
+
+uint32_t usage_profile::size_key(float size) noexcept {
+    if (!(size > 0.0f)) {
+        return 0;
+    }
+    return static_cast<uint32_t>(std::lround(std::min(size, 65536.0f) * 64.0f));
+}
+
+std::shared_ptr<usage_counter> usage_profile::counter(std::string_view font, float size) {
+    auto& slot = m_counters[key(std::string(font), size_key(size))];
+    if (!slot) {
+        slot = std::make_shared<usage_counter>();
+    }
+    return slot;
+}
+
+std::shared_ptr<const usage_counter> usage_profile::find(std::string_view font, float size) const {
+    auto it = m_counters.find(key(std::string(font), size_key(size)));
+    return it != m_counters.end() ? it->second : nullptr;
+}
+
+std::vector<char32_t> usage_profile::top(std::string_view font, float size, std::size_t k) const {
+    if (auto exact = find(font, size)) {
+        return exact->top(k);
+    }
+
+    // Entries of one font are adjacent in key order
+    usage_counter all_sizes;
+    for (auto it = m_counters.lower_bound(key(std::string(font), 0));
+         it != m_counters.end() && it->first.first == font; ++it) {
+        all_sizes.merge(*it->second);
+    }
+    return all_sizes.top(k);
+}
+
+void usage_profile::merge(const usage_profile& other) {
+    for (const auto& [k, c] : other.m_counters) {
+        auto& slot = m_counters[k];
+        if (!slot) {
+            slot = std::make_shared<usage_counter>();
+        }
+        slot->merge(*c);
+    }
+}
+
+std::vector<uint8_t> usage_profile::serialize() const {
+    std::vector<uint8_t> out(std::begin(PROFILE_MAGIC), std::end(PROFILE_MAGIC));
+    out.push_back(PROFILE_VERSION);
+    write_varint(out, m_counters.size());
+
+    std::vector<std::pair<char32_t, uint32_t>> sorted;
+    for (const auto& [k, c] : m_counters) {
+        write_varint(out, k.first.size());
+        out.insert(out.end(), k.first.begin(), k.first.end());
+        write_varint(out, k.second);
+
+        sorted.assign(c->counts().begin(), c->counts().end());
+        std::sort(sorted.begin(), sorted.end());
+        write_varint(out, sorted.size());
+        char32_t previous = 0;
+        for (const auto& [cp, n] : sorted) {
+            write_varint(out, cp - previous);
+            write_varint(out, n);
+            previous = cp;
+        }
+    }
+    return out;
+}
+
+usage_profile usage_profile::deserialize(std::span<const uint8_t> data) {
+    THROW_IF(data.size() < 5 || !std::equal(std::begin(PROFILE_MAGIC), std::end(PROFILE_MAGIC), data.begin()),
+             std::runtime_error, "Not a usage profile");
+    THROW_IF(data[4] != PROFILE_VERSION, std::runtime_error,
+             "Unsupported usage profile version:", static_cast<int>(data[4]));
+
+    profile_reader reader(data.subspan(5));
+    usage_profile profile;
+
+    // Every entry and glyph takes at least one byte per field, which
+    // bounds the counts before anything is allocated
+    auto entries = reader.varint(reader.remaining());
+    for (uint64_t e = 0; e < entries; ++e) {
+        std::string font = reader.string(reader.varint(reader.remaining()));
+        auto size = static_cast<uint32_t>(reader.varint(UINT32_MAX));
+        auto glyphs = reader.varint(reader.remaining() / 2);
+
+        auto& slot = profile.m_counters[key(std::move(font), size)];
+        THROW_IF(slot, std::runtime_error, "Duplicate usage profile entry");
+        slot = std::make_shared<usage_counter>();
+
+        uint64_t cp = 0;
+        for (uint64_t g = 0; g < glyphs; ++g) {
+            uint64_t delta = reader.varint(0x10FFFF);
+            THROW_IF(g > 0 && delta == 0, std::runtime_error, "Duplicate usage profile codepoint");
+            cp += delta;
+            THROW_IF(cp > 0x10FFFF, std::runtime_error, "Usage profile codepoint out of range");
+            slot->add(static_cast<char32_t>(cp), static_cast<uint32_t>(reader.varint(UINT32_MAX)));
+        }
+    }
+    THROW_IF(reader.remaining() != 0, std::runtime_error, "Trailing data after usage profile");
+    return profile;
+}
+
+void usage_profile::save(const std::filesystem::path& path) const {
+    auto data = serialize();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    THROW_IF(!file, std::runtime_error, "Cannot open file:", path.string());
+    THROW_IF(!file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size())),
+             std::runtime_error, "Failed to write file:", path.string());
+}
+
+usage_profile usage_profile::load(const std::filesystem::path& path) {
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        return {};
+    }
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    THROW_IF(!file, std::runtime_error, "Cannot open file:", path.string());
+    auto size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    std::vector<uint8_t> data(static_cast<std::size_t>(size));
+    THROW_IF(!file.read(reinterpret_cast<char*>(data.data()), size),
+             std::runtime_error, "Failed to read file:", path.string());
+    return deserialize(data);
+}
+
+} // namespace onyx_font
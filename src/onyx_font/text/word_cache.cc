@@ -0,0 +1,98 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/text/word_cache.hh>
+#include <onyx_font/text/sized_face.hh>
+#include <onyx_font/text/utf8.hh>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace onyx_font {
+
+std::size_t word_width_cache::key_hash::operator()(const key& k) const noexcept {
+    std::size_t h = k.hash;
+    h ^= std::hash<uint32_t>{}(k.size_64) + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    h ^= std::hash<const void*>{}(k.font) + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    return h;
+}
+
+word_metrics word_width_cache::measure_uncached(const sized_face& face, std::string_view word) {
+    word_metrics result;
+    float pen = 0.0f;
+    char32_t prev = 0;
+    for (char32_t cp : utf8_view(word)) {
+        if (prev != 0) {
+            pen += face.kerning(prev, cp);
+        } else {
+            result.first = cp;
+        }
+        pen += face.advance(cp);
+        result.peak = prev != 0 ? std::max(result.peak, pen) : pen;
+        prev = cp;
+    }
+    result.width = pen;
+    result.last = prev;
+    return result;
+}
+
+word_metrics word_width_cache::measure(const sized_face& face, std::string_view word) {
+    key k{std::hash<std::string_view>{}(word),
+          static_cast<uint32_t>(std::lround(std::max(face.size(), 0.0f) * 64.0f)),
+          face.source().font_identity()};
+    {
+        std::lock_guard lock(m_mutex);
+        if (auto it = m_index.find(k); it != m_index.end() && it->second->word == word) {
+            ++m_hits;
+            m_lru.splice(m_lru.begin(), m_lru, it->second);
+            return it->second->metrics;
+        }
+        ++m_misses;
+    }
+
+    // Measure outside the lock
+    word_metrics metrics = measure_uncached(face, word);
+
+    std::lock_guard lock(m_mutex);
+    if (m_capacity == 0) {
+        return metrics;
+    }
+    if (auto it = m_index.find(k); it != m_index.end()) {
+        // A colliding word (or another thread's result) is replaced
+        it->second->word.assign(word);
+        it->second->metrics = metrics;
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return metrics;
+    }
+    m_lru.push_front(entry{k, std::string(word), metrics});
+    m_index.emplace(k, m_lru.begin());
+    while (m_lru.size() > m_capacity) {
+        m_index.erase(m_lru.back().k);
+        m_lru.pop_back();
+    }
+    return metrics;
+}
+
+void word_width_cache::clear() {
+    std::lock_guard lock(m_mutex);
+    m_lru.clear();
+    m_index.clear();
+}
+
+std::size_t word_width_cache::size() const {
+    std::lock_guard lock(m_mutex);
+    return m_lru.size();
+}
+
+uint64_t word_width_cache::hits() const {
+    std::lock_guard lock(m_mutex);
+    return m_hits;
+}
+
+uint64_t word_width_cache::misses() const {
+    std::lock_guard lock(m_mutex);
+    return m_misses;
+}
+
+} // namespace onyx_font
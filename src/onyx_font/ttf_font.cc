@@ -30,6 +30,11 @@ namespace onyx_font {
         int index = 0;
         bool valid = false;
 
+        // Unscaled vertical metrics, read once
+        int ascent = 0;
+        int descent = 0;
+        int line_gap = 0;
+
         impl(std::span<const uint8_t> font_data, int font_index)
             : data(font_data), index(font_index) {
             if (data.empty()) {
@@ -50,6 +55,10 @@ namespace onyx_font {
                 data.data(),
                 offset
             ) != 0;
+
+            if (valid) {
+                stbtt_GetFontVMetrics(&font_info, &ascent, &descent, &line_gap);
+            }
         }
 
         [[nodiscard]] float get_scale(float pixel_height) const {
@@ -71,20 +80,27 @@ namespace onyx_font {
         return m_impl && m_impl->valid;
     }
 
+    float ttf_font::scale_for_pixel_height(float pixel_height) const {
+        if (!is_valid()) {
+            return 0.0f;
+        }
+        return m_impl->get_scale(pixel_height);
+    }
+
     ttf_font_metrics ttf_font::get_metrics(float pixel_height) const {
+        return get_metrics_at_scale(scale_for_pixel_height(pixel_height));
+    }
+
+    ttf_font_metrics ttf_font::get_metrics_at_scale(float scale) const {
         ttf_font_metrics metrics{};
 
         if (!is_valid()) {
             return metrics;
         }
 
-        int ascent, descent, line_gap;
-        stbtt_GetFontVMetrics(&m_impl->font_info, &ascent, &descent, &line_gap);
-
-        float scale = m_impl->get_scale(pixel_height);
-        metrics.ascent = static_cast<float>(ascent) * scale;
-        metrics.descent = static_cast<float>(descent) * scale;
-        metrics.line_gap = static_cast<float>(line_gap) * scale;
+        metrics.ascent = static_cast<float>(m_impl->ascent) * scale;
+        metrics.descent = static_cast<float>(m_impl->descent) * scale;
+        metrics.line_gap = static_cast<float>(m_impl->line_gap) * scale;
 
         return metrics;
     }
@@ -92,6 +108,13 @@ namespace onyx_font {
     std::optional<ttf_glyph_metrics> ttf_font::get_glyph_metrics(
         uint32_t codepoint,
         float pixel_height
+    ) const {
+        return get_glyph_metrics_at_scale(codepoint, scale_for_pixel_height(pixel_height));
+    }
+
+    std::optional<ttf_glyph_metrics> ttf_font::get_glyph_metrics_at_scale(
+        uint32_t codepoint,
+        float scale
     ) const {
         if (!is_valid()) {
             return std::nullopt;
@@ -102,8 +125,6 @@ namespace onyx_font {
             return std::nullopt;
         }
 
-        float scale = m_impl->get_scale(pixel_height);
-
         ttf_glyph_metrics result{};
 
         // Get bounding box (unscaled)
@@ -132,6 +153,13 @@ namespace onyx_font {
     std::optional<ttf_glyph_shape> ttf_font::get_glyph_shape(
         uint32_t codepoint,
         float pixel_height
+    ) const {
+        return get_glyph_shape_at_scale(codepoint, scale_for_pixel_height(pixel_height));
+    }
+
+    std::optional<ttf_glyph_shape> ttf_font::get_glyph_shape_at_scale(
+        uint32_t codepoint,
+        float scale
     ) const {
         if (!is_valid()) {
             return std::nullopt;
@@ -142,8 +170,6 @@ namespace onyx_font {
             return std::nullopt;
         }
 
-        float scale = m_impl->get_scale(pixel_height);
-
         // Get glyph shape from stb_truetype
         stbtt_vertex* stb_vertices = nullptr;
         int num_vertices = stbtt_GetGlyphShape(&m_impl->font_info, glyph_index, &stb_vertices);
@@ -211,12 +237,19 @@ namespace onyx_font {
         uint32_t first,
         uint32_t second,
         float pixel_height
+    ) const {
+        return get_kerning_at_scale(first, second, scale_for_pixel_height(pixel_height));
+    }
+
+    float ttf_font::get_kerning_at_scale(
+        uint32_t first,
+        uint32_t second,
+        float scale
     ) const {
         if (!is_valid()) {
             return 0.0f;
         }
 
-        float scale = m_impl->get_scale(pixel_height);
         int kern = stbtt_GetCodepointKernAdvance(
             &m_impl->font_info,
             static_cast<int>(first),
@@ -0,0 +1,312 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/ttf_outline_cache.hh>
+#include <algorithm>
+#include <cmath>
+
+namespace onyx_font {
+
+    namespace {
+        /// Upper bound on segments per curve, whatever the tolerance
+        constexpr int max_curve_segments = 64;
+
+        /// Smallest accepted flatness tolerance in pixels
+        constexpr float min_tolerance = 1e-3f;
+
+        int16_t to_font_units(float value) {
+            return static_cast<int16_t>(std::lround(value));
+        }
+
+        float length(float x, float y) {
+            return std::sqrt(x * x + y * y);
+        }
+
+        /// Segments needed so that a curve with second-difference bound
+        /// @p deviation stays within tolerance: error <= deviation / n^2
+        int curve_segments(float deviation, float tolerance) {
+            float n = std::ceil(std::sqrt(deviation / tolerance));
+            return std::clamp(static_cast<int>(n), 1, max_curve_segments);
+        }
+
+        /// Collects contour points, dropping duplicates and degenerate contours
+        class contour_builder {
+        public:
+            contour_builder(std::vector<flat_point>& points, std::vector<uint32_t>& ends)
+                : m_points(points), m_ends(ends) {}
+
+            void add(float x, float y) {
+                if (m_points.size() > m_start) {
+                    const flat_point& last = m_points.back();
+                    if (last.x == x && last.y == y) {
+                        return;
+                    }
+                }
+                m_points.push_back({x, y});
+            }
+
+            void close() {
+                // Closing point repeats the first: the loop is implicit
+                if (m_points.size() - m_start >= 2) {
+                    const flat_point& first = m_points[m_start];
+                    const flat_point& last = m_points.back();
+                    if (first.x == last.x && first.y == last.y) {
+                        m_points.pop_back();
+                    }
+                }
+
+                if (m_points.size() - m_start >= 2) {
+                    m_ends.push_back(static_cast<uint32_t>(m_points.size()));
+                } else {
+                    m_points.resize(m_start);
+                }
+                m_start = m_points.size();
+            }
+
+        private:
+            std::vector<flat_point>& m_points;
+            std::vector<uint32_t>& m_ends;
+            std::size_t m_start = 0;
+        };
+    }
+
+    void flatten_outline(const glyph_outline& outline, float scale, float tolerance,
+                         std::vector<flat_point>& points,
+                         std::vector<uint32_t>& contour_ends) {
+        points.clear();
+        contour_ends.clear();
+        tolerance = std::max(tolerance, min_tolerance);
+
+        contour_builder contour(points, contour_ends);
+        const int16_t* c = outline.coords.data();
+        const int16_t* c_end = c + outline.coords.size();
+        float pen_x = 0.0f;
+        float pen_y = 0.0f;
+
+        auto next = [&](float& x, float& y) {
+            x = static_cast<float>(c[0]) * scale;
+            y = static_cast<float>(c[1]) * scale;
+            c += 2;
+        };
+
+        for (ttf_vertex_type verb : outline.verbs) {
+            switch (verb) {
+                case ttf_vertex_type::MOVE_TO: {
+                    if (c_end - c < 2) {
+                        contour.close();
+                        return;
+                    }
+                    contour.close();
+                    next(pen_x, pen_y);
+                    contour.add(pen_x, pen_y);
+                    break;
+                }
+
+                case ttf_vertex_type::LINE_TO: {
+                    if (c_end - c < 2) {
+                        contour.close();
+                        return;
+                    }
+                    next(pen_x, pen_y);
+                    contour.add(pen_x, pen_y);
+                    break;
+                }
+
+                case ttf_vertex_type::CURVE_TO: {
+                    if (c_end - c < 4) {
+                        contour.close();
+                        return;
+                    }
+                    float cx, cy, x, y;
+                    next(cx, cy);
+                    next(x, y);
+
+                    // Chord error of n uniform steps: |p0 - 2p1 + p2| / (4 n^2)
+                    float d = length(pen_x - 2.0f * cx + x, pen_y - 2.0f * cy + y);
+                    int n = curve_segments(d / 4.0f, tolerance);
+                    for (int i = 1; i <= n; ++i) {
+                        float t = static_cast<float>(i) / static_cast<float>(n);
+                        float u = 1.0f - t;
+                        contour.add(u * u * pen_x + 2.0f * u * t * cx + t * t * x,
+                                    u * u * pen_y + 2.0f * u * t * cy + t * t * y);
+                    }
+                    pen_x = x;
+                    pen_y = y;
+                    break;
+                }
+
+                case ttf_vertex_type::CUBIC_TO: {
+                    if (c_end - c < 6) {
+                        contour.close();
+                        return;
+                    }
+                    float cx, cy, cx1, cy1, x, y;
+                    next(cx, cy);
+                    next(cx1, cy1);
+                    next(x, y);
+
+                    // Chord error of n uniform steps: 3 max|second difference| / (4 n^2)
+                    float d = std::max(length(pen_x - 2.0f * cx + cx1, pen_y - 2.0f * cy + cy1),
+                                       length(cx - 2.0f * cx1 + x, cy - 2.0f * cy1 + y));
+                    int n = curve_segments(3.0f * d / 4.0f, tolerance);
+                    for (int i = 1; i <= n; ++i) {
+                        float t = static_cast<float>(i) / static_cast<float>(n);
+                        float u = 1.0f - t;
+                        float b0 = u * u * u;
+                        float b1 = 3.0f * u * u * t;
+                        float b2 = 3.0f * u * t * t;
+                        float b3 = t * t * t;
+                        contour.add(b0 * pen_x + b1 * cx + b2 * cx1 + b3 * x,
+                                    b0 * pen_y + b1 * cy + b2 * cy1 + b3 * y);
+                    }
+                    pen_x = x;
+                    pen_y = y;
+                    break;
+                }
+            }
+        }
+
+        contour.close();
+    }
+
+    // ===========================================================================
+    // ttf_outline_cache
+    // ===========================================================================
+
+    ttf_outline_cache::ttf_outline_cache(const ttf_font& font)
+        : m_font(&font) {
+    }
+
+    const glyph_outline* ttf_outline_cache::get(char32_t codepoint) {
+        auto it = m_glyphs.find(codepoint);
+        if (it != m_glyphs.end()) {
+            return it->second.present ? &it->second.outline : nullptr;
+        }
+
+        entry e;
+
+        // Scale 1 yields font units; this is the only parse of the glyph
+        if (auto shape = m_font->get_glyph_shape_at_scale(static_cast<uint32_t>(codepoint), 1.0f)) {
+            m_verb_scratch.clear();
+            m_coord_scratch.clear();
+
+            for (const auto& v : shape->vertices) {
+                m_verb_scratch.push_back(v.type);
+                switch (v.type) {
+                    case ttf_vertex_type::CUBIC_TO:
+                        m_coord_scratch.push_back(to_font_units(v.cx));
+                        m_coord_scratch.push_back(to_font_units(v.cy));
+                        m_coord_scratch.push_back(to_font_units(v.cx1));
+                        m_coord_scratch.push_back(to_font_units(v.cy1));
+                        break;
+                    case ttf_vertex_type::CURVE_TO:
+                        m_coord_scratch.push_back(to_font_units(v.cx));
+                        m_coord_scratch.push_back(to_font_units(v.cy));
+                        break;
+                    default:
+                        break;
+                }
+                m_coord_scratch.push_back(to_font_units(v.x));
+                m_coord_scratch.push_back(to_font_units(v.y));
+            }
+
+            e.outline.verbs = m_verbs.append(m_verb_scratch);
+            e.outline.coords = m_coords.append(m_coord_scratch);
+            e.outline.x0 = to_font_units(shape->x0);
+            e.outline.y0 = to_font_units(shape->y0);
+            e.outline.x1 = to_font_units(shape->x1);
+            e.outline.y1 = to_font_units(shape->y1);
+            e.outline.advance_x = static_cast<int32_t>(std::lround(shape->advance_x));
+            e.outline.bearing_x = static_cast<int32_t>(std::lround(shape->bearing_x));
+            e.present = true;
+        }
+
+        auto& stored = m_glyphs.emplace(codepoint, e).first->second;
+        return stored.present ? &stored.outline : nullptr;
+    }
+
+    bool ttf_outline_cache::get_shape(char32_t codepoint, float pixel_height, ttf_glyph_shape& out) {
+        const glyph_outline* outline = get(codepoint);
+        if (!outline) {
+            return false;
+        }
+
+        float scale = m_font->scale_for_pixel_height(pixel_height);
+        auto scaled = [scale](int16_t value) { return static_cast<float>(value) * scale; };
+
+        out.vertices.clear();
+        const int16_t* c = outline->coords.data();
+        for (ttf_vertex_type verb : outline->verbs) {
+            ttf_vertex v{};
+            v.type = verb;
+            switch (verb) {
+                case ttf_vertex_type::CUBIC_TO:
+                    v.cx = scaled(c[0]);
+                    v.cy = scaled(c[1]);
+                    v.cx1 = scaled(c[2]);
+                    v.cy1 = scaled(c[3]);
+                    c += 4;
+                    break;
+                case ttf_vertex_type::CURVE_TO:
+                    v.cx = scaled(c[0]);
+                    v.cy = scaled(c[1]);
+                    c += 2;
+                    break;
+                default:
+                    break;
+            }
+            v.x = scaled(c[0]);
+            v.y = scaled(c[1]);
+            c += 2;
+            out.vertices.push_back(v);
+        }
+
+        out.x0 = scaled(outline->x0);
+        out.y0 = scaled(outline->y0);
+        out.x1 = scaled(outline->x1);
+        out.y1 = scaled(outline->y1);
+        out.advance_x = static_cast<float>(outline->advance_x) * scale;
+        out.bearing_x = static_cast<float>(outline->bearing_x) * scale;
+        out.bearing_y = out.y1;
+        return true;
+    }
+
+    // ===========================================================================
+    // flattened_outline_cache
+    // ===========================================================================
+
+    flattened_outline_cache::flattened_outline_cache(ttf_outline_cache& outlines, float pixel_height,
+                                                     float tolerance)
+        : m_outlines(&outlines)
+        , m_pixel_height(pixel_height)
+        , m_scale(outlines.scale_for_pixel_height(pixel_height))
+        , m_tolerance(std::max(tolerance, min_tolerance)) {
+    }
+
+    const flattened_glyph* flattened_outline_cache::get(char32_t codepoint) {
+        auto it = m_glyphs.find(codepoint);
+        if (it != m_glyphs.end()) {
+            return it->second.present ? &it->second.glyph : nullptr;
+        }
+
+        entry e;
+        if (const glyph_outline* outline = m_outlines->get(codepoint)) {
+            flatten_outline(*outline, m_scale, m_tolerance, m_point_scratch, m_contour_scratch);
+
+            e.glyph.points = m_points.append(m_point_scratch);
+            e.glyph.contour_ends = m_contours.append(m_contour_scratch);
+            e.glyph.advance_x = static_cast<float>(outline->advance_x) * m_scale;
+            e.glyph.bearing_x = static_cast<float>(outline->bearing_x) * m_scale;
+            e.glyph.x0 = static_cast<float>(outline->x0) * m_scale;
+            e.glyph.y0 = static_cast<float>(outline->y0) * m_scale;
+            e.glyph.x1 = static_cast<float>(outline->x1) * m_scale;
+            e.glyph.y1 = static_cast<float>(outline->y1) * m_scale;
+            e.present = true;
+        }
+
+        auto& stored = m_glyphs.emplace(codepoint, e).first->second;
+        return stored.present ? &stored.glyph : nullptr;
+    }
+
+}  // namespace onyx_font
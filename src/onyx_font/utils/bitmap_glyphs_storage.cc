@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <utility>
 #include <failsafe/enforce.hh>
+#include <failsafe/failsafe.hh>
+#include <stdexcept>
 #include <onyx_font/utils/bitmap_glyphs_storage.hh>
 
 namespace onyx_font {
@@ -57,10 +59,11 @@ namespace onyx_font {
         ENFORCE(glyph_index < m_glyphs.size());
         const auto& g = m_glyphs[glyph_index];
         const std::size_t bytes = static_cast <std::size_t>(g.stride) * g.height;
-        ENFORCE(g.offset + bytes <= m_blob.size());
+        const auto blob = this->bytes();
+        ENFORCE(g.offset + bytes <= blob.size());
 
         return {
-            std::span <const std::byte>(m_blob.data() + g.offset, bytes),
+            blob.subspan(g.offset, bytes),
             g.width,
             g.height,
             g.stride,
@@ -69,9 +72,73 @@ namespace onyx_font {
     }
 
     std::span <const std::byte> bitmap_storage::blob_bytes() const noexcept {
+        return bytes();
+    }
+
+    std::span <const std::byte> bitmap_storage::bytes() const noexcept {
+        if (m_owner) {
+            return m_borrowed;
+        }
         return {m_blob.data(), m_blob.size()};
     }
 
+    bool bitmap_storage::is_borrowed() const noexcept {
+        return m_owner != nullptr;
+    }
+
+    bitmap_storage bitmap_storage::wrap_uniform(std::shared_ptr <const void> owner,
+                                                std::span <const std::byte> bytes,
+                                                std::size_t glyph_count,
+                                                std::uint16_t width,
+                                                std::uint16_t height,
+                                                bit_order order) {
+        THROW_IF(!owner, std::invalid_argument, "Wrapped glyph bytes need an owner");
+        const std::uint16_t stride = bitmap_builder::packed_stride(width);
+        const std::size_t glyph_bytes = static_cast <std::size_t>(stride) * height;
+        THROW_IF(bytes.size() < glyph_bytes * glyph_count, std::invalid_argument,
+                 "Wrapped glyph bytes too small: expected", glyph_bytes * glyph_count, "bytes, got", bytes.size());
+
+        bitmap_storage s;
+        s.m_order = order;
+        s.m_owner = std::move(owner);
+        s.m_borrowed = bytes.first(glyph_bytes * glyph_count);
+        s.m_glyphs.resize(glyph_count);
+        for (std::size_t i = 0; i < glyph_count; ++i) {
+            auto& g = s.m_glyphs[i];
+            g.offset = i * glyph_bytes;
+            g.width = width;
+            g.height = height;
+            g.stride = stride;
+        }
+        return s;
+    }
+
+    bitmap_storage bitmap_storage::wrap(std::shared_ptr <const void> owner,
+                                        std::span <const std::byte> bytes,
+                                        std::span <const glyph_dimensions> glyphs,
+                                        bit_order order) {
+        THROW_IF(!owner, std::invalid_argument, "Wrapped glyph bytes need an owner");
+
+        bitmap_storage s;
+        s.m_order = order;
+        s.m_glyphs.resize(glyphs.size());
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < glyphs.size(); ++i) {
+            auto& g = s.m_glyphs[i];
+            g.offset = offset;
+            g.width = glyphs[i].width;
+            g.height = glyphs[i].height;
+            g.stride = bitmap_builder::packed_stride(g.width);
+            offset += static_cast <std::size_t>(g.stride) * g.height;
+        }
+        THROW_IF(bytes.size() < offset, std::invalid_argument,
+                 "Wrapped glyph bytes too small: expected", offset, "bytes, got", bytes.size());
+
+        s.m_owner = std::move(owner);
+        s.m_borrowed = bytes.first(offset);
+        return s;
+    }
+
     // =================================================================================
     // Bitmap Bilder
     // =================================================================================
@@ -0,0 +1,68 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/utils/codepoint_index.hh>
+#include <failsafe/failsafe.hh>
+#include <algorithm>
+#include <stdexcept>
+
+namespace onyx_font {
+    namespace {
+        constexpr char32_t unicode_max = 0x10FFFF;
+    }
+
+    codepoint_index::codepoint_index() = default;
+
+    std::uint32_t& codepoint_index::slot(char32_t codepoint) {
+        const std::size_t block = static_cast<std::size_t>(codepoint) >> 8;
+        if (m_pages.empty()) {
+            m_pages.assign(page_size, npos);  // shared empty page
+        }
+        if (block >= m_directory.size()) {
+            m_directory.resize(block + 1, 0);
+        }
+        if (m_directory[block] == 0) {
+            m_directory[block] = static_cast<std::uint16_t>(page_count());
+            m_pages.resize(m_pages.size() + page_size, npos);
+        }
+        return m_pages[static_cast<std::size_t>(m_directory[block]) * page_size + (codepoint & 0xFFu)];
+    }
+
+    bool codepoint_index::insert(char32_t codepoint, std::uint32_t glyph) {
+        THROW_IF(codepoint > unicode_max, std::invalid_argument, "Codepoint out of Unicode range");
+        THROW_IF(glyph == npos, std::invalid_argument, "Glyph index must not be npos");
+
+        auto& s = slot(codepoint);
+        if (s != npos) {
+            return false;
+        }
+        s = glyph;
+        m_min = m_size == 0 ? codepoint : std::min(m_min, codepoint);
+        m_max = m_size == 0 ? codepoint : std::max(m_max, codepoint);
+        ++m_size;
+        return true;
+    }
+
+    void codepoint_index::insert_range(char32_t first, char32_t last, std::uint32_t first_glyph) {
+        THROW_IF(last < first || last > unicode_max, std::invalid_argument, "Invalid codepoint range");
+        for (char32_t cp = first; cp <= last; ++cp) {
+            insert(cp, first_glyph + static_cast<std::uint32_t>(cp - first));
+        }
+    }
+
+    std::size_t codepoint_index::memory_usage() const noexcept {
+        return m_directory.capacity() * sizeof(std::uint16_t) +
+               m_pages.capacity() * sizeof(std::uint32_t);
+    }
+
+    void codepoint_index::clear() noexcept {
+        m_directory.clear();
+        m_directory.shrink_to_fit();
+        m_pages.clear();
+        m_pages.shrink_to_fit();
+        m_size = 0;
+        m_min = 0;
+        m_max = 0;
+    }
+} // namespace onyx_font
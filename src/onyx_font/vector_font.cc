@@ -24,6 +24,10 @@ namespace onyx_font {
         return m_default_char;
     }
 
+    std::optional<codepage> vector_font::get_codepage() const {
+        return m_codepage;
+    }
+
     const vector_font_metrics& vector_font::get_metrics() const {
         return m_metrics;
     }
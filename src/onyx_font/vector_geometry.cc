@@ -0,0 +1,278 @@
+//
+// Created by igor on 18/10/2026.
+//
+
+#include <onyx_font/vector_geometry.hh>
+#include <onyx_font/text/utf8.hh>
+#include <onyx_font/utils/codepage.hh>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ONYX_FONT_LINE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace onyx_font {
+
+    namespace {
+        /**
+         * Glyph for a codepoint, falling back to the default character.
+         * Codepoints are encoded through the font's codepage when it has
+         * one, as font_source does; unmappable ones draw nothing.
+         */
+        const vector_glyph* resolve_glyph(const vector_font& font, const codepage_table* encoding,
+                                          char32_t codepoint) {
+            if (encoding) {
+                const auto byte = encoding->encode(codepoint);
+                if (!byte) {
+                    return nullptr;
+                }
+                codepoint = *byte;
+            }
+            if (codepoint > 255) {
+                return nullptr;
+            }
+            const vector_glyph* glyph = font.get_glyph(static_cast<uint8_t>(codepoint));
+            if (!glyph) {
+                glyph = font.get_glyph(font.get_default_char());
+            }
+            return glyph;
+        }
+
+        /// Number of segments a glyph draws
+        std::size_t count_segments(const vector_glyph& glyph) {
+            std::size_t count = 0;
+            bool pen_down = true;
+            for (const auto& cmd : glyph.strokes) {
+                switch (cmd.type) {
+                    case stroke_type::MOVE_TO:
+                        pen_down = true;
+                        break;
+                    case stroke_type::LINE_TO:
+                        count += pen_down ? 1 : 0;
+                        break;
+                    case stroke_type::END:
+                        pen_down = false;
+                        break;
+                }
+            }
+            return count;
+        }
+
+        /**
+         * Expand line-list vertices (2 per segment) into quads (4 per
+         * segment) in place. Segments are walked back to front so no
+         * endpoint is overwritten before it is read.
+         */
+        void expand_to_quads(std::vector<line_vertex>& vertices, std::size_t segments, float thickness) {
+            const float half = thickness * 0.5f;
+            for (std::size_t i = segments; i-- > 0;) {
+                line_vertex p0 = vertices[2 * i];
+                line_vertex p1 = vertices[2 * i + 1];
+
+                float dx = p1.x - p0.x;
+                float dy = p1.y - p0.y;
+                float len = std::sqrt(dx * dx + dy * dy);
+                if (len > 0.0f) {
+                    dx /= len;
+                    dy /= len;
+                } else {
+                    // Zero-length segment: emit a square dot
+                    dx = 1.0f;
+                    dy = 0.0f;
+                    p0.x -= half;
+                    p1.x += half;
+                }
+
+                float nx = -dy * half;
+                float ny = dx * half;
+
+                line_vertex* q = vertices.data() + 4 * i;
+                q[0] = {p0.x + nx, p0.y + ny};
+                q[1] = {p0.x - nx, p0.y - ny};
+                q[2] = {p1.x + nx, p1.y + ny};
+                q[3] = {p1.x - nx, p1.y - ny};
+            }
+        }
+    }
+
+    // ===========================================================================
+    // affine_transform
+    // ===========================================================================
+
+    affine_transform affine_transform::translation(float x, float y) noexcept {
+        return {1.0f, 0.0f, 0.0f, 1.0f, x, y};
+    }
+
+    affine_transform affine_transform::scaling(float sx, float sy) noexcept {
+        return {sx, 0.0f, 0.0f, sy, 0.0f, 0.0f};
+    }
+
+    affine_transform affine_transform::rotation(float radians) noexcept {
+        float s = std::sin(radians);
+        float co = std::cos(radians);
+        return {co, s, -s, co, 0.0f, 0.0f};
+    }
+
+    affine_transform affine_transform::operator*(const affine_transform& r) const noexcept {
+        return {
+            a * r.a + c * r.b,
+            b * r.a + d * r.b,
+            a * r.c + c * r.d,
+            b * r.c + d * r.d,
+            a * r.tx + c * r.ty + tx,
+            b * r.tx + d * r.ty + ty
+        };
+    }
+
+    // ===========================================================================
+    // Vertex transform
+    // ===========================================================================
+
+    void transform_vertices_scalar(std::span<line_vertex> vertices,
+                                   const affine_transform& t) noexcept {
+        for (auto& v : vertices) {
+            v = t.apply(v);
+        }
+    }
+
+    void transform_vertices(std::span<line_vertex> vertices, const affine_transform& t) noexcept {
+#if defined(ONYX_FONT_LINE_SSE2)
+        // Two vertices per register: [x0 y0 x1 y1]
+        const __m128 diag = _mm_setr_ps(t.a, t.d, t.a, t.d);
+        const __m128 cross = _mm_setr_ps(t.c, t.b, t.c, t.b);
+        const __m128 offset = _mm_setr_ps(t.tx, t.ty, t.tx, t.ty);
+
+        float* p = reinterpret_cast<float*>(vertices.data());
+        std::size_t pairs = vertices.size() / 2;
+        for (std::size_t i = 0; i < pairs; ++i, p += 4) {
+            __m128 v = _mm_loadu_ps(p);
+            __m128 swapped = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v, diag), _mm_mul_ps(swapped, cross)), offset);
+            _mm_storeu_ps(p, r);
+        }
+        if (vertices.size() % 2 != 0) {
+            vertices.back() = t.apply(vertices.back());
+        }
+#else
+        transform_vertices_scalar(vertices, t);
+#endif
+    }
+
+    bool line_geometry_has_simd() noexcept {
+#if defined(ONYX_FONT_LINE_SSE2)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // ===========================================================================
+    // build_line_geometry
+    // ===========================================================================
+
+    void build_line_geometry(const vector_font& font, std::string_view text,
+                             const line_geometry_options& options,
+                             line_geometry& out) {
+        out.clear();
+
+        const auto& metrics = font.get_metrics();
+        if (metrics.pixel_height == 0) {
+            return;
+        }
+        const float native = static_cast<float>(metrics.pixel_height);
+        const float size = options.size > 0.0f ? options.size : native;
+        const float scale = size / native;
+
+        const auto cp = font.get_codepage();
+        const codepage_table* encoding = cp ? &codepage_table::get(*cp) : nullptr;
+
+        // Size the buffers exactly; a warm buffer keeps its capacity.
+        // Must skip the same codepoints as the emit pass below.
+        std::size_t segments = 0;
+        for (char32_t codepoint : utf8_view(text)) {
+            if (codepoint == '\n') {
+                continue;
+            }
+            if (const vector_glyph* glyph = resolve_glyph(font, encoding, codepoint)) {
+                segments += count_segments(*glyph);
+            }
+        }
+
+        const bool quads = options.thickness > 0.0f;
+        out.segment_count = segments;
+        out.triangles = quads;
+        out.vertices.resize(segments * (quads ? 4 : 2));
+        out.indices.resize(segments * (quads ? 6 : 2));
+
+        // Emit segment endpoints in layout space
+        line_vertex* v = out.vertices.data();
+        float origin_x = 0.0f;
+        float origin_y = 0.0f;
+        for (char32_t codepoint : utf8_view(text)) {
+            if (codepoint == '\n') {
+                out.advance = std::max(out.advance, origin_x);
+                origin_x = 0.0f;
+                origin_y += size;
+                continue;
+            }
+            const vector_glyph* glyph = resolve_glyph(font, encoding, codepoint);
+            if (!glyph) {
+                continue;
+            }
+
+            float pen_x = origin_x;
+            float pen_y = origin_y;
+            bool pen_down = true;
+            for (const auto& cmd : glyph->strokes) {
+                switch (cmd.type) {
+                    case stroke_type::MOVE_TO:
+                        pen_x += static_cast<float>(cmd.dx) * scale;
+                        pen_y += static_cast<float>(cmd.dy) * scale;
+                        pen_down = true;
+                        break;
+
+                    case stroke_type::LINE_TO: {
+                        float new_x = pen_x + static_cast<float>(cmd.dx) * scale;
+                        float new_y = pen_y + static_cast<float>(cmd.dy) * scale;
+                        if (pen_down) {
+                            *v++ = {pen_x, pen_y};
+                            *v++ = {new_x, new_y};
+                        }
+                        pen_x = new_x;
+                        pen_y = new_y;
+                        break;
+                    }
+
+                    case stroke_type::END:
+                        pen_down = false;
+                        break;
+                }
+            }
+            origin_x += static_cast<float>(glyph->width) * scale;
+        }
+        out.advance = std::max(out.advance, origin_x);
+
+        transform_vertices(std::span<line_vertex>(out.vertices.data(), segments * 2), options.transform);
+
+        uint32_t* idx = out.indices.data();
+        if (quads) {
+            expand_to_quads(out.vertices, segments, options.thickness);
+            for (std::size_t i = 0; i < segments; ++i) {
+                auto base = static_cast<uint32_t>(4 * i);
+                *idx++ = base;
+                *idx++ = base + 1;
+                *idx++ = base + 2;
+                *idx++ = base + 2;
+                *idx++ = base + 1;
+                *idx++ = base + 3;
+            }
+        } else {
+            for (std::size_t i = 0; i < 2 * segments; ++i) {
+                *idx++ = static_cast<uint32_t>(i);
+            }
+        }
+    }
+
+}  // namespace onyx_font
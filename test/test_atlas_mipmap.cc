@@ -0,0 +1,175 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for atlas_mip_chain and mip-aligned glyph packing
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/atlas_mipmap.hh>
+#include <onyx_font/text/glyph_cache.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    bool levels_equal(const atlas_mip_chain& a, const atlas_mip_chain& b) {
+        if (a.level_count() != b.level_count()) return false;
+        for (int level = 1; level <= a.level_count(); ++level) {
+            std::size_t n = static_cast<std::size_t>(a.level_width(level)) *
+                            static_cast<std::size_t>(a.level_height(level));
+            if (std::memcmp(a.level_data(level), b.level_data(level), n) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST_SUITE("atlas_mipmap") {
+
+    TEST_CASE("level dimensions") {
+        atlas_mip_chain chain(64, 32, 10);
+
+        // Stops once the smallest level is 1x1
+        CHECK(chain.level_count() == 6);
+        CHECK(chain.level_width(0) == 64);
+        CHECK(chain.level_width(1) == 32);
+        CHECK(chain.level_height(1) == 16);
+        CHECK(chain.level_width(5) == 2);
+        CHECK(chain.level_height(5) == 1);
+        CHECK(chain.level_width(6) == 1);
+        CHECK(chain.level_height(6) == 1);
+
+        CHECK_THROWS_AS((void)chain.level_data(0), std::out_of_range);
+        CHECK_THROWS_AS((void)chain.level_data(7), std::out_of_range);
+    }
+
+    TEST_CASE("box filter averages 2x2 blocks") {
+        const uint8_t base[16] = {
+            0, 255, 10, 10,
+            255, 0, 10, 10,
+            100, 100, 0, 0,
+            100, 100, 0, 4
+        };
+
+        atlas_mip_chain chain(4, 4, 2);
+        chain.rebuild(base, 4);
+
+        const uint8_t* l1 = chain.level_data(1);
+        CHECK(l1[0] == 128);  // (0 + 255 + 255 + 0 + 2) / 4
+        CHECK(l1[1] == 10);
+        CHECK(l1[2] == 100);
+        CHECK(l1[3] == 1);
+
+        const uint8_t* l2 = chain.level_data(2);
+        CHECK(l2[0] == 60);  // (128 + 10 + 100 + 1 + 2) / 4
+    }
+
+    TEST_CASE("incremental update matches full rebuild") {
+        memory_atlas atlas(128, 96);
+        atlas_mip_chain incremental(128, 96, 4);
+
+        std::vector<uint8_t> glyph(9 * 11);
+        for (std::size_t i = 0; i < glyph.size(); ++i) {
+            glyph[i] = static_cast<uint8_t>(i * 37);
+        }
+
+        atlas.write_alpha(5, 7, 9, 11, glyph.data(), 9);
+        atlas.write_alpha(70, 40, 9, 11, glyph.data(), 9);
+        glyph_rect first = incremental.update(atlas);
+        CHECK(first.w > 0);
+
+        atlas_mip_chain full(128, 96, 4);
+        full.rebuild(atlas.data(), atlas.width());
+        CHECK(levels_equal(incremental, full));
+
+        // Second batch touches a single tile
+        atlas.write_alpha(100, 80, 9, 11, glyph.data(), 9);
+        glyph_rect second = incremental.update(atlas);
+        CHECK(second.x == 96);
+        CHECK(second.y == 80);
+        CHECK(second.w == memory_atlas::dirty_tile_size);
+
+        full.rebuild(atlas.data(), atlas.width());
+        CHECK(levels_equal(incremental, full));
+
+        // Nothing new
+        CHECK(incremental.update(atlas).w == 0);
+    }
+
+    TEST_CASE("mip-aligned packing keeps glyphs in separate blocks") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto source = font_source::from_bitmap(font);
+
+        glyph_cache_config config;
+        config.atlas_size = 128;
+        config.mip_levels = 2;
+        config.pre_cache_ascii = false;
+        glyph_cache<memory_atlas> cache(std::move(source), 12.0f, config);
+        cache.cache_range('!', '~');
+
+        const int block = 1 << config.mip_levels;
+        struct footprint { int page, x0, y0, x1, y1; };
+        std::vector<footprint> placed;
+
+        for (char32_t cp = '!'; cp <= '~'; ++cp) {
+            const auto& g = cache.get(cp);
+            if (g.rect.w == 0) continue;
+
+            CHECK(g.rect.x % block == 0);
+            CHECK(g.rect.y % block == 0);
+            placed.push_back({g.atlas_index,
+                              g.rect.x / block, g.rect.y / block,
+                              (g.rect.x + g.rect.w + block - 1) / block,
+                              (g.rect.y + g.rect.h + block - 1) / block});
+        }
+        REQUIRE(placed.size() > 10);
+
+        // Footprints in block units must be separated by at least one block
+        for (std::size_t i = 0; i < placed.size(); ++i) {
+            for (std::size_t j = i + 1; j < placed.size(); ++j) {
+                const auto& a = placed[i];
+                const auto& b = placed[j];
+                if (a.page != b.page) continue;
+                bool apart = a.x1 < b.x0 || b.x1 < a.x0 || a.y1 < b.y0 || b.y1 < a.y0;
+                CHECK(apart);
+            }
+        }
+    }
+
+    TEST_CASE("update follows a page replaced by clear()") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        glyph_cache_config config;
+        config.atlas_size = 128;
+        config.pre_cache_ascii = false;
+        glyph_cache<memory_atlas> cache(font_source::from_vector(font), 32.0f, config);
+        atlas_mip_chain chain(128, 128, 4);
+
+        for (char32_t cp = 'A'; cp <= 'H'; ++cp) {
+            (void)cache.get(cp);
+        }
+        (void)chain.update(cache.atlas(0));
+
+        // The new page restarts at a lower revision than the one seen
+        cache.clear();
+        (void)cache.get('i');
+        glyph_rect changed = chain.update(cache.atlas(0));
+        CHECK(changed.w == 128);
+        CHECK(changed.h == 128);
+
+        atlas_mip_chain expected(128, 128, 4);
+        expected.rebuild(cache.atlas(0).data(), cache.atlas(0).stride());
+        CHECK(levels_equal(chain, expected));
+
+        // Tracking resumes on the new page
+        CHECK(chain.update(cache.atlas(0)).w == 0);
+    }
+}
@@ -0,0 +1,225 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for BC4 encoder
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/bc4_encoder.hh>
+#include <onyx_font/text/glyph_cache.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    int max_abs_diff(const uint8_t* a, const uint8_t* b, std::size_t n) {
+        int result = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            result = std::max(result, std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])));
+        }
+        return result;
+    }
+}
+
+TEST_SUITE("bc4_encoder") {
+
+    TEST_CASE("constant block is exact") {
+        uint8_t pixels[16];
+        std::fill(std::begin(pixels), std::end(pixels), static_cast<uint8_t>(77));
+
+        uint8_t block[bc4_block_bytes];
+        bc4_encode_block(pixels, 4, block);
+
+        uint8_t decoded[16] = {};
+        bc4_decode_block(block, decoded, 4);
+        CHECK(max_abs_diff(pixels, decoded, 16) == 0);
+    }
+
+    TEST_CASE("binary block is exact") {
+        uint8_t pixels[16];
+        for (int i = 0; i < 16; ++i) {
+            pixels[i] = (i % 3 == 0) ? 255 : 0;
+        }
+
+        uint8_t block[bc4_block_bytes];
+        bc4_encode_block(pixels, 4, block);
+
+        uint8_t decoded[16] = {};
+        bc4_decode_block(block, decoded, 4);
+        CHECK(max_abs_diff(pixels, decoded, 16) == 0);
+    }
+
+    TEST_CASE("antialiased edge keeps 0 and 255 exact") {
+        // Typical glyph edge: background, coverage ramp, solid interior
+        uint8_t pixels[16] = {
+            0, 0, 40, 255,
+            0, 0, 90, 255,
+            0, 10, 140, 255,
+            0, 20, 200, 255
+        };
+
+        uint8_t block[bc4_block_bytes];
+        bc4_encode_block(pixels, 4, block);
+
+        uint8_t decoded[16] = {};
+        bc4_decode_block(block, decoded, 4);
+        for (int i = 0; i < 16; ++i) {
+            if (pixels[i] == 0 || pixels[i] == 255) {
+                CHECK(decoded[i] == pixels[i]);
+            }
+        }
+        CHECK(max_abs_diff(pixels, decoded, 16) <= 24);
+    }
+
+    TEST_CASE("gradient error is bounded") {
+        uint8_t pixels[16];
+        for (int i = 0; i < 16; ++i) {
+            pixels[i] = static_cast<uint8_t>(60 + i * 8);
+        }
+
+        uint8_t block[bc4_block_bytes];
+        bc4_encode_block(pixels, 4, block);
+
+        uint8_t decoded[16] = {};
+        bc4_decode_block(block, decoded, 4);
+
+        // 8 levels over a range of 120 -> at most half a step of error
+        CHECK(max_abs_diff(pixels, decoded, 16) <= 120 / 14 + 1);
+    }
+
+    TEST_CASE("simd path matches scalar reference") {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> dist(0, 255);
+        std::uniform_int_distribution<int> pick(0, 3);
+
+        for (int n = 0; n < 2000; ++n) {
+            uint8_t pixels[16];
+            for (auto& p : pixels) {
+                // Mix random, clamped and narrow-range values
+                switch (pick(rng)) {
+                    case 0: p = 0; break;
+                    case 1: p = 255; break;
+                    case 2: p = static_cast<uint8_t>(100 + dist(rng) % 8); break;
+                    default: p = static_cast<uint8_t>(dist(rng)); break;
+                }
+            }
+
+            uint8_t fast[bc4_block_bytes];
+            uint8_t reference[bc4_block_bytes];
+            bc4_encode_block(pixels, 4, fast);
+            bc4_encode_block_scalar(pixels, 4, reference);
+            CHECK(std::equal(std::begin(fast), std::end(fast), std::begin(reference)));
+        }
+    }
+
+    TEST_CASE("image round trip with partial blocks") {
+        const int w = 37;
+        const int h = 21;
+        std::vector<uint8_t> src(static_cast<std::size_t>(w * h));
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                int d = (x - 18) * (x - 18) + (y - 10) * (y - 10);
+                src[static_cast<std::size_t>(y * w + x)] =
+                    static_cast<uint8_t>(std::clamp(255 - (d - 40) * 8, 0, 255));
+            }
+        }
+
+        bc4_image image(w, h);
+        CHECK(image.blocks_x() == 10);
+        CHECK(image.blocks_y() == 6);
+        CHECK(image.size_bytes() == 10u * 6u * bc4_block_bytes);
+
+        image.encode(src.data(), w);
+
+        std::vector<uint8_t> decoded(src.size(), 0);
+        image.decode(decoded.data(), w);
+
+        long long sq = 0;
+        for (std::size_t i = 0; i < src.size(); ++i) {
+            int d = static_cast<int>(src[i]) - static_cast<int>(decoded[i]);
+            sq += d * d;
+        }
+        double mse = static_cast<double>(sq) / static_cast<double>(src.size());
+        CHECK(mse < 20.0);
+        CHECK(max_abs_diff(src.data(), decoded.data(), src.size()) <= 32);
+    }
+
+    TEST_CASE("update re-encodes only dirty tiles") {
+        memory_atlas atlas(64, 64);
+        bc4_image image(64, 64);
+
+        // Fresh atlas: nothing to do
+        glyph_rect none = image.update(atlas);
+        CHECK(none.w == 0);
+        CHECK(none.h == 0);
+
+        std::vector<uint8_t> glyph(6 * 5, 200);
+        atlas.write_alpha(40, 20, 6, 5, glyph.data(), 6);
+
+        glyph_rect changed = image.update(atlas);
+        CHECK(changed.x <= 40);
+        CHECK(changed.y <= 20);
+        CHECK(changed.x + changed.w >= 46);
+        CHECK(changed.y + changed.h >= 25);
+        CHECK(changed.x % 4 == 0);
+        CHECK(changed.y % 4 == 0);
+        // Only the touched tile, not the whole page
+        CHECK(changed.w <= memory_atlas::dirty_tile_size);
+        CHECK(changed.h <= memory_atlas::dirty_tile_size);
+
+        std::vector<uint8_t> decoded(64 * 64, 0);
+        image.decode(decoded.data(), 64);
+        CHECK(decoded[22 * 64 + 42] == 200);
+        CHECK(decoded[0] == 0);
+
+        // Nothing changed since the last update
+        glyph_rect again = image.update(atlas);
+        CHECK(again.w == 0);
+    }
+
+    TEST_CASE("update rejects mismatched size") {
+        memory_atlas atlas(32, 32);
+        bc4_image image(64, 64);
+        CHECK_THROWS(image.update(atlas));
+    }
+
+    TEST_CASE("update follows a page replaced by clear()") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        glyph_cache_config config;
+        config.atlas_size = 128;
+        config.pre_cache_ascii = false;
+        glyph_cache<memory_atlas> cache(font_source::from_vector(font), 32.0f, config);
+        bc4_image image(128, 128);
+
+        for (char32_t cp = 'A'; cp <= 'H'; ++cp) {
+            (void)cache.get(cp);
+        }
+        (void)image.update(cache.atlas(0));
+
+        // The new page restarts at a lower revision than the one seen
+        cache.clear();
+        (void)cache.get('i');
+        glyph_rect changed = image.update(cache.atlas(0));
+        CHECK(changed.w == 128);
+        CHECK(changed.h == 128);
+
+        bc4_image expected(128, 128);
+        expected.encode(cache.atlas(0).data(), cache.atlas(0).stride());
+        std::vector<uint8_t> got(128 * 128, 0);
+        std::vector<uint8_t> want(128 * 128, 0);
+        image.decode(got.data(), 128);
+        expected.decode(want.data(), 128);
+        CHECK(got == want);
+
+        // Tracking resumes on the new page
+        CHECK(image.update(cache.atlas(0)).w == 0);
+    }
+}
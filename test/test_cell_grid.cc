@@ -0,0 +1,181 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for cell_grid
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/cell_grid.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <algorithm>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    constexpr uint32_t white = 0xFFFFFFFF;
+    constexpr uint32_t black = 0xFF000000;
+    constexpr uint32_t blue = 0xFF0000AA;
+
+    struct canvas {
+        std::vector<uint32_t> pixels;
+        cell_target target;
+
+        explicit canvas(const cell_grid& grid)
+            : pixels(static_cast<std::size_t>(grid.pixel_width() * grid.pixel_height()), 0) {
+            target = {pixels.data(), grid.pixel_width(), grid.pixel_height(), grid.pixel_width()};
+        }
+
+        /// Pixels of one cell
+        std::vector<uint32_t> cell(const cell_grid& grid, int column, int row) const {
+            std::vector<uint32_t> out;
+            for (int y = 0; y < grid.cell_height(); ++y) {
+                auto begin = pixels.begin() + (row * grid.cell_height() + y) * target.stride +
+                             column * grid.cell_width();
+                out.insert(out.end(), begin, begin + grid.cell_width());
+            }
+            return out;
+        }
+    };
+}
+
+TEST_SUITE("cell_grid") {
+    TEST_CASE("fixed-pitch fonts give the cell size") {
+        auto data = test_data::load_fon_vgaoem();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto source = font_source::from_bitmap(font);
+        cell_grid grid(source, 16.0f, 80, 25);
+
+        CHECK(grid.columns() == 80);
+        CHECK(grid.rows() == 25);
+        CHECK(grid.cell_width() > 0);
+        CHECK(grid.cell_height() > 0);
+        CHECK(grid.pixel_width() == 80 * grid.cell_width());
+        CHECK(grid.cells().size() == 80 * 25);
+
+        CHECK_THROWS_AS(cell_grid(source, 16.0f, -1, 2), std::invalid_argument);
+    }
+
+    TEST_CASE("proportional fonts are rejected") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+        auto source = font_source::from_vector(font);
+        CHECK_THROWS_AS(cell_grid(source, 16.0f, 10, 10), std::invalid_argument);
+    }
+
+    TEST_CASE("only changed cells are drawn") {
+        auto data = test_data::load_fon_vgaoem();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto source = font_source::from_bitmap(font);
+        cell_grid grid(source, 16.0f, 10, 4);
+        canvas c(grid);
+
+        CHECK(grid.write(0, 0, "Hello", white, black) == 5);
+        CHECK(grid.render(c.target) == 40);   // first frame: everything
+        CHECK(grid.render(c.target) == 0);    // unchanged frame
+
+        // Blank cells are pure background
+        auto blank = c.cell(grid, 7, 2);
+        CHECK(std::all_of(blank.begin(), blank.end(), [](uint32_t p) { return p == black; }));
+
+        // A glyph has both colors
+        auto h = c.cell(grid, 0, 0);
+        CHECK(std::count(h.begin(), h.end(), white) > 0);
+        CHECK(std::count(h.begin(), h.end(), black) > 0);
+
+        grid.at(1, 0).fg = blue;
+        CHECK(grid.render(c.target) == 1);
+        auto e = c.cell(grid, 1, 0);
+        CHECK(std::count(e.begin(), e.end(), blue) > 0);
+        CHECK(std::count(e.begin(), e.end(), white) == 0);
+
+        // Writing the same content again draws nothing
+        grid.write(2, 0, "llo", white, black);
+        CHECK(grid.render(c.target) == 0);
+
+        grid.invalidate();
+        CHECK(grid.render(c.target) == 40);
+    }
+
+    TEST_CASE("attributes") {
+        auto data = test_data::load_fon_vgaoem();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto source = font_source::from_bitmap(font);
+        cell_grid grid(source, 16.0f, 4, 1);
+        canvas c(grid);
+
+        grid.write(0, 0, "AAAA", white, black);
+        grid.at(1, 0).attrs = cell_attr::inverse;
+        grid.at(2, 0).attrs = cell_attr::bold;
+        grid.at(3, 0).attrs = cell_attr::hidden;
+        grid.render(c.target);
+
+        auto normal = c.cell(grid, 0, 0);
+        auto inverse = c.cell(grid, 1, 0);
+        auto bold = c.cell(grid, 2, 0);
+        auto hidden = c.cell(grid, 3, 0);
+        for (std::size_t i = 0; i < normal.size(); ++i) {
+            CHECK(inverse[i] == (normal[i] == white ? black : white));
+        }
+        CHECK(std::count(bold.begin(), bold.end(), white) >= std::count(normal.begin(), normal.end(), white));
+        CHECK(std::all_of(hidden.begin(), hidden.end(), [](uint32_t p) { return p == black; }));
+
+        grid.at(3, 0).attrs = cell_attr::underline;
+        grid.at(3, 0).codepoint = U' ';
+        grid.render(c.target);
+        auto underline = c.cell(grid, 3, 0);
+        CHECK(std::count(underline.begin(), underline.end(), white) == grid.cell_width());
+    }
+
+    TEST_CASE("scrolling moves pixel rows") {
+        auto data = test_data::load_fon_vgaoem();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto source = font_source::from_bitmap(font);
+        cell_grid grid(source, 16.0f, 6, 3);
+        canvas c(grid);
+
+        grid.write(0, 0, "first", white, black);
+        grid.write(0, 1, "second", white, black);
+        grid.write(0, 2, "third", white, black);
+        grid.render(c.target);
+        auto second = c.cell(grid, 0, 1);
+
+        grid.scroll(1);
+        CHECK(grid.at(0, 0).codepoint == U's');
+        CHECK(grid.at(0, 2).codepoint == U' ');
+        CHECK(grid.render(c.target) == 6);     // only the row scrolled in
+        CHECK(c.cell(grid, 0, 0) == second);
+
+        grid.write(0, 2, "fourth", white, black);
+        CHECK(grid.render(c.target) == 6);
+
+        grid.scroll(-1);
+        CHECK(grid.at(0, 1).codepoint == U's');
+        CHECK(grid.render(c.target) == 6);
+        CHECK(c.cell(grid, 0, 1) == second);
+
+        // Scrolling everything away redraws everything
+        grid.scroll(3);
+        CHECK(grid.render(c.target) == 18);
+    }
+
+    TEST_CASE("resize keeps the overlap") {
+        auto data = test_data::load_fon_vgaoem();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto source = font_source::from_bitmap(font);
+        cell_grid grid(source, 16.0f, 4, 2);
+        grid.write(0, 1, "abcd", white, black);
+
+        grid.resize(2, 3);
+        CHECK(grid.cells().size() == 6);
+        CHECK(grid.at(0, 1).codepoint == U'a');
+        CHECK(grid.at(1, 1).codepoint == U'b');
+        CHECK(grid.at(0, 2).codepoint == U' ');
+
+        canvas c(grid);
+        CHECK_THROWS_AS(grid.render(cell_target{c.pixels.data(), 1, 1, 1}), std::invalid_argument);
+        CHECK(grid.render(c.target) == 6);
+    }
+}
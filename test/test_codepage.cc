@@ -0,0 +1,128 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for codepage tables and their use by font_source
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/utils/codepage.hh>
+#include <onyx_font/text/font_source.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+TEST_SUITE("codepage") {
+    TEST_CASE("CP437 decodes PC graphics and box drawing") {
+        const auto& cp437 = codepage_table::get(codepage::cp437);
+        CHECK(cp437.id() == codepage::cp437);
+
+        CHECK(cp437.decode('A') == U'A');
+        CHECK(cp437.decode(0x01) == U'☺');
+        CHECK(cp437.decode(0x7F) == U'⌂');
+        CHECK(cp437.decode(0x82) == U'é');
+        CHECK(cp437.decode(0xC9) == U'╔');
+        CHECK(cp437.decode(0xFF) == 0x00A0);
+
+        CHECK(cp437.encode(U'é') == std::optional<uint8_t>(0x82));
+        CHECK(cp437.encode(U'╔') == std::optional<uint8_t>(0xC9));
+        CHECK(cp437.encode(U'☺') == std::optional<uint8_t>(0x01));
+        CHECK(cp437.encode(0x01) == std::optional<uint8_t>(0x01));  // control codes stay raw
+        CHECK(cp437.encode(0) == std::optional<uint8_t>(0));
+        CHECK_FALSE(cp437.encode(U'€').has_value());
+        CHECK_FALSE(cp437.encode(U'中').has_value());
+    }
+
+    TEST_CASE("every byte round-trips") {
+        for (auto cp : {codepage::cp437, codepage::cp850, codepage::cp866,
+                        codepage::cp1250, codepage::cp1251, codepage::cp1252}) {
+            const auto& table = codepage_table::get(cp);
+            CHECK(table.memory_usage() < 16 * 1024);
+            for (int b = 0; b < 256; ++b) {
+                const auto byte = static_cast<uint8_t>(b);
+                auto back = table.encode(table.decode(byte));
+                REQUIRE(back.has_value());
+                // CP850 has pilcrow and section sign in both halves
+                if (cp == codepage::cp850 && (b == 0x14 || b == 0x15)) {
+                    CHECK(*back >= 0x80);
+                } else {
+                    CHECK(*back == byte);
+                }
+            }
+        }
+    }
+
+    TEST_CASE("Windows codepages") {
+        CHECK(codepage_table::get(codepage::cp1252).encode(U'€') == std::optional<uint8_t>(0x80));
+        CHECK(codepage_table::get(codepage::cp1252).decode(0xE9) == U'é');
+        CHECK(codepage_table::get(codepage::cp1251).encode(U'Ж') == std::optional<uint8_t>(0xC6));
+        CHECK(codepage_table::get(codepage::cp1250).encode(U'ř') == std::optional<uint8_t>(0xF8));
+        CHECK(codepage_table::get(codepage::cp866).encode(U'Ж') == std::optional<uint8_t>(0x86));
+        CHECK(codepage_table::get(codepage::cp1252).decode(0x01) == 0x01);
+    }
+
+    TEST_CASE("Windows charsets select a codepage") {
+        CHECK(codepage_table::from_windows_charset(0) == codepage::cp1252);
+        CHECK(codepage_table::from_windows_charset(204) == codepage::cp1251);
+        CHECK(codepage_table::from_windows_charset(238) == codepage::cp1250);
+        CHECK(codepage_table::from_windows_charset(255) == codepage::cp437);
+        CHECK_FALSE(codepage_table::from_windows_charset(2).has_value());  // SYMBOL_CHARSET
+    }
+
+    TEST_CASE("font_source maps Unicode to CP437 glyphs of a raw font") {
+        // Glyph N is filled with byte N
+        std::vector<uint8_t> data;
+        for (int ch = 0; ch < 256; ++ch) {
+            data.insert(data.end(), 8, static_cast<uint8_t>(ch));
+        }
+        auto font = font_factory::load_raw(data, raw_font_options::vga_8x8());
+        CHECK(font.get_codepage() == codepage::cp437);
+
+        auto source = font_source::from_bitmap(font);
+        REQUIRE(source.encoding() != nullptr);
+        CHECK(source.encoding()->id() == codepage::cp437);
+        CHECK(source.has_glyph(U'╔'));
+        CHECK(source.has_glyph(U'é'));
+        CHECK_FALSE(source.has_glyph(U'€'));
+        CHECK(source.default_char() == U'?');
+
+        // First row of the rendered glyph is the byte it came from
+        auto first_row = [&source](char32_t codepoint) {
+            std::vector<uint8_t> row(8, 0);
+            callback_target target(8, 8, [&row](int x, int y, uint8_t alpha) {
+                if (y == 0 && alpha > 0) row[static_cast<std::size_t>(x)] = 1;
+            });
+            source.rasterize_glyph(codepoint, 8.0f, target, 0, 8);
+            uint8_t bits = 0;
+            for (std::size_t x = 0; x < 8; ++x) {
+                bits = static_cast<uint8_t>(bits << 1 | row[x]);
+            }
+            return bits;
+        };
+        CHECK(first_row(U'é') == 0x82);
+        CHECK(first_row(U'╔') == 0xC9);
+        CHECK(first_row(U'☺') == 0x01);
+
+        // Without a table codepoints are raw character codes
+        source.set_encoding(nullptr);
+        CHECK(first_row(0x82) == 0x82);
+        CHECK(first_row(U'é') == 0xE9);
+    }
+
+    TEST_CASE("Windows fonts pick the codepage from their charset") {
+        if (!test_data::file_exists(test_data::fon_vgaoem())) {
+            WARN("VGAOEM.FON not available - skipping test");
+            return;
+        }
+        auto data = test_data::load_fon_vgaoem();
+        auto font = font_factory::load_bitmap(data, 0);
+        CHECK(font.get_codepage() == codepage::cp437);
+
+        auto source = font_source::from_bitmap(font);
+        REQUIRE(source.encoding() != nullptr);
+        CHECK(source.has_glyph(U'─'));
+        CHECK(source.get_glyph_metrics(U'─', 16.0f).advance_x > 0);
+    }
+}
@@ -0,0 +1,64 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for codepoint_index
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/utils/codepoint_index.hh>
+#include <stdexcept>
+
+using namespace onyx_font;
+
+TEST_SUITE("codepoint_index") {
+    TEST_CASE("empty index finds nothing") {
+        codepoint_index index;
+        CHECK(index.empty());
+        CHECK(index.find(U'A') == codepoint_index::npos);
+        CHECK(index.find(0x10FFFF) == codepoint_index::npos);
+        CHECK(index.page_count() == 0);
+    }
+
+    TEST_CASE("insert and find") {
+        codepoint_index index;
+        CHECK(index.insert(U'A', 65));
+        CHECK(index.insert(U'中', 1234));
+        CHECK(index.insert(0x1F600, 7));
+
+        CHECK(index.size() == 3);
+        CHECK(index.min_codepoint() == U'A');
+        CHECK(index.max_codepoint() == 0x1F600);
+        CHECK(index.find(U'A') == 65);
+        CHECK(index.find(U'中') == 1234);
+        CHECK(index.find(0x1F600) == 7);
+        CHECK_FALSE(index.contains(U'B'));
+        CHECK_FALSE(index.contains(U'丮'));
+
+        // The first mapping wins
+        CHECK_FALSE(index.insert(U'A', 99));
+        CHECK(index.find(U'A') == 65);
+
+        CHECK_THROWS_AS(index.insert(0x110000, 1), std::invalid_argument);
+        CHECK_THROWS_AS(index.insert(U'C', codepoint_index::npos), std::invalid_argument);
+    }
+
+    TEST_CASE("pages are allocated only where mappings are") {
+        codepoint_index index;
+        index.insert_range(0x4E00, 0x9FFF, 0);  // CJK Unified Ideographs
+
+        CHECK(index.size() == 0x5200);
+        CHECK(index.find(0x4E00) == 0);
+        CHECK(index.find(0x9FFF) == 0x51FF);
+        CHECK(index.find(0x4DFF) == codepoint_index::npos);
+        CHECK(index.find(0xA000) == codepoint_index::npos);
+
+        // 82 blocks plus the shared empty page
+        CHECK(index.page_count() == 83);
+        CHECK(index.memory_usage() < 0x5200 * 8);
+
+        index.clear();
+        CHECK(index.empty());
+        CHECK(index.max_codepoint() == 0);
+        CHECK(index.find(0x4E00) == codepoint_index::npos);
+    }
+}
@@ -0,0 +1,231 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for cow_atlas, atlas_snapshot and glyph_cache snapshots
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/cow_atlas.hh>
+#include <onyx_font/text/glyph_cache.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <thread>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+TEST_SUITE("cow_atlas") {
+    TEST_CASE("construction") {
+        cow_atlas atlas(100, 70, 32);
+        CHECK(atlas.width() == 100);
+        CHECK(atlas.height() == 70);
+        CHECK(atlas.tile_size() == 32);
+        CHECK(atlas.revision() == 0);
+        CHECK(atlas.tiles_allocated() == 0);
+        CHECK(atlas.pixel(50, 50) == 0);
+
+        CHECK_THROWS_AS(cow_atlas(10, 10, 0), std::invalid_argument);
+        CHECK_THROWS_AS(cow_atlas(-1, 10), std::invalid_argument);
+    }
+
+    TEST_CASE("write across tiles") {
+        cow_atlas atlas(100, 70, 32);
+        std::vector<uint8_t> pixels(40 * 10);
+        for (std::size_t i = 0; i < pixels.size(); ++i) {
+            pixels[i] = static_cast<uint8_t>(i % 251 + 1);
+        }
+        atlas.write_alpha(20, 28, 40, 10, pixels.data(), 40);
+
+        // Spans tile columns 0-1 and rows 0-1
+        CHECK(atlas.tiles_allocated() == 4);
+        CHECK(atlas.revision() == 1);
+        for (int y = 0; y < 10; ++y) {
+            for (int x = 0; x < 40; ++x) {
+                REQUIRE(atlas.pixel(20 + x, 28 + y) == pixels[static_cast<std::size_t>(y * 40 + x)]);
+            }
+        }
+        CHECK(atlas.pixel(19, 28) == 0);
+        CHECK(atlas.pixel(60, 28) == 0);
+    }
+
+    TEST_CASE("write is clipped") {
+        cow_atlas atlas(40, 40, 16);
+        std::vector<uint8_t> pixels(20 * 20, 9);
+        atlas.write_alpha(30, -5, 20, 20, pixels.data(), 20);
+        CHECK(atlas.pixel(39, 0) == 9);
+        CHECK(atlas.pixel(30, 14) == 9);
+        CHECK(atlas.pixel(30, 15) == 0);
+
+        atlas.write_alpha(50, 50, 20, 20, pixels.data(), 20);
+        CHECK(atlas.revision() == 1);
+    }
+
+    TEST_CASE("snapshot is immutable") {
+        cow_atlas atlas(64, 64, 16);
+        std::vector<uint8_t> a(16 * 16, 1);
+        std::vector<uint8_t> b(16 * 16, 2);
+        atlas.write_alpha(0, 0, 16, 16, a.data(), 16);
+        atlas.write_alpha(16, 0, 16, 16, a.data(), 16);
+
+        auto snap = atlas.snapshot();
+        CHECK(snap.revision() == 2);
+
+        atlas.write_alpha(0, 0, 16, 16, b.data(), 16);
+        CHECK(atlas.pixel(0, 0) == 2);
+        CHECK(snap.pixel(0, 0) == 1);
+        CHECK(snap.pixel(16, 0) == 1);
+
+        // Only the modified tile was copied
+        CHECK(atlas.tiles_allocated() == 3);
+
+        // Without a live snapshot tiles are modified in place
+        snap = atlas_snapshot();
+        atlas.write_alpha(16, 0, 16, 16, b.data(), 16);
+        CHECK(atlas.tiles_allocated() == 3);
+        CHECK(atlas.pixel(16, 0) == 2);
+    }
+
+    TEST_CASE("snapshot tiles and regions") {
+        cow_atlas atlas(40, 40, 16);
+        std::vector<uint8_t> pixels(8 * 8, 7);
+        atlas.write_alpha(12, 12, 8, 8, pixels.data(), 8);
+
+        auto snap = atlas.snapshot();
+        CHECK(snap.tile(2, 2) == nullptr);
+        REQUIRE(snap.tile(0, 0) != nullptr);
+        CHECK(snap.tile(0, 0)[12 * 16 + 12] == 7);
+        CHECK(snap.tile(5, 0) == nullptr);
+
+        std::vector<uint8_t> region(12 * 12, 0xFF);
+        snap.copy_region({10, 10, 12, 12}, region.data(), 12);
+        for (int y = 0; y < 12; ++y) {
+            for (int x = 0; x < 12; ++x) {
+                bool inside = x >= 2 && x < 10 && y >= 2 && y < 10;
+                REQUIRE(region[static_cast<std::size_t>(y * 12 + x)] == (inside ? 7 : 0));
+            }
+        }
+
+        // Regions past the edge read as zero
+        std::vector<uint8_t> edge(8 * 8, 0xFF);
+        snap.copy_region({36, 36, 8, 8}, edge.data(), 8);
+        CHECK(edge[0] == 0);
+        CHECK(edge[63] == 0);
+    }
+
+    TEST_CASE("snapshot dirty tiles") {
+        cow_atlas atlas(40, 40, 16);
+        std::vector<uint8_t> pixels(4 * 4, 1);
+        atlas.write_alpha(0, 0, 4, 4, pixels.data(), 4);
+        uint64_t seen = atlas.snapshot().revision();
+
+        atlas.write_alpha(34, 34, 4, 4, pixels.data(), 4);
+        auto snap = atlas.snapshot();
+
+        std::vector<glyph_rect> dirty;
+        snap.for_each_dirty_tile(seen, [&](glyph_rect r) { dirty.push_back(r); });
+        REQUIRE(dirty.size() == 1);
+        CHECK(dirty[0].x == 32);
+        CHECK(dirty[0].y == 32);
+        CHECK(dirty[0].w == 8);
+        CHECK(dirty[0].h == 8);
+    }
+
+    TEST_CASE("clear keeps snapshot contents") {
+        cow_atlas atlas(32, 32, 16);
+        std::vector<uint8_t> pixels(4 * 4, 5);
+        atlas.write_alpha(0, 0, 4, 4, pixels.data(), 4);
+        auto snap = atlas.snapshot();
+        atlas.clear();
+        CHECK(atlas.pixel(0, 0) == 0);
+        CHECK(snap.pixel(0, 0) == 5);
+    }
+
+    TEST_CASE("snapshot released on another thread") {
+        cow_atlas atlas(64, 64, 16);
+        std::vector<uint8_t> pixels(16 * 16, 3);
+        atlas.write_alpha(0, 0, 16, 16, pixels.data(), 16);
+
+        auto snap = atlas.snapshot();
+        std::thread reader([s = std::move(snap)]() mutable {
+            int sum = 0;
+            for (int y = 0; y < 16; ++y) {
+                for (int x = 0; x < 16; ++x) {
+                    sum += s.pixel(x, y);
+                }
+            }
+            CHECK(sum == 3 * 256);
+            s = atlas_snapshot();
+        });
+
+        for (uint8_t v = 10; v < 50; ++v) {
+            std::vector<uint8_t> next(16 * 16, v);
+            atlas.write_alpha(0, 0, 16, 16, next.data(), 16);
+        }
+        reader.join();
+        CHECK(atlas.pixel(0, 0) == 49);
+    }
+}
+
+TEST_SUITE("glyph_cache snapshot") {
+    TEST_CASE("snapshot captures pages and glyphs") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        config.atlas_size = 128;
+        glyph_cache<cow_atlas> cache(font_source::from_bitmap(font), 12.0f, config);
+
+        const auto& a = cache.get('A');
+        auto snap = cache.snapshot();
+        CHECK(snap.generation() == cache.generation());
+        CHECK(snap.atlas_count() == 1);
+
+        const cached_glyph* sa = snap.find('A');
+        REQUIRE(sa != nullptr);
+        CHECK(sa->rect.x == a.rect.x);
+        CHECK(sa->rect.w == a.rect.w);
+        CHECK(snap.find('B') == nullptr);
+
+        // Pixels of the snapshot match the cache
+        for (int y = 0; y < a.rect.h; ++y) {
+            for (int x = 0; x < a.rect.w; ++x) {
+                REQUIRE(snap.atlas(0).pixel(a.rect.x + x, a.rect.y + y) ==
+                        cache.atlas(0).pixel(a.rect.x + x, a.rect.y + y));
+            }
+        }
+
+        // Later glyphs do not appear in the snapshot
+        (void)cache.get('B');
+        (void)cache.get(U'é');
+        CHECK(snap.find('B') == nullptr);
+        CHECK(cache.generation() > snap.generation());
+
+        auto next = cache.snapshot();
+        CHECK(next.find('A') != nullptr);
+        CHECK(next.find('B') != nullptr);
+        CHECK_THROWS_AS((void)next.atlas(5), std::out_of_range);
+    }
+
+    TEST_CASE("new pages after a snapshot") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        config.atlas_size = 32;
+        glyph_cache<cow_atlas> cache(font_source::from_bitmap(font), 12.0f, config);
+
+        auto empty = cache.snapshot();
+        cache.cache_range(32, 126);
+        auto full = cache.snapshot();
+
+        CHECK(empty.atlas_count() == 1);
+        CHECK(empty.find('A') == nullptr);
+        CHECK(full.atlas_count() == cache.atlas_count());
+        for (char32_t cp = 32; cp <= 126; ++cp) {
+            REQUIRE(full.find(cp) != nullptr);
+        }
+    }
+}
@@ -0,0 +1,260 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for font_bundle
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/font_bundle.hh>
+#include <onyx_font/font_converter.hh>
+#include "test_data.hh"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    bool same_glyphs(const bitmap_font& a, const bitmap_font& b) {
+        if (a.get_glyph_count() != b.get_glyph_count()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < a.get_glyph_count(); ++i) {
+            auto va = a.get_glyph_by_index(i);
+            auto vb = b.get_glyph_by_index(i);
+            if (va.width() != vb.width() || va.height() != vb.height()) {
+                return false;
+            }
+            for (uint16_t y = 0; y < va.height(); ++y) {
+                for (uint16_t x = 0; x < va.width(); ++x) {
+                    if (va.pixel(x, y) != vb.pixel(x, y)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    // True if the glyph pixels point into the bundle
+    bool glyphs_in(const bitmap_font& font, std::span<const uint8_t> bytes) {
+        auto row = font.get_glyph_by_index(0).row(0);
+        const auto* p = reinterpret_cast<const uint8_t*>(row.data());
+        return p >= bytes.data() && p < bytes.data() + bytes.size();
+    }
+}
+
+TEST_SUITE("font_bundle") {
+    TEST_CASE("empty bundle") {
+        font_bundle bundle(font_bundle_writer{}.serialize());
+        CHECK(bundle.size() == 0);
+        CHECK(bundle.atlas_count() == 0);
+        CHECK_FALSE(bundle.find("Helv").has_value());
+        CHECK_FALSE(bundle.find_atlas("ui").has_value());
+    }
+
+    TEST_CASE("bitmap fonts round-trip without copying glyphs") {
+        REQUIRE(test_data::file_exists(test_data::fon_helva()));
+
+        auto info = font_factory::analyze(test_data::fon_helva());
+        auto fonts = font_factory::load_all_bitmaps(test_data::load_fon_helva());
+        REQUIRE(fonts.size() == 3);
+
+        font_bundle_writer writer;
+        for (std::size_t i = 0; i < fonts.size(); ++i) {
+            writer.add_bitmap(fonts[i], info.fonts[i]);
+        }
+        auto bytes = writer.serialize();
+        CHECK(bytes.size() % 64 == 0);
+
+        font_bundle bundle(std::move(bytes));
+        REQUIRE(bundle.size() == 3);
+
+        auto face = bundle.find("HELV", 9);
+        REQUIRE(face.has_value());
+        CHECK(bundle.name(*face) == "Helv");
+        CHECK(bundle.entry(*face).type == font_type::BITMAP);
+        CHECK(bundle.entry(*face).pixel_height == 8);
+
+        auto font = bundle.load_bitmap(*face);
+        CHECK(font.get_name() == "Helv");
+        CHECK(font.get_first_char() == fonts[1].get_first_char());
+        CHECK(font.get_last_char() == fonts[1].get_last_char());
+        CHECK(font.get_codepage() == fonts[1].get_codepage());
+        CHECK(font.get_metrics().ascent == fonts[1].get_metrics().ascent);
+        CHECK(font.get_spacing('W').b_space == fonts[1].get_spacing('W').b_space);
+        CHECK(same_glyphs(font, fonts[1]));
+        CHECK(glyphs_in(font, bundle.data(*face)));
+    }
+
+    TEST_CASE("sparse Unicode index survives the round trip") {
+        REQUIRE(test_data::file_exists(test_data::ttf_arial()));
+
+        auto data = test_data::load_ttf_arial();
+        ttf_font ttf(data);
+        conversion_options opts;
+        opts.first_char = 0x20;
+        opts.last_char = 0x17F;
+        auto converted = font_converter::from_ttf(ttf, 12.0f, opts);
+        REQUIRE(converted.has_unicode_table());
+
+        font_bundle_writer writer;
+        writer.add_bitmap(converted);
+        font_bundle bundle(writer.serialize());
+
+        auto font = bundle.load_bitmap(0);
+        CHECK(font.has_unicode_table());
+        for (char32_t cp = 0x20; cp <= 0x17F; ++cp) {
+            CHECK(font.find_glyph(cp) == converted.find_glyph(cp));
+        }
+        CHECK(same_glyphs(font, converted));
+    }
+
+    TEST_CASE("vector and TrueType faces") {
+        REQUIRE(test_data::file_exists(test_data::bgi_litt()));
+        REQUIRE(test_data::file_exists(test_data::ttf_arial()));
+
+        auto litt = font_factory::load_vector(test_data::load_bgi_litt());
+        auto arial_data = test_data::load_ttf_arial();
+
+        font_bundle_writer writer;
+        writer.add_vector(litt);
+        writer.add_ttf(arial_data);
+        writer.add_ttf(arial_data);
+        font_bundle bundle(writer.serialize());
+        REQUIRE(bundle.size() == 3);
+
+        auto arial = bundle.find("arial");
+        REQUIRE(arial.has_value());
+        CHECK(bundle.entry(*arial).type == font_type::OUTLINE);
+        CHECK(bundle.data(*arial).size() == arial_data.size());
+        CHECK(bundle.data(0).data() == bundle.data(1).data());  // stored once
+
+        auto ttf = bundle.load_ttf(*arial);
+        CHECK(ttf.data().data() == bundle.data(*arial).data());
+        CHECK(ttf.has_glyph('A'));
+
+        auto vector_id = bundle.find(litt.get_name());
+        REQUIRE(vector_id.has_value());
+        auto vector = bundle.load_vector(*vector_id);
+        CHECK(vector.get_first_char() == litt.get_first_char());
+        CHECK(vector.get_last_char() == litt.get_last_char());
+        CHECK(vector.get_metrics().ascent == litt.get_metrics().ascent);
+        REQUIRE(vector.get_glyph('A') != nullptr);
+        CHECK(vector.get_glyph('A')->width == litt.get_glyph('A')->width);
+        CHECK(vector.get_glyph('A')->strokes.size() == litt.get_glyph('A')->strokes.size());
+
+        CHECK_THROWS_AS((void)bundle.load_bitmap(*arial), std::invalid_argument);
+        CHECK_THROWS_AS((void)bundle.load_ttf(*vector_id), std::invalid_argument);
+        CHECK_THROWS_AS((void)bundle.entry(3), std::out_of_range);
+    }
+
+    TEST_CASE("pre-rendered atlases") {
+        REQUIRE(test_data::file_exists(test_data::fon_helva()));
+
+        std::vector<uint8_t> pixels(40 * 8);
+        for (std::size_t i = 0; i < pixels.size(); ++i) {
+            pixels[i] = static_cast<uint8_t>(i);
+        }
+
+        font_bundle_writer writer;
+        auto helv = writer.add_bitmap(font_factory::load_bitmap(test_data::load_fon_helva(), 1));
+        writer.add_atlas("ui", helv, 8.0f, 32, 8, pixels, 40, {
+            {U'b', {8, 0, 8, 8}, 0, 7, 9},
+            {U'a', {0, 0, 8, 8}, 0, 7, 8}
+        });
+        font_bundle bundle(writer.serialize());
+
+        auto index = bundle.find_atlas("UI");
+        REQUIRE(index.has_value());
+        auto atlas = bundle.atlas(*index);
+        CHECK(atlas.name == "ui");
+        CHECK(atlas.font == bundle.find("Helv"));
+        CHECK(atlas.width == 32);
+        CHECK(atlas.height == 8);
+        REQUIRE(atlas.pixels.size() == 32 * 8);
+        CHECK(atlas.pixels[32 + 5] == pixels[40 + 5]);
+
+        REQUIRE(atlas.glyphs.size() == 2);
+        CHECK(atlas.glyphs[0].codepoint == U'a');
+        REQUIRE(atlas.find(U'b') != nullptr);
+        CHECK(atlas.find(U'b')->rect.x == 8);
+        CHECK(atlas.find(U'b')->advance_x == 9);
+        CHECK(atlas.find(U'c') == nullptr);
+
+        CHECK_THROWS_AS(writer.add_atlas("bad", std::nullopt, 8.0f, 32, 8, pixels, 40,
+                                         {{U'x', {30, 0, 8, 8}, 0, 0, 0}}),
+                        std::invalid_argument);
+    }
+
+    TEST_CASE("memory-mapped bundle file") {
+        REQUIRE(test_data::file_exists(test_data::fon_helva()));
+
+        auto original = font_factory::load_bitmap(test_data::load_fon_helva(), 2);
+        font_bundle_writer writer;
+        writer.add_bitmap(original);
+
+        auto path = std::filesystem::temp_directory_path() / "onyx_font_test_bundle.oxfb";
+        writer.save(path);
+
+        bitmap_font font;
+        {
+            auto bundle = font_bundle::open(path);
+            REQUIRE(bundle.size() == 1);
+            font = bundle.load_bitmap(0);
+            CHECK(glyphs_in(font, bundle.data(0)));
+        }
+        // The font keeps the mapping alive
+        CHECK(same_glyphs(font, original));
+
+        std::filesystem::remove(path);
+    }
+
+    TEST_CASE("corrupt bundles are rejected") {
+        REQUIRE(test_data::file_exists(test_data::fon_helva()));
+
+        font_bundle_writer writer;
+        writer.add_bitmap(font_factory::load_bitmap(test_data::load_fon_helva(), 0));
+        auto bytes = writer.serialize();
+
+        auto bad_magic = bytes;
+        bad_magic[0] = 'X';
+        CHECK_THROWS_AS(font_bundle{bad_magic}, std::runtime_error);
+
+        auto truncated = bytes;
+        truncated.resize(truncated.size() - 64);
+        CHECK_THROWS_AS(font_bundle{truncated}, std::runtime_error);
+
+        CHECK_THROWS_AS(font_bundle{std::vector<uint8_t>(16)}, std::runtime_error);
+    }
+
+    TEST_CASE("corrupt atlas glyphs are rejected") {
+        std::vector<uint8_t> pixels(16 * 8, 0xFF);
+        const baked_glyph a{U'a', {0, 0, 8, 8}, 0, 7, 8};
+        const baked_glyph b{U'b', {8, 0, 8, 8}, 0, 7, 8};
+
+        font_bundle_writer writer;
+        writer.add_atlas("ui", std::nullopt, 8.0f, 16, 8, pixels, 16, {a, b});
+        auto bytes = writer.serialize();
+        CHECK_NOTHROW(font_bundle{bytes});
+
+        // Locate the stored glyph records
+        const auto* first = reinterpret_cast<const uint8_t*>(&a);
+        auto it = std::search(bytes.begin(), bytes.end(), first, first + sizeof(baked_glyph));
+        REQUIRE(it != bytes.end());
+        const auto offset = static_cast<std::size_t>(it - bytes.begin());
+
+        auto outside = bytes;
+        baked_glyph moved = b;
+        moved.rect.x = 12;  // 12 + 8 > 16
+        std::memcpy(outside.data() + offset + sizeof(baked_glyph), &moved, sizeof(moved));
+        CHECK_THROWS_AS(font_bundle{outside}, std::runtime_error);
+
+        auto unsorted = bytes;
+        std::memcpy(unsorted.data() + offset, &b, sizeof(b));
+        std::memcpy(unsorted.data() + offset + sizeof(baked_glyph), &a, sizeof(a));
+        CHECK_THROWS_AS(font_bundle{unsorted}, std::runtime_error);
+    }
+}
@@ -0,0 +1,154 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for font_collection
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/font_collection.hh>
+#include "test_data.hh"
+#include <stdexcept>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+TEST_SUITE("font_collection") {
+    TEST_CASE("empty collection finds nothing") {
+        font_collection fonts;
+        CHECK(fonts.size() == 0);
+        CHECK_FALSE(fonts.find({.name = "Helv"}).has_value());
+        CHECK_THROWS_AS((void)fonts.entry(0), std::out_of_range);
+    }
+
+    TEST_CASE("indexes every face of a container") {
+        REQUIRE(test_data::file_exists(test_data::fon_helva()));
+
+        font_collection fonts;
+        CHECK(fonts.add(test_data::load_fon_helva()) == 3);
+        CHECK(fonts.size() == 3);
+
+        for (font_collection::face_id id = 0; id < fonts.size(); ++id) {
+            CHECK(fonts.entry(id).name == "Helv");
+            CHECK(fonts.entry(id).type == font_type::BITMAP);
+        }
+    }
+
+    TEST_CASE("picks the nearest bitmap strike") {
+        REQUIRE(test_data::file_exists(test_data::fon_helva()));
+
+        font_collection fonts;
+        fonts.add(test_data::load_fon_helva());
+
+        auto face = fonts.find({.name = "Helv", .pixel_height = 9});
+        REQUIRE(face.has_value());
+        CHECK(fonts.entry(*face).pixel_height == 8);
+
+        face = fonts.find({.name = "Helv", .pixel_height = 10});
+        REQUIRE(face.has_value());
+        CHECK(fonts.entry(*face).pixel_height == 10);
+
+        face = fonts.find({.name = "Helv", .pixel_height = 3});
+        REQUIRE(face.has_value());
+        CHECK(fonts.entry(*face).pixel_height == 6);
+
+        face = fonts.find({.name = "Helv", .pixel_height = 40});
+        REQUIRE(face.has_value());
+        CHECK(fonts.entry(*face).pixel_height == 10);
+    }
+
+    TEST_CASE("names are case-insensitive") {
+        REQUIRE(test_data::file_exists(test_data::fon_helva()));
+
+        font_collection fonts;
+        fonts.add(test_data::load_fon_helva());
+
+        CHECK(fonts.find({.name = "helv", .pixel_height = 8}) ==
+              fonts.find({.name = "HELV", .pixel_height = 8}));
+        CHECK(fonts.find({.name = "helv"}).has_value());
+        CHECK_FALSE(fonts.find({.name = "Courier"}).has_value());
+    }
+
+    TEST_CASE("falls back to the nearest weight and slant") {
+        REQUIRE(test_data::file_exists(test_data::fon_helva()));
+
+        font_collection fonts;
+        fonts.add(test_data::load_fon_helva());
+
+        auto face = fonts.find({.name = "Helv", .weight = 700, .italic = true, .pixel_height = 8});
+        REQUIRE(face.has_value());
+        CHECK(fonts.entry(*face).pixel_height == 8);
+        CHECK(fonts.entry(*face).weight == 400);
+        CHECK(fonts.entry(*face).italic == false);
+    }
+
+    TEST_CASE("indexes TrueType faces by family name") {
+        REQUIRE(test_data::file_exists(test_data::ttf_arial()));
+
+        font_collection fonts;
+        CHECK(fonts.add(test_data::ttf_arial()) == 1);
+
+        auto face = fonts.find({.name = "arial", .weight = 700, .pixel_height = 24});
+        REQUIRE(face.has_value());
+        CHECK(fonts.entry(*face).type == font_type::OUTLINE);
+        CHECK(fonts.entry(*face).weight == 400);
+    }
+
+    TEST_CASE("type restriction") {
+        REQUIRE(test_data::file_exists(test_data::fon_helva()));
+        REQUIRE(test_data::file_exists(test_data::ttf_arial()));
+
+        font_collection fonts;
+        fonts.add(test_data::load_fon_helva());
+        fonts.add(test_data::load_ttf_arial());
+
+        CHECK(fonts.find({.name = "Helv", .pixel_height = 8, .type = font_type::BITMAP}).has_value());
+        CHECK_FALSE(fonts.find({.name = "Helv", .pixel_height = 8, .type = font_type::OUTLINE}).has_value());
+        CHECK_FALSE(fonts.find({.name = "Arial", .pixel_height = 8, .type = font_type::BITMAP}).has_value());
+    }
+
+    TEST_CASE("faces load on first use") {
+        REQUIRE(test_data::file_exists(test_data::fon_helva()));
+        REQUIRE(test_data::file_exists(test_data::bgi_litt()));
+        REQUIRE(test_data::file_exists(test_data::ttf_arial()));
+
+        font_collection fonts;
+        fonts.add(test_data::fon_helva());
+        fonts.add(test_data::bgi_litt());
+        fonts.add(test_data::ttf_arial());
+        REQUIRE(fonts.size() == 5);
+
+        for (font_collection::face_id id = 0; id < fonts.size(); ++id) {
+            CHECK_FALSE(fonts.is_loaded(id));
+        }
+
+        auto helv = fonts.find({.name = "Helv", .pixel_height = 8});
+        REQUIRE(helv.has_value());
+        const auto& bitmap = fonts.get_bitmap(*helv);
+        CHECK(fonts.is_loaded(*helv));
+        CHECK(bitmap.get_metrics().pixel_height == 8);
+        CHECK(&fonts.get_bitmap(*helv) == &bitmap);
+        CHECK_FALSE(fonts.is_loaded(0));
+
+        const auto vector_id = fonts.size() - 2;
+        CHECK(fonts.entry(vector_id).type == font_type::VECTOR);
+        CHECK(fonts.get_vector(vector_id).has_glyph('A'));
+
+        auto arial = fonts.find({.name = "Arial"});
+        REQUIRE(arial.has_value());
+        font_source source = fonts.source(*arial);
+        CHECK(fonts.is_loaded(*arial));
+        CHECK(source.has_glyph('A'));
+    }
+
+    TEST_CASE("wrong type and bad ids throw") {
+        REQUIRE(test_data::file_exists(test_data::fon_helva()));
+
+        font_collection fonts;
+        fonts.add(test_data::load_fon_helva());
+
+        CHECK_THROWS_AS((void)fonts.get_vector(0), std::invalid_argument);
+        CHECK_THROWS_AS((void)fonts.get_ttf(0), std::invalid_argument);
+        CHECK_THROWS_AS((void)fonts.get_bitmap(3), std::out_of_range);
+        CHECK_THROWS_AS((void)fonts.is_loaded(3), std::out_of_range);
+    }
+}
@@ -7,6 +7,7 @@
 #include <doctest/doctest.h>
 #include <onyx_font/font_converter.hh>
 #include <onyx_font/font_factory.hh>
+#include <onyx_font/text/font_source.hh>
 #include "test_data.hh"
 
 using namespace onyx_font;
@@ -149,6 +150,40 @@ TEST_SUITE("font_converter") {
         }
     }
 
+    TEST_CASE("convert TTF font with a range past 255") {
+        if (!test_data::file_exists(test_data::ttf_arial())) {
+            WARN("Arial TTF not available - skipping test");
+            return;
+        }
+
+        auto data = test_data::load_ttf_arial();
+        ttf_font ttf(data);
+        REQUIRE(ttf.is_valid());
+        REQUIRE(ttf.has_glyph(U'Ж'));
+
+        conversion_options options;
+        options.first_char = U' ';
+        options.last_char = 0x04FF;  // Latin, Greek, Cyrillic
+
+        auto bitmap = font_converter::from_ttf(ttf, 16.0f, options);
+
+        CHECK(bitmap.has_unicode_table());
+        CHECK(bitmap.get_first_char() == U' ');
+        CHECK(bitmap.get_last_char() <= 0x04FF);
+        CHECK(bitmap.get_glyph_count() < 0x04FF - 0x20 + 1);  // gaps are skipped
+
+        CHECK(bitmap.get_glyph(U'A').width() > 0);
+        CHECK(bitmap.get_glyph(U'Ж').width() > 0);
+        CHECK(bitmap.get_spacing(U'Ж').b_space > 0);
+        CHECK(bitmap.has_glyph(U'Ж'));
+        CHECK_FALSE(bitmap.has_glyph(0x0378));  // unassigned
+
+        // Text rendering reaches the glyphs through font_source
+        auto source = font_source::from_bitmap(bitmap);
+        CHECK(source.has_glyph(U'Ж'));
+        CHECK(source.get_glyph_metrics(U'Ж', 16.0f).advance_x > 0);
+    }
+
     TEST_CASE("convert TTF font different sizes") {
         if (!test_data::file_exists(test_data::ttf_arial())) {
             WARN("Arial TTF not available - skipping test");
@@ -7,10 +7,105 @@
 #include <doctest/doctest.h>
 #include <onyx_font/font_factory.hh>
 #include "test_data.hh"
+#include <filesystem>
+#include <fstream>
 
 using namespace onyx_font;
 using namespace onyx_font::test;
 
+namespace {
+    // PSF1 font: 256 glyphs of 8x8, glyph N filled with byte N, Unicode table
+    // mapping glyph 'A' to U+0041 and U+0391 (Greek Alpha)
+    std::vector<uint8_t> make_psf1() {
+        std::vector<uint8_t> data = {0x36, 0x04, 0x02, 8};
+        for (int glyph = 0; glyph < 256; ++glyph) {
+            data.insert(data.end(), 8, static_cast<uint8_t>(glyph));
+        }
+        for (int glyph = 0; glyph < 256; ++glyph) {
+            auto put = [&data](uint16_t v) {
+                data.push_back(static_cast<uint8_t>(v & 0xFF));
+                data.push_back(static_cast<uint8_t>(v >> 8));
+            };
+            put(static_cast<uint16_t>(glyph));
+            if (glyph == 'A') {
+                put(0x0391);
+                put(0xFFFE);  // sequence: ignored
+                put(0x0041);
+                put(0x0301);
+            }
+            put(0xFFFF);
+        }
+        return data;
+    }
+
+    // PSF2 font: 300 glyphs of 10x4 (2 bytes per row), glyph 299 maps to U+4E2D
+    std::vector<uint8_t> make_psf2() {
+        auto put32 = [](std::vector<uint8_t>& out, uint32_t v) {
+            for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+        };
+        std::vector<uint8_t> data = {0x72, 0xB5, 0x4A, 0x86};
+        put32(data, 0);     // version
+        put32(data, 32);    // header size
+        put32(data, 1);     // flags: Unicode table
+        put32(data, 300);   // glyph count
+        put32(data, 8);     // bytes per glyph
+        put32(data, 4);     // height
+        put32(data, 10);    // width
+        for (int glyph = 0; glyph < 300; ++glyph) {
+            for (int row = 0; row < 4; ++row) {
+                data.push_back(glyph == 299 ? 0xFF : 0x00);
+                data.push_back(glyph == 299 ? 0xC0 : 0x00);
+            }
+        }
+        for (int glyph = 0; glyph < 300; ++glyph) {
+            if (glyph == '?') data.push_back('?');
+            if (glyph == 299) {
+                data.insert(data.end(), {0xE4, 0xB8, 0xAD});  // U+4E2D
+            }
+            data.push_back(0xFF);
+        }
+        return data;
+    }
+
+    // sfnt with only a name table holding a Windows English family name
+    std::vector<uint8_t> make_sfnt_named(const std::vector<uint16_t>& family) {
+        std::vector<uint8_t> data;
+        auto put16 = [&data](uint32_t v) {
+            data.push_back(static_cast<uint8_t>(v >> 8));
+            data.push_back(static_cast<uint8_t>(v));
+        };
+        auto put32 = [&put16](uint32_t v) {
+            put16(v >> 16);
+            put16(v & 0xFFFF);
+        };
+
+        const auto string_bytes = static_cast<uint32_t>(family.size() * 2);
+        put32(0x00010000);  // TrueType
+        put16(1);           // numTables
+        put16(16);
+        put16(0);
+        put16(0);
+        data.insert(data.end(), {'n', 'a', 'm', 'e'});
+        put32(0);           // checksum
+        put32(28);          // offset
+        put32(18 + string_bytes);
+
+        put16(0);           // format
+        put16(1);           // count
+        put16(18);          // string storage offset
+        put16(3);           // Windows
+        put16(1);           // Unicode BMP
+        put16(0x409);       // English (US)
+        put16(1);           // family
+        put16(string_bytes);
+        put16(0);
+        for (uint16_t unit : family) {
+            put16(unit);
+        }
+        return data;
+    }
+}
+
 TEST_SUITE("font_factory") {
 
     TEST_CASE("format_name returns valid strings") {
@@ -215,10 +310,20 @@ TEST_SUITE("font_factory") {
 
         const auto& font = info.fonts[0];
         CHECK(font.type == font_type::OUTLINE);
+        CHECK(font.name == "Arial");
         CHECK(font.weight == 400);
         CHECK(font.italic == false);
     }
 
+    TEST_CASE("analyze replaces unpaired surrogates in family names") {
+        // "A", high + 'B', lone low, U+1F600 as a pair, trailing high
+        auto data = make_sfnt_named({'A', 0xD800, 'B', 0xDC00, 0xD83D, 0xDE00, 0xD801});
+
+        auto info = font_factory::analyze(data);
+        REQUIRE(info.fonts.size() == 1);
+        CHECK(info.fonts[0].name == "A\xEF\xBF\xBD" "B\xEF\xBF\xBD\xF0\x9F\x98\x80\xEF\xBF\xBD");
+    }
+
     TEST_CASE("analyze VGAOEM FON file") {
         REQUIRE(test_data::file_exists(test_data::fon_vgaoem()));
 
@@ -547,11 +652,100 @@ TEST_SUITE("font_factory") {
         auto font = font_factory::load_raw(data, raw_font_options::vga_8x8());
 
         // All characters should have the same width (8)
-        // Use int to avoid uint8_t overflow when iterating to 255
-        for (int ch = font.get_first_char(); ch <= font.get_last_char(); ++ch) {
-            auto spacing = font.get_spacing(static_cast<uint8_t>(ch));
+        for (char32_t ch = font.get_first_char(); ch <= font.get_last_char(); ++ch) {
+            auto spacing = font.get_spacing(ch);
             REQUIRE(spacing.b_space.has_value());
             CHECK(*spacing.b_space == 8);
         }
     }
+
+    TEST_CASE("analyze PSF1 and PSF2 console fonts") {
+        auto info1 = font_factory::analyze(make_psf1());
+        CHECK(info1.format == container_format::PSF);
+        REQUIRE(info1.fonts.size() == 1);
+        CHECK(info1.fonts[0].type == font_type::BITMAP);
+        CHECK(info1.fonts[0].pixel_height == 8);
+        CHECK(font_factory::format_name(container_format::PSF) == "PC Screen Font");
+
+        auto info2 = font_factory::analyze(make_psf2());
+        CHECK(info2.format == container_format::PSF);
+        REQUIRE(info2.fonts.size() == 1);
+        CHECK(info2.fonts[0].name == "PSF2 10x4");
+
+        // Truncated glyph data is not a PSF font
+        auto truncated = make_psf1();
+        truncated.resize(100);
+        CHECK(font_factory::analyze(truncated).format == container_format::UNKNOWN);
+    }
+
+    TEST_CASE("load_bitmap from PSF1 with Unicode table") {
+        auto font = font_factory::load_bitmap(make_psf1());
+
+        REQUIRE(font.has_unicode_table());
+        CHECK(font.get_first_char() == 0);
+        CHECK(font.get_last_char() == 0x391);
+        CHECK(font.get_glyph_count() == 256);
+        CHECK(font.get_metrics().pixel_height == 8);
+
+        auto glyph = font.get_glyph(U'A');
+        CHECK(glyph.width() == 8);
+        CHECK(glyph.height() == 8);
+        CHECK(std::to_integer<uint8_t>(glyph.row(0)[0]) == 'A');
+
+        // Greek Alpha shares the Latin A glyph
+        CHECK(std::to_integer<uint8_t>(font.get_glyph(U'\u0391').row(0)[0]) == 'A');
+        CHECK(font.get_spacing(U'\u0391').b_space == 8);
+
+        CHECK(font.find_glyph(U'A') == std::optional<std::size_t>('A'));
+        CHECK(font.find_glyph(U'\u0391') == std::optional<std::size_t>('A'));
+        CHECK_FALSE(font.has_glyph(U'\u0301'));  // only inside a sequence
+        CHECK_FALSE(font.has_glyph(U'\u0300'));  // inside the range, not mapped
+        CHECK_FALSE(font.has_glyph(U'\u4E2D'));
+        CHECK_THROWS_AS((void)font.get_glyph(U'\u0300'), std::out_of_range);
+
+        CHECK_THROWS_AS((void)font_factory::load_bitmap(make_psf1(), 1), std::invalid_argument);
+    }
+
+    TEST_CASE("load_bitmap from PSF2 reaches glyphs past 255") {
+        auto font = font_factory::load_bitmap(make_psf2());
+
+        CHECK(font.get_glyph_count() == 300);
+        CHECK(font.get_first_char() == U'?');
+        CHECK(font.get_last_char() == 0x4E2D);
+        CHECK(font.get_default_char() == U'?');
+
+        auto index = font.find_glyph(U'\u4E2D');
+        REQUIRE(index.has_value());
+        CHECK(*index == 299);
+
+        auto glyph = font.get_glyph(U'\u4E2D');
+        CHECK(glyph.width() == 10);
+        CHECK(glyph.stride_bytes() == 2);
+        CHECK(glyph.pixel(9, 3));
+        CHECK_THROWS_AS((void)font.get_glyph_by_index(300), std::out_of_range);
+
+        auto all = font_factory::load_all_bitmaps(make_psf2());
+        CHECK(all.size() == 1);
+    }
+
+    TEST_CASE("load_bitmap from PSF path maps the file") {
+        auto path = std::filesystem::temp_directory_path() / "onyx_font_test.psf";
+        {
+            auto data = make_psf2();
+            std::ofstream out(path, std::ios::binary);
+            out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        }
+
+        auto font = font_factory::load_bitmap(path);
+        std::filesystem::remove(path);
+
+        // The mapping outlives the file name
+        auto index = font.find_glyph(U'\u4E2D');
+        REQUIRE(index.has_value());
+        CHECK(font.get_glyph_by_index(*index).pixel(0, 0));
+
+        // Copies share the mapping
+        auto copy = font;
+        CHECK(copy.get_glyph_by_index(*index).pixel(9, 3));
+    }
 }
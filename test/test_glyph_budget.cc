@@ -0,0 +1,217 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for glyph_budget and budgeted glyph caches
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/glyph_budget.hh>
+#include <onyx_font/text/glyph_cache.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <memory>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+TEST_SUITE("glyph_budget") {
+    TEST_CASE("tracks registered bytes") {
+        auto budget = std::make_shared<glyph_budget>(1000);
+        auto a = budget->add("a", [] { return std::size_t{0}; });
+        auto b = budget->add("b", [] { return std::size_t{0}; });
+
+        a.update(300);
+        b.update(200);
+        CHECK(budget->used() == 500);
+        CHECK(budget->client_count() == 2);
+
+        auto shares = budget->shares();
+        REQUIRE(shares.size() == 2);
+        CHECK(shares[0].name == "a");
+        CHECK(shares[0].bytes == 300);
+        CHECK(shares[1].name == "b");
+
+        b.reset();
+        CHECK(budget->used() == 300);
+        CHECK(budget->client_count() == 1);
+    }
+
+    TEST_CASE("evicts least recently used first") {
+        auto budget = std::make_shared<glyph_budget>(1000);
+        std::vector<std::string> evicted;
+        auto make = [&](const char* name, std::size_t keep) {
+            return budget->add(name, [&evicted, name, keep] {
+                evicted.emplace_back(name);
+                return keep;
+            });
+        };
+        auto a = make("a", 0);
+        auto b = make("b", 0);
+        auto c = make("c", 0);
+
+        a.update(400);
+        budget->tick();
+        b.update(400);
+        b.touch();
+        budget->tick();
+        a.touch();  // a is now more recent than b
+
+        c.update(400);  // 1200 > 1000
+        REQUIRE(evicted.size() == 1);
+        CHECK(evicted[0] == "b");
+        CHECK(budget->used() == 800);
+        CHECK(budget->evictions() == 1);
+        CHECK(budget->shares()[0].evictions == 0);
+    }
+
+    TEST_CASE("reporting client is not evicted") {
+        auto budget = std::make_shared<glyph_budget>(100);
+        bool evicted = false;
+        auto a = budget->add("a", [&evicted] {
+            evicted = true;
+            return std::size_t{0};
+        });
+        a.update(500);
+        CHECK_FALSE(evicted);
+        CHECK(budget->used() == 500);
+
+        // Lowering the limit evicts everyone not used in this tick
+        budget->set_limit(400);
+        CHECK_FALSE(evicted);
+        budget->tick();
+        budget->set_limit(400);
+        CHECK(evicted);
+        CHECK(budget->used() == 0);
+    }
+
+    TEST_CASE("clients used in the current tick are not evicted") {
+        auto budget = std::make_shared<glyph_budget>(1000);
+        std::vector<std::string> evicted;
+        auto make = [&](const char* name) {
+            return budget->add(name, [&evicted, name] {
+                evicted.emplace_back(name);
+                return std::size_t{0};
+            });
+        };
+        auto a = make("a");
+        auto b = make("b");
+        auto c = make("c");
+
+        a.update(400);
+        b.update(400);
+        budget->tick();
+        a.touch();
+
+        // a is drawing this frame; only b may go
+        c.update(800);
+        CHECK(evicted == std::vector<std::string>{"b"});
+        CHECK(budget->used() == 1200);
+
+        // Next frame a is fair game again
+        budget->tick();
+        c.update(800);
+        CHECK(evicted == std::vector<std::string>{"b", "a"});
+        CHECK(budget->used() == 800);
+    }
+
+    TEST_CASE("registration keeps the budget alive") {
+        glyph_budget::registration r;
+        CHECK_FALSE(r);
+        r.update(10);
+        {
+            auto budget = std::make_shared<glyph_budget>(100);
+            r = budget->add("x", {});
+        }
+        CHECK(static_cast<bool>(r));
+        r.update(20);
+        r.reset();
+        CHECK_FALSE(r);
+    }
+}
+
+TEST_SUITE("glyph_cache budget") {
+    TEST_CASE("caches report pages and evict each other") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        auto budget = std::make_shared<glyph_budget>(3 * 64 * 64);
+        glyph_cache_config config;
+        config.atlas_size = 64;
+        config.pre_cache_ascii = false;
+        config.budget = budget;
+
+        config.budget_name = "first";
+        glyph_cache<memory_atlas> first(font_source::from_bitmap(font), 12.0f, config);
+        CHECK(budget->used() == 64 * 64);
+
+        first.cache_range(32, 126);
+        int first_pages = first.atlas_count();
+        REQUIRE(first_pages >= 2);
+        CHECK(budget->used() == first.memory_bytes());
+
+        budget->tick();
+        config.budget_name = "second";
+        glyph_cache<memory_atlas> second(font_source::from_bitmap(font), 12.0f, config);
+        (void)second.get('A');
+        second.cache_range(32, 126);
+
+        // Second grew past the limit; first (least recently used) was cleared
+        CHECK(budget->used() <= budget->limit() + second.memory_bytes());
+        CHECK(first.atlas_count() == 1);
+        CHECK_FALSE(first.is_cached('A'));
+        CHECK(second.is_cached('A'));
+
+        // The cleared cache works again on demand
+        CHECK(first.get('A').advance_x > 0);
+        CHECK(first.is_cached('A'));
+
+        auto shares = budget->shares();
+        REQUIRE(shares.size() == 2);
+        CHECK(shares[0].name == "second");
+        CHECK(shares[1].evictions >= 1);
+    }
+
+    TEST_CASE("moved cache stays registered") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        auto budget = std::make_shared<glyph_budget>(64 * 64);
+        glyph_cache_config config;
+        config.atlas_size = 64;
+        config.pre_cache_ascii = false;
+        config.budget = budget;
+
+        std::vector<glyph_cache<memory_atlas>> caches;
+        caches.emplace_back(font_source::from_bitmap(font), 12.0f, config);
+        caches.emplace_back(font_source::from_bitmap(font), 12.0f, config);
+        CHECK(budget->client_count() == 2);
+
+        (void)caches[0].get('A');
+        budget->tick();
+        (void)caches[1].get('B');
+        caches[1].cache_range(32, 126);
+
+        // Eviction reached the relocated first cache
+        CHECK_FALSE(caches[0].is_cached('A'));
+
+        caches.clear();
+        CHECK(budget->client_count() == 0);
+        CHECK(budget->used() == 0);
+    }
+
+    TEST_CASE("clear keeps one page") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        glyph_cache_config config;
+        config.atlas_size = 64;
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f, config);
+        REQUIRE(cache.is_cached('A'));
+
+        cache.clear();
+        CHECK(cache.atlas_count() == 1);
+        CHECK(cache.memory_bytes() == 64 * 64);
+        CHECK_FALSE(cache.is_cached('A'));
+    }
+}
@@ -8,15 +8,74 @@
 #include <onyx_font/text/glyph_cache.hh>
 #include <onyx_font/font_factory.hh>
 #include "test_data.hh"
+#include <cstring>
+#include <vector>
 
 using namespace onyx_font;
 using namespace onyx_font::test;
 
+namespace {
+    /// Allocator counting the bytes it hands out
+    template<typename T>
+    struct counting_allocator {
+        using value_type = T;
+
+        std::size_t* allocated;
+
+        explicit counting_allocator(std::size_t* counter) noexcept : allocated(counter) {}
+
+        template<typename U>
+        counting_allocator(const counting_allocator<U>& other) noexcept : allocated(other.allocated) {}
+
+        T* allocate(std::size_t n) {
+            *allocated += n * sizeof(T);
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept {
+            std::allocator<T>{}.deallocate(p, n);
+        }
+
+        template<typename U>
+        bool operator==(const counting_allocator<U>& other) const noexcept {
+            return allocated == other.allocated;
+        }
+    };
+
+    /// Surface without a (width, height) constructor or exposed memory
+    class write_only_surface {
+    public:
+        write_only_surface(std::vector<uint8_t>& sink, int size)
+            : m_sink(&sink), m_size(size) {}
+
+        [[nodiscard]] int width() const noexcept { return m_size; }
+        [[nodiscard]] int height() const noexcept { return m_size; }
+
+        void write_alpha(int x, int y, int w, int h, const uint8_t* pixels, int stride) {
+            for (int row = 0; row < h; ++row) {
+                std::memcpy(m_sink->data() + (y + row) * m_size + x, pixels + row * stride,
+                            static_cast<std::size_t>(w));
+            }
+        }
+
+    private:
+        std::vector<uint8_t>* m_sink;
+        int m_size;
+    };
+}
+
 TEST_SUITE("glyph_cache") {
 
     TEST_CASE("atlas_surface concept") {
         // Verify memory_atlas satisfies the concept
         static_assert(atlas_surface<memory_atlas>);
+        static_assert(sized_atlas_surface<memory_atlas>);
+
+        // Surfaces over external memory need a factory
+        static_assert(atlas_surface<external_memory_atlas>);
+        static_assert(!sized_atlas_surface<external_memory_atlas>);
+        static_assert(atlas_surface<write_only_surface>);
+        static_assert(!direct_atlas_surface<write_only_surface>);
     }
 
     TEST_CASE("memory_atlas basic") {
@@ -43,6 +102,45 @@ TEST_SUITE("glyph_cache") {
         CHECK(atlas.pixel(10, 10) == 0);
     }
 
+    TEST_CASE("memory_atlas change tracking") {
+        memory_atlas atlas(64, 40);
+        CHECK(atlas.revision() == 0);
+
+        int tiles = 0;
+        atlas.for_each_dirty_tile(0, [&](glyph_rect) { ++tiles; });
+        CHECK(tiles == 0);
+
+        uint8_t data[] = {1, 2, 3, 4, 5, 6};
+        atlas.write_alpha(14, 34, 3, 2, data, 3);
+        uint64_t after_first = atlas.revision();
+        CHECK(after_first > 0);
+
+        // Spans two tiles horizontally, clipped at the bottom edge
+        std::vector<glyph_rect> dirty;
+        atlas.for_each_dirty_tile(0, [&](glyph_rect tile) { dirty.push_back(tile); });
+        REQUIRE(dirty.size() == 2);
+        CHECK(dirty[0].x == 0);
+        CHECK(dirty[0].y == 32);
+        CHECK(dirty[0].h == 8);
+        CHECK(dirty[1].x == 16);
+        CHECK(dirty[1].w == 16);
+
+        atlas.write_alpha(50, 2, 2, 2, data, 2);
+        dirty.clear();
+        atlas.for_each_dirty_tile(after_first, [&](glyph_rect tile) { dirty.push_back(tile); });
+        REQUIRE(dirty.size() == 1);
+        CHECK(dirty[0].x == 48);
+        CHECK(dirty[0].y == 0);
+
+        glyph_rect bounds = atlas.dirty_bounds(0);
+        CHECK(bounds.x == 0);
+        CHECK(bounds.y == 0);
+        CHECK(bounds.w == 64);
+        CHECK(bounds.h == 40);
+
+        CHECK(atlas.dirty_bounds(atlas.revision()).w == 0);
+    }
+
     TEST_CASE("basic caching bitmap") {
         auto data = test_data::load_fon_helva();
         auto font = font_factory::load_bitmap(data, 0);
@@ -257,4 +355,274 @@ TEST_SUITE("glyph_cache") {
         // 'A' typically has positive bearing_y (extends above baseline)
         CHECK(glyph_A.bearing_y > 0);
     }
+
+    TEST_CASE("texture array layout") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto source = font_source::from_bitmap(font);
+
+        glyph_cache_config config;
+        config.atlas_size = 32;
+        config.pre_cache_ascii = false;
+        config.layout = atlas_layout::texture_array;
+        config.max_layers = 2;
+        glyph_cache<memory_atlas> cache(std::move(source), 12.0f, config);
+
+        CHECK(cache.layout() == atlas_layout::texture_array);
+
+        // Fill until the layer limit is hit
+        CHECK_THROWS_AS(cache.cache_range('!', '~'), std::length_error);
+        CHECK(cache.atlas_count() == 2);
+
+        for (int i = 0; i < cache.atlas_count(); ++i) {
+            CHECK(cache.atlas(i).width() == 32);
+            CHECK(cache.atlas(i).height() == 32);
+        }
+
+        const auto& glyph = cache.get('!');
+        CHECK(glyph.layer == glyph.atlas_index);
+    }
+
+    TEST_CASE("external_memory_atlas writes into caller memory") {
+        // 8x4 atlas inside a buffer with 12-byte rows
+        std::vector<uint8_t> memory(12 * 4, 0xEE);
+        external_memory_atlas atlas(memory.data(), 8, 4, 12);
+
+        CHECK(atlas.width() == 8);
+        CHECK(atlas.stride() == 12);
+        CHECK(atlas.data() == memory.data());
+        CHECK(atlas.revision() == 0);
+
+        // Existing contents are kept
+        CHECK(atlas.pixel(0, 0) == 0xEE);
+
+        atlas.clear();
+        CHECK(atlas.pixel(7, 3) == 0);
+        CHECK(memory[8] == 0xEE);  // Row padding untouched
+
+        const uint8_t glyph[4] = {1, 2, 3, 4};
+        atlas.write_alpha(6, 2, 2, 2, glyph, 2);
+        CHECK(memory[2 * 12 + 6] == 1);
+        CHECK(memory[3 * 12 + 7] == 4);
+        CHECK(atlas.pixel(7, 3) == 4);
+
+        // In-place edits are tracked through invalidate()
+        uint64_t seen = atlas.revision();
+        atlas.data()[1] = 9;
+        atlas.invalidate(1, 0, 1, 1);
+        glyph_rect dirty = atlas.dirty_bounds(seen);
+        CHECK(dirty.x == 0);
+        CHECK(dirty.y == 0);
+        CHECK(dirty.w == 8);
+
+        CHECK_THROWS_AS(external_memory_atlas(memory.data(), 8, 4, 4), std::invalid_argument);
+        CHECK_THROWS_AS(external_memory_atlas(nullptr, 8, 4), std::invalid_argument);
+    }
+
+    TEST_CASE("basic_memory_atlas uses its allocator") {
+        std::size_t allocated = 0;
+        using counted_atlas = basic_memory_atlas<counting_allocator<uint8_t>>;
+
+        counted_atlas atlas(32, 16, counting_allocator<uint8_t>(&allocated));
+        CHECK(allocated == 32 * 16);
+
+        const uint8_t value = 77;
+        atlas.write_alpha(3, 4, 1, 1, &value, 1);
+
+        // Copies and moves keep pointing at their own storage
+        counted_atlas copy(atlas);
+        CHECK(copy.data() != atlas.data());
+        CHECK(copy.pixel(3, 4) == 77);
+
+        counted_atlas moved(std::move(copy));
+        CHECK(moved.pixel(3, 4) == 77);
+        CHECK(moved.revision() == atlas.revision());
+    }
+
+    TEST_CASE("surface factory over external memory") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        glyph_cache_config config;
+        config.atlas_size = 64;
+        config.pre_cache_ascii = false;
+
+        // Up to 8 pages in one caller-owned block, 64 bytes of slack per row
+        const int stride = 128;
+        std::vector<uint8_t> block(static_cast<std::size_t>(8 * stride * 64), 0);
+        std::vector<int> requested;
+
+        glyph_cache<external_memory_atlas> cache(
+            font_source::from_bitmap(font), 12.0f, config,
+            [&](int w, int h, int page) {
+                requested.push_back(page);
+                return external_memory_atlas(block.data() + page * stride * h, w, h, stride);
+            });
+
+        glyph_cache<memory_atlas> reference(font_source::from_bitmap(font), 12.0f, config);
+
+        cache.cache_range('!', '~');
+        reference.cache_range('!', '~');
+
+        REQUIRE(cache.atlas_count() > 1);
+        REQUIRE(cache.atlas_count() <= 8);
+        CHECK(cache.atlas_count() == reference.atlas_count());
+        CHECK(requested.size() == static_cast<std::size_t>(cache.atlas_count()));
+        CHECK(requested.front() == 0);
+
+        // Rasterized straight into the block, identical to memory_atlas
+        for (int page = 0; page < cache.atlas_count(); ++page) {
+            const auto& ext = cache.atlas(page);
+            const auto& ref = reference.atlas(page);
+            CHECK(ext.data() == block.data() + page * stride * 64);
+            CHECK(ext.revision() == ref.revision());
+
+            bool same = true;
+            for (int y = 0; y < 64; ++y) {
+                same = same && std::memcmp(ext.data() + y * stride, ref.data() + y * 64, 64) == 0;
+            }
+            CHECK(same);
+        }
+
+        // The slack after each row is never written
+        bool slack_clean = true;
+        for (int row = 0; row < 8 * 64; ++row) {
+            for (int x = 64; x < stride; ++x) {
+                slack_clean = slack_clean && block[static_cast<std::size_t>(row * stride + x)] == 0;
+            }
+        }
+        CHECK(slack_clean);
+
+        const auto& g = cache.get('A');
+        const auto& r = reference.get('A');
+        CHECK(g.rect.x == r.rect.x);
+        CHECK(g.atlas_index == r.atlas_index);
+    }
+
+    TEST_CASE("surface factory without direct memory access") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+
+        std::vector<uint8_t> sink(static_cast<std::size_t>(config.atlas_size * config.atlas_size), 0);
+        glyph_cache<write_only_surface> cache(
+            font_source::from_bitmap(font), 12.0f, config,
+            [&](int w, int, int) { return write_only_surface(sink, w); });
+
+        glyph_cache<memory_atlas> reference(font_source::from_bitmap(font), 12.0f, config);
+
+        cache.cache_string("Hello");
+        reference.cache_string("Hello");
+        CHECK(std::memcmp(sink.data(), reference.atlas(0).data(), sink.size()) == 0);
+
+        CHECK_THROWS_AS(glyph_cache<write_only_surface>(font_source::from_bitmap(font), 12.0f, config,
+                                                        atlas_surface_factory<write_only_surface>{}),
+                        std::invalid_argument);
+    }
+
+    TEST_CASE("allocator constructor") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        std::size_t allocated = 0;
+        glyph_cache_config config;
+        config.atlas_size = 128;
+        glyph_cache<basic_memory_atlas<counting_allocator<uint8_t>>> cache(
+            font_source::from_bitmap(font), 12.0f, config, counting_allocator<uint8_t>(&allocated));
+
+        CHECK(cache.is_cached('A'));
+        CHECK(allocated >= static_cast<std::size_t>(cache.atlas_count()) * 128 * 128);
+    }
+
+    TEST_CASE("miss budget defers glyphs to pump") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        config.miss_budget.glyphs = 2;
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f, config);
+        glyph_cache<memory_atlas> direct(font_source::from_bitmap(font), 12.0f);
+
+        (void)cache.get('A');
+        (void)cache.get('B');
+        CHECK(cache.is_cached('A'));
+        CHECK(cache.is_cached('B'));
+
+        // Budget spent: placeholders keep the real advance
+        const auto& c = cache.get('C');
+        CHECK(c.rect.w == 0);
+        CHECK(c.advance_x == direct.get('C').advance_x);
+        CHECK_FALSE(cache.is_cached('C'));
+        CHECK(cache.is_pending('C'));
+
+        (void)cache.get('D');
+        (void)cache.get('C');
+        CHECK(cache.pending_count() == 2);
+
+        // Drain one glyph, then the rest
+        CHECK(cache.pump({.glyphs = 1}) == 1);
+        CHECK(cache.is_cached('C'));
+        CHECK(cache.is_pending('D'));
+        CHECK(cache.pump() == 1);
+        CHECK(cache.pending_count() == 0);
+        CHECK(cache.get('D').rect.w == direct.get('D').rect.w);
+    }
+
+    TEST_CASE("pump starts a new frame") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        config.miss_budget.glyphs = 1;
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f, config);
+
+        (void)cache.get('x');
+        (void)cache.get('y');
+        CHECK(cache.is_pending('y'));
+
+        CHECK(cache.pump({.glyphs = 1}) == 1);
+        (void)cache.get('z');
+        CHECK(cache.is_cached('z'));
+        (void)cache.get('w');
+        CHECK(cache.is_pending('w'));
+    }
+
+    TEST_CASE("default_char placeholder") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto source = font_source::from_bitmap(font);
+        char32_t fallback = source.default_char();
+
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        config.miss_budget.glyphs = 1;
+        config.pending_style = pending_glyph_style::default_char;
+        glyph_cache<memory_atlas> cache(std::move(source), 12.0f, config);
+
+        (void)cache.get('a');
+        char32_t cp = fallback == 'W' ? 'M' : 'W';
+        const auto& placeholder = cache.get(cp);
+        REQUIRE(cache.is_cached(fallback));
+        const auto& def = cache.get(fallback);
+        CHECK(placeholder.rect.x == def.rect.x);
+        CHECK(placeholder.rect.w == def.rect.w);
+        CHECK(placeholder.advance_x == cache.face().get_glyph_metrics(cp).advance_x);
+    }
+
+    TEST_CASE("pre-caching ignores the miss budget") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        glyph_cache_config config;
+        config.miss_budget.glyphs = 1;
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f, config);
+
+        CHECK(cache.is_cached('~'));
+        cache.cache_string("\xc3\xa9\xc3\xa0");
+        CHECK(cache.pending_count() == 0);
+    }
 }
@@ -0,0 +1,286 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for glyph_store and the glyph_cache second tier
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/glyph_store.hh>
+#include <onyx_font/text/glyph_cache.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    /// Stand-ins for font_source::font_identity()
+    const int font_a = 1;
+    const int font_b = 2;
+
+    /// Glyph-like bitmap: empty border, solid core, antialiased edge
+    std::vector<uint8_t> make_bitmap(int w, int h) {
+        std::vector<uint8_t> pixels(static_cast<std::size_t>(w * h), 0);
+        for (int y = 2; y < h - 2; ++y) {
+            for (int x = 2; x < w - 2; ++x) {
+                pixels[static_cast<std::size_t>(y * w + x)] =
+                    (x == 2 || x == w - 3) ? static_cast<uint8_t>(37 * y) : 255;
+            }
+        }
+        return pixels;
+    }
+
+    stored_glyph make_info(int w, int h) {
+        stored_glyph info;
+        info.width = w;
+        info.height = h;
+        info.bearing_x = 1.0f;
+        info.bearing_y = static_cast<float>(h);
+        info.advance_x = static_cast<float>(w + 1);
+        return info;
+    }
+}
+
+TEST_SUITE("glyph_store") {
+    TEST_CASE("rle round-trips exactly") {
+        glyph_store store(1 << 20);
+        auto bitmap = make_bitmap(13, 17);
+        REQUIRE(store.put(&font_a, 'A', 16.0f, make_info(13, 17), bitmap.data(), 13));
+
+        stored_glyph info;
+        std::vector<uint8_t> pixels;
+        REQUIRE(store.fetch(&font_a, 'A', 16.0f, info, pixels));
+        CHECK(info.width == 13);
+        CHECK(info.height == 17);
+        CHECK(info.advance_x == 14.0f);
+        CHECK(pixels == bitmap);
+
+        auto stats = store.stats();
+        CHECK(stats.glyphs == 1);
+        CHECK(stats.raw_bytes == 13 * 17);
+        CHECK(stats.bytes < stats.raw_bytes + glyph_store::entry_overhead);
+    }
+
+    TEST_CASE("rle handles strides and long runs") {
+        glyph_store store(1 << 20);
+        const int w = 300;
+        const int h = 3;
+        const int stride = 320;
+        std::vector<uint8_t> source(static_cast<std::size_t>(stride * h), 0xEE);
+        for (int x = 0; x < w; ++x) {
+            source[static_cast<std::size_t>(stride + x)] = static_cast<uint8_t>(x);  // All literals
+        }
+        REQUIRE(store.put(&font_a, 'B', 16.0f, make_info(w, h), source.data(), stride));
+
+        stored_glyph info;
+        std::vector<uint8_t> pixels;
+        REQUIRE(store.fetch(&font_a, 'B', 16.0f, info, pixels));
+        REQUIRE(pixels.size() == static_cast<std::size_t>(w * h));
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                CHECK(pixels[static_cast<std::size_t>(y * w + x)] ==
+                      source[static_cast<std::size_t>(y * stride + x)]);
+            }
+        }
+    }
+
+    TEST_CASE("rle4 quantizes to 16 levels") {
+        glyph_store store(1 << 20, glyph_store_encoding::rle4);
+        auto bitmap = make_bitmap(9, 11);  // Odd pixel count
+        REQUIRE(store.put(&font_a, 'C', 16.0f, make_info(9, 11), bitmap.data(), 9));
+
+        stored_glyph info;
+        std::vector<uint8_t> pixels;
+        REQUIRE(store.fetch(&font_a, 'C', 16.0f, info, pixels));
+        REQUIRE(pixels.size() == bitmap.size());
+        for (std::size_t i = 0; i < bitmap.size(); ++i) {
+            CHECK(std::abs(int{pixels[i]} - int{bitmap[i]}) <= 8);
+            CHECK(pixels[i] % 17 == 0);
+        }
+        CHECK(pixels[0] == 0);
+        CHECK(pixels[static_cast<std::size_t>(5 * 9 + 4)] == 255);
+    }
+
+    TEST_CASE("entries are keyed by font and size") {
+        glyph_store store(1 << 20);
+        auto bitmap = make_bitmap(8, 8);
+        store.put(&font_a, 'A', 16.0f, make_info(8, 8), bitmap.data(), 8);
+
+        CHECK(store.contains(&font_a, 'A', 16.0f));
+        CHECK_FALSE(store.contains(&font_a, 'A', 17.0f));
+        CHECK_FALSE(store.contains(&font_a, 'B', 16.0f));
+        CHECK_FALSE(store.contains(&font_b, 'A', 16.0f));
+
+        store.put(&font_b, 'A', 16.0f, make_info(5, 7), bitmap.data(), 8);
+        CHECK(store.stats().glyphs == 2);
+
+        stored_glyph info;
+        std::vector<uint8_t> pixels;
+        CHECK_FALSE(store.fetch(&font_a, 'A', 24.0f, info, pixels));
+        CHECK(store.fetch(&font_a, 'A', 16.0f, info, pixels));
+        CHECK(store.stats().hits == 1);
+        CHECK(store.stats().misses == 1);
+    }
+
+    TEST_CASE("empty glyphs keep their metrics") {
+        glyph_store store(1 << 20);
+        REQUIRE(store.put(&font_a, ' ', 16.0f, make_info(0, 0), nullptr, 0));
+
+        stored_glyph info;
+        std::vector<uint8_t> pixels{1, 2, 3};
+        REQUIRE(store.fetch(&font_a, ' ', 16.0f, info, pixels));
+        CHECK(info.width == 0);
+        CHECK(info.advance_x == 1.0f);
+        CHECK(pixels.empty());
+    }
+
+    TEST_CASE("budget drops least recently used") {
+        glyph_store store(3 * glyph_store::entry_overhead + 200);
+        auto bitmap = make_bitmap(16, 16);
+        store.put(&font_a, 'A', 16.0f, make_info(16, 16), bitmap.data(), 16);
+        store.put(&font_a, 'B', 16.0f, make_info(16, 16), bitmap.data(), 16);
+
+        stored_glyph info;
+        std::vector<uint8_t> pixels;
+        REQUIRE(store.fetch(&font_a, 'A', 16.0f, info, pixels));  // B is now the oldest
+
+        for (char32_t cp = 'C'; cp <= 'H'; ++cp) {
+            store.put(&font_a, cp, 16.0f, make_info(16, 16), bitmap.data(), 16);
+        }
+        auto stats = store.stats();
+        CHECK(stats.bytes <= store.budget());
+        CHECK(stats.evictions > 0);
+        CHECK_FALSE(store.contains(&font_a, 'B', 16.0f));
+        CHECK(store.contains(&font_a, 'H', 16.0f));
+
+        store.set_budget(0);
+        CHECK(store.stats().glyphs == 0);
+        CHECK(store.stats().bytes == 0);
+        CHECK_FALSE(store.put(&font_a, 'A', 16.0f, make_info(16, 16), bitmap.data(), 16));
+    }
+
+    TEST_CASE("clear drops entries but keeps counters") {
+        glyph_store store(1 << 20);
+        auto bitmap = make_bitmap(8, 8);
+        store.put(&font_a, 'A', 16.0f, make_info(8, 8), bitmap.data(), 8);
+        stored_glyph info;
+        std::vector<uint8_t> pixels;
+        store.fetch(&font_a, 'A', 16.0f, info, pixels);
+
+        store.clear();
+        CHECK(store.stats().glyphs == 0);
+        CHECK(store.stats().raw_bytes == 0);
+        CHECK(store.stats().hits == 1);
+    }
+}
+
+TEST_SUITE("glyph_cache backing store") {
+    TEST_CASE("cleared glyphs are restored from the store") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        auto store = std::make_shared<glyph_store>(1 << 20);
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        config.backing_store = store;
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f, config);
+
+        const cached_glyph before = cache.get('A');
+        std::vector<uint8_t> original;
+        for (int y = 0; y < before.rect.h; ++y) {
+            for (int x = 0; x < before.rect.w; ++x) {
+                original.push_back(cache.atlas(before.atlas_index).pixel(before.rect.x + x, before.rect.y + y));
+            }
+        }
+        CHECK(cache.stats().atlas_misses == 1);
+        CHECK(cache.stats().store_misses == 1);
+
+        cache.clear();
+        CHECK(store->contains(cache.rasterizer().source().font_identity(), 'A', 12.0f));
+        CHECK_FALSE(cache.is_cached('A'));
+
+        const cached_glyph& after = cache.get('A');
+        CHECK(cache.stats().store_hits == 1);
+        CHECK(cache.stats().atlas_misses == 2);
+        CHECK(after.advance_x == before.advance_x);
+        CHECK(after.bearing_y == before.bearing_y);
+        REQUIRE(after.rect.w == before.rect.w);
+        REQUIRE(after.rect.h == before.rect.h);
+
+        std::vector<uint8_t> restored;
+        for (int y = 0; y < after.rect.h; ++y) {
+            for (int x = 0; x < after.rect.w; ++x) {
+                restored.push_back(cache.atlas(after.atlas_index).pixel(after.rect.x + x, after.rect.y + y));
+            }
+        }
+        CHECK(restored == original);
+
+        (void)cache.get('A');
+        CHECK(cache.stats().atlas_hits == 1);
+
+        cache.reset_stats();
+        CHECK(cache.stats().atlas_misses == 0);
+    }
+
+    TEST_CASE("budget eviction spills into the store") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        auto budget = std::make_shared<glyph_budget>(64 * 64);
+        auto store = std::make_shared<glyph_store>(1 << 20, glyph_store_encoding::rle4);
+        glyph_cache_config config;
+        config.atlas_size = 64;
+        config.pre_cache_ascii = false;
+        config.budget = budget;
+        config.backing_store = store;
+
+        glyph_cache<memory_atlas> first(font_source::from_bitmap(font), 12.0f, config);
+        (void)first.get('W');
+        budget->tick();
+
+        glyph_cache<memory_atlas> second(font_source::from_bitmap(font), 12.0f, config);
+        second.cache_range(32, 126);
+
+        CHECK_FALSE(first.is_cached('W'));
+        CHECK(store->contains(first.rasterizer().source().font_identity(), 'W', 12.0f));
+        (void)first.get('W');
+        CHECK(first.stats().store_hits == 1);
+    }
+
+    TEST_CASE("fonts sharing a store keep their own glyphs") {
+        auto helva_data = test_data::load_fon_helva();
+        auto vga_data = test_data::load_fon_vgaoem();
+        auto helva = font_factory::load_bitmap(helva_data, 0);
+        auto vga = font_factory::load_bitmap(vga_data, 0);
+
+        auto store = std::make_shared<glyph_store>(1 << 20);
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        config.backing_store = store;
+        glyph_cache<memory_atlas> first(font_source::from_bitmap(helva), 12.0f, config);
+        glyph_cache<memory_atlas> second(font_source::from_bitmap(vga), 12.0f, config);
+
+        glyph_cache_config plain;
+        plain.pre_cache_ascii = false;
+        glyph_cache<memory_atlas> reference(font_source::from_bitmap(vga), 12.0f, plain);
+        const cached_glyph expected = reference.get('W');
+
+        (void)first.get('W');
+        first.clear();
+        REQUIRE(store->contains(first.rasterizer().source().font_identity(), 'W', 12.0f));
+        CHECK_FALSE(store->contains(second.rasterizer().source().font_identity(), 'W', 12.0f));
+
+        const cached_glyph& glyph = second.get('W');
+        CHECK(second.stats().store_hits == 0);
+        CHECK(second.stats().store_misses == 1);
+        CHECK(glyph.rect.w == expected.rect.w);
+        CHECK(glyph.rect.h == expected.rect.h);
+        CHECK(glyph.advance_x == expected.advance_x);
+
+        (void)first.get('W');
+        CHECK(first.stats().store_hits == 1);
+    }
+}
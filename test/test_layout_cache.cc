@@ -0,0 +1,210 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for layout_cache and cached text_renderer layouts
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/layout_cache.hh>
+#include <onyx_font/text/text_renderer.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <memory>
+#include <tuple>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    using blit_call = std::tuple<int, int, int, float, float>;
+
+    auto recorder(std::vector<blit_call>& calls) {
+        return [&calls](const memory_atlas&, glyph_rect src, float x, float y) {
+            calls.emplace_back(src.x, src.y, src.w, x, y);
+        };
+    }
+}
+
+TEST_SUITE("layout_cache") {
+    TEST_CASE("find and insert") {
+        layout_cache cache(2);
+        layout_key key;
+        key.text = "hello";
+        key.size = 16.0f;
+
+        CHECK(cache.find(key) == nullptr);
+        CHECK(cache.misses() == 1);
+
+        layout_entry* entry = cache.insert(key);
+        REQUIRE(entry != nullptr);
+        entry->width = 42.0f;
+        entry->generation = 7;
+
+        const layout_entry* hit = cache.find(key);
+        REQUIRE(hit != nullptr);
+        CHECK(hit->width == 42.0f);
+        CHECK(cache.hits() == 1);
+
+        // Stale generation
+        CHECK(cache.find(key, 8) == nullptr);
+        CHECK(cache.find(key, 7) != nullptr);
+
+        // Every key field matters
+        layout_key other = key;
+        other.size = 17.0f;
+        CHECK(cache.find(other) == nullptr);
+        other = key;
+        other.kind = layout_kind::measure;
+        CHECK(cache.find(other) == nullptr);
+        other = key;
+        other.text = "hellO";
+        CHECK(cache.find(other) == nullptr);
+    }
+
+    TEST_CASE("capacity recycles least recently used") {
+        layout_cache cache(2);
+        layout_key a;
+        a.text = "a";
+        layout_key b;
+        b.text = "b";
+        layout_key c;
+        c.text = "c";
+
+        cache.insert(a)->width = 1.0f;
+        cache.insert(b)->width = 2.0f;
+        (void)cache.find(a);              // b is now the oldest
+        cache.insert(c)->width = 3.0f;
+
+        CHECK(cache.size() == 2);
+        CHECK(cache.find(b) == nullptr);
+        REQUIRE(cache.find(a) != nullptr);
+        CHECK(cache.find(a)->width == 1.0f);
+        CHECK(cache.find(c)->width == 3.0f);
+
+        // Re-inserting resets the entry
+        layout_entry* again = cache.insert(a);
+        CHECK(again->width == 0.0f);
+        CHECK(cache.size() == 2);
+
+        cache.clear();
+        CHECK(cache.size() == 0);
+
+        layout_cache none(0);
+        CHECK(none.insert(a) == nullptr);
+    }
+}
+
+TEST_SUITE("text_renderer layout cache") {
+    TEST_CASE("cached draws match uncached draws") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f);
+
+        text_renderer plain(cache);
+        text_renderer cached(cache);
+        auto layouts = std::make_shared<layout_cache>();
+        cached.set_layout_cache(layouts);
+        CHECK(cached.layouts() == layouts.get());
+
+        for (int frame = 0; frame < 3; ++frame) {
+            std::vector<blit_call> a;
+            std::vector<blit_call> b;
+            float wa = plain.draw("Hello, World", 10.0f, 20.0f, recorder(a));
+            float wb = cached.draw("Hello, World", 10.0f, 20.0f, recorder(b));
+            CHECK(wa == wb);
+            CHECK(a == b);
+
+            a.clear();
+            b.clear();
+            text_box box{5, 5, 40, 1000};
+            int la = plain.draw_wrapped("The quick brown fox jumps", box, text_align::center, recorder(a));
+            int lb = cached.draw_wrapped("The quick brown fox jumps", box, text_align::center, recorder(b));
+            CHECK(la == lb);
+            CHECK(a == b);
+        }
+        CHECK(layouts->hits() >= 4);
+    }
+
+    TEST_CASE("box height limits replayed lines") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f);
+        text_renderer renderer(cache);
+        renderer.set_layout_cache(std::make_shared<layout_cache>());
+
+        float line_h = renderer.line_height();
+        std::vector<blit_call> calls;
+        text_box tall{0, 0, 30, line_h * 10};
+        int all = renderer.draw_wrapped("one two three four", tall, text_align::left, recorder(calls));
+        REQUIRE(all >= 2);
+
+        calls.clear();
+        text_box one_line{0, 0, 30, line_h * 1.5f};
+        CHECK(renderer.draw_wrapped("one two three four", one_line, text_align::left, recorder(calls)) == 1);
+        for (const auto& call : calls) {
+            CHECK(std::get<4>(call) < line_h);
+        }
+        CHECK(renderer.layouts()->hits() == 1);
+    }
+
+    TEST_CASE("cached batches match uncached batches") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f);
+        text_renderer plain(cache);
+        text_renderer cached(cache);
+        cached.set_layout_cache(std::make_shared<layout_cache>());
+
+        auto collect = [](std::vector<glyph_quad>& out) {
+            return [&out](std::span<const glyph_quad> quads) {
+                out.insert(out.end(), quads.begin(), quads.end());
+            };
+        };
+        for (int frame = 0; frame < 2; ++frame) {
+            std::vector<glyph_quad> a;
+            std::vector<glyph_quad> b;
+            plain.draw_batched("batched text", 3.0f, 4.0f, collect(a));
+            cached.draw_batched("batched text", 3.0f, 4.0f, collect(b));
+            REQUIRE(a.size() == b.size());
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                CHECK(a[i].layer == b[i].layer);
+                CHECK(a[i].dst_x == b[i].dst_x);
+                CHECK(a[i].dst_y == b[i].dst_y);
+            }
+        }
+    }
+
+    TEST_CASE("measure is cached and generation invalidates quads") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f, config);
+        text_renderer renderer(cache);
+        renderer.set_layout_cache(std::make_shared<layout_cache>());
+        layout_cache& layouts = *renderer.layouts();
+
+        auto first = renderer.measure("label");
+        auto second = renderer.measure("label");
+        CHECK(first.width == second.width);
+        CHECK(layouts.hits() == 1);
+
+        std::vector<blit_call> calls;
+        renderer.draw("abc", 0.0f, 0.0f, recorder(calls));
+        renderer.draw("abc", 0.0f, 0.0f, recorder(calls));
+        CHECK(layouts.hits() == 2);
+
+        // A new glyph changes the generation; the layout is redone
+        (void)cache.get('Z');
+        auto misses = layouts.misses();
+        renderer.draw("abc", 0.0f, 0.0f, recorder(calls));
+        CHECK(layouts.misses() == misses + 1);
+
+        // Clearing the cache re-rasterizes the glyphs of the next draw
+        cache.clear();
+        calls.clear();
+        renderer.draw("abc", 0.0f, 0.0f, recorder(calls));
+        CHECK(cache.is_cached('a'));
+    }
+}
@@ -0,0 +1,168 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for resizable_glyph_cache
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/resizable_cache.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    using manual_queue = std::vector<std::function<void()>>;
+
+    /// Executor that runs nothing until the test drains the queue
+    resizable_glyph_cache<memory_atlas>::executor queue_executor(manual_queue& queue) {
+        return [&queue](std::function<void()> job) { queue.push_back(std::move(job)); };
+    }
+
+    void run_all(manual_queue& queue) {
+        auto jobs = std::move(queue);
+        queue.clear();
+        for (auto& job : jobs) {
+            job();
+        }
+    }
+}
+
+TEST_SUITE("resizable_glyph_cache") {
+    TEST_CASE("background resize seeds resident glyphs") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        resizable_glyph_cache<memory_atlas> cache(
+            [&font] { return font_source::from_vector(font); }, 16.0f, config);
+
+        (void)cache.active().get('A');
+        (void)cache.active().get('Z');
+        CHECK(cache.size() == 16.0f);
+        CHECK_FALSE(cache.resizing());
+
+        cache.resize(32.0f);
+        CHECK(cache.resizing());
+        CHECK(cache.target_size() == 32.0f);
+
+        CHECK(cache.finish());
+        CHECK_FALSE(cache.resizing());
+        CHECK(cache.size() == 32.0f);
+        CHECK(cache.generation() == 1);
+        CHECK(cache.active().is_cached('A'));
+        CHECK(cache.active().is_cached('Z'));
+        CHECK_FALSE(cache.active().is_cached('B'));
+        CHECK(cache.active().line_height() > 0.0f);
+    }
+
+    TEST_CASE("old cache serves until poll swaps") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        manual_queue queue;
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        resizable_glyph_cache<memory_atlas> cache(
+            [&font] { return font_source::from_vector(font); }, 16.0f, config, queue_executor(queue));
+
+        (void)cache.active().get('A');
+        auto* before = &cache.active();
+
+        cache.resize(24.0f);
+        REQUIRE(queue.size() == 1);
+        CHECK_FALSE(cache.poll());
+        CHECK(&cache.active() == before);
+        CHECK(cache.size() == 16.0f);
+
+        // Glyphs gained while building are carried over at the swap
+        (void)cache.active().get('Q');
+
+        run_all(queue);
+        CHECK(cache.poll());
+        CHECK(cache.size() == 24.0f);
+        CHECK(cache.active().is_cached('A'));
+        CHECK(cache.active().is_cached('Q'));
+        CHECK_FALSE(cache.poll());
+    }
+
+    TEST_CASE("requests during a build are coalesced") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        manual_queue queue;
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        resizable_glyph_cache<memory_atlas> cache(
+            [&font] { return font_source::from_vector(font); }, 16.0f, config, queue_executor(queue));
+
+        cache.resize(20.0f);
+        cache.resize(30.0f);
+        cache.resize(40.0f);
+        CHECK(queue.size() == 1);
+        CHECK(cache.target_size() == 40.0f);
+
+        run_all(queue);
+        CHECK(cache.poll());
+        CHECK(cache.size() == 20.0f);
+        REQUIRE(queue.size() == 1);
+
+        run_all(queue);
+        CHECK(cache.poll());
+        CHECK(cache.size() == 40.0f);
+        CHECK(cache.generation() == 2);
+
+        // Requesting the active size does nothing
+        cache.resize(40.0f);
+        CHECK(queue.empty());
+        CHECK_FALSE(cache.resizing());
+    }
+
+    TEST_CASE("build joins the shared budget at the swap") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        auto budget = std::make_shared<glyph_budget>(2 * 64 * 64);
+        glyph_cache_config config;
+        config.atlas_size = 64;
+        config.pre_cache_ascii = false;
+        config.budget = budget;
+
+        config.budget_name = "other";
+        glyph_cache<memory_atlas> other(font_source::from_vector(font), 16.0f, config);
+        (void)other.get('A');
+
+        manual_queue queue;
+        config.budget_name = "ui";
+        resizable_glyph_cache<memory_atlas> cache(
+            [&font] { return font_source::from_vector(font); }, 16.0f, config, queue_executor(queue));
+        cache.active().cache_range(32, 126);
+        CHECK(budget->client_count() == 2);
+        budget->tick();
+
+        // The build outgrows the budget but must not evict from its thread
+        cache.resize(32.0f);
+        run_all(queue);
+        CHECK(budget->client_count() == 2);
+        CHECK(other.is_cached('A'));
+        CHECK(budget->evictions() == 0);
+
+        // Registered on the owning thread, where eviction is safe
+        CHECK(cache.poll());
+        CHECK(budget->client_count() == 2);
+        CHECK_FALSE(other.is_cached('A'));
+        auto shares = budget->shares();
+        REQUIRE(shares.size() == 2);
+        CHECK(shares[0].name == "ui");
+        CHECK(shares[0].bytes == cache.active().memory_bytes());
+    }
+
+    TEST_CASE("empty factory throws") {
+        CHECK_THROWS_AS(resizable_glyph_cache<memory_atlas>({}, 16.0f), std::invalid_argument);
+    }
+}
@@ -0,0 +1,238 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for shared_glyph_atlas
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/shared_atlas.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    std::string region_name(const char* tag) {
+        return "/onyx_font_test_" + std::to_string(::getpid()) + "_" + tag;
+    }
+
+    shared_glyph_atlas open_helva(const std::string& name, const bitmap_font& font,
+                                  shared_atlas_config config = {}) {
+        return shared_glyph_atlas(name, font_source::from_bitmap(font), 12.0f, config);
+    }
+
+    bool has_pixels(const shared_glyph_atlas& atlas, const cached_glyph& g) {
+        const uint8_t* page = atlas.page_data(g.atlas_index);
+        for (int y = g.rect.y; y < g.rect.y + g.rect.h; ++y) {
+            for (int x = g.rect.x; x < g.rect.x + g.rect.w; ++x) {
+                if (page[y * atlas.page_size() + x] != 0) return true;
+            }
+        }
+        return false;
+    }
+
+    /// Wait for all children; true if every child exited with status 0
+    bool wait_children(const std::vector<pid_t>& children) {
+        bool ok = true;
+        for (pid_t pid : children) {
+            int status = 0;
+            ::waitpid(pid, &status, 0);
+            ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+        return ok;
+    }
+}
+
+TEST_SUITE("shared_atlas") {
+
+    TEST_CASE("create and rasterize") {
+        auto name = region_name("basic");
+        shared_glyph_atlas::remove(name);
+
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        {
+            auto atlas = open_helva(name, font);
+            CHECK(atlas.is_creator());
+            CHECK(atlas.glyph_count() == 0);
+            CHECK_FALSE(atlas.is_cached('A'));
+
+            cached_glyph g = atlas.get('A');
+            CHECK(g.rect.w > 0);
+            CHECK(g.rect.h > 0);
+            CHECK(g.advance_x > 0);
+            CHECK(atlas.is_cached('A'));
+            CHECK(atlas.glyph_count() == 1);
+            CHECK(atlas.page_count() == 1);
+            CHECK(has_pixels(atlas, g));
+
+            // Repeat lookups do not allocate again
+            cached_glyph again = atlas.get('A');
+            CHECK(again.rect.x == g.rect.x);
+            CHECK(again.rect.y == g.rect.y);
+            CHECK(atlas.glyph_count() == 1);
+        }
+
+        CHECK(shared_glyph_atlas::remove(name));
+        CHECK_FALSE(shared_glyph_atlas::remove(name));
+    }
+
+    TEST_CASE("second instance attaches to existing region") {
+        auto name = region_name("attach");
+        shared_glyph_atlas::remove(name);
+
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        auto first = open_helva(name, font);
+        first.cache_string("Hello");
+
+        auto second = open_helva(name, font);
+        CHECK_FALSE(second.is_creator());
+        CHECK(second.is_cached('H'));
+        CHECK(second.glyph_count() == first.glyph_count());
+
+        cached_glyph a = first.get('e');
+        cached_glyph b = second.get('e');
+        CHECK(a.rect.x == b.rect.x);
+        CHECK(a.rect.y == b.rect.y);
+        CHECK(a.atlas_index == b.atlas_index);
+
+        // A glyph added through one instance is visible through the other
+        cached_glyph z = second.get('Z');
+        CHECK(first.is_cached('Z'));
+        CHECK(first.get('Z').rect.x == z.rect.x);
+
+        shared_glyph_atlas::remove(name);
+    }
+
+    TEST_CASE("incompatible geometry is rejected") {
+        auto name = region_name("geometry");
+        shared_glyph_atlas::remove(name);
+
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        auto first = open_helva(name, font);
+
+        shared_atlas_config other;
+        other.atlas_size = 256;
+        CHECK_THROWS_AS(open_helva(name, font, other), std::runtime_error);
+
+        shared_glyph_atlas::remove(name);
+    }
+
+    TEST_CASE("full atlas throws length_error") {
+        auto name = region_name("full");
+        shared_glyph_atlas::remove(name);
+
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        shared_atlas_config config;
+        config.atlas_size = 32;
+        config.max_pages = 1;
+        auto atlas = open_helva(name, font, config);
+
+        CHECK_THROWS_AS(atlas.cache_range('!', '~'), std::length_error);
+
+        shared_glyph_atlas::remove(name);
+    }
+
+    TEST_CASE("glyph rasterized in child process is visible in parent") {
+        auto name = region_name("child");
+        shared_glyph_atlas::remove(name);
+
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto parent = open_helva(name, font);
+
+        pid_t pid = ::fork();
+        REQUIRE(pid >= 0);
+        if (pid == 0) {
+            int rc = 1;
+            try {
+                auto child = open_helva(name, font);
+                child.cache_string("Shared");
+                rc = child.is_creator() ? 2 : 0;
+            } catch (...) {
+            }
+            ::_exit(rc);
+        }
+
+        CHECK(wait_children({pid}));
+
+        // The parent never rasterized these
+        CHECK(parent.is_cached('S'));
+        CHECK(parent.is_cached('d'));
+        CHECK(parent.glyph_count() == 6);
+        CHECK(has_pixels(parent, parent.get('S')));
+
+        shared_glyph_atlas::remove(name);
+    }
+
+    TEST_CASE("concurrent processes rasterize each glyph once") {
+        auto name = region_name("concurrent");
+        shared_glyph_atlas::remove(name);
+
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        shared_atlas_config config;
+        config.atlas_size = 256;
+        auto parent = open_helva(name, font, config);
+
+        std::vector<pid_t> children;
+        for (int i = 0; i < 4; ++i) {
+            pid_t pid = ::fork();
+            REQUIRE(pid >= 0);
+            if (pid == 0) {
+                int rc = 1;
+                try {
+                    auto child = open_helva(name, font, config);
+                    // Different starting points to maximise contention
+                    child.cache_range(static_cast<char32_t>('!' + i * 20), '~');
+                    child.cache_range('!', '~');
+                    rc = 0;
+                } catch (...) {
+                }
+                ::_exit(rc);
+            }
+            children.push_back(pid);
+        }
+
+        CHECK(wait_children(children));
+        CHECK(parent.glyph_count() == '~' - '!' + 1);
+
+        // No two glyphs may overlap
+        std::vector<cached_glyph> glyphs;
+        for (char32_t cp = '!'; cp <= '~'; ++cp) {
+            REQUIRE(parent.is_cached(cp));
+            glyphs.push_back(parent.get(cp));
+        }
+        CHECK(parent.glyph_count() == '~' - '!' + 1);
+
+        for (std::size_t i = 0; i < glyphs.size(); ++i) {
+            for (std::size_t j = i + 1; j < glyphs.size(); ++j) {
+                const auto& a = glyphs[i];
+                const auto& b = glyphs[j];
+                if (a.rect.w == 0 || b.rect.w == 0 || a.atlas_index != b.atlas_index) continue;
+                bool apart = a.rect.x + a.rect.w <= b.rect.x || b.rect.x + b.rect.w <= a.rect.x ||
+                             a.rect.y + a.rect.h <= b.rect.y || b.rect.y + b.rect.h <= a.rect.y;
+                CHECK(apart);
+            }
+        }
+
+        shared_glyph_atlas::remove(name);
+    }
+}
+
+#endif
@@ -0,0 +1,126 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for sized_face
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/sized_face.hh>
+#include <onyx_font/text/text_rasterizer.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <utility>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    bool same_metrics(const glyph_metrics& a, const glyph_metrics& b) {
+        return a.advance_x == b.advance_x && a.bearing_x == b.bearing_x &&
+               a.bearing_y == b.bearing_y && a.width == b.width && a.height == b.height;
+    }
+}
+
+TEST_SUITE("sized_face") {
+
+    TEST_CASE("bitmap face matches font_source") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto source = font_source::from_bitmap(font);
+
+        // Bitmap fonts ignore the requested size
+        sized_face face(source, 40.0f);
+        CHECK(face.scale() == 1.0f);
+        CHECK_FALSE(face.has_kerning());
+        CHECK(face.line_height() == source.get_scaled_metrics(0).line_height);
+        CHECK(face.metrics().ascent == source.get_scaled_metrics(0).ascent);
+
+        for (char32_t cp = 0; cp < 256; ++cp) {
+            CHECK(same_metrics(face.get_glyph_metrics(cp), source.get_glyph_metrics(cp, 40.0f)));
+        }
+        CHECK(face.kerning('A', 'V') == 0.0f);
+    }
+
+    TEST_CASE("vector face matches font_source") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+        auto source = font_source::from_vector(font);
+
+        sized_face face(source, 30.0f);
+        CHECK(face.size() == 30.0f);
+        CHECK(face.scale() == doctest::Approx(30.0f / static_cast<float>(font.get_metrics().pixel_height)));
+        CHECK(face.line_height() == source.get_scaled_metrics(30.0f).line_height);
+
+        for (char32_t cp = 0; cp < 256; ++cp) {
+            CHECK(same_metrics(face.get_glyph_metrics(cp), source.get_glyph_metrics(cp, 30.0f)));
+        }
+    }
+
+    TEST_CASE("ttf face matches font_source") {
+        if (!test_data::file_exists(test_data::ttf_arial())) {
+            WARN("Arial TTF not available");
+            return;
+        }
+
+        auto data = test_data::load_ttf_arial();
+        ttf_font ttf(data);
+        auto source = font_source::from_ttf(ttf);
+
+        sized_face face(source, 24.0f);
+        CHECK(face.has_kerning());
+        CHECK(face.scale() == ttf.scale_for_pixel_height(24.0f));
+        CHECK(face.metrics().ascent == source.get_scaled_metrics(24.0f).ascent);
+        CHECK(face.line_height() == source.get_scaled_metrics(24.0f).line_height);
+
+        // Cached ASCII and forwarded non-ASCII agree with the size-based API
+        for (char32_t cp : {U'A', U'g', U' ', U'~', U'é', U'Ж'}) {
+            CHECK(same_metrics(face.get_glyph_metrics(cp), source.get_glyph_metrics(cp, 24.0f)));
+        }
+        CHECK(face.kerning('A', 'V') == source.get_kerning('A', 'V', 24.0f));
+    }
+
+    TEST_CASE("text_rasterizer keeps its face across moves and resizes") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        text_rasterizer raster(font_source::from_vector(font));
+        raster.set_size(20.0f);
+        CHECK(raster.face().size() == 20.0f);
+        CHECK(&raster.face().source() == &raster.source());
+
+        float width = raster.measure_text("Hello").width;
+
+        text_rasterizer moved(std::move(raster));
+        CHECK(&moved.face().source() == &moved.source());
+        CHECK(moved.measure_text("Hello").width == width);
+
+        moved.set_size(40.0f);
+        CHECK(moved.face().size() == 40.0f);
+        CHECK(moved.line_height() == moved.source().get_scaled_metrics(40.0f).line_height);
+        CHECK(moved.measure_text("Hello").width > width);
+    }
+
+    TEST_CASE("text_rasterizer copies rebind their face") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        text_rasterizer raster(font_source::from_vector(font));
+        raster.set_size(20.0f);
+        float width = raster.measure_text("Hello").width;
+
+        text_rasterizer copy(raster);
+        CHECK(&copy.face().source() == &copy.source());
+        CHECK(copy.face().size() == 20.0f);
+        CHECK(copy.measure_text("Hello").width == width);
+
+        // The copy is independent of the original
+        copy.set_size(40.0f);
+        CHECK(raster.face().size() == 20.0f);
+        CHECK(raster.measure_text("Hello").width == width);
+
+        raster = copy;
+        CHECK(&raster.face().source() == &raster.source());
+        CHECK(raster.face().size() == 40.0f);
+        CHECK(raster.measure_text("Hello").width == copy.measure_text("Hello").width);
+    }
+}
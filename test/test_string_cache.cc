@@ -0,0 +1,157 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for string_texture_cache
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/string_cache.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <cmath>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    /// Composite the glyphs of a line the way text_renderer positions them
+    owned_grayscale_target reference(glyph_cache<memory_atlas>& cache, std::string_view text,
+                                     float origin_x, float origin_y, int w, int h) {
+        owned_grayscale_target target(w, h);
+        text_renderer<memory_atlas> renderer(cache);
+        renderer.draw(text, 0.0f, 0.0f,
+                      [&](const memory_atlas& atlas, glyph_rect src, float x, float y) {
+                          int ox = static_cast<int>(std::lround(x - origin_x));
+                          int oy = static_cast<int>(std::lround(y - origin_y));
+                          for (int row = 0; row < src.h; ++row) {
+                              for (int col = 0; col < src.w; ++col) {
+                                  uint8_t a = atlas.pixel(src.x + col, src.y + row);
+                                  if (a > target.pixel(ox + col, oy + row)) {
+                                      target.put_pixel(ox + col, oy + row, a);
+                                  }
+                              }
+                          }
+                      });
+        return target;
+    }
+}
+
+TEST_SUITE("string_texture_cache") {
+    TEST_CASE("line image matches the glyph quads") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f);
+        string_texture_cache<memory_atlas> strings;
+
+        const rendered_string& s = strings.get(cache, "Hello");
+        REQUIRE(s.image.width() > 0);
+        REQUIRE(s.image.height() > 0);
+        CHECK(s.lines == 1);
+
+        text_renderer<memory_atlas> renderer(cache);
+        CHECK(s.width == renderer.measure("Hello").width);
+
+        auto expected = reference(cache, "Hello", s.offset_x, s.offset_y,
+                                  s.image.width(), s.image.height());
+        int lit = 0;
+        for (int y = 0; y < s.image.height(); ++y) {
+            for (int x = 0; x < s.image.width(); ++x) {
+                CHECK(s.image.pixel(x, y) == expected.pixel(x, y));
+                lit += s.image.pixel(x, y) != 0;
+            }
+        }
+        CHECK(lit > 0);
+    }
+
+    TEST_CASE("repeated strings hit and keep their id") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f);
+        string_texture_cache<memory_atlas> strings;
+
+        uint64_t id = strings.get(cache, "OK").id;
+        CHECK(strings.get(cache, "OK").id == id);
+        CHECK(strings.hits() == 1);
+        CHECK(strings.misses() == 1);
+
+        int calls = 0;
+        float width = strings.draw(cache, "OK", 100.0f, 50.0f,
+                                   [&](const rendered_string& s, float x, float y) {
+                                       CHECK(s.id == id);
+                                       CHECK(x == 100.0f + s.offset_x);
+                                       CHECK(y == 50.0f + s.offset_y);
+                                       ++calls;
+                                   });
+        CHECK(calls == 1);
+        CHECK(width > 0);
+
+        // Another glyph cache is another key
+        glyph_cache<memory_atlas> other(font_source::from_bitmap(font), 12.0f);
+        CHECK(strings.get(other, "OK").id != id);
+        CHECK(strings.size() == 2);
+
+        // Whitespace has no image and is not drawn
+        calls = 0;
+        strings.draw(cache, "   ", 0.0f, 0.0f,
+                     [&](const rendered_string&, float, float) { ++calls; });
+        CHECK(calls == 0);
+    }
+
+    TEST_CASE("least recently used strings are dropped") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f);
+        string_texture_cache<memory_atlas> strings(2);
+
+        uint64_t a = strings.get(cache, "a").id;
+        (void)strings.get(cache, "b");
+        (void)strings.get(cache, "a");
+        (void)strings.get(cache, "c");  // drops "b"
+
+        CHECK(strings.size() == 2);
+        CHECK(strings.get(cache, "a").id == a);
+        auto misses = strings.misses();
+        (void)strings.get(cache, "b");
+        CHECK(strings.misses() == misses + 1);
+
+        std::size_t bytes = strings.memory_bytes();
+        CHECK(bytes > 0);
+        strings.clear();
+        CHECK(strings.size() == 0);
+        CHECK(strings.memory_bytes() == 0);
+    }
+
+    TEST_CASE("byte limit keeps the newest string") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f);
+        string_texture_cache<memory_atlas> strings(16, 1);
+
+        (void)strings.get(cache, "first");
+        const rendered_string& s = strings.get(cache, "second");
+        CHECK(strings.size() == 1);
+        CHECK(s.image.width() > 0);
+    }
+
+    TEST_CASE("wrapped strings have one image for all lines") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f);
+        string_texture_cache<memory_atlas> strings;
+        text_renderer<memory_atlas> renderer(cache);
+
+        float line_h = renderer.line_height();
+        int lines = strings.draw_wrapped(cache, "one two three four", 0.0f, 0.0f, 30.0f,
+                                         text_align::left,
+                                         [&](const rendered_string& s, float, float) {
+                                             CHECK(static_cast<float>(s.image.height()) > line_h);
+                                         });
+        CHECK(lines >= 2);
+
+        // Alignment is part of the key
+        uint64_t left = strings.get_wrapped(cache, "one two three four", 30.0f).id;
+        uint64_t right = strings.get_wrapped(cache, "one two three four", 30.0f, text_align::right).id;
+        CHECK(left != right);
+    }
+}
@@ -0,0 +1,306 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for alpha_downsampler, reference_strike and supersampled strikes
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/supersample.hh>
+#include <onyx_font/text/glyph_cache.hh>
+#include <onyx_font/text/raster_target.hh>
+#include <onyx_font/font_converter.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    /// Fraction of pixel (x, y) inside a disc, estimated with n x n samples
+    float disc_coverage(float cx, float cy, float r, int x, int y, int n) {
+        int inside = 0;
+        for (int sy = 0; sy < n; ++sy) {
+            for (int sx = 0; sx < n; ++sx) {
+                float px = static_cast<float>(x) + (static_cast<float>(sx) + 0.5f) / static_cast<float>(n);
+                float py = static_cast<float>(y) + (static_cast<float>(sy) + 0.5f) / static_cast<float>(n);
+                if ((px - cx) * (px - cx) + (py - cy) * (py - cy) <= r * r) {
+                    ++inside;
+                }
+            }
+        }
+        return static_cast<float>(inside) / static_cast<float>(n * n);
+    }
+
+    struct comparison {
+        double mean_abs_diff = 0;   ///< Over pixels covered by either image
+        double coverage_ratio = 1;  ///< Sum(b) / Sum(a)
+    };
+
+    comparison compare(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+        double diff = 0, sum_a = 0, sum_b = 0;
+        int count = 0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (a[i] || b[i]) {
+                diff += std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i]));
+                ++count;
+            }
+            sum_a += a[i];
+            sum_b += b[i];
+        }
+        comparison result;
+        if (count > 0) result.mean_abs_diff = diff / count;
+        if (sum_a > 0) result.coverage_ratio = sum_b / sum_a;
+        return result;
+    }
+}
+
+TEST_SUITE("supersample") {
+
+    TEST_CASE("area filter averages whole blocks") {
+        // Pixel checkerboard of 0/255 -> every output pixel is half covered
+        std::vector<uint8_t> src(8 * 8);
+        for (int y = 0; y < 8; ++y) {
+            for (int x = 0; x < 8; ++x) {
+                src[static_cast<std::size_t>(y * 8 + x)] = ((x + y) % 2) ? 255 : 0;
+            }
+        }
+        std::vector<uint8_t> dst(4 * 4, 7);
+        alpha_downsampler ds;
+        ds.resample(src.data(), 8, 8, 8, dst.data(), 4, 4, 4, 0.5f, 0.0f, 0.0f);
+        for (uint8_t v : dst) {
+            CHECK(v == 128);
+        }
+    }
+
+    TEST_CASE("area filter handles fractional placement") {
+        // 8x8 solid block shrunk 4x and placed at (0.5, 0.5): spans [0.5, 2.5)
+        std::vector<uint8_t> src(8 * 8, 255);
+        std::vector<uint8_t> dst(4 * 4, 99);
+        alpha_downsampler ds;
+        ds.resample(src.data(), 8, 8, 8, dst.data(), 4, 4, 4, 0.25f, 0.5f, 0.5f);
+
+        const float cover[4] = {0.5f, 1.0f, 0.5f, 0.0f};
+        for (int y = 0; y < 4; ++y) {
+            for (int x = 0; x < 4; ++x) {
+                int expected = static_cast<int>(std::lround(255.0f * cover[x] * cover[y]));
+                CHECK(std::abs(dst[static_cast<std::size_t>(y * 4 + x)] - expected) <= 1);
+            }
+        }
+    }
+
+    TEST_CASE("stride and odd widths") {
+        // Destination wider than one SIMD group with an odd tail
+        const int src_w = 39, src_h = 30, dst_w = 13, dst_h = 10, dst_stride = 16;
+        std::vector<uint8_t> src(static_cast<std::size_t>(src_w * src_h), 200);
+        std::vector<uint8_t> dst(static_cast<std::size_t>(dst_stride * dst_h), 77);
+
+        for (auto filter : {downsample_filter::area, downsample_filter::lanczos}) {
+            alpha_downsampler ds;
+            ds.resample(src.data(), src_w, src_h, src_w, dst.data(), dst_w, dst_h, dst_stride,
+                        1.0f / 3.0f, 0.0f, 0.0f, filter);
+
+            // Lanczos reaches past the source near its edges, where samples are 0
+            int border = filter == downsample_filter::lanczos ? 2 : 0;
+            for (int y = 0; y < dst_h; ++y) {
+                for (int x = 0; x < dst_w; ++x) {
+                    if (y >= border && y < dst_h - border && x >= border && x < dst_w - border) {
+                        CHECK(std::abs(dst[static_cast<std::size_t>(y * dst_stride + x)] - 200) <= 1);
+                    }
+                }
+                // Padding between rows is untouched
+                CHECK(dst[static_cast<std::size_t>(y * dst_stride + dst_w)] == 77);
+            }
+        }
+    }
+
+    TEST_CASE("lanczos clamps ringing") {
+        // Vertical hard edge: ringing must not wrap around 0 or 255. The
+        // source extends past the checked pixels so the kernel never leaves it.
+        const int src_w = 40, src_h = 40;
+        std::vector<uint8_t> src(static_cast<std::size_t>(src_w * src_h), 0);
+        for (int y = 0; y < src_h; ++y) {
+            for (int x = 16; x < src_w; ++x) {
+                src[static_cast<std::size_t>(y * src_w + x)] = 255;
+            }
+        }
+        std::vector<uint8_t> dst(8 * 10);
+        alpha_downsampler ds;
+        ds.resample(src.data(), src_w, src_h, src_w, dst.data(), 8, 10, 8, 0.25f, 0.0f, 0.0f,
+                    downsample_filter::lanczos);
+
+        const uint8_t* row = dst.data() + 5 * 8;
+        CHECK(row[0] <= 2);
+        CHECK(row[1] <= 2);
+        CHECK(row[6] >= 253);
+        for (std::size_t x = 1; x < 7; ++x) {
+            CHECK(row[x] + 2 >= row[x - 1]);  // Monotone apart from tiny ringing
+        }
+    }
+
+    TEST_CASE("downsampled disc matches exact coverage") {
+        // Binary disc at 8x, filtered down, versus analytic coverage at 1x
+        const int size = 16, factor = 8;
+        const float cx = 7.3f, cy = 8.1f, r = 5.2f;
+
+        std::vector<uint8_t> high(static_cast<std::size_t>(size * factor * size * factor));
+        for (int y = 0; y < size * factor; ++y) {
+            for (int x = 0; x < size * factor; ++x) {
+                float px = (static_cast<float>(x) + 0.5f) / factor;
+                float py = (static_cast<float>(y) + 0.5f) / factor;
+                bool inside = (px - cx) * (px - cx) + (py - cy) * (py - cy) <= r * r;
+                high[static_cast<std::size_t>(y * size * factor + x)] = inside ? 255 : 0;
+            }
+        }
+
+        std::vector<uint8_t> low(static_cast<std::size_t>(size * size));
+        alpha_downsampler ds;
+        ds.resample(high.data(), size * factor, size * factor, size * factor,
+                    low.data(), size, size, size, 1.0f / factor, 0.0f, 0.0f);
+
+        int max_error = 0;
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                int exact = static_cast<int>(std::lround(255.0f * disc_coverage(cx, cy, r, x, y, 64)));
+                max_error = std::max(max_error, std::abs(low[static_cast<std::size_t>(y * size + x)] - exact));
+            }
+        }
+        CHECK(max_error <= 12);
+    }
+
+    TEST_CASE("bitmap sources are not downsampled") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        reference_strike strike(font_source::from_bitmap(font), 64.0f);
+        CHECK_FALSE(strike.supports(12.0f));
+    }
+
+    TEST_CASE("vector sources fall back to direct rasterization") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+        auto strike = std::make_shared<reference_strike>(font_source::from_vector(font), 64.0f);
+        CHECK_FALSE(strike->supports(12.0f));
+
+        glyph_cache_config config;
+        config.reference = strike;
+        glyph_cache<memory_atlas> with(font_source::from_vector(font), 16.0f, config);
+        glyph_cache<memory_atlas> without(font_source::from_vector(font), 16.0f);
+        CHECK(strike->glyph_count() == 0);
+        for (char32_t cp = 33; cp < 127; ++cp) {
+            CHECK(with.get(cp).rect.w == without.get(cp).rect.w);
+            CHECK(with.get(cp).advance_x == without.get(cp).advance_x);
+        }
+    }
+
+    TEST_CASE("strike quality against direct rasterization") {
+        if (!test_data::file_exists(test_data::ttf_arial())) {
+            WARN("Arial TTF not available");
+            return;
+        }
+
+        auto data = test_data::load_ttf_arial();
+        ttf_font ttf(data);
+        auto direct = font_source::from_ttf(ttf);
+
+        for (auto filter : {downsample_filter::area, downsample_filter::lanczos}) {
+            reference_strike strike(font_source::from_ttf(ttf), 96.0f, filter);
+
+            for (float size : {12.0f, 18.0f, 32.0f}) {
+                REQUIRE(strike.supports(size));
+                const int w = static_cast<int>(size) * 2;
+                const int h = static_cast<int>(size) * 2;
+                const int pen_x = static_cast<int>(size) / 2;
+                const int pen_y = static_cast<int>(size * 1.4f);
+
+                for (char32_t cp : {U'A', U'g', U'W', U'e', U'@'}) {
+                    std::vector<uint8_t> a(static_cast<std::size_t>(w * h), 0);
+                    grayscale_target target(a.data(), w, h);
+                    direct.rasterize_glyph(cp, size, target, pen_x, pen_y);
+
+                    std::vector<uint8_t> b(static_cast<std::size_t>(w * h), 0);
+                    strike.draw(cp, size, b.data(), w, h, w,
+                                static_cast<float>(pen_x), static_cast<float>(pen_y));
+
+                    auto cmp = compare(a, b);
+                    CHECK(cmp.coverage_ratio == doctest::Approx(1.0).epsilon(0.12));
+                    CHECK(cmp.mean_abs_diff < 48.0);
+
+                    // Derived metrics track the direct ones
+                    auto m = strike.get_glyph_metrics(cp, size);
+                    auto d = direct.get_glyph_metrics(cp, size);
+                    CHECK(m.advance_x == doctest::Approx(d.advance_x).epsilon(0.01));
+                    CHECK(std::fabs(m.width - d.width) <= 1.5f);
+                }
+            }
+        }
+    }
+
+    TEST_CASE("caches at many sizes share one rasterization") {
+        if (!test_data::file_exists(test_data::ttf_arial())) {
+            WARN("Arial TTF not available");
+            return;
+        }
+
+        auto data = test_data::load_ttf_arial();
+        ttf_font ttf(data);
+        auto strike = std::make_shared<reference_strike>(font_source::from_ttf(ttf), 64.0f);
+
+        glyph_cache_config config;
+        config.reference = strike;
+
+        std::vector<std::unique_ptr<glyph_cache<memory_atlas>>> caches;
+        for (int px = 10; px <= 20; px += 2) {
+            caches.push_back(std::make_unique<glyph_cache<memory_atlas>>(
+                font_source::from_ttf(ttf), static_cast<float>(px), config));
+        }
+        // ASCII was pre-cached at every size, but rasterized once
+        CHECK(strike->glyph_count() == 95);
+
+        const auto& small = caches.front()->get('M');
+        const auto& large = caches.back()->get('M');
+        CHECK(small.rect.w > 0);
+        CHECK(large.rect.w > small.rect.w);
+        CHECK(large.advance_x == doctest::Approx(small.advance_x * 2.0f).epsilon(0.01));
+
+        // Box and bearings agree
+        glyph_rect box = strike->box('M', 20.0f);
+        CHECK(large.rect.w == box.w);
+        CHECK(large.bearing_x == static_cast<float>(box.x));
+        CHECK(large.bearing_y == static_cast<float>(-box.y));
+    }
+
+    TEST_CASE("converter batch with supersampling") {
+        if (!test_data::file_exists(test_data::ttf_arial())) {
+            WARN("Arial TTF not available");
+            return;
+        }
+
+        auto data = test_data::load_ttf_arial();
+        ttf_font ttf(data);
+
+        conversion_options options;
+        options.first_char = 32;
+        options.last_char = 126;
+        options.supersample_size = 64.0f;
+
+        const float sizes[] = {10.0f, 14.0f, 20.0f, 80.0f};
+        auto fonts = font_converter::from_ttf(ttf, sizes, options);
+        REQUIRE(fonts.size() == 4);
+
+        conversion_options plain = options;
+        plain.supersample_size = 0.0f;
+        for (std::size_t i = 0; i < 4; ++i) {
+            auto reference = font_converter::from_ttf(ttf, sizes[i], plain);
+            CHECK(fonts[i].get_metrics().pixel_height == reference.get_metrics().pixel_height);
+            CHECK(std::abs(fonts[i].get_metrics().ascent - reference.get_metrics().ascent) <= 1);
+
+            auto a = fonts[i].get_glyph('H');
+            auto b = reference.get_glyph('H');
+            CHECK(std::abs(a.width() - b.width()) <= 2);
+            CHECK(std::abs(a.height() - b.height()) <= 2);
+        }
+    }
+}
@@ -277,4 +277,102 @@ TEST_SUITE("text_renderer") {
         // Space should add width
         CHECK(width_with_space > width_no_space);
     }
+
+    TEST_CASE("draw_batched groups glyphs by layer") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto source = font_source::from_bitmap(font);
+
+        glyph_cache_config config;
+        config.atlas_size = 32;  // Force glyphs onto several pages
+        config.pre_cache_ascii = false;
+        glyph_cache<memory_atlas> cache(std::move(source), 12.0f, config);
+        text_renderer renderer(cache);
+
+        const std::string_view text = "The quick brown fox";
+
+        // Reference positions from the text-order path
+        std::vector<std::tuple<glyph_rect, float, float>> blits;
+        float width = renderer.draw(text, 5.0f, 7.0f,
+            [&](const memory_atlas&, glyph_rect src, float x, float y) {
+                blits.emplace_back(src, x, y);
+            });
+        REQUIRE(cache.atlas_count() > 1);
+
+        std::vector<int> batch_layers;
+        std::size_t quad_count = 0;
+        float batched_width = renderer.draw_batched(text, 5.0f, 7.0f,
+            [&](std::span<const glyph_quad> quads) {
+                REQUIRE(!quads.empty());
+                for (const auto& q : quads) {
+                    CHECK(q.layer == quads[0].layer);
+                    bool found = false;
+                    for (const auto& [src, x, y] : blits) {
+                        if (src.x == q.src.x && src.y == q.src.y &&
+                            x == q.dst_x && y == q.dst_y) {
+                            found = true;
+                        }
+                    }
+                    CHECK(found);
+                }
+                batch_layers.push_back(quads[0].layer);
+                quad_count += quads.size();
+            });
+
+        CHECK(batched_width == width);
+        CHECK(quad_count == blits.size());
+        // One batch per page, each page visited once
+        std::set<int> unique_layers(batch_layers.begin(), batch_layers.end());
+        CHECK(unique_layers.size() == batch_layers.size());
+        CHECK(batch_layers.size() > 1);
+    }
+
+    TEST_CASE("draw_batched texture array is a single call") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto source = font_source::from_bitmap(font);
+
+        glyph_cache_config config;
+        config.atlas_size = 32;
+        config.pre_cache_ascii = false;
+        config.layout = atlas_layout::texture_array;
+        glyph_cache<memory_atlas> cache(std::move(source), 12.0f, config);
+        text_renderer renderer(cache);
+
+        int calls = 0;
+        std::set<int> layers;
+        renderer.draw_batched("The quick brown fox", 0.0f, 0.0f,
+            [&](std::span<const glyph_quad> quads) {
+                ++calls;
+                for (const auto& q : quads) {
+                    layers.insert(q.layer);
+                }
+            });
+
+        CHECK(calls == 1);
+        CHECK(layers.size() > 1);
+    }
+
+    TEST_CASE("draw_wrapped_batched matches draw_wrapped") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        auto source = font_source::from_bitmap(font);
+
+        glyph_cache<memory_atlas> cache(std::move(source), 12.0f);
+        text_renderer renderer(cache);
+
+        text_box box{0, 0, 60, 200};
+        std::size_t blit_count = 0;
+        int lines = renderer.draw_wrapped("Hello world this is wrapped", box,
+            text_align::center,
+            [&](const memory_atlas&, glyph_rect, float, float) { ++blit_count; });
+
+        std::size_t quad_count = 0;
+        int batched_lines = renderer.draw_wrapped_batched("Hello world this is wrapped",
+            box, text_align::center,
+            [&](std::span<const glyph_quad> quads) { quad_count += quads.size(); });
+
+        CHECK(batched_lines == lines);
+        CHECK(quad_count == blit_count);
+    }
 }
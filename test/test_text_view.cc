@@ -0,0 +1,166 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for text_view damage tracking
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/text_view.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    struct frame {
+        std::vector<text_box> cleared;
+        std::vector<float> scrolls;
+        int blits = 0;
+    };
+
+    template<typename View>
+    std::vector<text_box> render(View& view, frame& f) {
+        auto damage = view.render([&f](const text_box& r) { f.cleared.push_back(r); },
+                                  [&f](const memory_atlas&, glyph_rect, float, float) { ++f.blits; });
+        return {damage.begin(), damage.end()};
+    }
+
+    template<typename View>
+    std::vector<text_box> render_scrolling(View& view, frame& f) {
+        auto damage = view.render([&f](const text_box& r) { f.cleared.push_back(r); },
+                                  [&f](const memory_atlas&, glyph_rect, float, float) { ++f.blits; },
+                                  [&f](const text_box&, float dy) { f.scrolls.push_back(dy); });
+        return {damage.begin(), damage.end()};
+    }
+}
+
+TEST_SUITE("text_view") {
+    TEST_CASE("first render draws every row, second draws nothing") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f);
+        float line_h = cache.line_height();
+        text_view<memory_atlas> view(cache, text_box{10, 20, 200, line_h * 4});
+
+        view.set_text("alpha\nbeta\ngamma");
+        CHECK(view.line_count() == 3);
+        CHECK(view.rows() == 4);
+        CHECK(view.dirty());
+
+        frame f;
+        auto damage = render(view, f);
+        CHECK(f.cleared.size() == 4);
+        CHECK(f.blits > 0);
+        REQUIRE(damage.size() == 1);  // adjacent rows merge
+        CHECK(damage[0].x == 10.0f);
+        CHECK(damage[0].y == 20.0f);
+        CHECK(damage[0].h == doctest::Approx(line_h * 4));
+
+        frame g;
+        CHECK_FALSE(view.dirty());
+        CHECK(render(view, g).empty());
+        CHECK(g.blits == 0);
+
+        // Same text again: nothing changes
+        view.set_text("alpha\nbeta\ngamma");
+        CHECK_FALSE(view.dirty());
+    }
+
+    TEST_CASE("changing one line damages one row") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f);
+        float line_h = cache.line_height();
+        text_view<memory_atlas> view(cache, text_box{0, 0, 300, line_h * 3});
+        view.set_text("one\ntwo\nthree");
+        frame first;
+        render(view, first);
+
+        view.set_line(1, "two!");
+        frame f;
+        auto damage = render(view, f);
+        REQUIRE(damage.size() == 1);
+        CHECK(damage[0].y == doctest::Approx(line_h));
+        CHECK(damage[0].h == doctest::Approx(line_h));
+        CHECK(damage[0].w > 0.0f);
+        CHECK(damage[0].w < 300.0f);  // only up to the ink
+        CHECK(f.blits == 4);
+
+        CHECK_THROWS_AS(view.set_line(3, "x"), std::out_of_range);
+
+        // Lines 0 and 2 changing gives two separate rects
+        view.set_text("ONE\ntwo!\nTHREE");
+        auto two = render(view, f);
+        CHECK(two.size() == 2);
+
+        view.invalidate();
+        frame all;
+        render(view, all);
+        CHECK(all.cleared.size() == 3);
+    }
+
+    TEST_CASE("streamed appends and max lines") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f);
+        text_view<memory_atlas> view(cache, text_box{0, 0, 300, cache.line_height() * 3});
+
+        view.append("con");
+        view.append("nected\nready");
+        REQUIRE(view.line_count() == 2);
+        CHECK(view.line(0) == "connected");
+        CHECK(view.line(1) == "ready");
+
+        view.set_max_lines(3);
+        view.append_line("a");
+        view.append_line("b");
+        CHECK(view.line_count() == 3);
+        CHECK(view.line(0) == "ready");
+
+        view.clear();
+        CHECK(view.line_count() == 0);
+    }
+
+    TEST_CASE("following the tail scrolls retained rows") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f);
+        float line_h = cache.line_height();
+        text_view<memory_atlas> view(cache, text_box{0, 0, 300, line_h * 3});
+        view.set_follow_tail(true);
+        view.set_max_lines(100);
+
+        view.set_text("l1\nl2\nl3");
+        frame first;
+        render_scrolling(view, first);
+        CHECK(first.scrolls.empty());
+
+        view.append_line("l4");
+        CHECK(view.top_line() == 1);
+        frame f;
+        auto damage = render_scrolling(view, f);
+        REQUIRE(f.scrolls.size() == 1);
+        CHECK(f.scrolls[0] == doctest::Approx(-line_h));
+        REQUIRE(f.cleared.size() == 1);  // only the row scrolled in
+        CHECK(f.cleared[0].y == doctest::Approx(line_h * 2));
+        CHECK(f.blits == 2);
+        REQUIRE(damage.size() == 1);
+        CHECK(damage[0].h == doctest::Approx(line_h * 3));
+
+        // Trimming the front keeps the absolute position
+        view.set_max_lines(4);
+        view.append_line("l5");
+        frame g;
+        render_scrolling(view, g);
+        CHECK(g.scrolls.size() == 1);
+        CHECK(g.cleared.size() == 1);
+
+        // Without a scroll callback every row moves
+        view.append_line("l6");
+        frame h;
+        render(view, h);
+        CHECK(h.cleared.size() == 3);
+    }
+}
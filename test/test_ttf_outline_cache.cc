@@ -0,0 +1,202 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for ttf_outline_cache, flattened_outline_cache and flatten_outline
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/ttf_outline_cache.hh>
+#include "test_data.hh"
+#include <cmath>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    using V = ttf_vertex_type;
+
+    float distance_to_quad(float px, float py, float x0, float y0,
+                           float cx, float cy, float x1, float y1) {
+        float best = 1e9f;
+        for (int i = 0; i <= 20000; ++i) {
+            float t = static_cast<float>(i) / 20000.0f;
+            float u = 1.0f - t;
+            float x = u * u * x0 + 2 * u * t * cx + t * t * x1;
+            float y = u * u * y0 + 2 * u * t * cy + t * t * y1;
+            best = std::min(best, std::hypot(px - x, py - y));
+        }
+        return best;
+    }
+}
+
+TEST_SUITE("ttf_outline_cache") {
+
+    TEST_CASE("flatten polygon") {
+        // Square drawn with an explicit closing line back to the start
+        const V verbs[] = {V::MOVE_TO, V::LINE_TO, V::LINE_TO, V::LINE_TO, V::LINE_TO};
+        const int16_t coords[] = {0, 0, 100, 0, 100, 100, 0, 100, 0, 0};
+        glyph_outline outline;
+        outline.verbs = verbs;
+        outline.coords = coords;
+
+        std::vector<flat_point> points;
+        std::vector<uint32_t> ends;
+        flatten_outline(outline, 0.5f, 0.25f, points, ends);
+
+        REQUIRE(ends.size() == 1);
+        CHECK(ends[0] == 4);  // Closing duplicate dropped
+        REQUIRE(points.size() == 4);
+        CHECK(points[1].x == 50.0f);
+        CHECK(points[2].y == 50.0f);
+    }
+
+    TEST_CASE("flatten quadratic within tolerance") {
+        const V verbs[] = {V::MOVE_TO, V::CURVE_TO, V::LINE_TO};
+        const int16_t coords[] = {0, 0, 500, 1000, 1000, 0, 0, 0};
+        glyph_outline outline;
+        outline.verbs = verbs;
+        outline.coords = coords;
+
+        const float scale = 0.1f;
+        std::vector<flat_point> coarse_points, fine_points;
+        std::vector<uint32_t> coarse_ends, fine_ends;
+        flatten_outline(outline, scale, 1.0f, coarse_points, coarse_ends);
+        flatten_outline(outline, scale, 0.05f, fine_points, fine_ends);
+
+        // Tighter tolerance needs more points
+        CHECK(fine_points.size() > coarse_points.size());
+
+        // Chord midpoints stay within tolerance of the curve
+        for (std::size_t i = 0; i + 1 < fine_points.size(); ++i) {
+            float mx = (fine_points[i].x + fine_points[i + 1].x) / 2;
+            float my = (fine_points[i].y + fine_points[i + 1].y) / 2;
+            CHECK(distance_to_quad(mx, my, 0, 0, 50, 100, 100, 0) <= 0.05f + 1e-3f);
+        }
+
+        // Curve end point is hit exactly
+        bool has_end = false;
+        for (const auto& p : fine_points) {
+            has_end = has_end || (p.x == 100.0f && p.y == 0.0f);
+        }
+        CHECK(has_end);
+    }
+
+    TEST_CASE("flatten multiple contours and cubic") {
+        const V verbs[] = {V::MOVE_TO, V::LINE_TO, V::LINE_TO,
+                           V::MOVE_TO,                        // Degenerate: dropped
+                           V::MOVE_TO, V::CUBIC_TO};
+        const int16_t coords[] = {0, 0, 10, 0, 10, 10,
+                                  50, 50,
+                                  20, 0, 20, 30, 40, 30, 40, 0};
+        glyph_outline outline;
+        outline.verbs = verbs;
+        outline.coords = coords;
+
+        std::vector<flat_point> points;
+        std::vector<uint32_t> ends;
+        flatten_outline(outline, 1.0f, 0.1f, points, ends);
+
+        REQUIRE(ends.size() == 2);
+        CHECK(ends[0] == 3);
+        CHECK(ends[1] > ends[0] + 3);
+        CHECK(points[ends[0]].x == 20.0f);
+        CHECK(points.back().x == 40.0f);
+        CHECK(points.back().y == 0.0f);
+    }
+
+    TEST_CASE("missing glyphs are cached as absent") {
+        std::vector<uint8_t> empty;
+        ttf_font font(empty);
+        ttf_outline_cache outlines(font);
+
+        CHECK(outlines.get('A') == nullptr);
+        CHECK(outlines.glyph_count() == 1);
+        CHECK(outlines.get('A') == nullptr);
+        CHECK(outlines.glyph_count() == 1);
+
+        ttf_glyph_shape shape;
+        CHECK_FALSE(outlines.get_shape('A', 24.0f, shape));
+
+        flattened_outline_cache flat(outlines, 24.0f);
+        CHECK(flat.get('A') == nullptr);
+        CHECK(flat.glyph_count() == 1);
+    }
+
+    TEST_CASE("cached shape matches ttf_font") {
+        if (!test_data::file_exists(test_data::ttf_arial())) {
+            WARN("Arial TTF not available");
+            return;
+        }
+
+        auto data = test_data::load_ttf_arial();
+        ttf_font font(data);
+        ttf_outline_cache outlines(font);
+
+        const glyph_outline* a = outlines.get('a');
+        REQUIRE(a != nullptr);
+        CHECK(a->verbs.size() > 4);
+        CHECK(outlines.get('a') == a);  // Parsed once
+        CHECK(outlines.arena_bytes() > 0);
+
+        for (float size : {12.0f, 48.0f}) {
+            auto expected = font.get_glyph_shape('a', size);
+            REQUIRE(expected.has_value());
+
+            ttf_glyph_shape shape;
+            REQUIRE(outlines.get_shape('a', size, shape));
+            REQUIRE(shape.vertices.size() == expected->vertices.size());
+            for (std::size_t i = 0; i < shape.vertices.size(); ++i) {
+                CHECK(shape.vertices[i].type == expected->vertices[i].type);
+                CHECK(shape.vertices[i].x == doctest::Approx(expected->vertices[i].x));
+                CHECK(shape.vertices[i].y == doctest::Approx(expected->vertices[i].y));
+                CHECK(shape.vertices[i].cx == doctest::Approx(expected->vertices[i].cx));
+            }
+            CHECK(shape.advance_x == doctest::Approx(expected->advance_x));
+            CHECK(shape.y1 == doctest::Approx(expected->y1));
+        }
+
+        // Reusing the shape keeps its storage
+        ttf_glyph_shape shape;
+        outlines.get_shape('W', 24.0f, shape);
+        const ttf_vertex* storage = shape.vertices.data();
+        std::size_t capacity = shape.vertices.capacity();
+        outlines.get_shape('l', 24.0f, shape);
+        if (shape.vertices.size() <= capacity) {
+            CHECK(shape.vertices.data() == storage);
+        }
+    }
+
+    TEST_CASE("flattened cache at one size") {
+        if (!test_data::file_exists(test_data::ttf_arial())) {
+            WARN("Arial TTF not available");
+            return;
+        }
+
+        auto data = test_data::load_ttf_arial();
+        ttf_font font(data);
+        ttf_outline_cache outlines(font);
+        flattened_outline_cache flat(outlines, 32.0f, 0.2f);
+
+        const flattened_glyph* o = flat.get('o');
+        REQUIRE(o != nullptr);
+        CHECK(o->contour_ends.size() == 2);  // Outer and inner ring
+        CHECK(o->contour_ends.back() == o->points.size());
+        CHECK(o->advance_x == doctest::Approx(font.get_glyph_metrics('o', 32.0f)->advance_x));
+
+        // All points lie within the glyph box
+        for (const auto& p : o->points) {
+            CHECK(p.x >= o->x0 - 0.5f);
+            CHECK(p.x <= o->x1 + 0.5f);
+            CHECK(p.y >= o->y0 - 0.5f);
+            CHECK(p.y <= o->y1 + 0.5f);
+        }
+
+        // Stable across further glyphs
+        const flat_point* first = o->points.data();
+        flat.get('W');
+        flat.get('g');
+        CHECK(flat.get('o') == o);
+        CHECK(o->points.data() == first);
+    }
+}
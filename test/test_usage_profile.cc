@@ -0,0 +1,244 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for usage_counter, usage_profile and profile-guided warm-up
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/usage_profile.hh>
+#include <onyx_font/text/glyph_cache.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+TEST_SUITE("usage_profile") {
+    TEST_CASE("counter counts codepoints") {
+        usage_counter counter;
+        counter.add_text("hello");
+        counter.add(U'Ж', 3);
+
+        CHECK(counter.size() == 5);
+        CHECK(counter.count('l') == 2);
+        CHECK(counter.count('h') == 1);
+        CHECK(counter.count(U'Ж') == 3);
+        CHECK(counter.count('z') == 0);
+    }
+
+    TEST_CASE("counter saturates") {
+        usage_counter counter;
+        counter.add('a', UINT32_MAX - 1);
+        counter.add('a', 5);
+        CHECK(counter.count('a') == UINT32_MAX);
+    }
+
+    TEST_CASE("top orders by count then codepoint") {
+        usage_counter counter;
+        counter.add('c', 5);
+        counter.add('a', 2);
+        counter.add('b', 2);
+        counter.add('d', 9);
+
+        CHECK(counter.top(10) == std::vector<char32_t>{'d', 'c', 'a', 'b'});
+        CHECK(counter.top(2) == std::vector<char32_t>{'d', 'c'});
+        CHECK(counter.top(0).empty());
+    }
+
+    TEST_CASE("counters are keyed by font and size") {
+        usage_profile profile;
+        auto a = profile.counter("sans", 12.0f);
+        auto b = profile.counter("sans", 12.0f);
+        auto c = profile.counter("sans", 16.0f);
+        auto d = profile.counter("mono", 12.0f);
+
+        CHECK(a == b);
+        CHECK(a != c);
+        CHECK(a != d);
+        CHECK(profile.size() == 3);
+        CHECK(profile.find("sans", 12.0f) == a);
+        CHECK(profile.find("serif", 12.0f) == nullptr);
+    }
+
+    TEST_CASE("top falls back to all sizes of a font") {
+        usage_profile profile;
+        profile.counter("sans", 12.0f)->add('x', 4);
+        profile.counter("sans", 16.0f)->add('y', 1);
+        profile.counter("sans", 16.0f)->add('x', 1);
+        profile.counter("mono", 12.0f)->add('z', 100);
+
+        CHECK(profile.top("sans", 16.0f, 10) == std::vector<char32_t>{'x', 'y'});
+        CHECK(profile.top("sans", 20.0f, 10) == std::vector<char32_t>{'x', 'y'});
+        CHECK(profile.top("serif", 12.0f, 10).empty());
+    }
+
+    TEST_CASE("merge adds counts") {
+        usage_profile a;
+        a.counter("sans", 12.0f)->add('x', 2);
+        usage_profile b;
+        b.counter("sans", 12.0f)->add('x', 3);
+        b.counter("mono", 10.0f)->add('y');
+
+        a.merge(b);
+        CHECK(a.size() == 2);
+        CHECK(a.find("sans", 12.0f)->count('x') == 5);
+        CHECK(a.find("mono", 10.0f)->count('y') == 1);
+    }
+
+    TEST_CASE("serialize round trip") {
+        usage_profile profile;
+        auto sans = profile.counter("sans", 12.5f);
+        sans->add_text("The quick brown fox");
+        sans->add(U'中', 70000);
+        sans->add(0x10FFFF);
+        profile.counter("mono", 9.0f)->add('0', 42);
+
+        auto bytes = profile.serialize();
+        auto loaded = usage_profile::deserialize(bytes);
+
+        CHECK(loaded.size() == 2);
+        auto loaded_sans = loaded.find("sans", 12.5f);
+        REQUIRE(loaded_sans);
+        CHECK(loaded_sans->counts() == sans->counts());
+        CHECK(loaded.find("mono", 9.0f)->count('0') == 42);
+        CHECK(loaded.serialize() == bytes);
+    }
+
+    TEST_CASE("serialized form is compact") {
+        usage_profile profile;
+        auto counter = profile.counter("f", 16.0f);
+        for (char32_t cp = 0x0400; cp < 0x0500; ++cp) {
+            counter->add(cp, 10);
+        }
+        // 256 consecutive glyphs with small counts: about 2 bytes each
+        CHECK(profile.serialize().size() < 256 * 2 + 32);
+    }
+
+    TEST_CASE("deserialize rejects malformed data") {
+        usage_profile profile;
+        profile.counter("sans", 12.0f)->add_text("abc");
+        auto bytes = profile.serialize();
+
+        std::vector<uint8_t> bad_magic = bytes;
+        bad_magic[0] = 'X';
+        CHECK_THROWS_AS((void)usage_profile::deserialize(bad_magic), std::runtime_error);
+
+        std::vector<uint8_t> bad_version = bytes;
+        bad_version[4] = 99;
+        CHECK_THROWS_AS((void)usage_profile::deserialize(bad_version), std::runtime_error);
+
+        for (std::size_t n = 0; n < bytes.size(); ++n) {
+            std::vector<uint8_t> truncated(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(n));
+            CHECK_THROWS_AS((void)usage_profile::deserialize(truncated), std::runtime_error);
+        }
+
+        std::vector<uint8_t> trailing = bytes;
+        trailing.push_back(0);
+        CHECK_THROWS_AS((void)usage_profile::deserialize(trailing), std::runtime_error);
+    }
+
+    TEST_CASE("save and load") {
+        auto path = std::filesystem::temp_directory_path() / "onyx_font_usage_profile_test.prof";
+        std::filesystem::remove(path);
+
+        CHECK(usage_profile::load(path).size() == 0);
+
+        usage_profile profile;
+        profile.counter("sans", 14.0f)->add_text("profile");
+        profile.save(path);
+
+        auto loaded = usage_profile::load(path);
+        CHECK(loaded.find("sans", 14.0f)->count('f') == 1);
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_SUITE("usage_profile warm_up") {
+    TEST_CASE("glyph_cache records get but not pre-caching") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        usage_profile profile;
+        glyph_cache_config config;
+        config.pre_cache_ascii = true;
+        config.usage = profile.counter("helva", 12.0f);
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f, config);
+
+        CHECK(config.usage->size() == 0);
+        (void)cache.get('A');
+        (void)cache.get('A');
+        (void)cache.get('B');
+        CHECK(config.usage->count('A') == 2);
+        CHECK(config.usage->count('B') == 1);
+    }
+
+    TEST_CASE("warm_up caches top codepoints") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        usage_profile profile;
+        auto counter = profile.counter("helva", 12.0f);
+        counter->add('e', 10);
+        counter->add('t', 8);
+        counter->add('a', 6);
+        counter->add('q', 1);
+
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f, config);
+
+        CHECK(warm_up(cache, profile, "helva", 3) == 3);
+        CHECK(cache.is_cached('e'));
+        CHECK(cache.is_cached('t'));
+        CHECK(cache.is_cached('a'));
+        CHECK_FALSE(cache.is_cached('q'));
+
+        // Already cached glyphs are not counted again
+        CHECK(warm_up(cache, profile, "helva", 4) == 1);
+        CHECK(cache.is_cached('q'));
+    }
+
+    TEST_CASE("warm_up_async on an executor") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+
+        usage_profile profile;
+        profile.counter("helva", 12.0f)->add_text("status");
+
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        glyph_cache<memory_atlas> cache(font_source::from_bitmap(font), 12.0f, config);
+
+        std::vector<std::function<void()>> queue;
+        auto ready = warm_up_async(cache, profile, "helva", 16,
+                                   [&queue](std::function<void()> job) { queue.push_back(std::move(job)); });
+        REQUIRE(queue.size() == 1);
+        CHECK_FALSE(cache.is_cached('s'));
+
+        queue.front()();
+        CHECK(ready.get() == 4);
+        CHECK(cache.is_cached('s'));
+        CHECK(cache.is_cached('u'));
+    }
+
+    TEST_CASE("warm_up_async on a thread") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        usage_profile profile;
+        profile.counter("litt", 20.0f)->add_text("AB");
+
+        glyph_cache_config config;
+        config.pre_cache_ascii = false;
+        glyph_cache<memory_atlas> cache(font_source::from_vector(font), 20.0f, config);
+
+        CHECK(warm_up_async(cache, profile, "litt", 8).get() == 2);
+        CHECK(cache.is_cached('A'));
+        CHECK(cache.is_cached('B'));
+    }
+}
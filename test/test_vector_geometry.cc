@@ -0,0 +1,321 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for vector font line geometry export
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/vector_geometry.hh>
+#include <onyx_font/font_factory.hh>
+#include <onyx_font/text/font_source.hh>
+#include "test_data.hh"
+#include <cmath>
+#include <span>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    /// Stroke offset table of a BGI font (after the 16-byte font header)
+    std::span<uint8_t> litt_stroke_offsets(std::vector<uint8_t>& data) {
+        std::size_t info = 0;
+        while (data[info] != 0x1A) {
+            ++info;
+        }
+        ++info;
+        const std::size_t header_size = data[info] | (data[info + 1] << 8);
+        return std::span<uint8_t>(data).subspan(header_size + 16);
+    }
+
+    /// Number of segments a glyph draws
+    std::size_t count_drawn(const vector_glyph& glyph) {
+        std::size_t n = 0;
+        bool pen_down = true;
+        for (const auto& cmd : glyph.strokes) {
+            if (cmd.type == stroke_type::LINE_TO && pen_down) {
+                ++n;
+            } else if (cmd.type == stroke_type::MOVE_TO) {
+                pen_down = true;
+            } else if (cmd.type == stroke_type::END) {
+                pen_down = false;
+            }
+        }
+        return n;
+    }
+
+    /// Reference walk of one glyph, collecting drawn segments
+    void walk_glyph(const vector_glyph& glyph, float scale, float origin_x,
+                    std::vector<line_vertex>& out) {
+        float pen_x = origin_x;
+        float pen_y = 0.0f;
+        bool pen_down = true;
+        for (const auto& cmd : glyph.strokes) {
+            if (cmd.type == stroke_type::END) {
+                pen_down = false;
+                continue;
+            }
+            float nx = pen_x + static_cast<float>(cmd.dx) * scale;
+            float ny = pen_y + static_cast<float>(cmd.dy) * scale;
+            if (cmd.type == stroke_type::LINE_TO && pen_down) {
+                out.push_back({pen_x, pen_y});
+                out.push_back({nx, ny});
+            }
+            if (cmd.type == stroke_type::MOVE_TO) {
+                pen_down = true;
+            }
+            pen_x = nx;
+            pen_y = ny;
+        }
+    }
+
+    float distance(line_vertex a, line_vertex b) {
+        return std::hypot(a.x - b.x, a.y - b.y);
+    }
+}
+
+TEST_SUITE("vector_geometry") {
+
+    TEST_CASE("line list matches stroke walk") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        line_geometry_options options;
+        options.size = 2.0f * static_cast<float>(font.get_metrics().pixel_height);
+
+        line_geometry geometry;
+        build_line_geometry(font, "AbZ", options, geometry);
+
+        std::vector<line_vertex> expected;
+        float origin = 0.0f;
+        for (char ch : {'A', 'b', 'Z'}) {
+            const vector_glyph* glyph = font.get_glyph(static_cast<uint8_t>(ch));
+            REQUIRE(glyph != nullptr);
+            walk_glyph(*glyph, 2.0f, origin, expected);
+            origin += static_cast<float>(glyph->width) * 2.0f;
+        }
+
+        CHECK_FALSE(geometry.triangles);
+        CHECK(geometry.advance == doctest::Approx(origin));
+        REQUIRE(geometry.segment_count > 0);
+        REQUIRE(geometry.vertices.size() == expected.size());
+        REQUIRE(geometry.indices.size() == expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            CHECK(geometry.vertices[i].x == doctest::Approx(expected[i].x));
+            CHECK(geometry.vertices[i].y == doctest::Approx(expected[i].y));
+            CHECK(geometry.indices[i] == i);
+        }
+    }
+
+    TEST_CASE("transform is applied to every vertex") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        line_geometry plain;
+        build_line_geometry(font, "Hi", {}, plain);
+
+        line_geometry_options options;
+        options.transform = affine_transform::translation(10.0f, 20.0f) * affine_transform::rotation(0.5f);
+        line_geometry moved;
+        build_line_geometry(font, "Hi", options, moved);
+
+        REQUIRE(moved.vertices.size() == plain.vertices.size());
+        for (std::size_t i = 0; i < plain.vertices.size(); ++i) {
+            line_vertex p = options.transform.apply(plain.vertices[i]);
+            CHECK(moved.vertices[i].x == doctest::Approx(p.x));
+            CHECK(moved.vertices[i].y == doctest::Approx(p.y));
+        }
+        // Advance stays in layout space
+        CHECK(moved.advance == plain.advance);
+    }
+
+    TEST_CASE("simd transform matches scalar") {
+        std::vector<line_vertex> a;
+        for (int i = 0; i < 11; ++i) {  // Odd count exercises the tail
+            a.push_back({static_cast<float>(i) * 1.5f, static_cast<float>(i * i) - 3.0f});
+        }
+        std::vector<line_vertex> b = a;
+
+        affine_transform t{0.8f, 0.3f, -0.2f, 1.1f, 5.0f, -7.0f};
+        transform_vertices(a, t);
+        transform_vertices_scalar(b, t);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            CHECK(a[i].x == doctest::Approx(b[i].x));
+            CHECK(a[i].y == doctest::Approx(b[i].y));
+        }
+        CHECK(b[2].x == doctest::Approx(0.8f * 3.0f - 0.2f * 1.0f + 5.0f));
+        CHECK(b[2].y == doctest::Approx(0.3f * 3.0f + 1.1f * 1.0f - 7.0f));
+    }
+
+    TEST_CASE("transform composition") {
+        auto t = affine_transform::translation(3.0f, 4.0f) * affine_transform::scaling(2.0f, 5.0f);
+        line_vertex p = t.apply({1.0f, 1.0f});
+        CHECK(p.x == doctest::Approx(5.0f));
+        CHECK(p.y == doctest::Approx(9.0f));
+
+        line_vertex r = affine_transform::rotation(std::acos(-1.0f) / 2.0f).apply({1.0f, 0.0f});
+        CHECK(r.x == doctest::Approx(0.0f).epsilon(1e-5));
+        CHECK(r.y == doctest::Approx(1.0f));
+    }
+
+    TEST_CASE("thick lines become quads") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        line_geometry lines;
+        build_line_geometry(font, "W", {}, lines);
+
+        line_geometry_options options;
+        options.thickness = 3.0f;
+        line_geometry quads;
+        build_line_geometry(font, "W", options, quads);
+
+        const std::size_t n = lines.segment_count;
+        REQUIRE(n > 0);
+        CHECK(quads.triangles);
+        CHECK(quads.segment_count == n);
+        REQUIRE(quads.vertices.size() == 4 * n);
+        REQUIRE(quads.indices.size() == 6 * n);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            const line_vertex* q = quads.vertices.data() + 4 * i;
+            line_vertex p0 = lines.vertices[2 * i];
+            line_vertex p1 = lines.vertices[2 * i + 1];
+
+            // Each end is straddled symmetrically, one thickness apart
+            CHECK(distance(q[0], q[1]) == doctest::Approx(3.0f));
+            CHECK(distance(q[2], q[3]) == doctest::Approx(3.0f));
+            if (distance(p0, p1) > 0.0f) {
+                CHECK((q[0].x + q[1].x) / 2 == doctest::Approx(p0.x));
+                CHECK((q[0].y + q[1].y) / 2 == doctest::Approx(p0.y));
+                CHECK((q[2].x + q[3].x) / 2 == doctest::Approx(p1.x));
+                CHECK((q[2].y + q[3].y) / 2 == doctest::Approx(p1.y));
+            }
+
+            const uint32_t* idx = quads.indices.data() + 6 * i;
+            for (int k = 0; k < 6; ++k) {
+                CHECK(idx[k] >= 4 * i);
+                CHECK(idx[k] < 4 * i + 4);
+            }
+        }
+    }
+
+    TEST_CASE("reused buffer does not reallocate") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        line_geometry_options options;
+        options.thickness = 1.0f;
+
+        line_geometry geometry;
+        build_line_geometry(font, "Hello, World", options, geometry);
+        const line_vertex* vertices = geometry.vertices.data();
+        const uint32_t* indices = geometry.indices.data();
+
+        build_line_geometry(font, "Hello", options, geometry);
+        build_line_geometry(font, "Hello, World", options, geometry);
+        CHECK(geometry.vertices.data() == vertices);
+        CHECK(geometry.indices.data() == indices);
+    }
+
+    TEST_CASE("newline and empty input") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        line_geometry geometry;
+        build_line_geometry(font, "", {}, geometry);
+        CHECK(geometry.segment_count == 0);
+        CHECK(geometry.vertices.empty());
+
+        line_geometry_options options;
+        options.size = 20.0f;
+        line_geometry single;
+        build_line_geometry(font, "I", options, single);
+        build_line_geometry(font, "\nI", options, geometry);
+        REQUIRE(geometry.vertices.size() == single.vertices.size());
+        for (std::size_t i = 0; i < single.vertices.size(); ++i) {
+            CHECK(geometry.vertices[i].x == doctest::Approx(single.vertices[i].x));
+            CHECK(geometry.vertices[i].y == doctest::Approx(single.vertices[i].y + 20.0f));
+        }
+    }
+
+    TEST_CASE("newlines draw nothing and advance is the widest line") {
+        REQUIRE(test_data::file_exists(test_data::bgi_litt()));
+
+        // LITT's default character is a blank space; point its stroke
+        // offset at 'I' so a wrong fallback for '\n' would draw
+        auto data = test_data::load_bgi_litt();
+        auto stroke_offsets = litt_stroke_offsets(data);
+        const std::size_t i_offset = 2 * static_cast<std::size_t>('I' - ' ');
+        stroke_offsets[0] = stroke_offsets[i_offset];
+        stroke_offsets[1] = stroke_offsets[i_offset + 1];
+        auto font = font_factory::load_vector(data, 0);
+
+        const vector_glyph* fallback = font.get_glyph(font.get_default_char());
+        REQUIRE(fallback != nullptr);
+        REQUIRE(count_drawn(*fallback) > 0);
+        REQUIRE(font.get_glyph('\n') == nullptr);
+
+        line_geometry geometry;
+        build_line_geometry(font, "\n\n", {}, geometry);
+        CHECK(geometry.segment_count == 0);
+        CHECK(geometry.vertices.empty());
+
+        line_geometry_options options;
+        options.thickness = 2.0f;
+        line_geometry wide;
+        line_geometry narrow;
+        build_line_geometry(font, "WWW", options, wide);
+        build_line_geometry(font, "i", options, narrow);
+
+        build_line_geometry(font, "WWW\ni\n", options, geometry);
+        CHECK(geometry.segment_count == wide.segment_count + narrow.segment_count);
+        CHECK(geometry.vertices.size() == geometry.segment_count * 4);
+        CHECK(geometry.indices.size() == geometry.segment_count * 6);
+        CHECK(geometry.advance == doctest::Approx(wide.advance));
+
+        options.thickness = 0.0f;
+        build_line_geometry(font, "i\nWWW", options, geometry);
+        CHECK(geometry.vertices.size() == geometry.segment_count * 2);
+        CHECK(geometry.advance == doctest::Approx(wide.advance));
+    }
+
+    TEST_CASE("text is encoded through the font codepage") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+        REQUIRE(font.get_codepage() == codepage::cp437);
+
+        // U+00E9 is 0x82 in CP437; byte 0xE9 is a different glyph
+        const vector_glyph* e_acute = font.get_glyph(0x82);
+        const vector_glyph* theta = font.get_glyph(0xE9);
+        REQUIRE(e_acute != nullptr);
+        REQUIRE(theta != nullptr);
+        REQUIRE(count_drawn(*e_acute) != count_drawn(*theta));
+
+        line_geometry geometry;
+        build_line_geometry(font, "\xC3\xA9", {}, geometry);
+
+        std::vector<line_vertex> expected;
+        walk_glyph(*e_acute, 1.0f, 0.0f, expected);
+        REQUIRE(geometry.vertices.size() == expected.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            CHECK(geometry.vertices[i].x == doctest::Approx(expected[i].x));
+            CHECK(geometry.vertices[i].y == doctest::Approx(expected[i].y));
+        }
+
+        // Same glyph as the rasterized path
+        auto source = font_source::from_vector(font);
+        const float native = static_cast<float>(font.get_metrics().pixel_height);
+        CHECK(geometry.advance == doctest::Approx(source.get_glyph_metrics(U'\u00E9', native).advance_x));
+
+        // Box drawing maps too; codepoints CP437 lacks draw nothing
+        build_line_geometry(font, "\xE2\x94\x80", {}, geometry);
+        const vector_glyph* box = font.get_glyph(0xC4);
+        REQUIRE(box != nullptr);
+        CHECK(geometry.segment_count == count_drawn(*box));
+
+        build_line_geometry(font, "\xE4\xB8\xAD", {}, geometry);
+        CHECK(geometry.segment_count == 0);
+        CHECK(geometry.advance == 0.0f);
+    }
+}
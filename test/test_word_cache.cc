@@ -0,0 +1,138 @@
+//
+// Created by igor on 18/10/2026.
+//
+// Unit tests for word_width_cache
+//
+
+#include <doctest/doctest.h>
+#include <onyx_font/text/word_cache.hh>
+#include <onyx_font/text/text_renderer.hh>
+#include <onyx_font/font_factory.hh>
+#include "test_data.hh"
+#include <memory>
+#include <tuple>
+#include <vector>
+
+using namespace onyx_font;
+using namespace onyx_font::test;
+
+namespace {
+    constexpr const char* paragraph =
+        "The quick brown fox jumps over the lazy dog. The dog sleeps; the fox runs\n"
+        "away over the hills and far away, and the quick dog follows the fox.";
+}
+
+TEST_SUITE("word_width_cache") {
+    TEST_CASE("measures like measure_text") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        text_rasterizer raster(font_source::from_bitmap(font));
+
+        word_width_cache words;
+        word_metrics m = words.measure(raster.face(), "Hello");
+        CHECK(m.width == doctest::Approx(raster.measure_text("Hello").width));
+        CHECK(m.peak >= m.width);
+        CHECK(m.first == U'H');
+        CHECK(m.last == U'o');
+        CHECK(words.misses() == 1);
+
+        word_metrics again = words.measure(raster.face(), "Hello");
+        CHECK(again.width == m.width);
+        CHECK(words.hits() == 1);
+        CHECK(words.size() == 1);
+    }
+
+    TEST_CASE("keyed by size and font") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+        text_rasterizer small(font_source::from_vector(font));
+        small.set_size(12.0f);
+        text_rasterizer large(font_source::from_vector(font));
+        large.set_size(24.0f);
+
+        word_width_cache words;
+        float w12 = words.measure(small.face(), "wide").width;
+        float w24 = words.measure(large.face(), "wide").width;
+        CHECK(words.size() == 2);
+        CHECK(w24 > w12);
+        CHECK(words.hits() == 0);
+
+        // Another source over the same font shares entries
+        text_rasterizer other(font_source::from_vector(font));
+        other.set_size(12.0f);
+        CHECK(words.measure(other.face(), "wide").width == w12);
+        CHECK(words.hits() == 1);
+    }
+
+    TEST_CASE("capacity bounds the cache") {
+        auto data = test_data::load_fon_helva();
+        auto font = font_factory::load_bitmap(data, 0);
+        text_rasterizer raster(font_source::from_bitmap(font));
+
+        word_width_cache words(2);
+        (void)words.measure(raster.face(), "one");
+        (void)words.measure(raster.face(), "two");
+        (void)words.measure(raster.face(), "one");    // two is now the oldest
+        (void)words.measure(raster.face(), "three");
+        CHECK(words.size() == 2);
+
+        auto misses = words.misses();
+        (void)words.measure(raster.face(), "one");
+        CHECK(words.misses() == misses);
+        (void)words.measure(raster.face(), "two");
+        CHECK(words.misses() == misses + 1);
+
+        words.clear();
+        CHECK(words.size() == 0);
+    }
+
+    TEST_CASE("measure_wrapped is unchanged by the memo") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+        text_rasterizer plain(font_source::from_vector(font));
+        plain.set_size(16.0f);
+        text_rasterizer memo(font_source::from_vector(font));
+        memo.set_size(16.0f);
+        auto words = std::make_shared<word_width_cache>();
+        memo.set_word_cache(words);
+        CHECK(memo.word_cache() == words.get());
+
+        for (float width : {0.0f, 25.0f, 60.0f, 120.0f, 240.0f, 1000.0f}) {
+            auto a = plain.measure_wrapped(paragraph, width);
+            auto b = memo.measure_wrapped(paragraph, width);
+            CHECK(b.height == a.height);
+            CHECK(b.width == doctest::Approx(a.width));
+        }
+        CHECK(words->hits() > 0);
+    }
+
+    TEST_CASE("draw_wrapped is unchanged by the memo") {
+        auto data = test_data::load_bgi_litt();
+        auto font = font_factory::load_vector(data, 0);
+
+        glyph_cache<memory_atlas> plain_cache(font_source::from_vector(font), 16.0f);
+        glyph_cache_config config;
+        config.words = std::make_shared<word_width_cache>();
+        glyph_cache<memory_atlas> memo_cache(font_source::from_vector(font), 16.0f, config);
+        text_renderer plain(plain_cache);
+        text_renderer memo(memo_cache);
+
+        using call = std::tuple<float, float, int, int>;
+        for (float width : {30.0f, 80.0f, 150.0f, 400.0f}) {
+            std::vector<call> a;
+            std::vector<call> b;
+            text_box box{0, 0, width, 2000};
+            int lines_a = plain.draw_wrapped(paragraph, box, text_align::left,
+                [&](const memory_atlas&, glyph_rect src, float x, float y) {
+                    a.emplace_back(x, y, src.w, src.h);
+                });
+            int lines_b = memo.draw_wrapped(paragraph, box, text_align::left,
+                [&](const memory_atlas&, glyph_rect src, float x, float y) {
+                    b.emplace_back(x, y, src.w, src.h);
+                });
+            CHECK(lines_a == lines_b);
+            CHECK(a == b);
+        }
+        CHECK(config.words->hits() > 0);
+    }
+}